@@ -180,24 +180,35 @@
 // Imagics/Extraction
 #include "GteMarchingCubes.h"
 #include "GteMarchingCubesTable.h"
+#include "GteSparseSurfaceExtractor.h"
 #include "GteSurfaceExtractor.h"
 
 // Imagics
+#include "GteBinaryImage2.h"
+#include "GteBinaryImage3.h"
+#include "GteBinaryMorphology.h"
+#include "GteBrickedImage3.h"
 #include "GteColorPixels.h"
+#include "GteEuclideanDistanceTransform.h"
 #include "GteHistogram.h"
 #include "GteImage.h"
 #include "GteImage1.h"
 #include "GteImage2.h"
 #include "GteImage3.h"
+#include "GteImageFilter.h"
 #include "GteImageUtility2.h"
 #include "GteImageUtility3.h"
 #include "GteMarchingCubes.h"
 #include "GteMarchingCubesTable.h"
+#include "GteSparseSurfaceExtractor.h"
 #include "GteSurfaceExtractor.h"
+#include "GteUnionFindLabeler.h"
 
 // LowLevel/DataTypes
 #include "GteArray2.h"
 #include "GteAtomicMinMax.h"
+#include "GteBarrier.h"
+#include "GteParallelFor.h"
 #include "GteRangeIteration.h"
 #include "GteThreadSafeMap.h"
 #include "GteThreadSafeQueue.h"
@@ -205,9 +216,11 @@
 // LowLevel/Graphs
 #include "GteEdgeKey.h"
 #include "GteETManifoldMesh.h"
+#include "GteETPoolManifoldMesh.h"
 #include "GteFeatureKey.h"
 #include "GteTetrahedronKey.h"
 #include "GteTriangleKey.h"
+#include "GteTSIndexedManifoldMesh.h"
 #include "GteTSManifoldMesh.h"
 #include "GteVEManifoldMesh.h"
 
@@ -230,6 +243,7 @@
 // Mathematics/Algebra
 #include "GteAxisAngle.h"
 #include "GteBandedMatrix.h"
+#include "GteCSRMatrix.h"
 #include "GteEulerAngles.h"
 #include "GteGMatrix.h"
 #include "GteGVector.h"
@@ -267,21 +281,25 @@
 #include "GteApprQuadratic2.h"
 #include "GteApprQuadratic3.h"
 #include "GteApprSphere3.h"
+#include "GteCovarianceAccumulator3.h"
 
 // Mathematics/Arithmetic
 #include "GteBitHacks.h"
 #include "GteBSNumber.h"
 #include "GteBSRational.h"
 #include "GteBSUInteger.h"
+#include "GteBSUIntegerHybrid.h"
 #include "GteIEEEBinary.h"
 #include "GteIEEEBinary16.h"
 
 // Mathematics/ComputationalGeometry
+#include "GteBRIO.h"
 #include "GteConstrainedDelaunay2.h"
 #include "GteConvexHull2.h"
 #include "GteConvexHull3.h"
 #include "GteDelaunay2.h"
 #include "GteDelaunay3.h"
+#include "GteIncrementalConvexHull3.h"
 #include "GteMinimumAreaBox2.h"
 #include "GteMinimumAreaCircle2.h"
 #include "GteMinimumVolumeBox3.h"
@@ -530,6 +548,10 @@
 #include "GteIntrSphere3Sphere3.h"
 
 // Mathematics/NumericalMethods
+#include "GteBatchLanes.h"
+#include "GteBatchSingularValueDecomposition.h"
+#include "GteBatchSymmetricEigensolver.h"
+#include "GteBlockReflector.h"
 #include "GteGaussianElimination.h"
 #include "GteIntegration.h"
 #include "GteLinearSystem.h"
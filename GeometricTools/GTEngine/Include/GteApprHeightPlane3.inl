@@ -16,35 +16,28 @@ ApprHeightPlane3<Real>::ApprHeightPlane3()
 template <typename Real>
 bool ApprHeightPlane3<Real>::Fit(int numPoints, Vector3<Real> const* points)
 {
-    if (numPoints >= GetMinimumRequired() && points)
+    CovarianceAccumulator3<Real> accumulator;
+    accumulator.Insert(numPoints, points);
+    return Fit(accumulator);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool ApprHeightPlane3<Real>::Fit(
+    CovarianceAccumulator3<Real> const& accumulator)
+{
+    if (accumulator.GetNumPoints() >= (int64_t)GetMinimumRequired())
     {
-        // Compute the mean of the points.
-        Vector3<Real> mean = Vector3<Real>::Zero();
-        for (int i = 0; i < numPoints; ++i)
-        {
-            mean += points[i];
-        }
-        mean /= (Real)numPoints;
-
-        // Compute the covariance matrix of the points.
-        Real covar00 = (Real)0, covar01 = (Real)0, covar02 = (Real)0;
-        Real covar11 = (Real)0, covar12 = (Real)0;
-        for (int i = 0; i < numPoints; ++i)
-        {
-            Vector3<Real> diff = points[i] - mean;
-            covar00 += diff[0] * diff[0];
-            covar01 += diff[0] * diff[1];
-            covar02 += diff[0] * diff[2];
-            covar11 += diff[1] * diff[1];
-            covar12 += diff[1] * diff[2];
-        }
-
-        // Decompose the covariance matrix.
+        // Decompose the covariance matrix.  The sums are used rather than
+        // the covariance matrix, because the solution is invariant to the
+        // scaling.
+        std::array<Real, 6> const& sums = accumulator.GetSums();
+        Real covar00 = sums[0], covar01 = sums[1], covar02 = sums[2];
+        Real covar11 = sums[3], covar12 = sums[4];
         Real det = covar00*covar11 - covar01*covar01;
         if (det != (Real)0)
         {
             Real invDet = ((Real)1) / det;
-            mParameters.first = mean;
+            mParameters.first = accumulator.GetMean();
             mParameters.second[0] =
                 (covar11*covar02 - covar01*covar12)*invDet;
             mParameters.second[1] =
@@ -85,46 +78,8 @@ bool ApprHeightPlane3<Real>::Fit(
     std::vector<Vector3<Real>> const& observations,
     std::vector<int> const& indices)
 {
-    if (static_cast<int>(indices.size()) >= GetMinimumRequired())
-    {
-        // Compute the mean of the points.
-        Vector3<Real> mean = Vector3<Real>::Zero();
-        for (auto index : indices)
-        {
-            mean += observations[index];
-        }
-        mean /= (Real)indices.size();
-
-        // Compute the covariance matrix of the points.
-        Real covar00 = (Real)0, covar01 = (Real)0, covar02 = (Real)0;
-        Real covar11 = (Real)0, covar12 = (Real)0;
-        for (auto index : indices)
-        {
-            Vector3<Real> diff = observations[index] - mean;
-            covar00 += diff[0] * diff[0];
-            covar01 += diff[0] * diff[1];
-            covar02 += diff[0] * diff[2];
-            covar11 += diff[1] * diff[1];
-            covar12 += diff[1] * diff[2];
-        }
-
-        // Decompose the covariance matrix.
-        Real det = covar00*covar11 - covar01*covar01;
-        if (det != (Real)0)
-        {
-            Real invDet = ((Real)1) / det;
-            mParameters.first = mean;
-            mParameters.second[0] =
-                (covar11*covar02 - covar01*covar12)*invDet;
-            mParameters.second[1] =
-                (covar00*covar12 - covar01*covar02)*invDet;
-            mParameters.second[2] = (Real)-1;
-            return true;
-        }
-    }
-
-    mParameters.first = Vector3<Real>::Zero();
-    mParameters.second = Vector3<Real>::Zero();
-    return false;
+    CovarianceAccumulator3<Real> accumulator;
+    accumulator.Insert(observations, indices);
+    return Fit(accumulator);
 }
 //----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "GteApprQuery.h"
+#include "GteCovarianceAccumulator3.h"
 #include "GteVector3.h"
 #include "GteSymmetricEigensolver.h"
 
@@ -33,6 +34,9 @@ public:
     bool Fit(int numPoints, Vector3<Real> const* points);
     std::pair<Vector3<Real>, Vector3<Real>> const& GetParameters() const;
 
+    // Fitting from the mean and covariance of a streamed set of points.
+    bool Fit(CovarianceAccumulator3<Real> const& accumulator);
+
     // Functions called by ApprQuery::RANSAC.  See GteApprQuery.h for a
     // detailed description.
     int GetMinimumRequired() const;
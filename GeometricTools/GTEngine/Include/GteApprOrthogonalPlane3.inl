@@ -17,38 +17,20 @@ template <typename Real>
 bool ApprOrthogonalPlane3<Real>::Fit(int numPoints,
     Vector3<Real> const* points)
 {
-    if (numPoints >= GetMinimumRequired() && points)
+    CovarianceAccumulator3<Real> accumulator;
+    accumulator.Insert(numPoints, points);
+    return Fit(accumulator);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool ApprOrthogonalPlane3<Real>::Fit(
+    CovarianceAccumulator3<Real> const& accumulator)
+{
+    if (accumulator.GetNumPoints() >= (int64_t)GetMinimumRequired())
     {
-        // Compute the mean of the points.
-        Vector3<Real> mean = Vector3<Real>::Zero();
-        for (int i = 0; i < numPoints; ++i)
-        {
-            mean += points[i];
-        }
-        mean /= (Real)numPoints;
-
-        // Compute the covariance matrix of the points.
-        Real covar00 = (Real)0, covar01 = (Real)0, covar02 = (Real)0;
-        Real covar11 = (Real)0, covar12 = (Real)0, covar22 = (Real)0;
-        for (int i = 0; i < numPoints; ++i)
-        {
-            Vector3<Real> diff = points[i] - mean;
-            covar00 += diff[0] * diff[0];
-            covar01 += diff[0] * diff[1];
-            covar02 += diff[0] * diff[2];
-            covar11 += diff[1] * diff[1];
-            covar12 += diff[1] * diff[2];
-            covar22 += diff[2] * diff[2];
-        }
-
         // Solve the eigensystem.
         SymmetricEigensolver<Real> es(3, 32);
-        std::array<Real, 9> M =
-        {
-            covar00, covar01, covar02,
-            covar01, covar11, covar12,
-            covar02, covar12, covar22
-        };
+        std::array<Real, 9> M = accumulator.GetCovariance();
         std::array<Real, 9> R;
         std::array<Real, 3> D;
         es.Solve(&M[0], +1);  // D[0] <= D[1] <= D[2]
@@ -57,7 +39,7 @@ bool ApprOrthogonalPlane3<Real>::Fit(int numPoints,
 
         // The plane normal is the eigenvector in the direction of smallest
         // variance of the points.
-        mParameters.first = mean;
+        mParameters.first = accumulator.GetMean();
         mParameters.second = Vector3<Real>(R[0], R[3], R[6]);
 
         // The fitted plane is unique when the minimum eigenvalue has
@@ -87,10 +69,8 @@ template <typename Real>
 Real ApprOrthogonalPlane3<Real>::Error(Vector3<Real> const& observation)
 const
 {
-    Vector3<Real> diff = observation - mParameters.first;
-    Real sqrlen = Dot(diff, diff);
-    Real dot = Dot(diff, mParameters.second);
-    Real error = std::abs(sqrlen - dot*dot);
+    Real d = Dot(observation - mParameters.first, mParameters.second);
+    Real error = d*d;
     return error;
 }
 //----------------------------------------------------------------------------
@@ -99,56 +79,8 @@ bool ApprOrthogonalPlane3<Real>::Fit(
     std::vector<Vector3<Real>> const& observations,
     std::vector<int> const& indices)
 {
-    if (static_cast<int>(indices.size()) >= GetMinimumRequired())
-    {
-        // Compute the mean of the points.
-        Vector3<Real> mean = Vector3<Real>::Zero();
-        for (auto index : indices)
-        {
-            mean += observations[index];
-        }
-        mean /= (Real)indices.size();
-
-        // Compute the covariance matrix of the points.
-        Real covar00 = (Real)0, covar01 = (Real)0, covar02 = (Real)0;
-        Real covar11 = (Real)0, covar12 = (Real)0, covar22 = (Real)0;
-        for (auto index : indices)
-        {
-            Vector3<Real> diff = observations[index] - mean;
-            covar00 += diff[0]*diff[0];
-            covar01 += diff[0]*diff[1];
-            covar02 += diff[0]*diff[2];
-            covar11 += diff[1]*diff[1];
-            covar12 += diff[1]*diff[2];
-            covar22 += diff[2]*diff[2];
-        }
-
-        // Solve the eigensystem.
-        SymmetricEigensolver<Real> es(3, 32);
-        std::array<Real, 9> M =
-        {
-            covar00, covar01, covar02,
-            covar01, covar11, covar12,
-            covar02, covar12, covar22
-        };
-        std::array<Real, 9> R;
-        std::array<Real, 3> D;
-        es.Solve(&M[0], +1);  // D[0] <= D[1] <= D[2]
-        es.GetEigenvalues(&D[0]);
-        es.GetEigenvectors(&R[0]);
-
-        // The plane normal is the eigenvector in the direction of smallest
-        // variance of the points.
-        mParameters.first = mean;
-        mParameters.second = Vector3<Real>(R[0], R[3], R[6]);
-
-        // The fitted plane is unique when the minimum eigenvalue has
-        // multiplicity 1.
-        return D[0] < D[1];
-    }
-
-    mParameters.first = Vector3<Real>::Zero();
-    mParameters.second = Vector3<Real>::Zero();
-    return false;
+    CovarianceAccumulator3<Real> accumulator;
+    accumulator.Insert(observations, indices);
+    return Fit(accumulator);
 }
 //----------------------------------------------------------------------------
@@ -10,6 +10,9 @@
 #include "GteSphere3.h"
 #include "GteMatrix.h"
 #include "GteSymmetricEigensolver.h"
+#include "GteParallelFor.h"
+#include <cstdint>
+#include <vector>
 
 namespace gte
 {
@@ -48,12 +51,59 @@ namespace gte
 //
 // The characterization depends on the signs of the d_i.
 
+// The matrix M/n is determined by the number of points n and the sums over
+// the points of the 34 distinct monomials of V*V^t that are not constant.
+// QuadraticAccumulator3 accumulates these sums, so the fit can be computed
+// from a stream of points, and accumulators of disjoint sets of points are
+// merged by adding their sums.  The sums are of monomials of degree up to 4
+// of the point coordinates, so translate the points to be near the origin
+// (for example, by subtracting the mean of a sample of the points) to avoid
+// loss of precision when adding the sums.
+
+template <typename Real>
+class QuadraticAccumulator3
+{
+public:
+    // Construction of an accumulator for the empty set of points.
+    QuadraticAccumulator3();
+
+    // Remove all points.
+    void Clear();
+
+    // Insert a single point.
+    void Insert(Vector3<Real> const& point);
+
+    // Insert an array of points.  The array is partitioned among the
+    // threads and the sums of the threads are added in order, so the result
+    // does not depend on the scheduling of the threads.
+    void Insert(int numPoints, Vector3<Real> const* points,
+        unsigned int numThreads = 1);
+
+    // Insert the points of another accumulator.
+    void Merge(QuadraticAccumulator3 const& accumulator);
+
+    // Member access.  The sums are stored in the upper-triangular entries of
+    // the unnormalized matrix M that are not copies of other entries; the
+    // remaining entries are zero.
+    int64_t GetNumPoints() const;
+    Matrix<10, 10, Real> const& GetSums() const;
+
+private:
+    int64_t mNumPoints;
+    Matrix<10, 10, Real> mSums;
+};
+
 template <typename Real>
 class ApprQuadratic3
 {
 public:
     Real operator()(int numPoints, Vector3<Real> const* points,
         Real coefficidents[10]);
+
+    // Fitting from the sums of a streamed set of points.  The return value
+    // is zero and the coefficients are zero when there are no points.
+    Real operator()(QuadraticAccumulator3<Real> const& accumulator,
+        Real coefficients[10]);
 };
 
 
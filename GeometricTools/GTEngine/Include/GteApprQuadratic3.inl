@@ -5,87 +5,174 @@
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 // File Version: 1.0.0 (2014/08/11)
 
+//----------------------------------------------------------------------------
+template <typename Real>
+QuadraticAccumulator3<Real>::QuadraticAccumulator3()
+{
+    Clear();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void QuadraticAccumulator3<Real>::Clear()
+{
+    mNumPoints = 0;
+    mSums.MakeZero();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void QuadraticAccumulator3<Real>::Insert(Vector3<Real> const& point)
+{
+    ++mNumPoints;
+    Real x = point[0];
+    Real y = point[1];
+    Real z = point[2];
+    Real x2 = x*x;
+    Real y2 = y*y;
+    Real z2 = z*z;
+    Real xy = x*y;
+    Real xz = x*z;
+    Real yz = y*z;
+    Real x3 = x*x2;
+    Real xy2 = x*y2;
+    Real xz2 = x*z2;
+    Real x2y = x*xy;
+    Real x2z = x*xz;
+    Real xyz = x*y*z;
+    Real y3 = y*y2;
+    Real yz2 = y*z2;
+    Real y2z = y*yz;
+    Real z3 = z*z2;
+    Real x4 = x*x3;
+    Real x2y2 = x*xy2;
+    Real x2z2 = x*xz2;
+    Real x3y = x*x2y;
+    Real x3z = x*x2z;
+    Real x2yz = x*xyz;
+    Real y4 = y*y3;
+    Real y2z2 = y*yz2;
+    Real xy3 = x*y3;
+    Real xy2z = x*y2z;
+    Real y3z = y*y2z;
+    Real z4 = z*z3;
+    Real xyz2 = x*yz2;
+    Real xz3 = x*z3;
+    Real yz3 = y*z3;
+
+    mSums(0, 1) += x;
+    mSums(0, 2) += y;
+    mSums(0, 3) += z;
+    mSums(0, 4) += x2;
+    mSums(0, 5) += y2;
+    mSums(0, 6) += z2;
+    mSums(0, 7) += xy;
+    mSums(0, 8) += xz;
+    mSums(0, 9) += yz;
+    mSums(1, 4) += x3;
+    mSums(1, 5) += xy2;
+    mSums(1, 6) += xz2;
+    mSums(1, 7) += x2y;
+    mSums(1, 8) += x2z;
+    mSums(1, 9) += xyz;
+    mSums(2, 5) += y3;
+    mSums(2, 6) += yz2;
+    mSums(2, 9) += y2z;
+    mSums(3, 6) += z3;
+    mSums(4, 4) += x4;
+    mSums(4, 5) += x2y2;
+    mSums(4, 6) += x2z2;
+    mSums(4, 7) += x3y;
+    mSums(4, 8) += x3z;
+    mSums(4, 9) += x2yz;
+    mSums(5, 5) += y4;
+    mSums(5, 6) += y2z2;
+    mSums(5, 7) += xy3;
+    mSums(5, 8) += xy2z;
+    mSums(5, 9) += y3z;
+    mSums(6, 6) += z4;
+    mSums(6, 7) += xyz2;
+    mSums(6, 8) += xz3;
+    mSums(6, 9) += yz3;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void QuadraticAccumulator3<Real>::Insert(int numPoints,
+    Vector3<Real> const* points, unsigned int numThreads)
+{
+    if (numPoints <= 0 || !points)
+    {
+        return;
+    }
+
+    auto task = [points](int imin, int imax,
+        QuadraticAccumulator3& accumulator)
+    {
+        for (int i = imin; i < imax; ++i)
+        {
+            accumulator.Insert(points[i]);
+        }
+    };
+
+    numThreads = ParallelFor::GetNumThreads(numThreads, numPoints);
+    if (numThreads == 1)
+    {
+        task(0, numPoints, *this);
+        return;
+    }
+
+    std::vector<QuadraticAccumulator3> local(numThreads);
+    ParallelFor::Execute(numThreads, [&](unsigned int t)
+    {
+        int imin, imax;
+        ParallelFor::GetRange(numPoints, numThreads, t, imin, imax);
+        task(imin, imax, local[t]);
+    });
+    for (unsigned int t = 0; t < numThreads; ++t)
+    {
+        Merge(local[t]);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void QuadraticAccumulator3<Real>::Merge(
+    QuadraticAccumulator3 const& accumulator)
+{
+    mNumPoints += accumulator.mNumPoints;
+    mSums += accumulator.mSums;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int64_t QuadraticAccumulator3<Real>::GetNumPoints() const
+{
+    return mNumPoints;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Matrix<10, 10, Real> const& QuadraticAccumulator3<Real>::GetSums() const
+{
+    return mSums;
+}
 //----------------------------------------------------------------------------
 template <typename Real>
 Real ApprQuadratic3<Real>::operator()(int numPoints,
     Vector3<Real> const* points, Real coefficients[10])
 {
-    Matrix<10, 10, Real> A;
-    for (int i = 0; i < numPoints; ++i)
+    QuadraticAccumulator3<Real> accumulator;
+    accumulator.Insert(numPoints, points);
+    return (*this)(accumulator, coefficients);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real ApprQuadratic3<Real>::operator()(
+    QuadraticAccumulator3<Real> const& accumulator, Real coefficients[10])
+{
+    if (accumulator.GetNumPoints() == 0)
     {
-        Real x = points[i][0];
-        Real y = points[i][1];
-        Real z = points[i][2];
-        Real x2 = x*x;
-        Real y2 = y*y;
-        Real z2 = z*z;
-        Real xy = x*y;
-        Real xz = x*z;
-        Real yz = y*z;
-        Real x3 = x*x2;
-        Real xy2 = x*y2;
-        Real xz2 = x*z2;
-        Real x2y = x*xy;
-        Real x2z = x*xz;
-        Real xyz = x*y*z;
-        Real y3 = y*y2;
-        Real yz2 = y*z2;
-        Real y2z = y*yz;
-        Real z3 = z*z2;
-        Real x4 = x*x3;
-        Real x2y2 = x*xy2;
-        Real x2z2 = x*xz2;
-        Real x3y = x*x2y;
-        Real x3z = x*x2z;
-        Real x2yz = x*xyz;
-        Real y4 = y*y3;
-        Real y2z2 = y*yz2;
-        Real xy3 = x*y3;
-        Real xy2z = x*y2z;
-        Real y3z = y*y2z;
-        Real z4 = z*z3;
-        Real xyz2 = x*yz2;
-        Real xz3 = x*z3;
-        Real yz3 = y*z3;
-
-        A(0, 1) += x;
-        A(0, 2) += y;
-        A(0, 3) += z;
-        A(0, 4) += x2;
-        A(0, 5) += y2;
-        A(0, 6) += z2;
-        A(0, 7) += xy;
-        A(0, 8) += xz;
-        A(0, 9) += yz;
-        A(1, 4) += x3;
-        A(1, 5) += xy2;
-        A(1, 6) += xz2;
-        A(1, 7) += x2y;
-        A(1, 8) += x2z;
-        A(1, 9) += xyz;
-        A(2, 5) += y3;
-        A(2, 6) += yz2;
-        A(2, 9) += y2z;
-        A(3, 6) += z3;
-        A(4, 4) += x4;
-        A(4, 5) += x2y2;
-        A(4, 6) += x2z2;
-        A(4, 7) += x3y;
-        A(4, 8) += x3z;
-        A(4, 9) += x2yz;
-        A(5, 5) += y4;
-        A(5, 6) += y2z2;
-        A(5, 7) += xy3;
-        A(5, 8) += xy2z;
-        A(5, 9) += y3z;
-        A(6, 6) += z4;
-        A(6, 7) += xyz2;
-        A(6, 8) += xz3;
-        A(6, 9) += yz3;
-        A(9, 9) += y2z2;
+        std::fill(coefficients, coefficients + 10, (Real)0);
+        return (Real)0;
     }
 
-    A(0, 0) = static_cast<Real>(numPoints);
+    Matrix<10, 10, Real> A = accumulator.GetSums();
+    A(0, 0) = static_cast<Real>(accumulator.GetNumPoints());
     A(1, 1) = A(0, 4);
     A(1, 2) = A(0, 7);
     A(1, 3) = A(0, 8);
@@ -115,7 +202,7 @@ Real ApprQuadratic3<Real>::operator()(int numPoints,
         }
     }
 
-    Real invNumPoints = ((Real)1) / static_cast<Real>(numPoints);
+    Real invNumPoints = ((Real)1) / A(0, 0);
     for (int row = 0; row < 10; ++row)
     {
         for (int col = 0; col < 10; ++col)
@@ -139,6 +226,7 @@ Real ApprQuadraticSphere3<Real>::operator()(int numPoints,
     Vector3<Real> const* points, Sphere3<Real>& sphere)
 {
     Matrix<5, 5, Real> A;
+    A.MakeZero();
     for (int i = 0; i < numPoints; ++i)
     {
         Real x = points[i][0];
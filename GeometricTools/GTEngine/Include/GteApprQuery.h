@@ -7,7 +7,13 @@
 
 #pragma once
 
+#include "GteAtomicMinMax.h"
+#include "GteParallelFor.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
 #include <random>
 #include <vector>
 
@@ -25,8 +31,11 @@
 //   // Estimate the model parameters for all observations specified by the
 //   // indices.  The three Fit() functions of ApprQuery manipulate their
 //   // inputs in order to pass them to ModelType::Fit().
-//   ModelType::Fit(std::vector<ObservationType> const& observations,
-//       std::vector<size_t> const& indices);
+//   bool ModelType::Fit(std::vector<ObservationType> const& observations,
+//       std::vector<int> const& indices);
+//
+// RANSAC copies the candidate model once per thread, so ModelType must be
+// copy constructible and assignable.
 
 namespace gte
 {
@@ -48,14 +57,97 @@ public:
     bool Fit(std::vector<ObservationType> const& observations,
         std::vector<int> const& indices, int const numIndices);
 
+    // The parameters for the RANdom SAmple Consensus algorithm.
+    //
+    // A model is fitted to a minimal sample of GetMinimumRequired()
+    // observations and scored by the number of observations whose errors
+    // are at most maxErrorForGoodFit (the inliers).  The scoring of a model
+    // stops as soon as it cannot have more inliers than the best model so
+    // far.  The model with the most inliers, when there are at least
+    // numRequiredForGoodFit of them, is fitted to its inliers.
+    //
+    // At most maxIterations models are tried.  When confidence is in (0,1),
+    // the number of models is reduced whenever a better model is found to
+    // log(1-confidence)/log(1-w^m), where w is the inlier ratio of the best
+    // model and m is the minimum number of observations; this is the number
+    // of samples for which at least one sample consists only of inliers
+    // with the specified probability.  A confidence of 0 disables the
+    // adaptive termination.
+    //
+    // When numPreemptiveTests is positive, each model is first tested on
+    // at most that many randomly selected observations by the sequential
+    // probability ratio test of J. Matas and O. Chum, "Randomized RANSAC
+    // with Sequential Probability Ratio Test", ICCV 2005.  A model is
+    // discarded without scoring all observations as soon as the likelihood
+    // ratio of "bad model" to "model as good as the best one" exceeds
+    // SPRT_THRESHOLD, which discards about 1 in SPRT_THRESHOLD good models;
+    // the number of samples of the adaptive termination accounts for
+    // this.  Bad models are typically discarded after tens of tests, so a
+    // value of 1000 is reasonable when there are millions of observations.
+    //
+    // When progressive is 'true', the observations must be ordered by
+    // decreasing quality (for example, by a matching score) and the samples
+    // are drawn by the PROSAC schedule of O. Chum and J. Matas, "Matching
+    // with PROSAC - Progressive Sample Consensus", CVPR 2005.  Sample t is
+    // drawn from the first n(t) observations and contains observation
+    // n(t)-1, where n(t) grows from GetMinimumRequired() to the number of
+    // observations as the samples are drawn.
+    //
+    // The models are generated and scored by numThreads threads, each
+    // with its own random number generator seeded by the seed and the
+    // thread index.  The results are repeatable for a single thread; with
+    // multiple threads, the best model depends on the scheduling.
+    struct RANSACParameters
+    {
+        RANSACParameters();
+
+        int numRequiredForGoodFit;  // default 0
+        Real maxErrorForGoodFit;  // default 0
+        int maxIterations;  // default 1000
+        Real confidence;  // default 0.99
+        int numPreemptiveTests;  // default 0
+        bool progressive;  // default false
+        unsigned int numThreads;  // default 1
+        unsigned int seed;  // default 0
+    };
+
     // Apply the RANdom SAmple Consensus algorithm for fitting a model to
-    // observations.
+    // observations.  The candidate model provides the copies that are used
+    // for fitting the samples.  On success, bestConsensus stores the indices
+    // of the inliers of the best model in increasing order and bestModel is
+    // fitted to them.
+    static bool RANSAC(
+        ModelType& candidateModel,
+        std::vector<ObservationType> const& observations,
+        RANSACParameters const& parameters,
+        std::vector<int>& bestConsensus,
+        ModelType& bestModel);
+
+    // The original interface, which is RANSAC with maxIterations set to
+    // numIterations, no adaptive termination, no preemptive tests and a
+    // single thread.
     static bool RANSAC(
         ModelType& candidateModel,
         std::vector<ObservationType> const& observations,
         int const numRequiredForGoodFit, Real const maxErrorForGoodFit,
         int const numIterations, std::vector<int>& bestConsensus,
         ModelType& bestModel);
+
+private:
+    // The threshold on the likelihood ratio of the preemptive test.
+    enum { SPRT_THRESHOLD = 100 };
+
+    // Select numSelected distinct integers in [0,range) using the algorithm
+    // of R. Floyd, which requires numSelected random numbers.
+    static void SelectDistinct(int numSelected, int range,
+        std::mt19937& generator, std::vector<int>& selected);
+
+    // Compute the number of samples of size minRequired for which at least
+    // one sample consists only of inliers and is accepted, with the
+    // specified confidence.  The probability that a sample consisting only
+    // of inliers is accepted is 'acceptance'.
+    static int GetNumIterations(Real confidence, double inlierRatio,
+        double acceptance, int minRequired, int maxIterations);
 };
 
 #include "GteApprQuery.inl"
@@ -56,96 +56,331 @@ bool ApprQuery<Real, ModelType, ObservationType>::Fit(
         index = indices[i++];
     }
 
-    return ((ModelType*)this)->Fit(observations, indices);
+    return ((ModelType*)this)->Fit(observations, localindices);
+}
+//----------------------------------------------------------------------------
+template <typename Real, typename ModelType, typename ObservationType>
+ApprQuery<Real, ModelType, ObservationType>::RANSACParameters::
+RANSACParameters()
+    :
+    numRequiredForGoodFit(0),
+    maxErrorForGoodFit((Real)0),
+    maxIterations(1000),
+    confidence((Real)0.99),
+    numPreemptiveTests(0),
+    progressive(false),
+    numThreads(1),
+    seed(0)
+{
 }
 //----------------------------------------------------------------------------
 template <typename Real, typename ModelType, typename ObservationType>
 bool ApprQuery<Real, ModelType, ObservationType>::RANSAC(
     ModelType& candidateModel,
     std::vector<ObservationType> const& observations,
-    int const numRequiredForGoodFit, Real const maxErrorForGoodFit,
-    int const numIterations, std::vector<int>& bestConsensus,
+    RANSACParameters const& parameters,
+    std::vector<int>& bestConsensus,
     ModelType& bestModel)
 {
     int const numObservations = static_cast<int>(observations.size());
     int const minRequired = candidateModel.GetMinimumRequired();
-    if (numObservations < minRequired)
+    if (numObservations < minRequired || parameters.maxIterations <= 0)
     {
         // Too few observations for model fitting.
         return false;
     }
 
-    // The first part of the array will store the consensus set, initially
-    // filled with the minimumu number of indices that correspond to the
-    // candidate inliers.  The last part will store the remaining indices.
-    // These points are tested against the model and are added to the
-    // consensus set when they fit.  All the index manipulation is done
-    // in place.  Initially, the candidates are the identity permutation.
-    std::vector<int> candidates(numObservations);
-    int j = 0;
-    for (auto& c : candidates)
-    {
-        c = j++;
-    }
-
     if (numObservations == minRequired)
     {
         // We have the minimum number of observations to generate the model,
         // so RANSAC cannot be used.  Compute the model with the entire set
         // of observations.
-        bestConsensus = candidates;
-        return bestModel.Fit(observations);
+        bestConsensus.resize(numObservations);
+        for (int j = 0; j < numObservations; ++j)
+        {
+            bestConsensus[j] = j;
+        }
+        return bestModel.Fit(observations, bestConsensus);
     }
 
-    int bestNumFittedObservations = minRequired;
+    int const maxIterations = parameters.maxIterations;
+    Real const maxError = parameters.maxErrorForGoodFit;
+    int const numRequired = std::max(parameters.numRequiredForGoodFit, 1);
+    bool const adaptive = (parameters.confidence > (Real)0 &&
+        parameters.confidence < (Real)1);
+
+    // The probability that the preemptive test accepts a model at least as
+    // good as the best one is about 1-1/SPRT_THRESHOLD.
+    double const acceptance = (parameters.numPreemptiveTests > 0 ?
+        1.0 - 1.0 / (double)SPRT_THRESHOLD : 1.0);
 
-    for (int i = 0; i < numIterations; ++i)
+    // The PROSAC schedule.  The number of observations from which sample t
+    // is drawn is prosacSize[t].
+    std::vector<int> prosacSize;
+    if (parameters.progressive)
     {
-        // Randomly permute the previous candidates, partitioning the array
-        // into GetMinimumRequired() indices (the candidate inliers) followed
-        // by the remaining indices (candidates for testing against the
-        // model).
-        std::shuffle(candidates.begin(), candidates.end(),
-            std::default_random_engine());
-
-        // Fit the model to the inliers.
-        if (candidateModel.Fit(observations, candidates, minRequired))
+        prosacSize.resize(maxIterations);
+        double tn = (double)maxIterations;
+        for (int i = 0; i < minRequired; ++i)
+        {
+            tn *= (double)(minRequired - i) / (double)(numObservations - i);
+        }
+        int n = minRequired;
+        int64_t tnPrime = 1;
+        for (int t = 0; t < maxIterations; ++t)
         {
-            // Test each remaining observation whether it fits the model.  If
-            // it does, include it in the consensus set.
-            int numFittedObservations = minRequired;
-            for (j = minRequired; j < numObservations; ++j)
+            if (t + 1 > tnPrime && n < numObservations)
             {
-                if (candidateModel.Error(observations[candidates[j]])
-                    <= maxErrorForGoodFit)
+                double tnNext = tn * (double)(n + 1) /
+                    (double)(n + 1 - minRequired);
+                tnPrime += (int64_t)std::ceil(tnNext - tn);
+                tn = tnNext;
+                ++n;
+            }
+            prosacSize[t] = n;
+        }
+    }
+
+    // The state shared by the threads.  The number of inliers of the best
+    // model is read without locking for discarding models early; a stale
+    // value only makes the discarding less effective.  For PROSAC,
+    // bestPrefix[n] is the number of inliers of the best model among the
+    // first n observations.
+    std::atomic<int> nextIteration(0);
+    std::atomic<int> numIterations(maxIterations);
+    std::atomic<int> bestNumInliers(0);
+    std::mutex bestMutex;
+    ModelType bestHypothesis(candidateModel);
+    std::vector<int> bestPrefix;
+
+    auto task = [&](unsigned int t)
+    {
+        std::seed_seq sequence{ parameters.seed, t };
+        std::mt19937 generator(sequence);
+        std::uniform_int_distribution<int> rnd(0, numObservations - 1);
+        ModelType model(candidateModel);
+        std::vector<int> sample;
+        sample.reserve(minRequired);
+        int64_t numTested = 0, numTestedInliers = 0;
+
+        int iteration;
+        while ((iteration = nextIteration++) < numIterations)
+        {
+            if (parameters.progressive && adaptive && bestNumInliers > 0)
+            {
+                // The termination criterion of PROSAC, simplified.  Sample
+                // t is drawn from the first n observations.  When the
+                // inliers of the best model among them are more than 3
+                // standard deviations above the number expected for its
+                // inlier ratio over all observations (the m inliers of a
+                // sample are excluded), the number of samples is bounded
+                // using the inlier ratio of the first n observations.
+                std::lock_guard<std::mutex> lock(bestMutex);
+                int n = prosacSize[iteration];
+                int inliersN = bestPrefix[n];
+                double ratio =
+                    (double)bestNumInliers / (double)numObservations;
+                double mean = (double)(n - minRequired) * ratio;
+                double sigma = std::sqrt(mean * (1.0 - ratio));
+                if ((double)(inliersN - minRequired) > mean + 3.0 * sigma)
                 {
-                    std::swap(candidates[j],
-                        candidates[numFittedObservations]);
-                    ++numFittedObservations;
+                    int numRemaining = GetNumIterations(
+                        parameters.confidence, (double)inliersN / (double)n,
+                        acceptance, minRequired, maxIterations);
+                    AtomicMin(numIterations, iteration + numRemaining);
+                    if (iteration >= numIterations)
+                    {
+                        break;
+                    }
                 }
             }
 
-            if (numFittedObservations >= numRequiredForGoodFit)
+            // Select the sample and fit the model to it.
+            if (parameters.progressive &&
+                prosacSize[iteration] < numObservations)
+            {
+                int n = prosacSize[iteration];
+                SelectDistinct(minRequired - 1, n - 1, generator, sample);
+                sample.push_back(n - 1);
+            }
+            else
             {
-                // We have observations that fit the model.  Update the best
-                // model using the consensus set.
-                candidateModel.Fit(observations, candidates,
-                    numFittedObservations);
-                if (numFittedObservations > bestNumFittedObservations)
+                SelectDistinct(minRequired, numObservations, generator,
+                    sample);
+            }
+
+            if (!model.Fit(observations, sample))
+            {
+                continue;
+            }
+
+            int currentBest = bestNumInliers;
+            if (parameters.numPreemptiveTests > 0 && currentBest > 0 &&
+                currentBest < numObservations)
+            {
+                // The sequential probability ratio test.  The probability
+                // that an observation is an inlier is epsilon for a model
+                // as good as the best one and delta for a bad model, which
+                // is estimated from the tests of this thread.
+                double epsilon =
+                    (double)currentBest / (double)numObservations;
+                double delta = (numTested > 0 ?
+                    (double)numTestedInliers / (double)numTested : 0.01);
+                delta = std::min(delta, 0.5 * epsilon);
+                double inlierFactor = delta / epsilon;
+                double outlierFactor = (1.0 - delta) / (1.0 - epsilon);
+                double lambda = 1.0;
+                bool rejected = false;
+                for (int k = 0; k < parameters.numPreemptiveTests; ++k)
                 {
-                    // The consensus set is larger than the previous consensus
-                    // set, so its model becomes the best one.
-                    bestModel = candidateModel;
-                    bestConsensus.resize(numFittedObservations);
-                    std::copy(candidates.begin(),
-                        candidates.begin() + numFittedObservations,
-                        bestConsensus.begin());
-                    bestNumFittedObservations = numFittedObservations;
+                    ++numTested;
+                    if (model.Error(observations[rnd(generator)]) <=
+                        maxError)
+                    {
+                        ++numTestedInliers;
+                        lambda *= inlierFactor;
+                    }
+                    else
+                    {
+                        lambda *= outlierFactor;
+                        if (lambda > SPRT_THRESHOLD)
+                        {
+                            rejected = true;
+                            break;
+                        }
+                    }
                 }
+                if (rejected)
+                {
+                    continue;
+                }
+            }
+
+            // Count the inliers.  The counting stops when the model can no
+            // longer have more inliers than the best model.
+            int const numToBeat = std::max(currentBest + 1, numRequired);
+            int const maxOutliers = numObservations - numToBeat;
+            int numOutliers = 0;
+            for (auto const& observation : observations)
+            {
+                if (model.Error(observation) > maxError)
+                {
+                    if (++numOutliers > maxOutliers)
+                    {
+                        break;
+                    }
+                }
+            }
+            if (numOutliers > maxOutliers)
+            {
+                continue;
             }
+
+            int numInliers = numObservations - numOutliers;
+            std::lock_guard<std::mutex> lock(bestMutex);
+            if (numInliers > bestNumInliers)
+            {
+                bestHypothesis = model;
+                bestNumInliers = numInliers;
+                if (parameters.progressive)
+                {
+                    int const maxSize = prosacSize.back();
+                    bestPrefix.resize(maxSize + 1);
+                    bestPrefix[0] = 0;
+                    for (int j = 0; j < maxSize; ++j)
+                    {
+                        bool inlier = (model.Error(observations[j]) <=
+                            maxError);
+                        bestPrefix[j + 1] = bestPrefix[j] + (inlier ? 1 : 0);
+                    }
+                }
+                if (adaptive)
+                {
+                    AtomicMin(numIterations, GetNumIterations(
+                        parameters.confidence,
+                        (double)numInliers / (double)numObservations,
+                        acceptance, minRequired, maxIterations));
+                }
+            }
+        }
+    };
+
+    ParallelFor::Execute(parameters.numThreads, task);
+
+    if (bestNumInliers == 0)
+    {
+        return false;
+    }
+
+    // Gather the inliers of the best model and fit the model to them.
+    bestConsensus.clear();
+    bestConsensus.reserve(bestNumInliers);
+    for (int j = 0; j < numObservations; ++j)
+    {
+        if (bestHypothesis.Error(observations[j]) <= maxError)
+        {
+            bestConsensus.push_back(j);
+        }
+    }
+    bestModel = bestHypothesis;
+    bestModel.Fit(observations, bestConsensus);
+    return true;
+}
+//----------------------------------------------------------------------------
+template <typename Real, typename ModelType, typename ObservationType>
+bool ApprQuery<Real, ModelType, ObservationType>::RANSAC(
+    ModelType& candidateModel,
+    std::vector<ObservationType> const& observations,
+    int const numRequiredForGoodFit, Real const maxErrorForGoodFit,
+    int const numIterations, std::vector<int>& bestConsensus,
+    ModelType& bestModel)
+{
+    RANSACParameters parameters;
+    parameters.numRequiredForGoodFit = numRequiredForGoodFit;
+    parameters.maxErrorForGoodFit = maxErrorForGoodFit;
+    parameters.maxIterations = numIterations;
+    parameters.confidence = (Real)0;
+    return RANSAC(candidateModel, observations, parameters, bestConsensus,
+        bestModel);
+}
+//----------------------------------------------------------------------------
+template <typename Real, typename ModelType, typename ObservationType>
+void ApprQuery<Real, ModelType, ObservationType>::SelectDistinct(
+    int numSelected, int range, std::mt19937& generator,
+    std::vector<int>& selected)
+{
+    selected.clear();
+    for (int j = range - numSelected; j < range; ++j)
+    {
+        int k = std::uniform_int_distribution<int>(0, j)(generator);
+        if (std::find(selected.begin(), selected.end(), k) == selected.end())
+        {
+            selected.push_back(k);
         }
+        else
+        {
+            selected.push_back(j);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real, typename ModelType, typename ObservationType>
+int ApprQuery<Real, ModelType, ObservationType>::GetNumIterations(
+    Real confidence, double inlierRatio, double acceptance, int minRequired,
+    int maxIterations)
+{
+    double allInliers = acceptance * std::pow(inlierRatio, minRequired);
+    if (allInliers >= 1.0)
+    {
+        return 1;
     }
 
-    return bestNumFittedObservations >= numRequiredForGoodFit;
+    double numerator = std::log(1.0 - (double)confidence);
+    double denominator = std::log(1.0 - allInliers);
+    if (denominator >= 0.0 || numerator / denominator >= maxIterations)
+    {
+        return maxIterations;
+    }
+    return std::max((int)std::ceil(numerator / denominator), 1);
 }
 //----------------------------------------------------------------------------
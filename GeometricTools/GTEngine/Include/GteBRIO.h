@@ -0,0 +1,70 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GteVector.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Biased randomized insertion order (BRIO) for incremental constructions
+// such as Delaunay2 and Delaunay3.
+//   N. Amenta, S. Choi, G. Rote, "Incremental constructions con BRIO",
+//   Proceedings of the 19th Annual Symposium on Computational Geometry,
+//   pp. 211-219, 2003.
+// The indices are randomly shuffled and then partitioned into rounds whose
+// sizes grow geometrically; the last round contains about half the indices,
+// the round before it about a quarter, and so on.  The randomization keeps
+// the expected cost of the incremental algorithm bounded, and the rounds
+// are each sorted along a Hilbert curve so that consecutive points are
+// spatially close.  An incremental algorithm that starts each point-location
+// walk from the last simplex it created then has short walks, which makes
+// the construction nearly linear in practice for spatially coherent inputs.
+//
+// The Hilbert index is computed from the points quantized to an integer grid
+// that covers their axis-aligned bounding box, using the transpose algorithm
+// in
+//   J. Skilling, "Programming the Hilbert curve",
+//   AIP Conference Proceedings 707, pp. 381-387, 2004.
+// The grid has 2^b cells per axis, where b = min(31, 63/N), so the index
+// fits in 64 bits.
+
+namespace gte
+{
+
+template <int N, typename Real>
+class BRIO
+{
+public:
+    // The seed is used for the random shuffle, so the order is
+    // deterministic for a specified seed.  The indices are halved into
+    // rounds until fewer than 2*minRoundSize of them remain, and those form
+    // the first round.  Every round, including the first, is sorted along
+    // the curve.
+    BRIO(unsigned int seed = 0, int minRoundSize = 64);
+
+    // Reorder indices[] (the indices into points[] of the points to be
+    // inserted) into BRIO order.
+    void operator()(Vector<N, Real> const* points, std::vector<int>& indices);
+
+    // Compute the Hilbert index of a point whose coordinates are already
+    // quantized to integers in [0,2^NUM_BITS).
+    static int const NUM_BITS = (63 / N < 31 ? 63 / N : 31);
+    static uint64_t GetHilbertIndex(uint64_t const coord[N]);
+
+private:
+    unsigned int mSeed;
+    int mMinRoundSize;
+
+    // Scratch storage for the sorting, reused across calls.
+    std::vector<std::pair<uint64_t, int>> mKeys;
+};
+
+#include "GteBRIO.inl"
+
+}
@@ -0,0 +1,159 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <int N, typename Real>
+BRIO<N, Real>::BRIO(unsigned int seed, int minRoundSize)
+    :
+    mSeed(seed),
+    mMinRoundSize(std::max(minRoundSize, 1))
+{
+}
+//----------------------------------------------------------------------------
+template <int N, typename Real>
+void BRIO<N, Real>::operator()(Vector<N, Real> const* points,
+    std::vector<int>& indices)
+{
+    int const numIndices = static_cast<int>(indices.size());
+    if (numIndices < 2)
+    {
+        return;
+    }
+
+    // Compute the axis-aligned bounding box of the points.
+    double vmin[N], vmax[N];
+    for (int d = 0; d < N; ++d)
+    {
+        vmin[d] = static_cast<double>(points[indices[0]][d]);
+        vmax[d] = vmin[d];
+    }
+    for (auto index : indices)
+    {
+        for (int d = 0; d < N; ++d)
+        {
+            double value = static_cast<double>(points[index][d]);
+            if (value < vmin[d])
+            {
+                vmin[d] = value;
+            }
+            else if (value > vmax[d])
+            {
+                vmax[d] = value;
+            }
+        }
+    }
+
+    // Quantize the points to the grid and compute their Hilbert indices.
+    // The scales map the bounding box onto [0,2^NUM_BITS-1] per axis.
+    double const maxCoord = static_cast<double>((1ull << NUM_BITS) - 1);
+    double scale[N];
+    for (int d = 0; d < N; ++d)
+    {
+        double extent = vmax[d] - vmin[d];
+        scale[d] = (extent > 0.0 ? maxCoord / extent : 0.0);
+    }
+
+    // Randomly shuffle the indices.
+    std::mt19937 mte(mSeed);
+    std::shuffle(indices.begin(), indices.end(), mte);
+
+    mKeys.resize(numIndices);
+    for (int i = 0; i < numIndices; ++i)
+    {
+        int index = indices[i];
+        uint64_t coord[N];
+        for (int d = 0; d < N; ++d)
+        {
+            double value = static_cast<double>(points[index][d]);
+            double q = (value - vmin[d]) * scale[d];
+            coord[d] = static_cast<uint64_t>(std::min(std::max(q, 0.0),
+                maxCoord));
+        }
+        mKeys[i] = std::make_pair(GetHilbertIndex(coord), index);
+    }
+
+    // Partition the shuffled indices into rounds [end/2,end) for
+    // end = numIndices, numIndices/2, ... and sort each round along the
+    // curve.  The first round is [0,end) for the final 'end'.
+    int end = numIndices;
+    while (end > 0)
+    {
+        int begin = (end >= 2 * mMinRoundSize ? end / 2 : 0);
+        std::sort(mKeys.begin() + begin, mKeys.begin() + end);
+        end = begin;
+    }
+
+    for (int i = 0; i < numIndices; ++i)
+    {
+        indices[i] = mKeys[i].second;
+    }
+}
+//----------------------------------------------------------------------------
+template <int N, typename Real>
+uint64_t BRIO<N, Real>::GetHilbertIndex(uint64_t const coord[N])
+{
+    // Convert the coordinates to the transposed Hilbert index.
+    uint64_t x[N];
+    for (int d = 0; d < N; ++d)
+    {
+        x[d] = coord[d];
+    }
+
+    uint64_t const M = 1ull << (NUM_BITS - 1);
+    uint64_t P, Q, t;
+
+    // Inverse undo.
+    for (Q = M; Q > 1; Q >>= 1)
+    {
+        P = Q - 1;
+        for (int d = 0; d < N; ++d)
+        {
+            if (x[d] & Q)
+            {
+                // Invert.
+                x[0] ^= P;
+            }
+            else
+            {
+                // Exchange.
+                t = (x[0] ^ x[d]) & P;
+                x[0] ^= t;
+                x[d] ^= t;
+            }
+        }
+    }
+
+    // Gray encode.
+    for (int d = 1; d < N; ++d)
+    {
+        x[d] ^= x[d - 1];
+    }
+    t = 0;
+    for (Q = M; Q > 1; Q >>= 1)
+    {
+        if (x[N - 1] & Q)
+        {
+            t ^= Q - 1;
+        }
+    }
+    for (int d = 0; d < N; ++d)
+    {
+        x[d] ^= t;
+    }
+
+    // Interleave the bits of the transposed index, most significant first.
+    uint64_t index = 0;
+    for (int b = NUM_BITS - 1; b >= 0; --b)
+    {
+        for (int d = 0; d < N; ++d)
+        {
+            index = (index << 1) | ((x[d] >> b) & 1);
+        }
+    }
+    return index;
+}
+//----------------------------------------------------------------------------
@@ -10,6 +10,8 @@
 #include "GteIEEEBinary.h"
 #include "GteBitHacks.h"
 #include "GteLogger.h"
+#include <algorithm>
+#include <vector>
 
 // The class BSNumber (binary scientific number) is designed to provide exact
 // arithmetic for robust algorithms, typically those for which we need to know
@@ -49,10 +51,22 @@
 // regularly with std::vector<uint32_t> during BSNumber operations.  A safer
 // choice is to argue mathematically that the maximum size is bounded by N.
 // This requires an analysis of how many bits of precision you need for the
-// types of computation you perform.
+// types of computation you perform.  If you cannot bound the size, use
+// BSUIntegerHybrid<N>, which stores numbers of at most N blocks inline and
+// larger numbers on the heap.  The histogram gte::gBSNumberSizeHistogram[]
+// counts the BSNumber results by size, with the last bin counting all sizes
+// of GTE_BSNUMBER_HISTOGRAM_BINS-1 or larger; a good choice for the N of
+// BSUIntegerHybrid<N> is a size that covers most of the results.  Call
+// gte::ResetBSNumberStatistics() before running an algorithm to obtain the
+// statistics for that algorithm alone.
 //
 //#define GTE_COLLECT_BSNUMBER_STATISTICS
 
+#if defined(GTE_COLLECT_BSNUMBER_STATISTICS)
+#include "GteAtomicMinMax.h"
+#include <atomic>
+#endif
+
 namespace gte
 {
 
@@ -141,6 +155,27 @@ private:
     static BSNumber Sub(BSNumber const& n0, BSNumber const& n1);
     static BSNumber Mul(BSNumber const& n0, BSNumber const& n1);
 
+    // Support for Mul on arrays of 32-bit blocks.  MulBlocks computes the
+    // numW low-order blocks of w = u*v, where numW is at least the number of
+    // blocks in the product.  Schoolbook multiplication is used when the
+    // smaller input has fewer than KARATSUBA_THRESHOLD blocks; otherwise,
+    // Karatsuba multiplication is applied to pieces of the larger input.
+    // Karatsuba computes all 2*num blocks of the product of two inputs of
+    // num blocks, using GetKaratsubaScratchSize(num) blocks of scratch
+    // memory that MulBlocks allocates once.  AddBlocks and SubBlocks compute
+    // w += a and w -= a in place, propagating the carry or borrow through
+    // the numW blocks of w.
+    static int32_t const KARATSUBA_THRESHOLD = 48;
+    static void MulBlocks(uint32_t const* u, int32_t numU,
+        uint32_t const* v, int32_t numV, uint32_t* w, int32_t numW);
+    static void Karatsuba(uint32_t const* u, uint32_t const* v, int32_t num,
+        uint32_t* w, uint32_t* scratch);
+    static int32_t GetKaratsubaScratchSize(int32_t num);
+    static void AddBlocks(uint32_t* w, int32_t numW, uint32_t const* a,
+        int32_t numA);
+    static void SubBlocks(uint32_t* w, int32_t numW, uint32_t const* a,
+        int32_t numA);
+
     // Decrements mNumBits in arithmetic operations that allocated the
     // worst-case number of bits and a carry-out did not occur.  The mBits
     // array is potentially resized to one less block.
@@ -190,8 +225,17 @@ private:
 };
 
 #if defined(GTE_COLLECT_BSNUMBER_STATISTICS)
+#define GTE_BSNUMBER_HISTOGRAM_BINS 65
 extern std::atomic<size_t> gBSNumberMaxSize;
-#define GET_BSNUMBER_MAXSIZE_UPDATE(bits) AtomicMax(gBSNumberMaxSize, bits.size())
+extern std::atomic<size_t>
+    gBSNumberSizeHistogram[GTE_BSNUMBER_HISTOGRAM_BINS];
+GTE_IMPEXP void ResetBSNumberStatistics();
+#define GET_BSNUMBER_MAXSIZE_UPDATE(bits) \
+{ \
+    AtomicMax(gBSNumberMaxSize, bits.size()); \
+    ++gBSNumberSizeHistogram[std::min(bits.size(), \
+        static_cast<size_t>(GTE_BSNUMBER_HISTOGRAM_BINS - 1))]; \
+}
 #else
 #define GET_BSNUMBER_MAXSIZE_UPDATE(bits)
 #endif
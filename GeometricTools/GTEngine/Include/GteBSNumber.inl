@@ -800,73 +800,37 @@ BSNumber<UIntegerType> BSNumber<UIntegerType>::Sub(BSNumber const& n0,
     BSNumber const& n1)
 {
     // Subtract the numbers considered as positive integers.  We know that
-    // n0 >= n1, so create a number n2 that has the same number of bits as
-    // n0 and use two's-complement to generate -n2, and then add n0 and -n2.
-    // The result is nonnegative, so we do not need to apply two's complement
-    // to a negative result to extract the sign and absolute value.
+    // n0 >= n1, so the blocks of n1 are subtracted from those of n0 with
+    // borrows and the result is nonnegative.
 
     // Get the input array sizes.  We know numElements0 >= numElements1.
     int32_t numElements0 = 1 + (n0.mNumBits - 1) / 32;
     int32_t numElements1 = 1 + (n1.mNumBits - 1) / 32;
 
-    // Create the two's-complement number n2.  We allocate one extra bit to
-    // ensure the the high-order bit is truly a two's-complement sign bit;
-    // that is, a high-order 1-bit is part of the number n1, so we need an
-    // additional bit for the sign bit.
-    BSNumber n2(1, n0.mNumBits + 1);
-    int32_t numElements2 = static_cast<int>(n2.mBits.size());
+    BSNumber result(1, n0.mNumBits);
+    uint64_t borrow = 0, diff;
     int32_t i;
     for (i = 0; i < numElements1; ++i)
     {
-        n2.mBits[i] = ~n1.mBits[i];
-    }
-    for (/**/; i < numElements2; ++i)
-    {
-        n2.mBits[i] = ~0u;
+        diff = static_cast<uint64_t>(n0.mBits[i]) - n1.mBits[i] - borrow;
+        result.mBits[i] = GTE_GET_LO_U64(diff);
+        borrow = (GTE_GET_HI_U64(diff) != 0 ? 1 : 0);
     }
 
-    // Now add 1 to the bit-negated result to obtain -n1.
-    uint64_t carry = 1, sum;
-    for (i = 0; i < numElements2; ++i)
+    // We have no more n1-blocks.  Propagate the borrow, if there is one, or
+    // copy the remaining blocks if there is not.
+    for (/**/; i < numElements0 && borrow > 0; ++i)
     {
-        sum = n2.mBits[i] + carry;
-        n2.mBits[i] = GTE_GET_LO_U64(sum);
-        carry = GTE_GET_HI_U64(sum);
+        diff = static_cast<uint64_t>(n0.mBits[i]) - borrow;
+        result.mBits[i] = GTE_GET_LO_U64(diff);
+        borrow = (GTE_GET_HI_U64(diff) != 0 ? 1 : 0);
     }
-
-    // Add the numbers considered as positive integers.  Set the last block to
-    // zero in case no carry-out occurs.
-    BSNumber result(1, n2.mNumBits + 1);
-    result.mBits.back() = 0;
-
-    // Add the n0-blocks to n2-blocks.
-    for (i = 0, carry = 0; i < numElements0; ++i)
+    for (/**/; i < numElements0; ++i)
     {
-        sum = n2.mBits[i] + (n0.mBits[i] + carry);
-        result.mBits[i] = GTE_GET_LO_U64(sum);
-        carry = GTE_GET_HI_U64(sum);
+        result.mBits[i] = n0.mBits[i];
     }
 
-    // We have no more n0-blocks. Propagate the carry-out, if there is
-    // one, or copy the remaining blocks if there is not.
-    if (carry > 0)
-    {
-        for (/**/; i < numElements2; ++i)
-        {
-            sum = n2.mBits[i] + carry;
-            result.mBits[i] = GTE_GET_LO_U64(sum);
-            carry = GTE_GET_HI_U64(sum);
-        }
-    }
-    else
-    {
-        for (/**/; i < numElements2; ++i)
-        {
-            result.mBits[i] = n2.mBits[i];
-        }
-    }
-
-    // Strip off the bits introduced by two's-complement.
+    // Strip off the leading zero bits.
     result.ReduceBlocks(numElements0 - 1);
     return result;
 }
@@ -875,60 +839,187 @@ template <typename UIntegerType>
 BSNumber<UIntegerType> BSNumber<UIntegerType>::Mul(BSNumber const& n0,
     BSNumber const& n1)
 {
-    // Multiply the numbers consider as positive integers.
-
-    // The number of bits is at most this, possibly one bit smaller.
-    // TODO: It would be nice to avoid the std::fill, but 'result' is used as
-    // an accumulator later, which assumes it is zeroed.  We would have to
-    // copy p[] to v[] when i0 = 0 but then accumulate on subsequent
-    // passes.
+    // Multiply the numbers consider as positive integers.  The number of
+    // bits is at most this, possibly one bit smaller.
     BSNumber result(1, n0.mNumBits + n1.mNumBits);
     int32_t const n = static_cast<int>(result.mBits.size());
-    std::fill(&result.mBits[0], &result.mBits[0] + n, 0);
-
-    // Product of a single-block number with a multiple-block number.
-    UIntegerType product(n);
 
     // Get the input array sizes.
     int32_t const numElements0 = 1 + (n0.mNumBits - 1) / 32;
     int32_t const numElements1 = 1 + (n1.mNumBits - 1) / 32;
 
-    // Compute the product v = u0*u1.
-    for (int32_t i0 = 0; i0 < numElements0; ++i0)
+    MulBlocks(&n0.mBits[0], numElements0, &n1.mBits[0], numElements1,
+        &result.mBits[0], n);
+
+    result.ReduceBits();
+    return result;
+}
+//----------------------------------------------------------------------------
+template <typename UIntegerType>
+void BSNumber<UIntegerType>::MulBlocks(uint32_t const* u, int32_t numU,
+    uint32_t const* v, int32_t numV, uint32_t* w, int32_t numW)
+{
+    if (numU < numV)
+    {
+        std::swap(u, v);
+        std::swap(numU, numV);
+    }
+
+    if (numV < KARATSUBA_THRESHOLD)
     {
-        // Compute the product p = u0[i0]*u1.
-        uint64_t block0 = n0.mBits[i0];
-        uint64_t carry = 0;
-        int32_t i1, i2;
-        for (i1 = 0, i2 = i0; i1 < numElements1; ++i1, ++i2)
-        {
-            uint64_t block1 = n1.mBits[i1];
-            uint64_t term = block0 * block1 + carry;
-            product[i2] = GTE_GET_LO_U64(term);
-            carry = GTE_GET_HI_U64(term);
-        }
-        if (i2 < n)
+        // Schoolbook multiplication.  The products of blocks are added
+        // directly to the accumulator w; block0*block1 + w[i2] + carry is
+        // at most 2^{64}-1, so the 64-bit sum cannot overflow.  Row i0
+        // writes blocks i0 through i0+numV, and block i0+numV has not been
+        // written by the previous rows, so it is assigned the carry.
+        std::fill(w, w + numW, 0);
+        for (int32_t i0 = 0; i0 < numU; ++i0)
         {
-            product[i2] = static_cast<uint32_t>(carry);
+            uint64_t block0 = u[i0];
+            uint64_t carry = 0;
+            int32_t i1, i2;
+            for (i1 = 0, i2 = i0; i1 < numV; ++i1, ++i2)
+            {
+                uint64_t term = block0 * v[i1] + w[i2] + carry;
+                w[i2] = GTE_GET_LO_U64(term);
+                carry = GTE_GET_HI_U64(term);
+            }
+            if (i2 < numW)
+            {
+                w[i2] = GTE_GET_LO_U64(carry);
+            }
         }
+        return;
+    }
 
-        // Add p to the accumulator v.
-        carry = 0;
-        for (i1 = 0, i2 = i0; i1 < numElements1; ++i1, ++i2)
+    // The product has numU+numV blocks, but the caller might have allocated
+    // one block less when the leading block is known to be zero.  The
+    // temporary product, the product of a piece and the Karatsuba scratch
+    // blocks share one allocation.
+    int32_t const numX = numU + numV;
+    int32_t const numFull = (numW < numX ? numX : 0);
+    std::vector<uint32_t> temp(numFull + 2 * numV +
+        GetKaratsubaScratchSize(numV));
+    uint32_t* x = (numFull > 0 ? &temp[0] : w);
+    uint32_t* piece = &temp[numFull];
+    uint32_t* scratch = piece + 2 * numV;
+    std::fill(x, x + numX, 0);
+
+    // Split u into pieces of numV blocks, multiply each piece by v using
+    // Karatsuba multiplication, and add the products to x.
+    for (int32_t i = 0; i < numU; i += numV)
+    {
+        int32_t numPiece = std::min(numV, numU - i);
+        if (numPiece == numV)
         {
-            uint64_t sum = product[i2] + (result.mBits[i2] + carry);
-            result.mBits[i2] = GTE_GET_LO_U64(sum);
-            carry = GTE_GET_HI_U64(sum);
+            Karatsuba(u + i, v, numV, piece, scratch);
         }
-        if (i2 < n)
+        else
         {
-            uint64_t sum = product[i2] + (result.mBits[i2] + carry);
-            result.mBits[i2] = GTE_GET_LO_U64(sum);
+            MulBlocks(u + i, numPiece, v, numV, piece, numPiece + numV);
         }
+        AddBlocks(x + i, numX - i, piece, numPiece + numV);
     }
 
-    result.ReduceBits();
-    return result;
+    if (x != w)
+    {
+        std::copy(x, x + numW, w);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename UIntegerType>
+void BSNumber<UIntegerType>::Karatsuba(uint32_t const* u, uint32_t const* v,
+    int32_t num, uint32_t* w, uint32_t* scratch)
+{
+    if (num < KARATSUBA_THRESHOLD)
+    {
+        MulBlocks(u, num, v, num, w, 2 * num);
+        return;
+    }
+
+    // Write u = u1*b^m + u0 and v = v1*b^m + v0, where b = 2^{32}, u0 and v0
+    // have m blocks, and u1 and v1 have h >= m blocks.  The product is
+    // u*v = z2*b^{2m} + z1*b^m + z0, where z0 = u0*v0, z2 = u1*v1 and
+    // z1 = (u0+u1)*(v0+v1) - z0 - z2.  The sums u0+u1 and v0+v1 are stored
+    // in w, which has 2*num >= 2*h+2 blocks, and the product of the sums is
+    // stored in the first 2*h+2 blocks of the scratch memory.  The products
+    // z0 and z2 then overwrite the sums.
+    int32_t const m = num / 2, h = num - m;
+    uint32_t* sumU = w;
+    uint32_t* sumV = w + h + 1;
+    uint32_t* z1 = scratch;
+    uint32_t* next = scratch + 2 * h + 2;
+    std::copy(u + m, u + num, sumU);
+    std::copy(v + m, v + num, sumV);
+    sumU[h] = 0;
+    sumV[h] = 0;
+    AddBlocks(sumU, h + 1, u, m);
+    AddBlocks(sumV, h + 1, v, m);
+    Karatsuba(sumU, sumV, h + 1, z1, next);
+
+    Karatsuba(u, v, m, w, next);
+    Karatsuba(u + m, v + m, h, w + 2 * m, next);
+    SubBlocks(z1, 2 * h + 2, w, 2 * m);
+    SubBlocks(z1, 2 * h + 2, w + 2 * m, 2 * h);
+
+    // The leading blocks of z1 are zero beyond those that fit.
+    AddBlocks(w + m, num + h, z1, std::min(2 * h + 2, num + h));
+}
+//----------------------------------------------------------------------------
+template <typename UIntegerType>
+int32_t BSNumber<UIntegerType>::GetKaratsubaScratchSize(int32_t num)
+{
+    // Each level uses 2*h+2 blocks for z1 and passes the rest to the
+    // multiplication of the sums, which has the most blocks, h+1.  The
+    // total is about 2*num blocks.
+    int32_t size = 0;
+    while (num >= KARATSUBA_THRESHOLD)
+    {
+        int32_t const h = num - num / 2;
+        size += 2 * h + 2;
+        num = h + 1;
+    }
+    return size;
+}
+//----------------------------------------------------------------------------
+template <typename UIntegerType>
+void BSNumber<UIntegerType>::AddBlocks(uint32_t* w, int32_t numW,
+    uint32_t const* a, int32_t numA)
+{
+    uint64_t carry = 0, sum;
+    int32_t i;
+    for (i = 0; i < numA; ++i)
+    {
+        sum = static_cast<uint64_t>(w[i]) + a[i] + carry;
+        w[i] = GTE_GET_LO_U64(sum);
+        carry = GTE_GET_HI_U64(sum);
+    }
+    for (/**/; i < numW && carry > 0; ++i)
+    {
+        sum = w[i] + carry;
+        w[i] = GTE_GET_LO_U64(sum);
+        carry = GTE_GET_HI_U64(sum);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename UIntegerType>
+void BSNumber<UIntegerType>::SubBlocks(uint32_t* w, int32_t numW,
+    uint32_t const* a, int32_t numA)
+{
+    uint64_t borrow = 0, diff;
+    int32_t i;
+    for (i = 0; i < numA; ++i)
+    {
+        diff = static_cast<uint64_t>(w[i]) - a[i] - borrow;
+        w[i] = GTE_GET_LO_U64(diff);
+        borrow = (GTE_GET_HI_U64(diff) != 0 ? 1 : 0);
+    }
+    for (/**/; i < numW && borrow > 0; ++i)
+    {
+        diff = static_cast<uint64_t>(w[i]) - borrow;
+        w[i] = GTE_GET_LO_U64(diff);
+        borrow = (GTE_GET_HI_U64(diff) != 0 ? 1 : 0);
+    }
 }
 //----------------------------------------------------------------------------
 template <typename UIntegerType>
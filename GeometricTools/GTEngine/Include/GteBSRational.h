@@ -10,6 +10,21 @@
 #include "GteBSNumber.h"
 
 // See the comments in GteBSNumber.h about the UIntegerType requirements.
+//
+// The numerator and denominator are not reduced by their greatest common
+// divisor; the powers of two are factored out by BSNumber, and computing the
+// odd part of the GCD costs more than it saves in the typical expressions of
+// the geometric queries.  Instead, the arithmetic operations avoid creating
+// common factors when the operands allow it.  The denominator of a number
+// constructed from a numerator alone is one, and a sum or difference of
+// numbers with equal denominators is computed over the common denominator.
+// Comparisons of numbers with equal denominators compare the numerators.
+// A sum of products such as X[0]*P[0] + X[1]*P[1] + X[2]*P[2], where the
+// X[i] are the solution to a linear system (their denominators are all the
+// determinant) and the P[i] are converted from floating-point inputs, is
+// then evaluated as a single numerator over the determinant.  Without these
+// cases, each addition squares the denominator, and the operand sizes grow
+// exponentially in the number of terms.
 
 namespace gte
 {
@@ -75,6 +90,10 @@ public:
     BSRational& operator/=(BSRational const& rational);
 
 private:
+    // Test whether the number is exactly one.  The denominators produced
+    // by the constructors are one when no denominator is specified.
+    inline static bool IsOne(BSNumber<UIntegerType> const& number);
+
     BSNumber<UIntegerType> mNumerator, mDenominator;
 
     friend class UnitTestBSRational;
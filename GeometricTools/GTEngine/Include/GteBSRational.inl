@@ -202,6 +202,11 @@ BSNumber<UIntegerType> const& BSRational<UIntegerType>::GetDenomator() const
 template <typename UIntegerType>
 bool BSRational<UIntegerType>::operator==(BSRational const& rational) const
 {
+    if (mDenominator == rational.mDenominator)
+    {
+        return mNumerator == rational.mNumerator;
+    }
+
     BSNumber<UIntegerType> product0 = mNumerator * rational.mDenominator;
     BSNumber<UIntegerType> product1 = mDenominator * rational.mNumerator;
     return product0 == product1;
@@ -216,6 +221,11 @@ bool BSRational<UIntegerType>::operator!=(BSRational const& rational) const
 template <typename UIntegerType>
 bool BSRational<UIntegerType>::operator< (BSRational const& rational) const
 {
+    if (mDenominator == rational.mDenominator && mDenominator.mSign > 0)
+    {
+        return mNumerator < rational.mNumerator;
+    }
+
     BSNumber<UIntegerType> product0 = mNumerator * rational.mDenominator;
     BSNumber<UIntegerType> product1 = mDenominator * rational.mNumerator;
     if (mDenominator.mSign > 0)
@@ -276,6 +286,24 @@ template <typename UIntegerType>
 BSRational<UIntegerType> BSRational<UIntegerType>::operator+(
     BSRational const& rational) const
 {
+    if (mDenominator == rational.mDenominator)
+    {
+        // n0/d + n1/d = (n0 + n1)/d
+        return BSRational(mNumerator + rational.mNumerator, mDenominator);
+    }
+    if (IsOne(mDenominator))
+    {
+        // n0 + n1/d1 = (n0*d1 + n1)/d1
+        return BSRational(mNumerator * rational.mDenominator +
+            rational.mNumerator, rational.mDenominator);
+    }
+    if (IsOne(rational.mDenominator))
+    {
+        // n0/d0 + n1 = (n0 + d0*n1)/d0
+        return BSRational(mNumerator + mDenominator * rational.mNumerator,
+            mDenominator);
+    }
+
     BSNumber<UIntegerType> product0 = mNumerator * rational.mDenominator;
     BSNumber<UIntegerType> product1 = mDenominator * rational.mNumerator;
     BSNumber<UIntegerType> numerator = product0 + product1;
@@ -287,6 +315,24 @@ template <typename UIntegerType>
 BSRational<UIntegerType> BSRational<UIntegerType>::operator-(
     BSRational const& rational) const
 {
+    if (mDenominator == rational.mDenominator)
+    {
+        // n0/d - n1/d = (n0 - n1)/d
+        return BSRational(mNumerator - rational.mNumerator, mDenominator);
+    }
+    if (IsOne(mDenominator))
+    {
+        // n0 - n1/d1 = (n0*d1 - n1)/d1
+        return BSRational(mNumerator * rational.mDenominator -
+            rational.mNumerator, rational.mDenominator);
+    }
+    if (IsOne(rational.mDenominator))
+    {
+        // n0/d0 - n1 = (n0 - d0*n1)/d0
+        return BSRational(mNumerator - mDenominator * rational.mNumerator,
+            mDenominator);
+    }
+
     BSNumber<UIntegerType> product0 = mNumerator * rational.mDenominator;
     BSNumber<UIntegerType> product1 = mDenominator * rational.mNumerator;
     BSNumber<UIntegerType> numerator = product0 - product1;
@@ -299,6 +345,14 @@ BSRational<UIntegerType> BSRational<UIntegerType>::operator*(
     BSRational const& rational) const
 {
     BSNumber<UIntegerType> numerator = mNumerator * rational.mNumerator;
+    if (IsOne(mDenominator))
+    {
+        return BSRational(numerator, rational.mDenominator);
+    }
+    if (IsOne(rational.mDenominator))
+    {
+        return BSRational(numerator, mDenominator);
+    }
     BSNumber<UIntegerType> denominator = mDenominator * rational.mDenominator;
     return BSRational(numerator, denominator);
 }
@@ -352,3 +406,11 @@ BSRational<UIntegerType>& BSRational<UIntegerType>::operator/=(
     return *this;
 }
 //----------------------------------------------------------------------------
+template <typename UIntegerType> inline
+bool BSRational<UIntegerType>::IsOne(BSNumber<UIntegerType> const& number)
+{
+    // The number is 1*2^0, where the odd integer 1 has a single bit.
+    return number.mSign > 0 && number.mNumBits == 1
+        && number.mBiasedExponent == 0;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,72 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GteLogger.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// A UIntegerType for BSNumber that stores up to N 32-bit blocks inline, just
+// as BSUInteger<N> does, but switches to heap storage when a number requires
+// more than N blocks.  When N is chosen so that most of the numbers in an
+// algorithm fit, the performance is close to that of BSUInteger<N>, but the
+// results are still correct when the bound is exceeded, which is not the
+// case for BSUInteger<N>.  The numbers that spill to the heap have the
+// performance of std::vector<uint32_t>.
+//
+// The sizes reached in an algorithm may be measured by enabling
+// GTE_COLLECT_BSNUMBER_STATISTICS in GteBSNumber.h, which collects the
+// maximum size and a histogram of the sizes of the BSNumber results.  The
+// sizes grow with the spread of the exponents of the inputs, so N should be
+// chosen from measurements on representative data.
+
+namespace gte
+{
+
+template <size_t N>
+class BSUIntegerHybrid
+{
+public:
+    // Construction and destruction.  The storage is inline when 'size' is
+    // no larger than N; otherwise, it is allocated on the heap.
+    ~BSUIntegerHybrid();
+    BSUIntegerHybrid(size_t size = 0);
+    BSUIntegerHybrid(BSUIntegerHybrid const& number);
+    BSUIntegerHybrid(BSUIntegerHybrid&& number);
+
+    // Assignment.
+    BSUIntegerHybrid& operator=(BSUIntegerHybrid const& number);
+    BSUIntegerHybrid& operator=(BSUIntegerHybrid&& number);
+
+    // Member access.
+    inline size_t size() const;
+    inline uint32_t& operator[](int32_t i);
+    inline uint32_t const& operator[](int32_t i) const;
+    inline uint32_t& back();
+    inline uint32_t const& back() const;
+
+    // Support for statistics.  The function returns 'true' when the number
+    // is stored on the heap.
+    inline bool IsSpilled() const;
+
+private:
+    // Set mSize and mData for a number of the specified size.  The heap
+    // storage, when used, is not initialized.
+    void Allocate(size_t size);
+
+    size_t mSize;
+    uint32_t* mData;
+    std::array<uint32_t, N> mInline;
+    std::vector<uint32_t> mHeap;
+};
+
+#include "GteBSUIntegerHybrid.inl"
+
+}
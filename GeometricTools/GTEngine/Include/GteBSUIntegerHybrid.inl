@@ -0,0 +1,122 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <size_t N>
+BSUIntegerHybrid<N>::~BSUIntegerHybrid()
+{
+}
+//----------------------------------------------------------------------------
+template <size_t N>
+BSUIntegerHybrid<N>::BSUIntegerHybrid(size_t size)
+{
+    Allocate(size);
+}
+//----------------------------------------------------------------------------
+template <size_t N>
+BSUIntegerHybrid<N>::BSUIntegerHybrid(BSUIntegerHybrid const& number)
+{
+    Allocate(number.mSize);
+    std::copy(number.mData, number.mData + mSize, mData);
+}
+//----------------------------------------------------------------------------
+template <size_t N>
+BSUIntegerHybrid<N>::BSUIntegerHybrid(BSUIntegerHybrid&& number)
+{
+    *this = std::move(number);
+}
+//----------------------------------------------------------------------------
+template <size_t N>
+BSUIntegerHybrid<N>& BSUIntegerHybrid<N>::operator=(
+    BSUIntegerHybrid const& number)
+{
+    if (this != &number)
+    {
+        Allocate(number.mSize);
+        std::copy(number.mData, number.mData + mSize, mData);
+    }
+    return *this;
+}
+//----------------------------------------------------------------------------
+template <size_t N>
+BSUIntegerHybrid<N>& BSUIntegerHybrid<N>::operator=(BSUIntegerHybrid&& number)
+{
+    if (this != &number)
+    {
+        if (number.mSize > N)
+        {
+            // Take ownership of the heap storage.  The moved-from number is
+            // left as zero.
+            mSize = number.mSize;
+            mHeap = std::move(number.mHeap);
+            mData = mHeap.data();
+            number.mSize = 0;
+            number.mData = number.mInline.data();
+        }
+        else
+        {
+            // There is no 'move' to apply to inline storage, so this is a
+            // copy.
+            Allocate(number.mSize);
+            std::copy(number.mData, number.mData + mSize, mData);
+        }
+    }
+    return *this;
+}
+//----------------------------------------------------------------------------
+template <size_t N> inline
+size_t BSUIntegerHybrid<N>::size() const
+{
+    return mSize;
+}
+//----------------------------------------------------------------------------
+template <size_t N> inline
+uint32_t& BSUIntegerHybrid<N>::operator[](int32_t i)
+{
+    return mData[i];
+}
+//----------------------------------------------------------------------------
+template <size_t N> inline
+uint32_t const& BSUIntegerHybrid<N>::operator[](int32_t i) const
+{
+    return mData[i];
+}
+//----------------------------------------------------------------------------
+template <size_t N> inline
+uint32_t& BSUIntegerHybrid<N>::back()
+{
+    return mData[mSize - 1];
+}
+//----------------------------------------------------------------------------
+template <size_t N> inline
+uint32_t const& BSUIntegerHybrid<N>::back() const
+{
+    return mData[mSize - 1];
+}
+//----------------------------------------------------------------------------
+template <size_t N> inline
+bool BSUIntegerHybrid<N>::IsSpilled() const
+{
+    return mSize > N;
+}
+//----------------------------------------------------------------------------
+template <size_t N>
+void BSUIntegerHybrid<N>::Allocate(size_t size)
+{
+    mSize = size;
+    if (size <= N)
+    {
+        mData = mInline.data();
+    }
+    else
+    {
+        // The heap capacity of previous values is reused when possible.
+        mHeap.resize(size);
+        mData = mHeap.data();
+    }
+}
+//----------------------------------------------------------------------------
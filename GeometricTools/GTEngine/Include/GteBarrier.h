@@ -0,0 +1,38 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include <condition_variable>
+#include <mutex>
+
+// A reusable barrier for a fixed number of threads.  Each call to Wait()
+// blocks until all numThreads threads have called it, so the threads of a
+// ParallelFor::Execute call can run several phases of a computation without
+// being started for each phase.
+
+namespace gte
+{
+
+class GTE_IMPEXP Barrier
+{
+public:
+    // Construction.  The numThreads must be positive.
+    Barrier(unsigned int numThreads);
+
+    // Block until all threads have called Wait().  The writes of every
+    // thread before the call are visible to all threads after the call.
+    void Wait();
+
+private:
+    unsigned int mNumThreads, mNumWaiting, mGeneration;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+};
+
+}
@@ -0,0 +1,117 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include <emmintrin.h>
+#include <algorithm>
+#include <cmath>
+
+// The arithmetic on the lanes of BatchSymmetricEigensolver and
+// BatchSingularValueDecomposition.  A register holds NUM_LANES consecutive
+// lanes:  four for float (SSE) and two for double (SSE2), and one for any
+// other Real, in which case the operations are the scalar ones.  Each
+// operation rounds exactly as the corresponding scalar expression, so the
+// results do not depend on the number of lanes per register.  A mask has
+// all bits set in the lanes for which a comparison is true; Select(m,v0,v1)
+// returns v0 in those lanes and v1 in the others.  Load and Store do not
+// require aligned memory.
+
+namespace gte
+{
+
+template <typename Real>
+class BatchLanes
+{
+public:
+    enum { NUM_LANES = 1 };
+    typedef Real Register;
+    typedef bool Mask;
+
+    inline static Register Load(Real const* source);
+    inline static void Store(Real* target, Register const v);
+    inline static Register Set(Real value);
+
+    inline static Register Add(Register const v0, Register const v1);
+    inline static Register Subtract(Register const v0, Register const v1);
+    inline static Register Multiply(Register const v0, Register const v1);
+    inline static Register Divide(Register const v0, Register const v1);
+    inline static Register Sqrt(Register const v);
+    inline static Register Abs(Register const v);
+    inline static Register Max(Register const v0, Register const v1);
+
+    inline static Mask Less(Register const v0, Register const v1);
+    inline static Mask Greater(Register const v0, Register const v1);
+    inline static Mask GreaterEqual(Register const v0, Register const v1);
+    inline static Mask NotEqual(Register const v0, Register const v1);
+    inline static Register Select(Mask const m, Register const v0,
+        Register const v1);
+    inline static bool Any(Mask const m);
+};
+
+template <>
+class BatchLanes<float>
+{
+public:
+    enum { NUM_LANES = 4 };
+    typedef __m128 Register;
+    typedef __m128 Mask;
+
+    inline static Register Load(float const* source);
+    inline static void Store(float* target, Register const v);
+    inline static Register Set(float value);
+
+    inline static Register Add(Register const v0, Register const v1);
+    inline static Register Subtract(Register const v0, Register const v1);
+    inline static Register Multiply(Register const v0, Register const v1);
+    inline static Register Divide(Register const v0, Register const v1);
+    inline static Register Sqrt(Register const v);
+    inline static Register Abs(Register const v);
+    inline static Register Max(Register const v0, Register const v1);
+
+    inline static Mask Less(Register const v0, Register const v1);
+    inline static Mask Greater(Register const v0, Register const v1);
+    inline static Mask GreaterEqual(Register const v0, Register const v1);
+    inline static Mask NotEqual(Register const v0, Register const v1);
+    inline static Register Select(Mask const m, Register const v0,
+        Register const v1);
+    inline static bool Any(Mask const m);
+};
+
+template <>
+class BatchLanes<double>
+{
+public:
+    enum { NUM_LANES = 2 };
+    typedef __m128d Register;
+    typedef __m128d Mask;
+
+    inline static Register Load(double const* source);
+    inline static void Store(double* target, Register const v);
+    inline static Register Set(double value);
+
+    inline static Register Add(Register const v0, Register const v1);
+    inline static Register Subtract(Register const v0, Register const v1);
+    inline static Register Multiply(Register const v0, Register const v1);
+    inline static Register Divide(Register const v0, Register const v1);
+    inline static Register Sqrt(Register const v);
+    inline static Register Abs(Register const v);
+    inline static Register Max(Register const v0, Register const v1);
+
+    inline static Mask Less(Register const v0, Register const v1);
+    inline static Mask Greater(Register const v0, Register const v1);
+    inline static Mask GreaterEqual(Register const v0, Register const v1);
+    inline static Mask NotEqual(Register const v0, Register const v1);
+    inline static Register Select(Mask const m, Register const v0,
+        Register const v1);
+    inline static bool Any(Mask const m);
+};
+
+#include "GteBatchLanes.inl"
+
+}
@@ -0,0 +1,291 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register BatchLanes<Real>::Load(Real const* source)
+{
+    return *source;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+void BatchLanes<Real>::Store(Real* target, Register const v)
+{
+    *target = v;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register BatchLanes<Real>::Set(Real value)
+{
+    return value;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register
+BatchLanes<Real>::Add(Register const v0, Register const v1)
+{
+    return v0 + v1;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register
+BatchLanes<Real>::Subtract(Register const v0, Register const v1)
+{
+    return v0 - v1;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register
+BatchLanes<Real>::Multiply(Register const v0, Register const v1)
+{
+    return v0 * v1;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register
+BatchLanes<Real>::Divide(Register const v0, Register const v1)
+{
+    return v0 / v1;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register BatchLanes<Real>::Sqrt(Register const v)
+{
+    return std::sqrt(v);
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register BatchLanes<Real>::Abs(Register const v)
+{
+    return std::abs(v);
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register
+BatchLanes<Real>::Max(Register const v0, Register const v1)
+{
+    return std::max(v0, v1);
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Mask
+BatchLanes<Real>::Less(Register const v0, Register const v1)
+{
+    return v0 < v1;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Mask
+BatchLanes<Real>::Greater(Register const v0, Register const v1)
+{
+    return v0 > v1;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Mask
+BatchLanes<Real>::GreaterEqual(Register const v0, Register const v1)
+{
+    return v0 >= v1;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Mask
+BatchLanes<Real>::NotEqual(Register const v0, Register const v1)
+{
+    return v0 != v1;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+typename BatchLanes<Real>::Register
+BatchLanes<Real>::Select(Mask const m, Register const v0,
+    Register const v1)
+{
+    return (m ? v0 : v1);
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+bool BatchLanes<Real>::Any(Mask const m)
+{
+    return m;
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Load(float const* source)
+{
+    return _mm_loadu_ps(source);
+}
+//----------------------------------------------------------------------------
+inline void BatchLanes<float>::Store(float* target, Register const v)
+{
+    _mm_storeu_ps(target, v);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Set(float value)
+{
+    return _mm_set1_ps(value);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Add(Register const v0, Register const v1)
+{
+    return _mm_add_ps(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Subtract(Register const v0,
+    Register const v1)
+{
+    return _mm_sub_ps(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Multiply(Register const v0,
+    Register const v1)
+{
+    return _mm_mul_ps(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Divide(Register const v0, Register const v1)
+{
+    return _mm_div_ps(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Sqrt(Register const v)
+{
+    return _mm_sqrt_ps(v);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Abs(Register const v)
+{
+    // Clear the sign bits.
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Max(Register const v0, Register const v1)
+{
+    // std::max(v0,v1) is v1 when v0 < v1, and so is _mm_max(v1,v0).
+    return _mm_max_ps(v1, v0);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Less(Register const v0, Register const v1)
+{
+    return _mm_cmplt_ps(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Greater(Register const v0, Register const v1)
+{
+    return _mm_cmpgt_ps(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::GreaterEqual(Register const v0,
+    Register const v1)
+{
+    return _mm_cmpge_ps(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::NotEqual(Register const v0,
+    Register const v1)
+{
+    return _mm_cmpneq_ps(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128 BatchLanes<float>::Select(Mask const m, Register const v0,
+    Register const v1)
+{
+    return _mm_or_ps(_mm_and_ps(m, v0), _mm_andnot_ps(m, v1));
+}
+//----------------------------------------------------------------------------
+inline bool BatchLanes<float>::Any(Mask const m)
+{
+    return _mm_movemask_ps(m) != 0;
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Load(double const* source)
+{
+    return _mm_loadu_pd(source);
+}
+//----------------------------------------------------------------------------
+inline void BatchLanes<double>::Store(double* target, Register const v)
+{
+    _mm_storeu_pd(target, v);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Set(double value)
+{
+    return _mm_set1_pd(value);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Add(Register const v0, Register const v1)
+{
+    return _mm_add_pd(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Subtract(Register const v0,
+    Register const v1)
+{
+    return _mm_sub_pd(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Multiply(Register const v0,
+    Register const v1)
+{
+    return _mm_mul_pd(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Divide(Register const v0,
+    Register const v1)
+{
+    return _mm_div_pd(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Sqrt(Register const v)
+{
+    return _mm_sqrt_pd(v);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Abs(Register const v)
+{
+    // Clear the sign bits.
+    return _mm_andnot_pd(_mm_set1_pd(-0.0), v);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Max(Register const v0, Register const v1)
+{
+    // std::max(v0,v1) is v1 when v0 < v1, and so is _mm_max(v1,v0).
+    return _mm_max_pd(v1, v0);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Less(Register const v0, Register const v1)
+{
+    return _mm_cmplt_pd(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Greater(Register const v0,
+    Register const v1)
+{
+    return _mm_cmpgt_pd(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::GreaterEqual(Register const v0,
+    Register const v1)
+{
+    return _mm_cmpge_pd(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::NotEqual(Register const v0,
+    Register const v1)
+{
+    return _mm_cmpneq_pd(v0, v1);
+}
+//----------------------------------------------------------------------------
+inline __m128d BatchLanes<double>::Select(Mask const m, Register const v0,
+    Register const v1)
+{
+    return _mm_or_pd(_mm_and_pd(m, v0), _mm_andnot_pd(m, v1));
+}
+//----------------------------------------------------------------------------
+inline bool BatchLanes<double>::Any(Mask const m)
+{
+    return _mm_movemask_pd(m) != 0;
+}
+//----------------------------------------------------------------------------
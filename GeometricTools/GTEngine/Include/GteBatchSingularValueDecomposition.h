@@ -0,0 +1,92 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include "GteBatchLanes.h"
+#include "GteParallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// The BatchSingularValueDecomposition class computes the singular value
+// decompositions A = U*S*V^T of many small NxN matrices (N = 2, 3, or 4),
+// such as the deformation gradients of polar decompositions, using the
+// one-sided Jacobi method of M. R. Hestenes, "Inversion of Matrices by
+// Biorthogonalization and Related Results", J. SIAM 6(1), 1958.  Rotations
+// J applied to the columns of W = A*V make the columns orthogonal, which is
+// the cyclic Jacobi method applied implicitly to W^T*W.  When the columns
+// are orthogonal, the singular values are their lengths and the columns of
+// U are the normalized columns.  The small singular values are computed to
+// high relative accuracy, which is not the case when computing them from
+// the eigenvalues of A^T*A.
+//
+// The matrices are processed in batches of BATCH_SIZE as described for
+// BatchSymmetricEigensolver.  The sweeps stop when for every pair of
+// columns p and q of every matrix of the batch,
+// |Dot(w[p],w[q])| <= epsilon*|w[p]|*|w[q]|, where epsilon is the unit
+// roundoff of Real.  The batches are partitioned among the threads.  The
+// lanes are processed BatchLanes<Real>::NUM_LANES at a time, which is four
+// for float and two for double using SSE2.
+//
+// The batch solver uses at most 6 sweeps.  Columns of W whose lengths are
+// at most N*epsilon times the largest length are treated as zero; their
+// singular values are set to zero and the corresponding columns of U are
+// completed to an orthonormal basis.
+
+namespace gte
+{
+
+template <typename Real, int N>
+class BatchSingularValueDecomposition
+{
+public:
+    // The number of matrices processed together.
+    enum { BATCH_SIZE = 16 };
+
+    // The maximum number of sweeps must be specified; 8 is more than enough
+    // for double precision.
+    BatchSingularValueDecomposition(unsigned int maxSweeps);
+
+    // The input 'matrices' stores numMatrices NxN matrices, each in row-major
+    // order.  The order of the singular values of each matrix is specified
+    // by sortType: -1 (decreasing), 0 (no sorting), or +1 (increasing).  The
+    // output 'singularValues' must have N*numMatrices elements, which are
+    // nonnegative.  The outputs 'uMatrices' and 'vMatrices' must have
+    // N*N*numMatrices elements; matrices i are the orthogonal U_i and V_i in
+    // row-major order for which U_i^T*A_i*V_i = S_i.  When A_i has zero
+    // singular values, the corresponding columns of U_i are completed to an
+    // orthonormal basis.  Pass nullptr for 'uMatrices' or 'vMatrices' when
+    // you do not need them.
+    void Solve(int numMatrices, Real const* matrices, int sortType,
+        Real* singularValues, Real* uMatrices, Real* vMatrices,
+        unsigned int numThreads = 1) const;
+
+private:
+    // Solve the matrices of one batch, where numLanes <= BATCH_SIZE.
+    void SolveBatch(int numLanes, Real const* matrices, int sortType,
+        Real* singularValues, Real* uMatrices, Real* vMatrices) const;
+
+    // Replace the columns of U (row-major) whose flags are set by unit
+    // vectors that complete the other columns to an orthonormal basis.
+    static void CompleteBasis(bool const zeroColumn[N], Real* U);
+
+    // Apply the rotation (cs,sn) to the lanes of elements p and q of a row
+    // of W or V, or swap those lanes for which the mask is set.
+    static void Rotate(typename BatchLanes<Real>::Register const cs,
+        typename BatchLanes<Real>::Register const sn, Real* xp, Real* xq);
+    static void Swap(typename BatchLanes<Real>::Mask const swap, Real* xp,
+        Real* xq);
+
+    unsigned int mMaxSweeps;
+};
+
+#include "GteBatchSingularValueDecomposition.inl"
+
+}
@@ -0,0 +1,322 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+BatchSingularValueDecomposition<Real, N>::BatchSingularValueDecomposition(
+    unsigned int maxSweeps)
+    :
+    mMaxSweeps(maxSweeps)
+{
+    static_assert(2 <= N && N <= 4, "The size must be 2, 3, or 4.");
+}
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+void BatchSingularValueDecomposition<Real, N>::Solve(int numMatrices,
+    Real const* matrices, int sortType, Real* singularValues,
+    Real* uMatrices, Real* vMatrices, unsigned int numThreads) const
+{
+    int const numBatches = (numMatrices + BATCH_SIZE - 1) / BATCH_SIZE;
+    auto task = [this, numMatrices, matrices, sortType, singularValues,
+        uMatrices, vMatrices](int bmin, int bmax)
+    {
+        for (int b = bmin; b < bmax; ++b)
+        {
+            int const i0 = b * BATCH_SIZE;
+            int const numLanes = std::min(numMatrices - i0,
+                (int)BATCH_SIZE);
+            size_t const offset = (size_t)N*N*i0;
+            SolveBatch(numLanes, matrices + offset, sortType,
+                singularValues + (size_t)N*i0,
+                (uMatrices ? uMatrices + offset : nullptr),
+                (vMatrices ? vMatrices + offset : nullptr));
+        }
+    };
+
+    ParallelFor::Execute(numBatches, numThreads, task);
+}
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+void BatchSingularValueDecomposition<Real, N>::SolveBatch(int numLanes,
+    Real const* matrices, int sortType, Real* singularValues,
+    Real* uMatrices, Real* vMatrices) const
+{
+    typedef BatchLanes<Real> Lanes;
+    typedef typename Lanes::Register Register;
+    typedef typename Lanes::Mask Mask;
+    int const L = BATCH_SIZE, M = Lanes::NUM_LANES;
+    Real const zero = (Real)0, one = (Real)1;
+    Real const epsilon = std::numeric_limits<Real>::epsilon();
+    Register const vZero = Lanes::Set(zero), vOne = Lanes::Set(one);
+    Register const vMinusOne = Lanes::Set(-one), vTwo = Lanes::Set((Real)2);
+    Register const vEpsilon = Lanes::Set(epsilon);
+
+    // Element (r,c) of W = A*V for lane l is W[r][c][l].  The unused lanes
+    // are the identity, which requires no rotations.
+    Real W[N][N][L], V[N][N][L];
+    for (int r = 0; r < N; ++r)
+    {
+        for (int c = 0; c < N; ++c)
+        {
+            for (int l = 0; l < L; ++l)
+            {
+                W[r][c][l] = (l < numLanes ? matrices[N*N*l + N*r + c] :
+                    (r == c ? one : zero));
+                V[r][c][l] = (r == c ? one : zero);
+            }
+        }
+    }
+
+    for (unsigned int sweep = 0; sweep < mMaxSweeps; ++sweep)
+    {
+        bool notConverged = false;
+        for (int p = 0; p < N - 1; ++p)
+        {
+            for (int q = p + 1; q < N; ++q)
+            {
+                // The rotation that zeros the off-diagonal element gamma of
+                // the 2x2 submatrix of W^T*W for columns p and q, as in
+                // BatchSymmetricEigensolver.  The rotation is the identity
+                // when the columns are already orthogonal to working
+                // precision.  The square roots are taken separately to
+                // avoid underflow for columns of tiny length.
+                for (int l = 0; l < L; l += M)
+                {
+                    Register alpha = vZero, beta = vZero, gamma = vZero;
+                    for (int k = 0; k < N; ++k)
+                    {
+                        Register wkp = Lanes::Load(&W[k][p][l]);
+                        Register wkq = Lanes::Load(&W[k][q][l]);
+                        alpha = Lanes::Add(alpha, Lanes::Multiply(wkp, wkp));
+                        beta = Lanes::Add(beta, Lanes::Multiply(wkq, wkq));
+                        gamma = Lanes::Add(gamma, Lanes::Multiply(wkp, wkq));
+                    }
+
+                    Mask rotate = Lanes::Greater(Lanes::Abs(gamma),
+                        Lanes::Multiply(Lanes::Multiply(vEpsilon,
+                        Lanes::Sqrt(alpha)), Lanes::Sqrt(beta)));
+                    if (!Lanes::Any(rotate))
+                    {
+                        continue;
+                    }
+                    notConverged = true;
+
+                    Register zeta = Lanes::Divide(
+                        Lanes::Subtract(beta, alpha), Lanes::Multiply(vTwo,
+                        Lanes::Select(rotate, gamma, vOne)));
+                    Register t = Lanes::Divide(
+                        Lanes::Select(Lanes::GreaterEqual(zeta, vZero), vOne,
+                        vMinusOne), Lanes::Add(Lanes::Abs(zeta), Lanes::Sqrt(
+                        Lanes::Add(vOne, Lanes::Multiply(zeta, zeta)))));
+                    Register c = Lanes::Divide(vOne, Lanes::Sqrt(
+                        Lanes::Add(vOne, Lanes::Multiply(t, t))));
+                    Register cs = Lanes::Select(rotate, c, vOne);
+                    Register sn = Lanes::Select(rotate, Lanes::Multiply(t, c),
+                        vZero);
+
+                    for (int k = 0; k < N; ++k)
+                    {
+                        Rotate(cs, sn, &W[k][p][l], &W[k][q][l]);
+                        Rotate(cs, sn, &V[k][p][l], &V[k][q][l]);
+                    }
+                }
+            }
+        }
+        if (!notConverged)
+        {
+            break;
+        }
+    }
+
+    // The singular values are the lengths of the columns of W.  The lengths
+    // of the columns of W for a matrix of rank r < N are on the order of
+    // epsilon*|A| for N-r of its columns, and these columns do not determine
+    // the columns of U.  Such lengths are set to zero.
+    Real S[N][L];
+    Register const vNEpsilon = Lanes::Set((Real)N * epsilon);
+    for (int l = 0; l < L; l += M)
+    {
+        Register length[N], threshold = vZero;
+        for (int c = 0; c < N; ++c)
+        {
+            Register sqrLength = vZero;
+            for (int k = 0; k < N; ++k)
+            {
+                Register wkc = Lanes::Load(&W[k][c][l]);
+                sqrLength = Lanes::Add(sqrLength, Lanes::Multiply(wkc, wkc));
+            }
+            length[c] = Lanes::Sqrt(sqrLength);
+            threshold = Lanes::Max(threshold, length[c]);
+        }
+        threshold = Lanes::Multiply(vNEpsilon, threshold);
+        for (int c = 0; c < N; ++c)
+        {
+            Lanes::Store(&S[c][l], Lanes::Select(
+                Lanes::Greater(length[c], threshold), length[c], vZero));
+        }
+    }
+
+    // Sort the singular values and the columns of W and V using an odd-even
+    // transposition sort, whose compare-exchanges are branchless selects.
+    if (sortType != 0)
+    {
+        for (int pass = 0; pass < N; ++pass)
+        {
+            for (int p = (pass & 1); p + 1 < N; p += 2)
+            {
+                int const q = p + 1;
+                for (int l = 0; l < L; l += M)
+                {
+                    Register sp = Lanes::Load(&S[p][l]);
+                    Register sq = Lanes::Load(&S[q][l]);
+                    Mask swap = (sortType > 0 ? Lanes::Less(sq, sp) :
+                        Lanes::Less(sp, sq));
+                    Lanes::Store(&S[p][l], Lanes::Select(swap, sq, sp));
+                    Lanes::Store(&S[q][l], Lanes::Select(swap, sp, sq));
+                    for (int k = 0; k < N; ++k)
+                    {
+                        Swap(swap, &W[k][p][l], &W[k][q][l]);
+                        Swap(swap, &V[k][p][l], &V[k][q][l]);
+                    }
+                }
+            }
+        }
+    }
+
+    for (int l = 0; l < numLanes; ++l)
+    {
+        for (int c = 0; c < N; ++c)
+        {
+            singularValues[N*l + c] = S[c][l];
+        }
+    }
+
+    if (uMatrices)
+    {
+        for (int l = 0; l < numLanes; ++l)
+        {
+            Real* U = uMatrices + N*N*l;
+            bool zeroColumn[N];
+            bool anyZero = false;
+            for (int c = 0; c < N; ++c)
+            {
+                Real s = S[c][l];
+                zeroColumn[c] = (s == zero);
+                anyZero = anyZero || zeroColumn[c];
+                Real invS = (s != zero ? one / s : zero);
+                for (int r = 0; r < N; ++r)
+                {
+                    U[N*r + c] = W[r][c][l] * invS;
+                }
+            }
+
+            if (anyZero)
+            {
+                CompleteBasis(zeroColumn, U);
+            }
+        }
+    }
+
+    if (vMatrices)
+    {
+        for (int l = 0; l < numLanes; ++l)
+        {
+            for (int r = 0; r < N; ++r)
+            {
+                for (int c = 0; c < N; ++c)
+                {
+                    vMatrices[N*N*l + N*r + c] = V[r][c][l];
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+void BatchSingularValueDecomposition<Real, N>::Rotate(
+    typename BatchLanes<Real>::Register const cs,
+    typename BatchLanes<Real>::Register const sn, Real* xp, Real* xq)
+{
+    typedef BatchLanes<Real> Lanes;
+    typename Lanes::Register vp = Lanes::Load(xp), vq = Lanes::Load(xq);
+    Lanes::Store(xp, Lanes::Subtract(Lanes::Multiply(cs, vp),
+        Lanes::Multiply(sn, vq)));
+    Lanes::Store(xq, Lanes::Add(Lanes::Multiply(sn, vp),
+        Lanes::Multiply(cs, vq)));
+}
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+void BatchSingularValueDecomposition<Real, N>::Swap(
+    typename BatchLanes<Real>::Mask const swap, Real* xp, Real* xq)
+{
+    typedef BatchLanes<Real> Lanes;
+    typename Lanes::Register vp = Lanes::Load(xp), vq = Lanes::Load(xq);
+    Lanes::Store(xp, Lanes::Select(swap, vq, vp));
+    Lanes::Store(xq, Lanes::Select(swap, vp, vq));
+}
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+void BatchSingularValueDecomposition<Real, N>::CompleteBasis(
+    bool const zeroColumn[N], Real* U)
+{
+    // Each missing column is the standard basis vector whose projection
+    // onto the orthogonal complement of the known columns is longest,
+    // which is that projection normalized.
+    bool known[N];
+    for (int c = 0; c < N; ++c)
+    {
+        known[c] = !zeroColumn[c];
+    }
+
+    for (int c = 0; c < N; ++c)
+    {
+        if (known[c])
+        {
+            continue;
+        }
+
+        Real best[N], bestLength = (Real)-1;
+        for (int e = 0; e < N; ++e)
+        {
+            Real candidate[N];
+            for (int r = 0; r < N; ++r)
+            {
+                candidate[r] = (r == e ? (Real)1 : (Real)0);
+            }
+            for (int k = 0; k < N; ++k)
+            {
+                if (known[k])
+                {
+                    Real dot = U[N*e + k];
+                    for (int r = 0; r < N; ++r)
+                    {
+                        candidate[r] -= dot * U[N*r + k];
+                    }
+                }
+            }
+
+            Real length = (Real)0;
+            for (int r = 0; r < N; ++r)
+            {
+                length += candidate[r] * candidate[r];
+            }
+            if (length > bestLength)
+            {
+                bestLength = length;
+                std::copy(candidate, candidate + N, best);
+            }
+        }
+
+        Real invLength = (Real)1 / std::sqrt(bestLength);
+        for (int r = 0; r < N; ++r)
+        {
+            U[N*r + c] = best[r] * invLength;
+        }
+        known[c] = true;
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,81 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include "GteBatchLanes.h"
+#include "GteParallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// The BatchSymmetricEigensolver class computes the eigenvalues and
+// eigenvectors of many small NxN symmetric matrices (N = 2, 3, or 4), such
+// as covariance matrices, using the cyclic Jacobi method of Algorithm 8.4.3
+// (Cyclic Jacobi) described in "Matrix Computations, 2nd edition" by G. H.
+// Golub and C. F. Van Loan, The Johns Hopkins University Press, Baltimore
+// MD, Fourth Printing 1993.  For such sizes, SymmetricEigensolver spends
+// most of its time in the setup of its general Householder and QR steps.
+//
+// The matrices are processed in batches of BATCH_SIZE.  A batch is stored
+// with element (r,c) of the matrices contiguous, and each Jacobi rotation
+// is computed and applied with branchless selects to
+// BatchLanes<Real>::NUM_LANES matrices at a time, which is four for float
+// and two for double using SSE2.  A sweep rotates each of the N(N-1)/2
+// off-diagonal pairs, and the sweeps stop when every off-diagonal element
+// of every matrix of the batch is negligible in the sense of
+// SymmetricEigensolver:  sum = |a(p,p)| + |a(q,q)|; sum + |a(p,q)| == sum.
+// The batches are partitioned among the threads.
+//
+// The batch solver uses at most 4 sweeps for 3x3 and 5 sweeps for 4x4
+// matrices.
+
+namespace gte
+{
+
+template <typename Real, int N>
+class BatchSymmetricEigensolver
+{
+public:
+    // The number of matrices processed together.
+    enum { BATCH_SIZE = 16 };
+
+    // The maximum number of sweeps must be specified; 8 is more than enough
+    // for double precision.
+    BatchSymmetricEigensolver(unsigned int maxSweeps);
+
+    // The input 'matrices' stores numMatrices NxN symmetric matrices, each
+    // in row-major order.  The order of the eigenvalues of each matrix is
+    // specified by sortType: -1 (decreasing), 0 (no sorting), or +1
+    // (increasing).  The output 'eigenvalues' must have N*numMatrices
+    // elements.  The output 'eigenvectors' must have N*N*numMatrices
+    // elements; matrix i is the orthogonal Q_i in row-major order, whose
+    // columns are the eigenvectors, for which Q_i^T*A_i*Q_i = D_i.  Pass
+    // nullptr for 'eigenvectors' when you need only the eigenvalues.
+    void Solve(int numMatrices, Real const* matrices, int sortType,
+        Real* eigenvalues, Real* eigenvectors,
+        unsigned int numThreads = 1) const;
+
+private:
+    // Solve the matrices of one batch, where numLanes <= BATCH_SIZE.
+    void SolveBatch(int numLanes, Real const* matrices, int sortType,
+        Real* eigenvalues, Real* eigenvectors) const;
+
+    // Apply the rotation (cs,sn) to the lanes of elements p and q of a row
+    // of A or Q, or swap those lanes for which the mask is set.
+    static void Rotate(typename BatchLanes<Real>::Register const cs,
+        typename BatchLanes<Real>::Register const sn, Real* xp, Real* xq);
+    static void Swap(typename BatchLanes<Real>::Mask const swap, Real* xp,
+        Real* xq);
+
+    unsigned int mMaxSweeps;
+};
+
+#include "GteBatchSymmetricEigensolver.inl"
+
+}
@@ -0,0 +1,224 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+BatchSymmetricEigensolver<Real, N>::BatchSymmetricEigensolver(
+    unsigned int maxSweeps)
+    :
+    mMaxSweeps(maxSweeps)
+{
+    static_assert(2 <= N && N <= 4, "The size must be 2, 3, or 4.");
+}
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+void BatchSymmetricEigensolver<Real, N>::Solve(int numMatrices,
+    Real const* matrices, int sortType, Real* eigenvalues,
+    Real* eigenvectors, unsigned int numThreads) const
+{
+    int const numBatches = (numMatrices + BATCH_SIZE - 1) / BATCH_SIZE;
+    auto task = [this, numMatrices, matrices, sortType, eigenvalues,
+        eigenvectors](int bmin, int bmax)
+    {
+        for (int b = bmin; b < bmax; ++b)
+        {
+            int const i0 = b * BATCH_SIZE;
+            int const numLanes = std::min(numMatrices - i0,
+                (int)BATCH_SIZE);
+            SolveBatch(numLanes, matrices + (size_t)N*N*i0, sortType,
+                eigenvalues + (size_t)N*i0, (eigenvectors ?
+                eigenvectors + (size_t)N*N*i0 : nullptr));
+        }
+    };
+
+    ParallelFor::Execute(numBatches, numThreads, task);
+}
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+void BatchSymmetricEigensolver<Real, N>::SolveBatch(int numLanes,
+    Real const* matrices, int sortType, Real* eigenvalues,
+    Real* eigenvectors) const
+{
+    typedef BatchLanes<Real> Lanes;
+    typedef typename Lanes::Register Register;
+    typedef typename Lanes::Mask Mask;
+    int const L = BATCH_SIZE, M = Lanes::NUM_LANES;
+    Real const zero = (Real)0, one = (Real)1;
+    Register const vZero = Lanes::Set(zero), vOne = Lanes::Set(one);
+    Register const vMinusOne = Lanes::Set(-one), vTwo = Lanes::Set((Real)2);
+
+    // Element (r,c) of the matrix of lane l is A[r][c][l].  The unused
+    // lanes are the identity, which requires no rotations.
+    Real A[N][N][L], Q[N][N][L];
+    for (int r = 0; r < N; ++r)
+    {
+        for (int c = 0; c < N; ++c)
+        {
+            for (int l = 0; l < L; ++l)
+            {
+                A[r][c][l] = (l < numLanes ? matrices[N*N*l + N*r + c] :
+                    (r == c ? one : zero));
+                Q[r][c][l] = (r == c ? one : zero);
+            }
+        }
+    }
+
+    for (unsigned int sweep = 0; sweep < mMaxSweeps; ++sweep)
+    {
+        bool notConverged = false;
+        for (int p = 0; p < N - 1; ++p)
+        {
+            for (int q = p + 1; q < N; ++q)
+            {
+                for (int l = 0; l < L; l += M)
+                {
+                    Register sum = Lanes::Add(
+                        Lanes::Abs(Lanes::Load(&A[p][p][l])),
+                        Lanes::Abs(Lanes::Load(&A[q][q][l])));
+                    Register test = Lanes::Add(sum,
+                        Lanes::Abs(Lanes::Load(&A[p][q][l])));
+                    if (Lanes::Any(Lanes::NotEqual(test, sum)))
+                    {
+                        notConverged = true;
+                    }
+                }
+            }
+        }
+        if (!notConverged)
+        {
+            break;
+        }
+
+        for (int p = 0; p < N - 1; ++p)
+        {
+            for (int q = p + 1; q < N; ++q)
+            {
+                for (int l = 0; l < L; l += M)
+                {
+                    // Compute the rotation that zeros A(p,q) by Algorithm
+                    // 8.4.1 (2-by-2 Symmetric Schur Decomposition).  The
+                    // rotation is the identity when A(p,q) is zero.
+                    Register apq = Lanes::Load(&A[p][q][l]);
+                    Mask nonzero = Lanes::NotEqual(apq, vZero);
+                    if (!Lanes::Any(nonzero))
+                    {
+                        continue;
+                    }
+
+                    Register app = Lanes::Load(&A[p][p][l]);
+                    Register aqq = Lanes::Load(&A[q][q][l]);
+                    Register tau = Lanes::Divide(Lanes::Subtract(aqq, app),
+                        Lanes::Multiply(vTwo,
+                        Lanes::Select(nonzero, apq, vOne)));
+                    Register t = Lanes::Divide(
+                        Lanes::Select(Lanes::GreaterEqual(tau, vZero), vOne,
+                        vMinusOne), Lanes::Add(Lanes::Abs(tau), Lanes::Sqrt(
+                        Lanes::Add(vOne, Lanes::Multiply(tau, tau)))));
+                    Register c = Lanes::Divide(vOne, Lanes::Sqrt(
+                        Lanes::Add(vOne, Lanes::Multiply(t, t))));
+                    Register tn = Lanes::Select(nonzero, t, vZero);
+                    Register cs = Lanes::Select(nonzero, c, vOne);
+                    Register sn = Lanes::Select(nonzero,
+                        Lanes::Multiply(t, c), vZero);
+
+                    // A = J^T*A*J and Q = Q*J, where J(p,p) = J(q,q) = c,
+                    // J(p,q) = s, and J(q,p) = -s.
+                    Lanes::Store(&A[p][p][l],
+                        Lanes::Subtract(app, Lanes::Multiply(tn, apq)));
+                    Lanes::Store(&A[q][q][l],
+                        Lanes::Add(aqq, Lanes::Multiply(tn, apq)));
+                    Lanes::Store(&A[p][q][l], vZero);
+                    Lanes::Store(&A[q][p][l], vZero);
+                    for (int k = 0; k < N; ++k)
+                    {
+                        if (k != p && k != q)
+                        {
+                            Rotate(cs, sn, &A[k][p][l], &A[k][q][l]);
+                            Lanes::Store(&A[p][k][l],
+                                Lanes::Load(&A[k][p][l]));
+                            Lanes::Store(&A[q][k][l],
+                                Lanes::Load(&A[k][q][l]));
+                        }
+                        Rotate(cs, sn, &Q[k][p][l], &Q[k][q][l]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Sort the eigenvalues and the columns of Q using an odd-even
+    // transposition sort, whose compare-exchanges are branchless selects.
+    if (sortType != 0)
+    {
+        for (int pass = 0; pass < N; ++pass)
+        {
+            for (int p = (pass & 1); p + 1 < N; p += 2)
+            {
+                int const q = p + 1;
+                for (int l = 0; l < L; l += M)
+                {
+                    Register dp = Lanes::Load(&A[p][p][l]);
+                    Register dq = Lanes::Load(&A[q][q][l]);
+                    Mask swap = (sortType > 0 ? Lanes::Less(dq, dp) :
+                        Lanes::Less(dp, dq));
+                    Lanes::Store(&A[p][p][l], Lanes::Select(swap, dq, dp));
+                    Lanes::Store(&A[q][q][l], Lanes::Select(swap, dp, dq));
+                    for (int k = 0; k < N; ++k)
+                    {
+                        Swap(swap, &Q[k][p][l], &Q[k][q][l]);
+                    }
+                }
+            }
+        }
+    }
+
+    for (int l = 0; l < numLanes; ++l)
+    {
+        for (int r = 0; r < N; ++r)
+        {
+            eigenvalues[N*l + r] = A[r][r][l];
+        }
+    }
+
+    if (eigenvectors)
+    {
+        for (int l = 0; l < numLanes; ++l)
+        {
+            for (int r = 0; r < N; ++r)
+            {
+                for (int c = 0; c < N; ++c)
+                {
+                    eigenvectors[N*N*l + N*r + c] = Q[r][c][l];
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+void BatchSymmetricEigensolver<Real, N>::Rotate(
+    typename BatchLanes<Real>::Register const cs,
+    typename BatchLanes<Real>::Register const sn, Real* xp, Real* xq)
+{
+    typedef BatchLanes<Real> Lanes;
+    typename Lanes::Register vp = Lanes::Load(xp), vq = Lanes::Load(xq);
+    Lanes::Store(xp, Lanes::Subtract(Lanes::Multiply(cs, vp),
+        Lanes::Multiply(sn, vq)));
+    Lanes::Store(xq, Lanes::Add(Lanes::Multiply(sn, vp),
+        Lanes::Multiply(cs, vq)));
+}
+//----------------------------------------------------------------------------
+template <typename Real, int N>
+void BatchSymmetricEigensolver<Real, N>::Swap(
+    typename BatchLanes<Real>::Mask const swap, Real* xp, Real* xq)
+{
+    typedef BatchLanes<Real> Lanes;
+    typename Lanes::Register vp = Lanes::Load(xp), vq = Lanes::Load(xq);
+    Lanes::Store(xp, Lanes::Select(swap, vq, vp));
+    Lanes::Store(xq, Lanes::Select(swap, vp, vq));
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GteImage2.h"
+#include <cstdint>
+#include <vector>
+
+// A 2D binary image stored with one bit per pixel.  Each row is stored in
+// GetWordsPerRow() 64-bit words; pixel x of a row is bit (x & 63) of word
+// (x >> 6).  The bits of the last word of a row that are beyond the image
+// are zero.  The morphological operations of ImageUtility2 process 64
+// pixels of a row with one word operation.
+
+namespace gte
+{
+
+class GTE_IMPEXP BinaryImage2
+{
+public:
+    // Construction.  The default constructor creates a null image.  The
+    // input dimensions must be positive; otherwise, a null image is created.
+    // The pixels are initialized to zero.
+    BinaryImage2();
+    BinaryImage2(int dimension0, int dimension1);
+
+    // Conversion to and from Image2<int>.  The nonzero pixels of 'image' are
+    // the 1-valued pixels of the binary image.  CopyTo resizes 'image' when
+    // necessary and sets its pixels to 0 or 1.
+    BinaryImage2(Image2<int> const& image);
+    void CopyTo(Image2<int>& image) const;
+
+    // Recreate the image when the dimensions are different; otherwise, the
+    // pixels are unchanged.
+    void Resize(int dimension0, int dimension1);
+
+    // Member access.
+    inline int GetDimension(int i) const;
+    inline int GetWordsPerRow() const;
+    inline bool IsNullImage() const;
+
+    // Pixel access.  The coordinates must be in the image.
+    inline bool Get(int x, int y) const;
+    inline void Set(int x, int y, bool value);
+
+    // Access to the words.  The words of row y start at index
+    // y*GetWordsPerRow().
+    inline uint64_t* GetWords();
+    inline uint64_t const* GetWords() const;
+
+private:
+    int mDimensions[2], mWordsPerRow;
+    std::vector<uint64_t> mWords;
+};
+
+#include "GteBinaryImage2.inl"
+
+}
@@ -0,0 +1,45 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+inline int BinaryImage2::GetDimension(int i) const
+{
+    return mDimensions[i];
+}
+//----------------------------------------------------------------------------
+inline int BinaryImage2::GetWordsPerRow() const
+{
+    return mWordsPerRow;
+}
+//----------------------------------------------------------------------------
+inline bool BinaryImage2::IsNullImage() const
+{
+    return mWords.size() == 0;
+}
+//----------------------------------------------------------------------------
+inline bool BinaryImage2::Get(int x, int y) const
+{
+    return ((mWords[y*mWordsPerRow + (x >> 6)] >> (x & 63)) & 1) != 0;
+}
+//----------------------------------------------------------------------------
+inline void BinaryImage2::Set(int x, int y, bool value)
+{
+    uint64_t& word = mWords[y*mWordsPerRow + (x >> 6)];
+    uint64_t const mask = (uint64_t)1 << (x & 63);
+    word = (value ? word | mask : word & ~mask);
+}
+//----------------------------------------------------------------------------
+inline uint64_t* BinaryImage2::GetWords()
+{
+    return (mWords.size() > 0 ? &mWords[0] : nullptr);
+}
+//----------------------------------------------------------------------------
+inline uint64_t const* BinaryImage2::GetWords() const
+{
+    return (mWords.size() > 0 ? &mWords[0] : nullptr);
+}
+//----------------------------------------------------------------------------
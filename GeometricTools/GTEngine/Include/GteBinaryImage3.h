@@ -0,0 +1,64 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GteImage3.h"
+#include <cstdint>
+#include <vector>
+
+// A 3D binary image stored with one bit per voxel.  The rows of voxels
+// (constant y and z) are stored in the order of y + GetDimension(1)*z, each
+// in GetWordsPerRow() 64-bit words; voxel x of a row is bit (x & 63) of word
+// (x >> 6).  The bits of the last word of a row that are beyond the image
+// are zero.  The morphological operations of ImageUtility3 process 64
+// voxels of a row with one word operation.
+
+namespace gte
+{
+
+class GTE_IMPEXP BinaryImage3
+{
+public:
+    // Construction.  The default constructor creates a null image.  The
+    // input dimensions must be positive; otherwise, a null image is created.
+    // The voxels are initialized to zero.
+    BinaryImage3();
+    BinaryImage3(int dimension0, int dimension1, int dimension2);
+
+    // Conversion to and from Image3<int>.  The nonzero voxels of 'image' are
+    // the 1-valued voxels of the binary image.  CopyTo resizes 'image' when
+    // necessary and sets its voxels to 0 or 1.
+    BinaryImage3(Image3<int> const& image);
+    void CopyTo(Image3<int>& image) const;
+
+    // Recreate the image when the dimensions are different; otherwise, the
+    // voxels are unchanged.
+    void Resize(int dimension0, int dimension1, int dimension2);
+
+    // Member access.
+    inline int GetDimension(int i) const;
+    inline int GetWordsPerRow() const;
+    inline bool IsNullImage() const;
+
+    // Voxel access.  The coordinates must be in the image.
+    inline bool Get(int x, int y, int z) const;
+    inline void Set(int x, int y, int z, bool value);
+
+    // Access to the words.  The words of row (y,z) start at index
+    // (y + GetDimension(1)*z)*GetWordsPerRow().
+    inline uint64_t* GetWords();
+    inline uint64_t const* GetWords() const;
+
+private:
+    int mDimensions[3], mWordsPerRow;
+    std::vector<uint64_t> mWords;
+};
+
+#include "GteBinaryImage3.inl"
+
+}
@@ -0,0 +1,47 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+inline int BinaryImage3::GetDimension(int i) const
+{
+    return mDimensions[i];
+}
+//----------------------------------------------------------------------------
+inline int BinaryImage3::GetWordsPerRow() const
+{
+    return mWordsPerRow;
+}
+//----------------------------------------------------------------------------
+inline bool BinaryImage3::IsNullImage() const
+{
+    return mWords.size() == 0;
+}
+//----------------------------------------------------------------------------
+inline bool BinaryImage3::Get(int x, int y, int z) const
+{
+    int const row = y + mDimensions[1]*z;
+    return ((mWords[row*mWordsPerRow + (x >> 6)] >> (x & 63)) & 1) != 0;
+}
+//----------------------------------------------------------------------------
+inline void BinaryImage3::Set(int x, int y, int z, bool value)
+{
+    int const row = y + mDimensions[1]*z;
+    uint64_t& word = mWords[row*mWordsPerRow + (x >> 6)];
+    uint64_t const mask = (uint64_t)1 << (x & 63);
+    word = (value ? word | mask : word & ~mask);
+}
+//----------------------------------------------------------------------------
+inline uint64_t* BinaryImage3::GetWords()
+{
+    return (mWords.size() > 0 ? &mWords[0] : nullptr);
+}
+//----------------------------------------------------------------------------
+inline uint64_t const* BinaryImage3::GetWords() const
+{
+    return (mWords.size() > 0 ? &mWords[0] : nullptr);
+}
+//----------------------------------------------------------------------------
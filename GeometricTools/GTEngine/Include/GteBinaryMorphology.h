@@ -0,0 +1,75 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Dilation and erosion of bit-packed binary images (BinaryImage2 and
+// BinaryImage3).  This is the implementation of the functions of
+// ImageUtility2 and ImageUtility3 for those images; use those functions
+// rather than this class.
+//
+// The structuring element consists of the origin and the specified
+// offsets.  Its offsets are grouped by their (y,z) components.  Each group
+// is a set of x-offsets, and the row of the result is the combination of
+// the input rows at the (y,z) offsets of the groups, each shifted by the x-
+// offsets of its group.  The shifts of a row by a set of x-offsets are
+// computed once per distinct set in a horizontal pass; a shift costs two
+// word shifts and an OR per 64 pixels.  A vertical pass then combines the
+// shifted rows of the groups with one word operation per 64 pixels.  The
+// word operations are SSE2 operations on pairs of words.  For
+// example, the 3x3 square requires 3 shifts and 3 combinations per word
+// rather than 9 of each, and the 4-connected cross requires a single
+// horizontal set because the shifts of the set {0} are the input itself.
+// The rows of each pass are partitioned among the threads.
+
+namespace gte
+{
+
+class GTE_IMPEXP BinaryMorphology
+{
+public:
+    // The image has dimensions[0] pixels per row, dimensions[1] rows per
+    // slice, and dimensions[2] slices (1 for a 2D image).  Row y+d1*z starts
+    // at word (y+d1*z)*wordsPerRow, and the bits beyond the image in the
+    // last word of a row are zero.  The input and output must be different
+    // arrays.
+    //
+    // Dilation sets output(p) to 1 when input(p-e) is 1 for some e in the
+    // structuring element.  Erosion sets output(p) to 1 when input(p+e) is
+    // 1 for all e in the structuring element; if zeroExterior is true the
+    // pixels outside the image are 0, and otherwise they are ignored.
+    static void Dilate(int const dimensions[3], int wordsPerRow,
+        int numOffsets, std::array<int, 3> const offsets[],
+        uint64_t const* input, uint64_t* output, unsigned int numThreads);
+
+    static void Erode(int const dimensions[3], int wordsPerRow,
+        bool zeroExterior, int numOffsets,
+        std::array<int, 3> const offsets[], uint64_t const* input,
+        uint64_t* output, unsigned int numThreads);
+
+private:
+    // The common implementation.  Each output pixel is the OR (dilation) or
+    // the AND (erosion) of the input pixels at p+s for the sample offsets s,
+    // where the pixels outside the image have the value 'exterior'.
+    static void Execute(int const dimensions[3], int wordsPerRow,
+        bool dilate, bool exterior, std::vector<std::array<int, 3> >& samples,
+        uint64_t const* input, uint64_t* output, unsigned int numThreads);
+
+    // Combine the words of a row into the target row.  Word w of the
+    // row consists of bits [shift,64) of source[w] and bits [0,shift) of
+    // source[w+1].  The target words are replaced when 'first' is true;
+    // otherwise, they are combined with OR (dilation) or AND (erosion).
+    static void Combine(bool dilate, bool first, int numWords,
+        uint64_t const* source, int shift, uint64_t* target);
+};
+
+}
@@ -0,0 +1,49 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include <algorithm>
+
+// The product of K Householder reflections H[k] = I - tau[k]*y[k]*y[k]^T,
+// where tau[k] = 2/Dot(y[k],y[k]) or 0, is represented compactly as
+//   H[0]*H[1]*...*H[K-1] = I - Y*T*Y^T
+// where Y is the matrix whose columns are the y[k] and T is KxK upper
+// triangular.  This is the compact WY representation of R. Schreiber and
+// C. Van Loan, "A Storage-Efficient WY Representation for Products of
+// Householder Transformations", SIAM J. Sci. Stat. Comput. 10(1), 1989.
+// Applying K reflections to a matrix Z as Z - Y*(T*(Y^T*Z)) is a sequence
+// of matrix-matrix products, which visits Z once rather than K times.  The
+// functions are used for accumulating the Householder reflections of
+// SymmetricEigensolver and SingularValueDecomposition.
+
+namespace gte
+{
+
+template <typename Real>
+class BlockReflector
+{
+public:
+    // The matrix Y has numRows rows and numReflections columns and is
+    // stored in row-major order.  The output T must have
+    // numReflections*numReflections elements and is stored in row-major
+    // order.
+    static void ComputeT(int numRows, int numReflections, Real const* Y,
+        Real const* tau, Real* T);
+
+    // Compute Z = (I - Y*T*Y^T)*Z, where Z has numRows rows and numColumns
+    // columns.  The element (r,c) of Z is Z[c + stride*r], so Z may be a
+    // block of columns of a larger row-major matrix.  The array 'work' must
+    // have numReflections*numColumns elements.
+    static void Apply(int numRows, int numReflections, Real const* Y,
+        Real const* T, int numColumns, int stride, Real* Z, Real* work);
+};
+
+#include "GteBlockReflector.inl"
+
+}
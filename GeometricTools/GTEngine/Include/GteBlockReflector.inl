@@ -0,0 +1,115 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <typename Real>
+void BlockReflector<Real>::ComputeT(int numRows, int numReflections,
+    Real const* Y, Real const* tau, Real* T)
+{
+    // Use the recursion of the Schreiber-Van Loan paper.  The matrix for the
+    // first k reflections is extended by reflection k using
+    //   T(k,k) = tau[k], T(0:k-1,k) = -tau[k]*T(0:k-1,0:k-1)*Y^T*y[k]
+    int const K = numReflections;
+    std::fill(T, T + K*K, (Real)0);
+    for (int k = 0; k < K; ++k)
+    {
+        // Store Y^T*y[k] temporarily in column k of T.
+        for (int r = 0; r < numRows; ++r)
+        {
+            Real const* Yrow = &Y[K*r];
+            Real ykr = Yrow[k];
+            if (ykr != (Real)0)
+            {
+                for (int j = 0; j < k; ++j)
+                {
+                    T[k + K*j] += Yrow[j] * ykr;
+                }
+            }
+        }
+
+        // T is upper triangular, so the product is computed in place by
+        // visiting the rows in increasing order.
+        for (int j = 0; j < k; ++j)
+        {
+            Real sum = (Real)0;
+            for (int m = j; m < k; ++m)
+            {
+                sum += T[m + K*j] * T[k + K*m];
+            }
+            T[k + K*j] = -tau[k] * sum;
+        }
+        T[k + K*k] = tau[k];
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void BlockReflector<Real>::Apply(int numRows, int numReflections,
+    Real const* Y, Real const* T, int numColumns, int stride, Real* Z,
+    Real* work)
+{
+    int const K = numReflections;
+
+    // work = Y^T*Z
+    std::fill(work, work + K*numColumns, (Real)0);
+    for (int r = 0; r < numRows; ++r)
+    {
+        Real const* Yrow = &Y[K*r];
+        Real const* Zrow = &Z[stride*r];
+        for (int k = 0; k < K; ++k)
+        {
+            Real ykr = Yrow[k];
+            if (ykr != (Real)0)
+            {
+                Real* Wrow = &work[numColumns*k];
+                for (int c = 0; c < numColumns; ++c)
+                {
+                    Wrow[c] += ykr * Zrow[c];
+                }
+            }
+        }
+    }
+
+    // work = T*work, computed in place because T is upper triangular.
+    for (int k = 0; k < K; ++k)
+    {
+        Real* Wrow = &work[numColumns*k];
+        Real tkk = T[k + K*k];
+        for (int c = 0; c < numColumns; ++c)
+        {
+            Wrow[c] *= tkk;
+        }
+        for (int m = k + 1; m < K; ++m)
+        {
+            Real tkm = T[m + K*k];
+            Real const* Wm = &work[numColumns*m];
+            for (int c = 0; c < numColumns; ++c)
+            {
+                Wrow[c] += tkm * Wm[c];
+            }
+        }
+    }
+
+    // Z = Z - Y*work
+    for (int r = 0; r < numRows; ++r)
+    {
+        Real const* Yrow = &Y[K*r];
+        Real* Zrow = &Z[stride*r];
+        for (int k = 0; k < K; ++k)
+        {
+            Real ykr = Yrow[k];
+            if (ykr != (Real)0)
+            {
+                Real const* Wrow = &work[numColumns*k];
+                for (int c = 0; c < numColumns; ++c)
+                {
+                    Zrow[c] -= ykr * Wrow[c];
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
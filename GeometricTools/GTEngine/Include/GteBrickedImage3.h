@@ -0,0 +1,96 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GteImage3.h"
+#include <algorithm>
+#include <vector>
+
+// A 3D image whose pixels are stored in bricks of 8x8x8 pixels rather than
+// in row-major order.  The pixels of a brick are contiguous and stored in
+// row-major order within the brick, and the bricks are stored in row-major
+// order within the image.  A pixel and its 26 neighbors are in the same
+// brick unless the pixel is on a brick face, so neighborhood operators touch
+// one or a few 2KB blocks of memory (for 4-byte pixels) per pixel rather
+// than three slices of the image.  The dimensions of the storage are the
+// image dimensions rounded up to multiples of 8; the padding pixels are
+// zero-initialized and are not part of the image.
+//
+// The coordinate access is that of Image3, but the 1-dimensional indices
+// (GetIndex, GetCoordinates, operator[]) refer to the bricked storage, so
+// they range over GetNumPixels() values that include the padding.  Convert
+// to and from Image3 for the algorithms that depend on row-major indices.
+// The layout pays for the dilations of ImageUtility3, but not for its
+// connected component labeling; see the comments in GteImageUtility3.h.
+// The PixelType must be "plain old data" (POD).
+
+namespace gte
+{
+
+template <typename PixelType>
+class BrickedImage3
+{
+public:
+    enum
+    {
+        BRICK_LOG = 3,
+        BRICK_SIZE = 8,
+        BRICK_MASK = 7,
+        BRICK_NUM_PIXELS = 512
+    };
+
+    // Construction.  The default constructor creates a null image.  The
+    // input dimensions must be positive; otherwise, a null image is created.
+    // The pixels are initialized to zero.
+    BrickedImage3();
+    BrickedImage3(int dimension0, int dimension1, int dimension2);
+
+    // Conversion between the bricked and the row-major layouts.  CopyTo
+    // resizes 'image' when necessary.
+    BrickedImage3(Image3<PixelType> const& image);
+    void CopyTo(Image3<PixelType>& image) const;
+
+    // Member access.  GetNumBricks(i) is the number of bricks along
+    // dimension i.  GetNumPixels() is the number of pixels in the storage,
+    // GetNumBricks(0)*GetNumBricks(1)*GetNumBricks(2)*BRICK_NUM_PIXELS.
+    inline int GetDimension(int i) const;
+    inline int GetNumBricks(int i) const;
+    inline int GetNumPixels() const;
+    inline bool IsNullImage() const;
+
+    // Conversion between 1-dimensional indices and 3-dimensional
+    // coordinates.  The coordinates must satisfy 0 <= x < GetNumBricks(0)*8,
+    // and similarly for y and z.
+    inline int GetIndex(int x, int y, int z) const;
+    inline void GetCoordinates(int index, int& x, int& y, int& z) const;
+
+    // Access the data as a 1-dimensional array.  The pixels of brick
+    // (bx,by,bz) start at index
+    // BRICK_NUM_PIXELS*(bx + GetNumBricks(0)*(by + GetNumBricks(1)*bz)).
+    inline PixelType* GetPixels1D();
+    inline PixelType const* GetPixels1D() const;
+    inline PixelType& operator[](int i);
+    inline PixelType const& operator[](int i) const;
+
+    // Access the data as a 3-dimensional array.
+    inline PixelType& operator()(int x, int y, int z);
+    inline PixelType const& operator()(int x, int y, int z) const;
+
+    // Set all pixels, including the padding, to the specified value.
+    void SetAllPixels(PixelType const& value);
+
+private:
+    void Create(int dimension0, int dimension1, int dimension2);
+
+    int mDimensions[3], mNumBricks[3];
+    std::vector<PixelType> mPixels;
+};
+
+#include "GteBrickedImage3.inl"
+
+}
@@ -0,0 +1,205 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <typename PixelType>
+BrickedImage3<PixelType>::BrickedImage3()
+{
+    Create(0, 0, 0);
+}
+//----------------------------------------------------------------------------
+template <typename PixelType>
+BrickedImage3<PixelType>::BrickedImage3(int dimension0, int dimension1,
+    int dimension2)
+{
+    Create(dimension0, dimension1, dimension2);
+}
+//----------------------------------------------------------------------------
+template <typename PixelType>
+BrickedImage3<PixelType>::BrickedImage3(Image3<PixelType> const& image)
+{
+    Create(image.GetDimension(0), image.GetDimension(1),
+        image.GetDimension(2));
+
+    // Copy a row of a brick at a time.  The rows of the padding pixels are
+    // left zero.
+    for (int z = 0; z < mDimensions[2]; ++z)
+    {
+        for (int y = 0; y < mDimensions[1]; ++y)
+        {
+            for (int x = 0; x < mDimensions[0]; x += BRICK_SIZE)
+            {
+                int const length = std::min(mDimensions[0] - x,
+                    (int)BRICK_SIZE);
+                PixelType const* source = &image(x, y, z);
+                PixelType* target = &mPixels[GetIndex(x, y, z)];
+                for (int i = 0; i < length; ++i)
+                {
+                    target[i] = source[i];
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename PixelType>
+void BrickedImage3<PixelType>::CopyTo(Image3<PixelType>& image) const
+{
+    image.Resize(mDimensions[0], mDimensions[1], mDimensions[2]);
+    if (IsNullImage())
+    {
+        return;
+    }
+
+    for (int z = 0; z < mDimensions[2]; ++z)
+    {
+        for (int y = 0; y < mDimensions[1]; ++y)
+        {
+            for (int x = 0; x < mDimensions[0]; x += BRICK_SIZE)
+            {
+                int const length = std::min(mDimensions[0] - x,
+                    (int)BRICK_SIZE);
+                PixelType const* source = &mPixels[GetIndex(x, y, z)];
+                PixelType* target = &image(x, y, z);
+                for (int i = 0; i < length; ++i)
+                {
+                    target[i] = source[i];
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+int BrickedImage3<PixelType>::GetDimension(int i) const
+{
+    return mDimensions[i];
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+int BrickedImage3<PixelType>::GetNumBricks(int i) const
+{
+    return mNumBricks[i];
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+int BrickedImage3<PixelType>::GetNumPixels() const
+{
+    return (int)mPixels.size();
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+bool BrickedImage3<PixelType>::IsNullImage() const
+{
+    return mPixels.size() == 0;
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+int BrickedImage3<PixelType>::GetIndex(int x, int y, int z) const
+{
+    int brick = (x >> BRICK_LOG) + mNumBricks[0]*((y >> BRICK_LOG) +
+        mNumBricks[1]*(z >> BRICK_LOG));
+    int local = (x & BRICK_MASK) + BRICK_SIZE*((y & BRICK_MASK) +
+        BRICK_SIZE*(z & BRICK_MASK));
+#if defined(GTE_IMAGICS_ASSERT_ON_INVALID_INDEX)
+    if (0 <= x && x < BRICK_SIZE*mNumBricks[0]
+    &&  0 <= y && y < BRICK_SIZE*mNumBricks[1]
+    &&  0 <= z && z < BRICK_SIZE*mNumBricks[2])
+    {
+        return BRICK_NUM_PIXELS*brick + local;
+    }
+    LogError("Invalid coordinates (" + std::to_string(x) + "," +
+        std::to_string(y) + "," + std::to_string(z) + ").");
+    return 0;
+#else
+    return BRICK_NUM_PIXELS*brick + local;
+#endif
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+void BrickedImage3<PixelType>::GetCoordinates(int index, int& x, int& y,
+    int& z) const
+{
+    int brick = index >> (3*BRICK_LOG);
+    int local = index & (BRICK_NUM_PIXELS - 1);
+    x = BRICK_SIZE*(brick % mNumBricks[0]) + (local & BRICK_MASK);
+    brick /= mNumBricks[0];
+    y = BRICK_SIZE*(brick % mNumBricks[1]) +
+        ((local >> BRICK_LOG) & BRICK_MASK);
+    z = BRICK_SIZE*(brick / mNumBricks[1]) + (local >> (2*BRICK_LOG));
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+PixelType* BrickedImage3<PixelType>::GetPixels1D()
+{
+    return (mPixels.size() > 0 ? &mPixels[0] : nullptr);
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+PixelType const* BrickedImage3<PixelType>::GetPixels1D() const
+{
+    return (mPixels.size() > 0 ? &mPixels[0] : nullptr);
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+PixelType& BrickedImage3<PixelType>::operator[](int i)
+{
+    return mPixels[i];
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+PixelType const& BrickedImage3<PixelType>::operator[](int i) const
+{
+    return mPixels[i];
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+PixelType& BrickedImage3<PixelType>::operator()(int x, int y, int z)
+{
+    return mPixels[GetIndex(x, y, z)];
+}
+//----------------------------------------------------------------------------
+template <typename PixelType> inline
+PixelType const& BrickedImage3<PixelType>::operator()(int x, int y, int z)
+    const
+{
+    return mPixels[GetIndex(x, y, z)];
+}
+//----------------------------------------------------------------------------
+template <typename PixelType>
+void BrickedImage3<PixelType>::SetAllPixels(PixelType const& value)
+{
+    std::fill(mPixels.begin(), mPixels.end(), value);
+}
+//----------------------------------------------------------------------------
+template <typename PixelType>
+void BrickedImage3<PixelType>::Create(int dimension0, int dimension1,
+    int dimension2)
+{
+    if (dimension0 > 0 && dimension1 > 0 && dimension2 > 0)
+    {
+        mDimensions[0] = dimension0;
+        mDimensions[1] = dimension1;
+        mDimensions[2] = dimension2;
+        for (int i = 0; i < 3; ++i)
+        {
+            mNumBricks[i] = (mDimensions[i] + BRICK_MASK) >> BRICK_LOG;
+        }
+        mPixels.assign(BRICK_NUM_PIXELS*mNumBricks[0]*mNumBricks[1]*
+            mNumBricks[2], PixelType());
+    }
+    else
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            mDimensions[i] = 0;
+            mNumBricks[i] = 0;
+        }
+        mPixels.clear();
+    }
+}
+//----------------------------------------------------------------------------
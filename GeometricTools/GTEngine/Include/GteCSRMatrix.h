@@ -0,0 +1,110 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GteLogger.h"
+#include "GteParallelFor.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+// A sparse matrix in compressed sparse row (CSR) format.  The nonzero
+// elements of row r are stored in positions [rowStarts[r],rowStarts[r+1])
+// of the arrays of column indices and values, sorted by column index.  A
+// matrix-vector product is then a sequential pass over these arrays, which
+// is much faster than visiting the nodes of a std::map.
+
+namespace gte
+{
+
+template <typename Real>
+class CSRMatrix
+{
+public:
+    // An element (row,column,value) of the matrix.
+    struct Element
+    {
+        int row, column;
+        Real value;
+    };
+
+    // Construction.  The elements may be in any order, and the values of
+    // elements with the same (row,column) are summed.  The second
+    // constructor accepts the map of LinearSystem<Real>::SparseMatrix,
+    // whose keys are (row,column) pairs.  When 'symmetric' is true, the map
+    // stores only one of (i,j) and (j,i), and the element (i,j) is also
+    // stored at (j,i) for i != j.
+    CSRMatrix();
+    CSRMatrix(int numRows, int numColumns,
+        std::vector<Element> const& elements);
+    CSRMatrix(int numRows, int numColumns,
+        std::map<std::array<int, 2>, Real> const& elements, bool symmetric);
+
+    // Member access.  The values may be modified, which allows a matrix with
+    // a fixed sparsity pattern to be refilled without rebuilding it.
+    inline int GetNumRows() const;
+    inline int GetNumColumns() const;
+    inline int GetNumElements() const;
+    inline std::vector<int> const& GetRowStarts() const;
+    inline std::vector<int> const& GetColumns() const;
+    inline std::vector<Real> const& GetValues() const;
+    inline std::vector<Real>& GetValues();
+
+    // Compute Y = A*X, where X has numColumns elements and Y has numRows
+    // elements.  The rows are partitioned among the threads so that each
+    // thread processes approximately the same number of elements.
+    void Multiply(Real const* X, Real* Y, unsigned int numThreads = 1) const;
+
+    // Compute the rows [rmin,rmax) of Y = A*X.  This supports callers that
+    // run their own threads, such as the conjugate gradient solver.
+    void Multiply(int rmin, int rmax, Real const* X, Real* Y) const;
+
+    // Split the rows into numThreads subranges with approximately the same
+    // number of elements.  The rows of subrange t are
+    // [partition[t],partition[t+1]), which may be empty.
+    void GetRowPartition(unsigned int numThreads,
+        std::vector<int>& partition) const;
+
+    // Get the diagonal elements of a square matrix, which are zero when not
+    // stored.
+    void GetDiagonal(Real* diagonal) const;
+
+    // Compute the incomplete Cholesky factorization A = L*L^T with no fill,
+    // IC(0), of a symmetric matrix A that stores both triangles.  The factor
+    // L is lower triangular with the sparsity pattern of the lower triangle
+    // of A; the diagonal element is the last element of each of its rows.
+    // The return value is 'false' when a diagonal element of A is missing
+    // or a pivot is not positive, which can happen for symmetric positive
+    // definite matrices that are not diagonally dominant.
+    bool GetIncompleteCholesky(CSRMatrix& factor) const;
+
+    // Solve L*X = B and L^T*X = B, where L is lower triangular with the
+    // diagonal element last in each row (as computed by
+    // GetIncompleteCholesky).  The input is B and the output X is stored in
+    // the same array.  The substitutions are sequential.
+    void SolveLower(Real* X) const;
+    void SolveLowerTranspose(Real* X) const;
+
+private:
+    // Build the arrays from the elements, summing the duplicates.
+    void Create(int numRows, int numColumns,
+        std::vector<Element> const& elements);
+
+    int mNumRows, mNumColumns;
+    std::vector<int> mRowStarts;
+    std::vector<int> mColumns;
+    std::vector<Real> mValues;
+};
+
+#include "GteCSRMatrix.inl"
+
+}
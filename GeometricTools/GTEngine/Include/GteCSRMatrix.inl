@@ -0,0 +1,354 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <typename Real>
+CSRMatrix<Real>::CSRMatrix()
+    :
+    mNumRows(0),
+    mNumColumns(0),
+    mRowStarts(1, 0)
+{
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+CSRMatrix<Real>::CSRMatrix(int numRows, int numColumns,
+    std::vector<Element> const& elements)
+    :
+    mNumRows(0),
+    mNumColumns(0),
+    mRowStarts(1, 0)
+{
+    Create(numRows, numColumns, elements);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+CSRMatrix<Real>::CSRMatrix(int numRows, int numColumns,
+    std::map<std::array<int, 2>, Real> const& elements, bool symmetric)
+    :
+    mNumRows(0),
+    mNumColumns(0),
+    mRowStarts(1, 0)
+{
+    std::vector<Element> list;
+    list.reserve(symmetric ? 2*elements.size() : elements.size());
+    for (auto const& element : elements)
+    {
+        int i = element.first[0];
+        int j = element.first[1];
+        list.push_back({ i, j, element.second });
+        if (symmetric && i != j)
+        {
+            list.push_back({ j, i, element.second });
+        }
+    }
+    Create(numRows, numColumns, list);
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+int CSRMatrix<Real>::GetNumRows() const
+{
+    return mNumRows;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+int CSRMatrix<Real>::GetNumColumns() const
+{
+    return mNumColumns;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+int CSRMatrix<Real>::GetNumElements() const
+{
+    return mRowStarts[mNumRows];
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+std::vector<int> const& CSRMatrix<Real>::GetRowStarts() const
+{
+    return mRowStarts;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+std::vector<int> const& CSRMatrix<Real>::GetColumns() const
+{
+    return mColumns;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+std::vector<Real> const& CSRMatrix<Real>::GetValues() const
+{
+    return mValues;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+std::vector<Real>& CSRMatrix<Real>::GetValues()
+{
+    return mValues;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::Multiply(Real const* X, Real* Y,
+    unsigned int numThreads) const
+{
+    numThreads = ParallelFor::GetNumThreads(numThreads, mNumRows);
+    std::vector<int> partition;
+    GetRowPartition(numThreads, partition);
+    ParallelFor::Execute(numThreads, [this, X, Y, &partition](unsigned int t)
+    {
+        Multiply(partition[t], partition[t + 1], X, Y);
+    });
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::Multiply(int rmin, int rmax, Real const* X,
+    Real* Y) const
+{
+    int const* columns = mColumns.data();
+    Real const* values = mValues.data();
+    for (int r = rmin; r < rmax; ++r)
+    {
+        Real sum = (Real)0;
+        for (int k = mRowStarts[r]; k < mRowStarts[r + 1]; ++k)
+        {
+            sum += values[k] * X[columns[k]];
+        }
+        Y[r] = sum;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::GetDiagonal(Real* diagonal) const
+{
+    for (int r = 0; r < mNumRows; ++r)
+    {
+        diagonal[r] = (Real)0;
+        for (int k = mRowStarts[r]; k < mRowStarts[r + 1]; ++k)
+        {
+            if (mColumns[k] == r)
+            {
+                diagonal[r] = mValues[k];
+                break;
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool CSRMatrix<Real>::GetIncompleteCholesky(CSRMatrix& factor) const
+{
+    if (mNumRows != mNumColumns)
+    {
+        LogError("The matrix must be square.");
+        return false;
+    }
+
+    // Copy the lower triangle of A.  The columns of a row are sorted, so
+    // the diagonal element is the last one of the row.
+    factor.mNumRows = mNumRows;
+    factor.mNumColumns = mNumColumns;
+    factor.mRowStarts.resize(mNumRows + 1);
+    factor.mColumns.clear();
+    factor.mValues.clear();
+    factor.mRowStarts[0] = 0;
+    for (int r = 0; r < mNumRows; ++r)
+    {
+        for (int k = mRowStarts[r]; k < mRowStarts[r + 1]; ++k)
+        {
+            if (mColumns[k] > r)
+            {
+                break;
+            }
+            factor.mColumns.push_back(mColumns[k]);
+            factor.mValues.push_back(mValues[k]);
+        }
+
+        factor.mRowStarts[r + 1] = (int)factor.mColumns.size();
+        if (factor.mRowStarts[r + 1] == factor.mRowStarts[r]
+            || factor.mColumns.back() != r)
+        {
+            return false;
+        }
+    }
+
+    // L(i,k) = (A(i,k) - sum_{j<k} L(i,j)*L(k,j))/L(k,k) for k < i and
+    // L(i,i) = sqrt(A(i,i) - sum_{j<i} L(i,j)^2), where the sums are over
+    // the elements in the sparsity pattern.  The sum for L(i,k) merges the
+    // sorted rows i and k.
+    std::vector<int> const& rowStarts = factor.mRowStarts;
+    std::vector<int> const& columns = factor.mColumns;
+    std::vector<Real>& values = factor.mValues;
+    for (int i = 0; i < mNumRows; ++i)
+    {
+        int const iBegin = rowStarts[i], iDiagonal = rowStarts[i + 1] - 1;
+        for (int ik = iBegin; ik < iDiagonal; ++ik)
+        {
+            int const k = columns[ik];
+            int const kDiagonal = rowStarts[k + 1] - 1;
+            Real sum = values[ik];
+            for (int ij = iBegin, kj = rowStarts[k];
+                ij < ik && kj < kDiagonal; /**/)
+            {
+                if (columns[ij] < columns[kj])
+                {
+                    ++ij;
+                }
+                else if (columns[kj] < columns[ij])
+                {
+                    ++kj;
+                }
+                else
+                {
+                    sum -= values[ij++] * values[kj++];
+                }
+            }
+            values[ik] = sum / values[kDiagonal];
+        }
+
+        Real pivot = values[iDiagonal];
+        for (int ij = iBegin; ij < iDiagonal; ++ij)
+        {
+            pivot -= values[ij] * values[ij];
+        }
+        if (pivot <= (Real)0)
+        {
+            return false;
+        }
+        values[iDiagonal] = sqrt(pivot);
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::SolveLower(Real* X) const
+{
+    for (int r = 0; r < mNumRows; ++r)
+    {
+        int const diagonal = mRowStarts[r + 1] - 1;
+        Real sum = X[r];
+        for (int k = mRowStarts[r]; k < diagonal; ++k)
+        {
+            sum -= mValues[k] * X[mColumns[k]];
+        }
+        X[r] = sum / mValues[diagonal];
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::SolveLowerTranspose(Real* X) const
+{
+    // Row r of L is column r of L^T, so X(r) is known once the rows after
+    // r have been processed, and it is then eliminated from the earlier
+    // unknowns.
+    for (int r = mNumRows - 1; r >= 0; --r)
+    {
+        int const diagonal = mRowStarts[r + 1] - 1;
+        Real const value = X[r] / mValues[diagonal];
+        X[r] = value;
+        for (int k = mRowStarts[r]; k < diagonal; ++k)
+        {
+            X[mColumns[k]] -= mValues[k] * value;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::Create(int numRows, int numColumns,
+    std::vector<Element> const& elements)
+{
+    if (numRows <= 0 || numColumns <= 0)
+    {
+        LogError("Invalid dimensions.");
+        return;
+    }
+    for (auto const& element : elements)
+    {
+        if (element.row < 0 || element.row >= numRows
+            || element.column < 0 || element.column >= numColumns)
+        {
+            LogError("Element out of range.");
+            return;
+        }
+    }
+
+    mNumRows = numRows;
+    mNumColumns = numColumns;
+
+    // Bucket the elements by row (a counting sort).
+    std::vector<int> starts(numRows + 1, 0);
+    for (auto const& element : elements)
+    {
+        ++starts[element.row + 1];
+    }
+    for (int r = 0; r < numRows; ++r)
+    {
+        starts[r + 1] += starts[r];
+    }
+
+    std::vector<std::pair<int, Real>> sorted(elements.size());
+    std::vector<int> next(starts.begin(), starts.end() - 1);
+    for (auto const& element : elements)
+    {
+        sorted[next[element.row]++] =
+            std::make_pair(element.column, element.value);
+    }
+
+    // Sort each row by column and sum the duplicates.
+    mRowStarts.resize(numRows + 1);
+    mColumns.clear();
+    mValues.clear();
+    mColumns.reserve(elements.size());
+    mValues.reserve(elements.size());
+    mRowStarts[0] = 0;
+    for (int r = 0; r < numRows; ++r)
+    {
+        auto begin = sorted.begin() + starts[r];
+        auto end = sorted.begin() + starts[r + 1];
+        std::sort(begin, end,
+            [](std::pair<int, Real> const& p0, std::pair<int, Real> const& p1)
+            {
+                return p0.first < p1.first;
+            }
+        );
+
+        int const rowStart = (int)mColumns.size();
+        for (auto iter = begin; iter != end; ++iter)
+        {
+            if ((int)mColumns.size() > rowStart
+                && mColumns.back() == iter->first)
+            {
+                mValues.back() += iter->second;
+            }
+            else
+            {
+                mColumns.push_back(iter->first);
+                mValues.push_back(iter->second);
+            }
+        }
+        mRowStarts[r + 1] = (int)mColumns.size();
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::GetRowPartition(unsigned int numThreads,
+    std::vector<int>& partition) const
+{
+    // Row partition t starts at the first row whose elements begin at or
+    // after t*numElements/numThreads.
+    int64_t const numElements = mRowStarts[mNumRows];
+    partition.resize(numThreads + 1);
+    partition[0] = 0;
+    partition[numThreads] = mNumRows;
+    for (unsigned int t = 1; t < numThreads; ++t)
+    {
+        int target = (int)((numElements*t)/numThreads);
+        partition[t] = (int)(std::lower_bound(mRowStarts.begin(),
+            mRowStarts.begin() + mNumRows, target) - mRowStarts.begin());
+        partition[t] = std::max(partition[t], partition[t - 1]);
+    }
+}
+//----------------------------------------------------------------------------
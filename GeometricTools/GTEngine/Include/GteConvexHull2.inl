@@ -58,7 +58,6 @@ bool ConvexHull2<InputType, ComputeType>::operator()(int numPoints,
 
     // Compute the points for the queries.
     mComputePoints.resize(mNumPoints);
-    mQuery.Set(mNumPoints, &mComputePoints[0]);
     for (i = 0; i < mNumPoints; ++i)
     {
         for (j = 0; j < 2; ++j)
@@ -66,6 +65,7 @@ bool ConvexHull2<InputType, ComputeType>::operator()(int numPoints,
             mComputePoints[i][j] = points[i][j];
         }
     }
+    mQuery.Set(mNumPoints, &mComputePoints[0]);
 
     // Sort the points.
     mHull.resize(mNumPoints);
@@ -70,7 +70,6 @@ bool ConvexHull3<InputType, ComputeType>::operator()(int numPoints,
 
     // Compute the vertices for the queries.
     mComputePoints.resize(mNumPoints);
-    mQuery.Set(mNumPoints, &mComputePoints[0]);
     for (i = 0; i < mNumPoints; ++i)
     {
         for (j = 0; j < 3; ++j)
@@ -78,6 +77,7 @@ bool ConvexHull3<InputType, ComputeType>::operator()(int numPoints,
             mComputePoints[i][j] = points[i][j];
         }
     }
+    mQuery.Set(mNumPoints, &mComputePoints[0]);
 
     // Insert the faces of the (nondegenerate) tetrahedron constructed by the
     // call to GetInformation.
@@ -0,0 +1,99 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GteVector3.h"
+#include "GteParallelFor.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Accumulate the mean and covariance matrix of 3D points without storing
+// the points.  A point is inserted with the update of B. P. Welford, "Note
+// on a Method for Calculating Corrected Sums of Squares and Products",
+// Technometrics 4(3), 1962.  Two accumulators are merged with the update of
+// T. F. Chan, G. H. Golub and R. J. LeVeque, "Updating Formulae and a
+// Pairwise Algorithm for Computing Sample Variances", Technical Report
+// STAN-CS-79-773, Stanford University, 1979.  Both updates use the sums of
+// products of the differences of the points from the mean, so they do not
+// suffer the cancellation of the sums of products of the points.
+//
+// The accumulators of disjoint sets of points, such as the tiles of a scan
+// or the subsets processed by different threads, can be merged in any
+// order.  The fitters ApprGaussian3, ApprHeightPlane3, ApprOrthogonalLine3
+// and ApprOrthogonalPlane3 compute their fits from an accumulator, so a
+// fit is available at any time during a streaming pass over the points.
+
+namespace gte
+{
+
+template <typename Real>
+class CovarianceAccumulator3
+{
+public:
+    // The number of points processed together by Insert(numPoints,...).
+    enum { CHUNK_SIZE = 4096 };
+
+    // Construction of an accumulator for the empty set of points.
+    CovarianceAccumulator3();
+
+    // Remove all points.
+    void Clear();
+
+    // Insert a single point.
+    void Insert(Vector3<Real> const& point);
+
+    // Insert an array of points.  The mean and covariance of each chunk of
+    // CHUNK_SIZE points are computed from two passes over the chunk, which
+    // is in the cache for the second pass, and the chunk is merged into the
+    // accumulator.  The chunks are partitioned among the threads and the
+    // accumulators of the threads are merged in order, so the result does
+    // not depend on the scheduling of the threads.
+    void Insert(int numPoints, Vector3<Real> const* points,
+        unsigned int numThreads = 1);
+
+    // Insert the points whose indices are specified, which is the subset
+    // of points used by the Fit functions called by ApprQuery::RANSAC.  The
+    // indexed points are processed in chunks as for Insert(numPoints,...).
+    void Insert(std::vector<Vector3<Real>> const& points,
+        std::vector<int> const& indices);
+
+    // Insert the points of another accumulator.  The sets of points of the
+    // two accumulators must be disjoint.
+    void Merge(CovarianceAccumulator3 const& accumulator);
+
+    // Member access.  The sums are those of the products of the components
+    // of p-mean over the points p, stored in the order (00,01,02,11,12,22).
+    int64_t GetNumPoints() const;
+    Vector3<Real> const& GetMean() const;
+    std::array<Real, 6> const& GetSums() const;
+
+    // The covariance matrix, which is the symmetric matrix of the sums
+    // divided by the number of points, stored in row-major order.  The
+    // matrix is zero when there are no points.
+    std::array<Real, 9> GetCovariance() const;
+
+private:
+    // Merge the mean and sums of a chunk of points, where point(i) returns
+    // the point i of the chunk.
+    template <typename PointAccess>
+    void InsertChunk(int numPoints, PointAccess const& point);
+
+    // Merge the mean and sums of n points.
+    void Merge(int64_t numPoints, Vector3<Real> const& mean,
+        std::array<Real, 6> const& sums);
+
+    int64_t mNumPoints;
+    Vector3<Real> mMean;
+    std::array<Real, 6> mSums;
+};
+
+#include "GteCovarianceAccumulator3.inl"
+
+}
@@ -0,0 +1,211 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <typename Real>
+CovarianceAccumulator3<Real>::CovarianceAccumulator3()
+{
+    Clear();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CovarianceAccumulator3<Real>::Clear()
+{
+    mNumPoints = 0;
+    mMean = Vector3<Real>::Zero();
+    mSums.fill((Real)0);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CovarianceAccumulator3<Real>::Insert(Vector3<Real> const& point)
+{
+    // The sums are updated by the products of the differences of the point
+    // from the old mean and from the new mean.
+    ++mNumPoints;
+    Vector3<Real> diff0 = point - mMean;
+    mMean += diff0 / (Real)mNumPoints;
+    Vector3<Real> diff1 = point - mMean;
+    mSums[0] += diff0[0] * diff1[0];
+    mSums[1] += diff0[0] * diff1[1];
+    mSums[2] += diff0[0] * diff1[2];
+    mSums[3] += diff0[1] * diff1[1];
+    mSums[4] += diff0[1] * diff1[2];
+    mSums[5] += diff0[2] * diff1[2];
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CovarianceAccumulator3<Real>::Insert(int numPoints,
+    Vector3<Real> const* points, unsigned int numThreads)
+{
+    if (numPoints <= 0 || !points)
+    {
+        return;
+    }
+
+    auto task = [points](int imin, int imax,
+        CovarianceAccumulator3& accumulator)
+    {
+        for (int i0 = imin; i0 < imax; i0 += CHUNK_SIZE)
+        {
+            int i1 = std::min(i0 + (int)CHUNK_SIZE, imax);
+            Vector3<Real> const* chunk = &points[i0];
+            accumulator.InsertChunk(i1 - i0,
+                [chunk](int i) -> Vector3<Real> const& { return chunk[i]; });
+        }
+    };
+
+    int const numChunks = (numPoints + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    numThreads = ParallelFor::GetNumThreads(numThreads, numChunks);
+    if (numThreads == 1)
+    {
+        task(0, numPoints, *this);
+        return;
+    }
+
+    // The ranges of the threads are unions of chunks.
+    std::vector<CovarianceAccumulator3> local(numThreads);
+    ParallelFor::Execute(numThreads, [&](unsigned int t)
+    {
+        int cmin, cmax;
+        ParallelFor::GetRange(numChunks, numThreads, t, cmin, cmax);
+        int imin = cmin * CHUNK_SIZE;
+        int imax = std::min(cmax * (int)CHUNK_SIZE, numPoints);
+        task(imin, imax, local[t]);
+    });
+    for (unsigned int t = 0; t < numThreads; ++t)
+    {
+        Merge(local[t]);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CovarianceAccumulator3<Real>::Insert(
+    std::vector<Vector3<Real>> const& points, std::vector<int> const& indices)
+{
+    int const numIndices = static_cast<int>(indices.size());
+    for (int i0 = 0; i0 < numIndices; i0 += CHUNK_SIZE)
+    {
+        int i1 = std::min(i0 + (int)CHUNK_SIZE, numIndices);
+        int const* chunk = &indices[i0];
+        InsertChunk(i1 - i0, [&points, chunk](int i)
+            -> Vector3<Real> const&
+        {
+            return points[chunk[i]];
+        });
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CovarianceAccumulator3<Real>::Merge(
+    CovarianceAccumulator3 const& accumulator)
+{
+    Merge(accumulator.mNumPoints, accumulator.mMean, accumulator.mSums);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int64_t CovarianceAccumulator3<Real>::GetNumPoints() const
+{
+    return mNumPoints;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Vector3<Real> const& CovarianceAccumulator3<Real>::GetMean() const
+{
+    return mMean;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+std::array<Real, 6> const& CovarianceAccumulator3<Real>::GetSums() const
+{
+    return mSums;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+std::array<Real, 9> CovarianceAccumulator3<Real>::GetCovariance() const
+{
+    Real invNumPoints = (mNumPoints > 0 ?
+        ((Real)1) / (Real)mNumPoints : (Real)0);
+    Real c00 = mSums[0] * invNumPoints;
+    Real c01 = mSums[1] * invNumPoints;
+    Real c02 = mSums[2] * invNumPoints;
+    Real c11 = mSums[3] * invNumPoints;
+    Real c12 = mSums[4] * invNumPoints;
+    Real c22 = mSums[5] * invNumPoints;
+    std::array<Real, 9> covariance =
+    {
+        c00, c01, c02,
+        c01, c11, c12,
+        c02, c12, c22
+    };
+    return covariance;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CovarianceAccumulator3<Real>::Merge(int64_t numPoints,
+    Vector3<Real> const& mean, std::array<Real, 6> const& sums)
+{
+    if (numPoints == 0)
+    {
+        return;
+    }
+
+    if (mNumPoints == 0)
+    {
+        mNumPoints = numPoints;
+        mMean = mean;
+        mSums = sums;
+        return;
+    }
+
+    // The sums are updated by the product of the difference of the means
+    // weighted by n0*n1/(n0+n1).
+    int64_t total = mNumPoints + numPoints;
+    Real n0 = (Real)mNumPoints, n1 = (Real)numPoints;
+    Real invTotal = ((Real)1) / (Real)total;
+    Vector3<Real> delta = mean - mMean;
+    mMean += delta * (n1 * invTotal);
+    Vector3<Real> weighted = delta * (n0 * n1 * invTotal);
+    mSums[0] += sums[0] + weighted[0] * delta[0];
+    mSums[1] += sums[1] + weighted[0] * delta[1];
+    mSums[2] += sums[2] + weighted[0] * delta[2];
+    mSums[3] += sums[3] + weighted[1] * delta[1];
+    mSums[4] += sums[4] + weighted[1] * delta[2];
+    mSums[5] += sums[5] + weighted[2] * delta[2];
+    mNumPoints = total;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+template <typename PointAccess>
+void CovarianceAccumulator3<Real>::InsertChunk(int numPoints,
+    PointAccess const& point)
+{
+    // Compute the mean of the points of the chunk.
+    Vector3<Real> mean = Vector3<Real>::Zero();
+    for (int i = 0; i < numPoints; ++i)
+    {
+        mean += point(i);
+    }
+    mean /= (Real)numPoints;
+
+    // Compute the sums of the points of the chunk.
+    Real sum00 = (Real)0, sum01 = (Real)0, sum02 = (Real)0;
+    Real sum11 = (Real)0, sum12 = (Real)0, sum22 = (Real)0;
+    for (int i = 0; i < numPoints; ++i)
+    {
+        Vector3<Real> diff = point(i) - mean;
+        sum00 += diff[0] * diff[0];
+        sum01 += diff[0] * diff[1];
+        sum02 += diff[0] * diff[2];
+        sum11 += diff[1] * diff[1];
+        sum12 += diff[1] * diff[2];
+        sum22 += diff[2] * diff[2];
+    }
+
+    std::array<Real, 6> sums = { sum00, sum01, sum02, sum11, sum12, sum22 };
+    Merge(numPoints, mean, sums);
+}
+//----------------------------------------------------------------------------
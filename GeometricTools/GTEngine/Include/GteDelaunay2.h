@@ -7,10 +7,15 @@
 
 #pragma once
 
+#include "GteBRIO.h"
 #include "GteETManifoldMesh.h"
 #include "GteLine2.h"
 #include "GtePrimalQuery2.h"
 #include "GteLogger.h"
+#include "GteParallelFor.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 // Delaunay triangulation of points (intrinsic dimensionality 2).
@@ -61,8 +66,16 @@ public:
     // positive, the determination is fuzzy--vertices approximately the same
     // point, approximately on a line, or planar.  The return value is 'true'
     // if and only if the hull construction is successful.
+    //
+    // The vertices are inserted in the order they occur in the input unless
+    // 'useBRIO' is 'true', in which case they are inserted in a biased
+    // randomized insertion order (see GteBRIO.h).  The latter is much faster
+    // for large inputs, because each point location starts at the most
+    // recently created triangle and the BRIO order keeps the walks short.
+    // The triangulation is the same in both cases for points in general
+    // position, but the triangle ordering of GetIndices() differs.
     bool operator()(int numVertices, Vector2<InputType> const* vertices,
-        InputType epsilon);
+        InputType epsilon, bool useBRIO = false);
 
     // Dimensional information.  If GetDimension() returns 1, the points lie
     // on a line P+t*D (fuzzy comparison when epsilon > 0).  You can sort
@@ -132,6 +145,31 @@ public:
     int GetContainingTriangle(Vector2<InputType> const& p,
         SearchInfo& info) const;
 
+    // Batched point location for numPoints points, intended for large sets
+    // of queries in a fixed triangulation.  On return, triangles[i] is the
+    // index of a triangle containing points[i] or -1 when the point is
+    // outside the hull.  If 'barycentrics' is not null, it must have
+    // 3*numPoints elements; elements 3*i through 3*i+2 are set to the
+    // barycentric coordinates of points[i] with respect to the vertices
+    // GetIndices(triangles[i]), or to zero when triangles[i] is -1.  The
+    // containment tests are exact as for GetContainingTriangle; the
+    // barycentric coordinates are computed using InputType.
+    //
+    // The bounding box of the vertices is partitioned into a grid of 2^k by
+    // 2^k cells with about one to four triangles per cell, and each cell
+    // stores a triangle whose centroid is in the cell.  The queries are
+    // sorted along a Hilbert curve by a counting sort on a grid of at least
+    // that resolution, so the cost of the sort is linear.  A walk starts at
+    // the final triangle of the previous query, or at the triangle of the
+    // grid cell when the curve has skipped over empty cells, so the walks
+    // visit few triangles and the triangles are accessed coherently.  The
+    // sorted queries are partitioned into contiguous ranges, one per
+    // thread, and the threads share GetQuery().
+    void GetContainingTriangles(int numPoints,
+        Vector2<InputType> const* points, int* triangles,
+        InputType* barycentrics = nullptr,
+        unsigned int numThreads = 1) const;
+
 protected:
     // Support for incremental Delaunay triangulation.
     typedef ETManifoldMesh::Triangle Triangle;
@@ -140,6 +178,13 @@ protected:
         std::set<Triangle*>& candidates, std::set<EdgeKey<true>>& boundary);
     void Update(int i);
 
+    // Support for GetContainingTriangles.  The walk starts at 'triangle' and
+    // does not retest the edge through which it entered a triangle.  The
+    // return value is the containing triangle or -1, and 'finalTriangle' is
+    // the last triangle visited.
+    int Walk(Vector2<ComputeType> const& test, int triangle,
+        int& finalTriangle) const;
+
     // The epsilon value is used for fuzzy determination of intrinsic
     // dimensionality.  If the dimension is 0 or 1, the constructor returns
     // early.  The caller is responsible for retrieving the dimension and
@@ -165,6 +210,10 @@ protected:
     std::vector<int> mIndices;
     std::vector<int> mAdjacencies;
 
+    // The most recently created triangle, used as the starting point for
+    // the point-location walks during the incremental construction.
+    Triangle* mLastTriangle;
+
     // If a vertex occurs multiple times in the 'vertices' input to the
     // constructor, the first processed occurrence of that vertex has an
     // index stored in this array.  If there are no duplicates, then
@@ -19,7 +19,8 @@ Delaunay2<InputType, ComputeType>::Delaunay2()
     mLine(Vector2<InputType>::Zero(), Vector2<InputType>::Zero()),
     mNumVertices(0),
     mNumUniqueVertices(0),
-    mNumTriangles(0)
+    mNumTriangles(0),
+    mLastTriangle(nullptr)
 {
     // INVESTIGATE.  If the initialization of mIndex is placed in the
     // constructor initializer list, MSVS 2012 generates an internal
@@ -29,7 +30,7 @@ Delaunay2<InputType, ComputeType>::Delaunay2()
 //----------------------------------------------------------------------------
 template <typename InputType, typename ComputeType>
 bool Delaunay2<InputType, ComputeType>::operator()(int numVertices,
-    Vector2<InputType> const* vertices, InputType epsilon)
+    Vector2<InputType> const* vertices, InputType epsilon, bool useBRIO)
 {
     mEpsilon = std::max(epsilon, (InputType)0);
     mDimension = 0;
@@ -39,6 +40,7 @@ bool Delaunay2<InputType, ComputeType>::operator()(int numVertices,
     mNumUniqueVertices = 0;
     mNumTriangles = 0;
     mGraph = ETManifoldMesh();
+    mLastTriangle = nullptr;
     mIndices.clear();
     mAdjacencies.clear();
     mDuplicates.resize(std::max(numVertices, 3));
@@ -69,7 +71,6 @@ bool Delaunay2<InputType, ComputeType>::operator()(int numVertices,
 
     // Compute the vertices for the queries.
     mComputeVertices.resize(mNumVertices);
-    mQuery.Set(mNumVertices, &mComputeVertices[0]);
     for (i = 0; i < mNumVertices; ++i)
     {
         for (j = 0; j < 2; ++j)
@@ -77,6 +78,7 @@ bool Delaunay2<InputType, ComputeType>::operator()(int numVertices,
             mComputeVertices[i][j] = vertices[i][j];
         }
     }
+    mQuery.Set(mNumVertices, &mComputeVertices[0]);
 
     // Insert the (nondegenerate) triangle constructed by the call to
     // GetInformation.  This is necessary for the circumcircle-visibility
@@ -85,11 +87,13 @@ bool Delaunay2<InputType, ComputeType>::operator()(int numVertices,
     {
         std::swap(info.extreme[1], info.extreme[2]);
     }
-    mGraph.Insert(info.extreme[0], info.extreme[1], info.extreme[2]);
+    mLastTriangle = mGraph.Insert(info.extreme[0], info.extreme[1],
+        info.extreme[2]);
 
-    // Incrementally update the triangulation.  The set of processed points
-    // is maintained to eliminate duplicates, either in the original input
-    // points or in the points obtained by snap rounding.
+    // The set of processed points is maintained to eliminate duplicates,
+    // either in the original input points or in the points obtained by snap
+    // rounding.  The unique points other than the initial triangle vertices
+    // are the ones to insert.
     std::set<ProcessedVertex> processed;
     for (i = 0; i < 3; ++i)
     {
@@ -97,13 +101,15 @@ bool Delaunay2<InputType, ComputeType>::operator()(int numVertices,
         processed.insert(ProcessedVertex(vertices[j], j));
         mDuplicates[j] = j;
     }
+    std::vector<int> insertions;
+    insertions.reserve(mNumVertices);
     for (i = 0; i < mNumVertices; ++i)
     {
         ProcessedVertex v(vertices[i], i);
         auto iter = processed.find(v);
         if (iter == processed.end())
         {
-            Update(i);
+            insertions.push_back(i);
             processed.insert(v);
             mDuplicates[i] = i;
         }
@@ -114,6 +120,17 @@ bool Delaunay2<InputType, ComputeType>::operator()(int numVertices,
     }
     mNumUniqueVertices = static_cast<int>(processed.size());
 
+    // Incrementally update the triangulation.
+    if (useBRIO)
+    {
+        BRIO<2, InputType> brio;
+        brio(vertices, insertions);
+    }
+    for (auto index : insertions)
+    {
+        Update(index);
+    }
+
     // Assign integer values to the triangles for use by the caller.
     std::map<Triangle*, int> permute;
     i = -1;
@@ -386,6 +403,198 @@ int Delaunay2<InputType, ComputeType>::GetContainingTriangle(
 }
 //----------------------------------------------------------------------------
 template <typename InputType, typename ComputeType>
+void Delaunay2<InputType, ComputeType>::GetContainingTriangles(
+    int numPoints, Vector2<InputType> const* points, int* triangles,
+    InputType* barycentrics, unsigned int numThreads) const
+{
+    if (numPoints <= 0)
+    {
+        return;
+    }
+
+    if (mDimension != 2)
+    {
+        LogError("The dimension must be 2.");
+        std::fill(triangles, triangles + numPoints, -1);
+        if (barycentrics)
+        {
+            std::fill(barycentrics, barycentrics + 3 * numPoints,
+                (InputType)0);
+        }
+        return;
+    }
+
+    // The vertices as InputType for the grid and the barycentric
+    // coordinates.  The compute vertices were converted from InputType, so
+    // the conversion back is exact.
+    std::vector<Vector2<InputType>> vertices(mNumVertices);
+    double vmin[2], vmax[2];
+    for (int d = 0; d < 2; ++d)
+    {
+        vmin[d] = std::numeric_limits<double>::max();
+        vmax[d] = -std::numeric_limits<double>::max();
+    }
+    for (int i = 0; i < mNumVertices; ++i)
+    {
+        for (int d = 0; d < 2; ++d)
+        {
+            vertices[i][d] = (InputType)mComputeVertices[i][d];
+            double value = static_cast<double>(vertices[i][d]);
+            vmin[d] = std::min(vmin[d], value);
+            vmax[d] = std::max(vmax[d], value);
+        }
+    }
+
+    // The triangle grid has 2^kt cells per axis, where 2^{2kt} is in
+    // (T/4,T] for T triangles.  The queries are sorted on a grid with 2^ks
+    // cells per axis, where ks is the larger of kt and the level with about
+    // one to four queries per cell; the latter is at most 11 to bound the
+    // memory of the sort.  The buckets are the Hilbert indices of the cells
+    // of the sort grid.  The Hilbert curve visits the 2^{2m} cells of an
+    // aligned block of 2^m by 2^m cells consecutively, so bucket b is in
+    // the cell b >> (2*(ks-kt)) of the triangle grid, where the cells of
+    // that grid are numbered in the order the curve visits them.
+    int kt = 0;
+    while (4ll << (2 * kt) <= (int64_t)mNumTriangles)
+    {
+        ++kt;
+    }
+    int ks = 0;
+    while (ks < 11 && 4ll << (2 * ks) <= (int64_t)numPoints)
+    {
+        ++ks;
+    }
+    ks = std::max(ks, kt);
+    int const levelShift = 2 * (ks - kt);
+
+    int const gridSize = (1 << ks);
+    int const numCells = gridSize * gridSize;
+    double scale[2];
+    for (int d = 0; d < 2; ++d)
+    {
+        double extent = vmax[d] - vmin[d];
+        scale[d] = (extent > 0.0 ? gridSize / extent : 0.0);
+    }
+
+    // Walk the Hilbert curve of the sort grid to assign the buckets to the
+    // cells, using the iterative conversion of a curve index to the cell
+    // coordinates.
+    std::vector<int> cellBucket(numCells);
+    for (int bucket = 0; bucket < numCells; ++bucket)
+    {
+        int x = 0, y = 0;
+        for (int s = 1, index = bucket; s < gridSize; s *= 2, index /= 4)
+        {
+            int rx = 1 & (index / 2);
+            int ry = 1 & (index ^ rx);
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = s - 1 - x;
+                    y = s - 1 - y;
+                }
+                std::swap(x, y);
+            }
+            x += s * rx;
+            y += s * ry;
+        }
+        cellBucket[x + gridSize * y] = bucket;
+    }
+
+    auto getBucket = [&cellBucket, &vmin, &scale, gridSize](
+        Vector2<InputType> const& p)
+    {
+        int cell[2];
+        for (int d = 0; d < 2; ++d)
+        {
+            double q = (static_cast<double>(p[d]) - vmin[d]) * scale[d];
+            cell[d] = static_cast<int>(std::min(std::max(q, 0.0),
+                (double)(gridSize - 1)));
+        }
+        return cellBucket[cell[0] + gridSize * cell[1]];
+    };
+
+    // Each cell of the triangle grid stores a triangle whose centroid is in
+    // the cell, or -1 when there is no such triangle.
+    std::vector<int> cellTriangle(numCells >> levelShift, -1);
+    InputType const oneThird = ((InputType)1) / (InputType)3;
+    for (int t = 0; t < mNumTriangles; ++t)
+    {
+        int const* v = &mIndices[3 * t];
+        Vector2<InputType> centroid =
+            (vertices[v[0]] + vertices[v[1]] + vertices[v[2]]) * oneThird;
+        cellTriangle[getBucket(centroid) >> levelShift] = t;
+    }
+
+    // Sort the queries by bucket using a counting sort.
+    std::vector<int> offsets(numCells + 1, 0);
+    for (int i = 0; i < numPoints; ++i)
+    {
+        ++offsets[getBucket(points[i]) + 1];
+    }
+    for (int b = 0; b < numCells; ++b)
+    {
+        offsets[b + 1] += offsets[b];
+    }
+    std::vector<int> order(numPoints);
+    for (int i = 0; i < numPoints; ++i)
+    {
+        order[offsets[getBucket(points[i])]++] = i;
+    }
+
+    // Consecutive cells along the Hilbert curve are adjacent, so the walk
+    // starts at the final triangle of the previous query unless the curve
+    // skipped over empty cells.
+    auto task = [this, points, triangles, barycentrics, &vertices, &order,
+        &cellTriangle, &getBucket, levelShift](int imin, int imax)
+    {
+        int previousBucket = -2, previousTriangle = 0;
+        for (int j = imin; j < imax; ++j)
+        {
+            int const i = order[j];
+            Vector2<InputType> const& p = points[i];
+            int const bucket = getBucket(p);
+            int start = previousTriangle;
+            if (bucket > previousBucket + 1)
+            {
+                int candidate = cellTriangle[bucket >> levelShift];
+                if (candidate >= 0)
+                {
+                    start = candidate;
+                }
+            }
+
+            Vector2<ComputeType> test(p[0], p[1]);
+            int triangle = Walk(test, start, previousTriangle);
+            previousBucket = bucket;
+            triangles[i] = triangle;
+
+            if (barycentrics)
+            {
+                InputType* bary = &barycentrics[3 * i];
+                if (triangle >= 0)
+                {
+                    int const* v = &mIndices[3 * triangle];
+                    ComputeBarycentrics(p, vertices[v[0]], vertices[v[1]],
+                        vertices[v[2]], bary);
+                }
+                else
+                {
+                    bary[0] = (InputType)0;
+                    bary[1] = (InputType)0;
+                    bary[2] = (InputType)0;
+                }
+            }
+        }
+    };
+
+    // The threads share mQuery, whose queries have no side effects other
+    // than the atomic filter counts.
+    ParallelFor::Execute(numPoints, numThreads, task);
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
 bool Delaunay2<InputType, ComputeType>::GetContainingTriangle(int i,
     Triangle*& tri) const
 {
@@ -480,8 +689,12 @@ void Delaunay2<InputType, ComputeType>::GetAndRemoveInsertionPolygon(int i,
 template <typename InputType, typename ComputeType>
 void Delaunay2<InputType, ComputeType>::Update(int i)
 {
+    // The triangles created by the previous update are not removed until
+    // this one, so the most recently created triangle is a valid starting
+    // point for the search.  It is null when the previous update removed
+    // triangles but inserted none.
     auto const& tmap = mGraph.GetTriangles();
-    Triangle* tri = tmap.begin()->second;
+    Triangle* tri = (mLastTriangle ? mLastTriangle : tmap.begin()->second);
     if (GetContainingTriangle(i, tri))
     {
         // The point is inside the convex hull.  The insertion polygon
@@ -499,6 +712,10 @@ void Delaunay2<InputType, ComputeType>::Update(int i)
         std::set<EdgeKey<true>> boundary;
         GetAndRemoveInsertionPolygon(i, candidates, boundary);
 
+        // The removed triangles might include mLastTriangle, so it is reset
+        // and then set only by a successful insertion.
+        mLastTriangle = nullptr;
+
         // The insertion polygon consists of the triangles formed by
         // point i and the faces of C.
         for (auto const& key : boundary)
@@ -507,7 +724,11 @@ void Delaunay2<InputType, ComputeType>::Update(int i)
             int v1 = key.V[1];
             if (mQuery.ToLine(i, v0, v1) < 0)
             {
-                mGraph.Insert(i, v0, v1);
+                Triangle* inserted = mGraph.Insert(i, v0, v1);
+                if (inserted)
+                {
+                    mLastTriangle = inserted;
+                }
             }
             // else:  Point i is on an edge of 'tri', so the
             // subdivision has degenerate triangles.  Ignore these.
@@ -578,6 +799,7 @@ void Delaunay2<InputType, ComputeType>::Update(int i)
         // triangles whose circumcircles contain point i.
         std::set<EdgeKey<true>> boundary;
         GetAndRemoveInsertionPolygon(i, candidates, boundary);
+        mLastTriangle = nullptr;
 
         // The insertion polygon P consists of the triangles formed by point i
         // and the back edges of C *and* the visible edges of mGraph-C.
@@ -588,14 +810,65 @@ void Delaunay2<InputType, ComputeType>::Update(int i)
             if (mQuery.ToLine(i, v0, v1) < 0)
             {
                 // This is a back edge of the boundary.
-                mGraph.Insert(i, v0, v1);
+                Triangle* inserted = mGraph.Insert(i, v0, v1);
+                if (inserted)
+                {
+                    mLastTriangle = inserted;
+                }
             }
         }
         for (auto const& key : visible)
         {
-            mGraph.Insert(i, key.V[1], key.V[0]);
+            Triangle* inserted = mGraph.Insert(i, key.V[1], key.V[0]);
+            if (inserted)
+            {
+                mLastTriangle = inserted;
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+int Delaunay2<InputType, ComputeType>::Walk(Vector2<ComputeType> const& test,
+    int triangle, int& finalTriangle) const
+{
+    // Use triangle edges as binary separating lines.  The test point is
+    // strictly to the left of the edge through which the walk entered the
+    // current triangle, so that edge is skipped.
+    int entryEdge = -1;
+    for (int i = 0; i < mNumTriangles; ++i)
+    {
+        int const ibase = 3 * triangle;
+        int const* v = &mIndices[ibase];
+        int j;
+        for (j = 0; j < 3; ++j)
+        {
+            if (j != entryEdge
+                && mQuery.ToLine(test, v[mIndex[j][0]], v[mIndex[j][1]]) > 0)
+            {
+                break;
+            }
+        }
+
+        finalTriangle = triangle;
+        if (j == 3)
+        {
+            return triangle;
         }
+
+        int adjacent = mAdjacencies[ibase + j];
+        if (adjacent == -1)
+        {
+            return -1;
+        }
+
+        int const* a = &mAdjacencies[3 * adjacent];
+        entryEdge = (a[0] == triangle ? 0 : (a[1] == triangle ? 1 : 2));
+        triangle = adjacent;
     }
+
+    LogError("Unexpected termination of Walk.");
+    return -1;
 }
 //----------------------------------------------------------------------------
 template <typename InputType, typename ComputeType>
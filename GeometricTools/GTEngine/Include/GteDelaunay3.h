@@ -7,11 +7,15 @@
 
 #pragma once
 
+#include "GteBRIO.h"
+#include "GteTSIndexedManifoldMesh.h"
 #include "GteTSManifoldMesh.h"
+#include "GteTetrahedronKey.h"
 #include "GteLine3.h"
 #include "GtePlane3.h"
 #include "GtePrimalQuery3.h"
 #include "GteLogger.h"
+#include <memory>
 #include <vector>
 
 // Delaunay tetrahedralization of points (intrinsic dimensionality 3).
@@ -52,6 +56,12 @@
 // be exact) is to choose ComputeType for exact rational arithmetic.  You may
 // use BSNumber.  No divisions are performed in this computation, so you do
 // not have to use BSRational.
+//
+// The tetrahedralization is maintained by a TSIndexedManifoldMesh, so the
+// tetrahedra are referenced by integer handles whose storage is recycled
+// during the incremental insertions.  The searches for the insertion
+// polyhedra use scratch buffers that are members of the class, so they are
+// reused across the insertions and across calls to operator().
 
 namespace gte
 {
@@ -69,8 +79,16 @@ public:
     // dimensionality of the vertices (d = 0, 1, 2, or 3).  When epsilon is
     // positive, the determination is fuzzy--vertices approximately the same
     // point, approximately on a line, approximately planar, or volumetric.
+    //
+    // The vertices are inserted in the order they occur in the input unless
+    // 'useBRIO' is 'true', in which case they are inserted in a biased
+    // randomized insertion order (see GteBRIO.h).  The latter is much faster
+    // for large inputs, because each point location starts at the most
+    // recently created tetrahedron and the BRIO order keeps the walks short.
+    // The tetrahedralization is the same in both cases for points in general
+    // position, but the tetrahedron ordering of GetIndices() differs.
     bool operator()(int numVertices, Vector3<InputType> const* vertices,
-        InputType epsilon);
+        InputType epsilon, bool useBRIO = false);
 
     // Dimensional information.  If GetDimension() returns 1, the points lie
     // on a line P+t*D (fuzzy comparison when epsilon > 0).  You can sort
@@ -90,10 +108,17 @@ public:
     inline int GetNumUniqueVertices() const;
     inline int GetNumTetrahedra() const;
     inline PrimalQuery3<ComputeType> const& GetQuery() const;
-    inline TSManifoldMesh const& GetGraph() const;
     inline std::vector<int> const& GetIndices() const;
     inline std::vector<int> const& GetAdjacencies() const;
 
+    // The tetrahedralization is computed in a TSIndexedManifoldMesh, which
+    // GetIndexedGraph() returns.  GetGraph() returns the tetrahedralization
+    // as a TSManifoldMesh.  That mesh is built from GetIndices() on the
+    // first call after operator() and is kept until the next operator(), so
+    // the first call is not thread-safe.
+    inline TSIndexedManifoldMesh const& GetIndexedGraph() const;
+    TSManifoldMesh const& GetGraph() const;
+
     // Locate those tetrahedra faces that do not share other tetrahedra.  The
     // returned array has hull.size() = 3*numFaces indices, each triple
     // representing a triangle.  The triangles are counterclockwise ordered
@@ -142,13 +167,18 @@ public:
         SearchInfo& info) const;
 
 private:
-    // Support for incremental Delaunay tetrahedralization.
-    typedef TSManifoldMesh::Tetrahedron Tetrahedron;
-    bool GetContainingTetrahedron(int i, Tetrahedron*& tetra) const;
-    void GetAndRemoveInsertionPolyhedron(int i,
-        std::set<Tetrahedron*>& candidates,
-        std::set<TriangleKey<true>>& boundary);
-    void Update (int i);
+    // Support for incremental Delaunay tetrahedralization.  The input
+    // 'tetra' to GetContainingTetrahedron is the handle of the tetrahedron
+    // at which the search starts.  On return it is the handle of the
+    // containing tetrahedron when the function returns 'true' or the handle
+    // of a tetrahedron with a hull face visible to point i when the function
+    // returns 'false'.  GetAndRemoveInsertionPolyhedron starts with the
+    // tetrahedra in mCavity (each with mMark set to 1), removes the
+    // insertion polyhedron from the mesh and stores its boundary faces in
+    // mBoundary.
+    bool GetContainingTetrahedron(int i, int& tetra) const;
+    void GetAndRemoveInsertionPolyhedron(int i);
+    void Update(int i);
 
     // The epsilon value is used for fuzzy determination of intrinsic
     // dimensionality.  If the dimension is 0, 1, or 2, the constructor
@@ -174,9 +204,25 @@ private:
     int mNumVertices;
     int mNumUniqueVertices;
     int mNumTetrahedra;
-    TSManifoldMesh mGraph;
+    TSIndexedManifoldMesh mGraph;
     std::vector<int> mIndices;
     std::vector<int> mAdjacencies;
+    mutable std::shared_ptr<TSManifoldMesh> mPointerGraph;
+
+    // The handle of the most recently created tetrahedron, used as the
+    // starting point for the point-location walks.
+    int mLastTetrahedron;
+
+    // Scratch buffers for Update.  mMark is indexed by tetrahedron handle;
+    // it is 1 for the tetrahedra of the insertion polyhedron (listed in
+    // mCavity), 2 for the tetrahedra whose circumspheres were tested and do
+    // not contain the point (listed in mRejected), and 0 otherwise.  The
+    // marks are all zero between calls to Update.
+    std::vector<int> mCavity;
+    std::vector<int> mRejected;
+    std::vector<char> mMark;
+    std::vector<std::array<int, 3>> mBoundary;
+    std::vector<std::array<int, 3>> mVisible;
 };
 
 #include "GteDelaunay3.inl"
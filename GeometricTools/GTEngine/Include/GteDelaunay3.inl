@@ -15,13 +15,14 @@ Delaunay3<InputType, ComputeType>::Delaunay3()
     mPlane(Vector3<InputType>::Zero(), (InputType)0),
     mNumVertices(0),
     mNumUniqueVertices(0),
-    mNumTetrahedra(0)
+    mNumTetrahedra(0),
+    mLastTetrahedron(-1)
 {
 }
 //----------------------------------------------------------------------------
 template <typename InputType, typename ComputeType>
 bool Delaunay3<InputType, ComputeType>::operator()(int numVertices,
-    Vector3<InputType> const* vertices, InputType epsilon)
+    Vector3<InputType> const* vertices, InputType epsilon, bool useBRIO)
 {
     mEpsilon = std::max(epsilon, (InputType)0);
     mDimension = 0;
@@ -32,9 +33,11 @@ bool Delaunay3<InputType, ComputeType>::operator()(int numVertices,
     mNumVertices = numVertices;
     mNumUniqueVertices = 0;
     mNumTetrahedra = 0;
-    mGraph = TSManifoldMesh();
+    mGraph.Clear();
+    mLastTetrahedron = -1;
     mIndices.clear();
     mAdjacencies.clear();
+    mPointerGraph = nullptr;
 
     int i, j;
     if (mNumVertices < 4)
@@ -71,7 +74,6 @@ bool Delaunay3<InputType, ComputeType>::operator()(int numVertices,
 
     // Compute the vertices for the queries.
     mComputeVertices.resize(mNumVertices);
-    mQuery.Set(mNumVertices, &mComputeVertices[0]);
     for (i = 0; i < mNumVertices; ++i)
     {
         for (j = 0; j < 3; ++j)
@@ -79,6 +81,12 @@ bool Delaunay3<InputType, ComputeType>::operator()(int numVertices,
             mComputeVertices[i][j] = vertices[i][j];
         }
     }
+    mQuery.Set(mNumVertices, &mComputeVertices[0]);
+
+    // A tetrahedralization of n points in general position has on average
+    // about 6.5*n tetrahedra, so reserve enough storage that the mesh arrays
+    // are not reallocated during the incremental updates.
+    mGraph.Reserve(7 * mNumVertices);
 
     // Insert the (nondegenerate) tetrahedron constructed by the call to
     // GetInformation. This is necessary for the circumsphere-visibility
@@ -87,51 +95,74 @@ bool Delaunay3<InputType, ComputeType>::operator()(int numVertices,
     {
         std::swap(info.extreme[2], info.extreme[3]);
     }
-    mGraph.Insert(info.extreme[0], info.extreme[1], info.extreme[2],
-        info.extreme[3]);
+    mLastTetrahedron = mGraph.Insert(info.extreme[0], info.extreme[1],
+        info.extreme[2], info.extreme[3]);
 
-    // Incrementally update the tetrahedralization.  The set of processed
-    // points is maintained to eliminate duplicates, either in the original
-    // input points or in the points obtained by snap rounding.
+    // The set of processed points is maintained to eliminate duplicates,
+    // either in the original input points or in the points obtained by snap
+    // rounding.  The unique points other than the initial tetrahedron
+    // vertices are the ones to insert.
     std::set<Vector3<InputType>> processed;
     for (i = 0; i < 4; ++i)
     {
         processed.insert(vertices[info.extreme[i]]);
     }
+    std::vector<int> insertions;
+    insertions.reserve(mNumVertices);
     for (i = 0; i < mNumVertices; ++i)
     {
         if (processed.find(vertices[i]) == processed.end())
         {
-            Update(i);
+            insertions.push_back(i);
             processed.insert(vertices[i]);
         }
     }
     mNumUniqueVertices = static_cast<int>(processed.size());
 
-    // Assign integer values to the tetrahedra for use by the caller.
-    std::map<Tetrahedron*, int> permute;
-    i = -1;
-    permute[nullptr] = i++;
-    for (auto const& element : mGraph.GetTetrahedra())
+    // Incrementally update the tetrahedralization.
+    if (useBRIO)
+    {
+        BRIO<3, InputType> brio;
+        brio(vertices, insertions);
+    }
+    for (auto index : insertions)
+    {
+        Update(index);
+    }
+
+    // Assign integer values to the tetrahedra for use by the caller.  The
+    // handles of removed tetrahedra map to -1, but they are never
+    // referenced by the valid tetrahedra.
+    int numHandles = mGraph.GetNumHandles();
+    std::vector<int> permute(numHandles, -1);
+    for (int t = 0, k = 0; t < numHandles; ++t)
     {
-        permute[element.second] = i++;
+        if (mGraph.IsValid(t))
+        {
+            permute[t] = k++;
+        }
     }
 
     // Put Delaunay tetrahedra into an array (vertices and adjacency info).
-    mNumTetrahedra = static_cast<int>(mGraph.GetTetrahedra().size());
+    mNumTetrahedra = mGraph.GetNumTetrahedra();
     int numIndices = 4 * mNumTetrahedra;
     if (mNumTetrahedra > 0)
     {
+        auto const& tetraV = mGraph.GetVertices();
+        auto const& tetraS = mGraph.GetAdjacents();
         mIndices.resize(numIndices);
         mAdjacencies.resize(numIndices);
         i = 0;
-        for (auto const& element : mGraph.GetTetrahedra())
+        for (int t = 0; t < numHandles; ++t)
         {
-            Tetrahedron const* tetra = element.second;
-            for (j = 0; j < 4; ++j, ++i)
+            if (mGraph.IsValid(t))
             {
-                mIndices[i] = tetra->V[j];
-                mAdjacencies[i] = permute[tetra->S[j]];
+                for (j = 0; j < 4; ++j, ++i)
+                {
+                    mIndices[i] = tetraV[t][j];
+                    int adj = tetraS[t][j];
+                    mAdjacencies[i] = (adj >= 0 ? permute[adj] : -1);
+                }
             }
         }
     }
@@ -189,11 +220,27 @@ Delaunay3<InputType, ComputeType>::GetQuery() const
 }
 //----------------------------------------------------------------------------
 template <typename InputType, typename ComputeType> inline
-TSManifoldMesh const& Delaunay3<InputType, ComputeType>::GetGraph() const
+TSIndexedManifoldMesh const&
+Delaunay3<InputType, ComputeType>::GetIndexedGraph() const
 {
     return mGraph;
 }
 //----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+TSManifoldMesh const& Delaunay3<InputType, ComputeType>::GetGraph() const
+{
+    if (!mPointerGraph)
+    {
+        mPointerGraph = std::make_shared<TSManifoldMesh>();
+        for (int t = 0, i = 0; t < mNumTetrahedra; ++t, i += 4)
+        {
+            mPointerGraph->Insert(mIndices[i], mIndices[i + 1],
+                mIndices[i + 2], mIndices[i + 3]);
+        }
+    }
+    return *mPointerGraph;
+}
+//----------------------------------------------------------------------------
 template <typename InputType, typename ComputeType> inline
 std::vector<int> const& Delaunay3<InputType, ComputeType>::GetIndices() const
 {
@@ -429,37 +476,37 @@ int Delaunay3<InputType, ComputeType>::GetContainingTetrahedron(
 //----------------------------------------------------------------------------
 template <typename InputType, typename ComputeType>
 bool Delaunay3<InputType, ComputeType>::GetContainingTetrahedron(int i,
-    Tetrahedron*& tetra) const
+    int& tetra) const
 {
-    int numTetrahedra = static_cast<int>(mGraph.GetTetrahedra().size());
+    auto const& tetraV = mGraph.GetVertices();
+    auto const& tetraS = mGraph.GetAdjacents();
+    int numTetrahedra = mGraph.GetNumTetrahedra();
     for (int t = 0; t < numTetrahedra; ++t)
     {
         int j;
         for (j = 0; j < 4; ++j)
         {
             auto const& opposite = TetrahedronKey<true>::oppositeFace;
-            int v0 = tetra->V[opposite[j][0]];
-            int v1 = tetra->V[opposite[j][1]];
-            int v2 = tetra->V[opposite[j][2]];
+            int v0 = tetraV[tetra][opposite[j][0]];
+            int v1 = tetraV[tetra][opposite[j][1]];
+            int v2 = tetraV[tetra][opposite[j][2]];
             if (mQuery.ToPlane(i, v0, v1, v2) > 0)
             {
                 // Point i sees face <v0,v1,v2> from outside the tetrahedron.
-                if (tetra->S[j])
+                int adj = tetraS[tetra][j];
+                if (adj >= 0)
                 {
                     // Traverse to the tetrahedron sharing the face.
-                    tetra = tetra->S[j];
+                    tetra = adj;
                     break;
                 }
                 else
                 {
                     // We reached a hull face, so the point is outside the
-                    // hull.  TODO:  Once a hull data structure is in place,
-                    // return tetra->S[j] as the candidate for starting a
-                    // search for visible hull faces.
+                    // hull.
                     return false;
                 }
             }
-
         }
 
         if (j == 4)
@@ -475,91 +522,132 @@ bool Delaunay3<InputType, ComputeType>::GetContainingTetrahedron(int i,
 }
 //----------------------------------------------------------------------------
 template <typename InputType, typename ComputeType>
-void Delaunay3<InputType, ComputeType>::GetAndRemoveInsertionPolyhedron(int i,
-    std::set<Tetrahedron*>& candidates, std::set<TriangleKey<true>>& boundary)
+void Delaunay3<InputType, ComputeType>::GetAndRemoveInsertionPolyhedron(
+    int i)
 {
-    // Locate the tetrahedra that make up the insertion polyhedron.
-    TSManifoldMesh polyhedron;
-    while (candidates.size() > 0)
+    auto const& tetraV = mGraph.GetVertices();
+    auto const& tetraS = mGraph.GetAdjacents();
+    auto const& opposite = TetrahedronKey<true>::oppositeFace;
+
+    // Locate the tetrahedra that make up the insertion polyhedron.  The
+    // array mCavity grows during the breadth-first search.  A tetrahedron
+    // whose circumsphere does not contain point i is marked so that it is
+    // tested only once.
+    for (size_t c = 0; c < mCavity.size(); ++c)
     {
-        Tetrahedron* tetra = *candidates.begin();
-        candidates.erase(candidates.begin());
-
+        int tetra = mCavity[c];
         for (int j = 0; j < 4; ++j)
         {
-            Tetrahedron* adj = tetra->S[j];
-            if (adj && candidates.find(adj) == candidates.end())
+            int adj = tetraS[tetra][j];
+            if (adj >= 0 && mMark[adj] == 0)
             {
-                int a0 = adj->V[0];
-                int a1 = adj->V[1];
-                int a2 = adj->V[2];
-                int a3 = adj->V[3];
+                int a0 = tetraV[adj][0];
+                int a1 = tetraV[adj][1];
+                int a2 = tetraV[adj][2];
+                int a3 = tetraV[adj][3];
                 if (mQuery.ToCircumsphere(i, a0, a1, a2, a3) <= 0)
                 {
                     // Point i is in the circumsphere.
-                    candidates.insert(adj);
+                    mMark[adj] = 1;
+                    mCavity.push_back(adj);
+                }
+                else
+                {
+                    mMark[adj] = 2;
+                    mRejected.push_back(adj);
                 }
             }
         }
-
-        int v0 = tetra->V[0];
-        int v1 = tetra->V[1];
-        int v2 = tetra->V[2];
-        int v3 = tetra->V[3];
-        polyhedron.Insert(v0, v1, v2, v3);
-        mGraph.Remove(v0, v1, v2, v3);
     }
 
-    // Get the boundary triangles of the insertion polyhedron.
-	for (auto const& element : polyhedron.GetTetrahedra())
+    // Get the boundary triangles of the insertion polyhedron.  These are
+    // the faces not shared with another tetrahedron of the polyhedron.
+    mBoundary.clear();
+    for (auto tetra : mCavity)
     {
-        Tetrahedron const* tetra = element.second;
         for (int j = 0; j < 4; ++j)
         {
-            if (!tetra->S[j])
+            int adj = tetraS[tetra][j];
+            if (adj < 0 || mMark[adj] != 1)
             {
-                auto const& opposite = TetrahedronKey<true>::oppositeFace;
-                int v0 = tetra->V[opposite[j][0]];
-                int v1 = tetra->V[opposite[j][1]];
-                int v2 = tetra->V[opposite[j][2]];
-                boundary.insert(TriangleKey<true>(v0, v1, v2));
+                std::array<int, 3> face;
+                face[0] = tetraV[tetra][opposite[j][0]];
+                face[1] = tetraV[tetra][opposite[j][1]];
+                face[2] = tetraV[tetra][opposite[j][2]];
+                mBoundary.push_back(face);
             }
         }
     }
+
+    // Remove the insertion polyhedron from the mesh and restore the marks
+    // to zero for the next update.
+    for (auto tetra : mCavity)
+    {
+        mMark[tetra] = 0;
+        mGraph.Remove(tetra);
+    }
+    for (auto tetra : mRejected)
+    {
+        mMark[tetra] = 0;
+    }
+    mCavity.clear();
+    mRejected.clear();
 }
 //----------------------------------------------------------------------------
 template <typename InputType, typename ComputeType>
 void Delaunay3<InputType, ComputeType>::Update(int i)
 {
-    auto const& smap = mGraph.GetTetrahedra();
-    Tetrahedron* tetra = smap.begin()->second;
+    // The marks are indexed by tetrahedron handle.  The handles are
+    // recycled, so the array grows only when the mesh does.
+    int numHandles = mGraph.GetNumHandles();
+    if (static_cast<int>(mMark.size()) < numHandles)
+    {
+        mMark.resize(numHandles, 0);
+    }
+
+    if (!mGraph.IsValid(mLastTetrahedron))
+    {
+        for (mLastTetrahedron = 0; mLastTetrahedron < numHandles;
+            ++mLastTetrahedron)
+        {
+            if (mGraph.IsValid(mLastTetrahedron))
+            {
+                break;
+            }
+        }
+    }
+
+    int tetra = mLastTetrahedron;
     if (GetContainingTetrahedron(i, tetra))
     {
         // The point is inside the convex hull.  The insertion polyhedron
         // contains only tetrahedra in the current tetrahedralization; the
         // hull does not change.
 
-        // Use a depth-first search for those tetrahedra whose circumspheres
-        // contain point i.
-        std::set<Tetrahedron*> candidates;
-        candidates.insert(tetra);
+        // Use a breadth-first search for those tetrahedra whose
+        // circumspheres contain point i.
+        mMark[tetra] = 1;
+        mCavity.push_back(tetra);
 
         // Get the boundary of the insertion polyhedron C that contains the
         // tetrahedra whose circumspheres contain point i.  C contains the
         // point i.
-        std::set<TriangleKey<true>> boundary;
-        GetAndRemoveInsertionPolyhedron(i, candidates, boundary);
+        GetAndRemoveInsertionPolyhedron(i);
 
         // The insertion polyhedron consists of the tetrahedra formed by
         // point i and the faces of C.
-        for (auto const& key : boundary)
+        for (auto const& face : mBoundary)
         {
-            int v0 = key.V[0];
-            int v1 = key.V[1];
-            int v2 = key.V[2];
+            int v0 = face[0];
+            int v1 = face[1];
+            int v2 = face[2];
             if (mQuery.ToPlane(i, v0, v1, v2) < 0)
             {
-                mGraph.Insert(i, v0, v1, v2);
+                int inserted = mGraph.Insert(i, v0, v1, v2);
+                if (inserted >= 0)
+                {
+                    mLastTetrahedron = inserted;
+                }
             }
             // else:  Point i is on an edge or face of 'tetra', so the
             // subdivision has degenerate tetrahedra.  Ignore these.
@@ -571,60 +659,58 @@ void Delaunay3<InputType, ComputeType>::Update(int i)
         // is formed by point i and any tetrahedra in the current
         // tetrahedralization whose circumspheres contain point i.
 
-        // Locate the convex hull of the tetrahedra.  TODO:  Maintain a hull
-        // data structure that is updated incrementally.
-        std::set<TriangleKey<true>> hull;
-        for (auto const& element : smap)
+        // TODO:  Maintain a hull data structure that is updated
+        // incrementally.  For now just iterate over all the hull faces and
+        // use the ones visible to point i to locate the insertion
+        // polyhedron.
+        auto const& tetraV = mGraph.GetVertices();
+        auto const& tetraS = mGraph.GetAdjacents();
+        auto const& opposite = TetrahedronKey<true>::oppositeFace;
+        mVisible.clear();
+        for (int t = 0; t < numHandles; ++t)
         {
-            Tetrahedron const* tetra = element.second;
+            if (!mGraph.IsValid(t))
+            {
+                continue;
+            }
+
             for (int j = 0; j < 4; ++j)
             {
-                if (!tetra->S[j])
+                if (tetraS[t][j] >= 0)
                 {
-                    auto const& opposite = TetrahedronKey<true>::oppositeFace;
-                    int v0 = tetra->V[opposite[j][0]];
-                    int v1 = tetra->V[opposite[j][1]];
-                    int v2 = tetra->V[opposite[j][2]];
-                    hull.insert(TriangleKey<true>(v0, v1, v2));
+                    continue;
                 }
-            }
-        }
 
-        // TODO:  Until the hull change, for now just iterate over all the
-        // hull faces and use the ones visible to point i to locate the
-        // insertion polyhedron.
-        auto const& tmap = mGraph.GetTriangles();
-        std::set<Tetrahedron*> candidates;
-        std::set<TriangleKey<true>> visible;
-        for (auto const& key : hull)
-        {
-            int v0 = key.V[0];
-            int v1 = key.V[1];
-            int v2 = key.V[2];
-            if (mQuery.ToPlane(i, v0, v1, v2) > 0)
-            {
-                auto iter = tmap.find(TriangleKey<false>(v0, v1, v2));
-                LogAssert(iter != tmap.end(),
-                    "Unexpected condition.");
-                LogAssert(iter->second->T[1] == nullptr,
-                    "Unexpected condition.");
-                Tetrahedron* adj = iter->second->T[0];
-                if (adj && candidates.find(adj) == candidates.end())
+                int v0 = tetraV[t][opposite[j][0]];
+                int v1 = tetraV[t][opposite[j][1]];
+                int v2 = tetraV[t][opposite[j][2]];
+                if (mQuery.ToPlane(i, v0, v1, v2) > 0)
                 {
-                    int a0 = adj->V[0];
-                    int a1 = adj->V[1];
-                    int a2 = adj->V[2];
-                    int a3 = adj->V[3];
-                    if (mQuery.ToCircumsphere(i, a0, a1, a2, a3) <= 0)
+                    if (mMark[t] == 0)
                     {
-                        // Point i is in the circumsphere.
-                        candidates.insert(adj);
+                        int a0 = tetraV[t][0];
+                        int a1 = tetraV[t][1];
+                        int a2 = tetraV[t][2];
+                        int a3 = tetraV[t][3];
+                        if (mQuery.ToCircumsphere(i, a0, a1, a2, a3) <= 0)
+                        {
+                            // Point i is in the circumsphere.
+                            mMark[t] = 1;
+                            mCavity.push_back(t);
+                        }
+                        else
+                        {
+                            mMark[t] = 2;
+                            mRejected.push_back(t);
+                        }
                     }
-                    else
+
+                    if (mMark[t] == 2)
                     {
                         // Point i is not in the circumsphere but the hull
                         // face is visible.
-                        visible.insert(key);
+                        std::array<int, 3> face = {{ v0, v1, v2 }};
+                        mVisible.push_back(face);
                     }
                 }
             }
@@ -632,26 +718,33 @@ void Delaunay3<InputType, ComputeType>::Update(int i)
 
         // Get the boundary of the insertion subpolyhedron C that contains the
         // tetrahedra whose circumspheres contain point i.
-        std::set<TriangleKey<true>> boundary;
-        GetAndRemoveInsertionPolyhedron(i, candidates, boundary);
+        GetAndRemoveInsertionPolyhedron(i);
 
         // The insertion polyhedron P consists of the tetrahedra formed by
         // point i and the back faces of C *and* the visible faces of
         // mGraph-C.
-        for (auto const& key : boundary)
+        for (auto const& face : mBoundary)
         {
-            int v0 = key.V[0];
-            int v1 = key.V[1];
-            int v2 = key.V[2];
+            int v0 = face[0];
+            int v1 = face[1];
+            int v2 = face[2];
             if (mQuery.ToPlane(i, v0, v1, v2) < 0)
             {
                 // This is a back face of the boundary.
-                mGraph.Insert(i, v0, v1, v2);
+                int inserted = mGraph.Insert(i, v0, v1, v2);
+                if (inserted >= 0)
+                {
+                    mLastTetrahedron = inserted;
+                }
             }
         }
-        for (auto const& key : visible)
+        for (auto const& face : mVisible)
         {
-            mGraph.Insert(i, key.V[0], key.V[2], key.V[1]);
+            int inserted = mGraph.Insert(i, face[0], face[2], face[1]);
+            if (inserted >= 0)
+            {
+                mLastTetrahedron = inserted;
+            }
         }
     }
 }
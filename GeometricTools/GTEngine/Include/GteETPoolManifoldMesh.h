@@ -0,0 +1,176 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include "GteEdgeKey.h"
+#include "GteTriangleKey.h"
+#include <string>
+#include <vector>
+
+// An edge-triangle manifold mesh with the same topological semantics as
+// ETManifoldMesh but designed for meshes with millions of triangles.  The
+// Edge and Triangle objects are allocated from pools owned by the mesh, so
+// Insert and Remove do not call the global allocator once the pools are
+// large enough; use Reserve(numTriangles) to size the pools (and the lookup
+// tables) before a bulk insertion.  The edges and triangles are located by
+// open-addressing hash tables (linear probing with backward-shift deletion)
+// rather than by std::map, and the number of boundary edges is maintained
+// incrementally so that IsClosed() is O(1).
+//
+// The price for the speed is that the Edge and Triangle classes cannot be
+// derived from (there are no creator callbacks) and the iteration order of
+// GetEdges() and GetTriangles() is that of the hash tables, not the sorted
+// order of the keys.
+
+namespace gte
+{
+
+class GTE_IMPEXP ETPoolManifoldMesh
+{
+public:
+    class Edge;
+    class Triangle;
+
+    // Edge object.
+    class GTE_IMPEXP Edge
+    {
+    public:
+        // Vertices of the edge.
+        int V[2];
+
+        // Triangles sharing the edge.
+        Triangle* T[2];
+    };
+
+    // Triangle object.
+    class GTE_IMPEXP Triangle
+    {
+    public:
+        // Vertices, listed in counterclockwise order (V[0],V[1],V[2]).
+        int V[3];
+
+        // Adjacent edges.  E[i] points to edge (V[i],V[(i+1)%3]).
+        Edge* E[3];
+
+        // Adjacent triangles.  T[i] points to the adjacent triangle
+        // sharing edge E[i].
+        Triangle* T[3];
+    };
+
+    // Slots of the hash tables.  A slot is unused when its pointer is null.
+    struct ESlot
+    {
+        EdgeKey<false> key;
+        Edge* edge;
+    };
+
+    struct TSlot
+    {
+        TriangleKey<true> key;
+        Triangle* triangle;
+    };
+
+    // Construction and destruction.  The input is passed to Reserve.
+    ~ETPoolManifoldMesh();
+    ETPoolManifoldMesh(int numTriangles = 0);
+
+    // Grow the pools and hash tables so that a mesh with the specified
+    // number of triangles can be built without further allocations.  A
+    // manifold mesh has at most 3*numTriangles edges.  The call never
+    // shrinks the storage.
+    void Reserve(int numTriangles);
+
+    // Remove all edges and triangles.  The pool and table storage is
+    // retained for reuse.
+    void Clear();
+
+    // Member access.  The tables are returned as-is, so skip the slots
+    // whose pointers are null when iterating.
+    inline int GetNumEdges() const;
+    inline int GetNumTriangles() const;
+    inline std::vector<ESlot> const& GetEdges() const;
+    inline std::vector<TSlot> const& GetTriangles() const;
+
+    // If <v0,v1,v2> is not in the mesh, a Triangle object is created and
+    // returned; otherwise, <v0,v1,v2> is in the mesh and nullptr is returned.
+    // If the insertion leads to a nonmanifold mesh, the call fails with a
+    // nullptr returned.
+    Triangle* Insert(int v0, int v1, int v2);
+
+    // If <v0,v1,v2> is in the mesh, it is removed and 'true' is returned;
+    // otherwise, <v0,v1,v2> is not in the mesh and 'false' is returned.
+    bool Remove(int v0, int v1, int v2);
+
+    // A manifold mesh is closed if each edge is shared twice.
+    inline bool IsClosed() const;
+
+    // For debugging.  The function returns 'true' iff the text file has been
+    // created and saved.
+    bool Print(std::string const& filename);
+
+private:
+    // The edge and triangle pointers are owned by the pools, so copying a
+    // mesh is not supported.
+    ETPoolManifoldMesh(ETPoolManifoldMesh const&);
+    ETPoolManifoldMesh& operator=(ETPoolManifoldMesh const&);
+
+    // Storage for objects that is allocated in blocks.  The blocks are never
+    // resized, so the object addresses are stable for the life of the pool.
+    template <typename Object>
+    class Pool
+    {
+    public:
+        Pool();
+        Object* Allocate();
+        void Free(Object* object);
+        void Reserve(int numObjects);
+        void Clear();
+
+    private:
+        std::vector<std::vector<Object>> mBlocks;
+        std::vector<Object*> mFree;
+        size_t mCurrentBlock, mNumUsed;
+    };
+
+    // Hash functions for the keys.  The table sizes are powers of two, so
+    // the hash values are masked to obtain the home slots.
+    static unsigned int Hash(EdgeKey<false> const& key);
+    static unsigned int Hash(TriangleKey<true> const& key);
+
+    // Table lookups.  The functions return the index of the slot containing
+    // the key or, if the key is not in the table, the index of the empty
+    // slot at which the key would be inserted.
+    size_t Find(EdgeKey<false> const& key) const;
+    size_t Find(TriangleKey<true> const& key) const;
+
+    // Table insertion (after Find returned an empty slot) and deletion.
+    // The tables grow when the load factor exceeds 1/2.
+    void InsertEdge(size_t slot, EdgeKey<false> const& key, Edge* edge);
+    void InsertTriangle(size_t slot, TriangleKey<true> const& key,
+        Triangle* tri);
+    void RemoveEdge(size_t slot);
+    void RemoveTriangle(size_t slot);
+    void RehashEdges(size_t numSlots);
+    void RehashTriangles(size_t numSlots);
+
+    Pool<Edge> mEPool;
+    std::vector<ESlot> mETable;
+    int mNumEdges;
+
+    Pool<Triangle> mTPool;
+    std::vector<TSlot> mTTable;
+    int mNumTriangles;
+
+    // The number of edges shared by only one triangle.
+    int mNumBoundaryEdges;
+};
+
+#include "GteETPoolManifoldMesh.inl"
+
+}
@@ -0,0 +1,36 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+inline int ETPoolManifoldMesh::GetNumEdges() const
+{
+    return mNumEdges;
+}
+//----------------------------------------------------------------------------
+inline int ETPoolManifoldMesh::GetNumTriangles() const
+{
+    return mNumTriangles;
+}
+//----------------------------------------------------------------------------
+inline std::vector<ETPoolManifoldMesh::ESlot> const&
+ETPoolManifoldMesh::GetEdges() const
+{
+    return mETable;
+}
+//----------------------------------------------------------------------------
+inline std::vector<ETPoolManifoldMesh::TSlot> const&
+ETPoolManifoldMesh::GetTriangles() const
+{
+    return mTTable;
+}
+//----------------------------------------------------------------------------
+inline bool ETPoolManifoldMesh::IsClosed() const
+{
+    return mNumBoundaryEdges == 0;
+}
+//----------------------------------------------------------------------------
+
@@ -0,0 +1,68 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include <vector>
+
+// Exact Euclidean distance transform of a 1D, 2D, or 3D grid using the
+// separable algorithm of
+//   A. Meijster, J.B.T.M. Roerdink, and W.H. Hesselink,
+//   "A General Algorithm for Computing Distance Transforms in Linear Time",
+//   Mathematical Morphology and its Applications to Image and Signal
+//   Processing, Kluwer, 2000, pp. 331-340.
+// The squared distance is a sum of squares of the coordinate differences,
+// so it is computed one dimension at a time.  The pass for a dimension
+// replaces the values on each grid line parallel to that dimension by the
+// lower envelope of the parabolas (x-i)^2 + f(i), which takes linear time.
+// The grid lines of a pass are independent and are partitioned among the
+// threads.  A thread gathers blocks of adjacent lines into a buffer so that
+// the passes along dimensions 1 and 2 read and write whole cache lines.
+// This is the implementation of the GetExactL2Distance functions of
+// ImageUtility2 and ImageUtility3.
+
+namespace gte
+{
+
+class GTE_IMPEXP EuclideanDistanceTransform
+{
+public:
+    // The grid has numDimensions (1, 2, or 3) dimensions and its values are
+    // stored in row-major order.  The feature points are those for which
+    // image[i] is 0.  On output, distance[i] holds the squared distance from
+    // point i to its nearest feature point and, if 'nearest' is not null,
+    // nearest[i] is the index of that feature point.  The squared distances
+    // are integers that can exceed 2^24, so they are stored as the bit
+    // patterns of 'int' values in the 'float' storage until GetDistances
+    // converts them; they are read and written with memcpy.  When there are
+    // no feature points, the squared distances are INT_MAX and the indices
+    // are -1.  The squared distances must be representable as 'int', which
+    // is the case when the grid diagonal is smaller than 46340.
+    static void Execute(int numDimensions, int const dimensions[],
+        unsigned int numThreads, int const* image, float* distance,
+        int* nearest);
+
+    // Replace the squared distances computed by Execute with the distances.
+    // The function returns the maximum distance and the index of the first
+    // point at which the maximum is attained.
+    static void GetDistances(int numPoints, unsigned int numThreads,
+        float* distance, float& maxDistance, int& maxIndex);
+
+private:
+    // The lower envelope of the parabolas for one line of n values.  On
+    // output, f[i] is the minimum squared distance and source[i] is the
+    // position on the line that attains it, or -1 when all the inputs are
+    // INT_MAX.  The workspace must have 3*n values.
+    static void Transform1(int n, int* f, int* source, int* workspace);
+
+    // Access to the squared distances stored in the 'float' storage.
+    static int GetSqr(float const* distance, int i);
+    static void SetSqr(float* distance, int i, int sqrDistance);
+};
+
+}
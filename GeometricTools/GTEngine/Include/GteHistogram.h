@@ -25,15 +25,26 @@ public:
     // {0,1,...,numBuckets-1}, but in the event of out-of-range values, the
     // histogram stores a count for those numbers smaller than 0 and those
     // numbers larger or equal to numBuckets.
+    //
+    // The samples are partitioned among the threads, each thread counting
+    // its samples in private buckets that are summed at the end.  The
+    // bucket indices of a block of samples are computed with SSE2 before
+    // the buckets are incremented.
     Histogram (int numBuckets, int numSamples, int const* samples,
-        bool noRescaling);
-    Histogram (int numBuckets, int numSamples, float const* samples);
-    Histogram (int numBuckets, int numSamples, double const* samples);
+        bool noRescaling, unsigned int numThreads = 1);
+    Histogram (int numBuckets, int numSamples, float const* samples,
+        unsigned int numThreads = 1);
+    Histogram (int numBuckets, int numSamples, double const* samples,
+        unsigned int numThreads = 1);
 
     // Construction where you plan on updating the histogram incrementally.
-    // The incremental update is implemented only for integer samples and
-    // no rescaling.
+    // The first constructor maps the value v in {0,...,numBuckets-1} to
+    // bucket v.  The second constructor maps the values in the interval
+    // [minValue,maxValue] to the buckets as the sample constructors do for
+    // the sample extremes, which allows a histogram of a stream of images
+    // to be accumulated for a known range of values.
     Histogram (int numBuckets);
+    Histogram (int numBuckets, double minValue, double maxValue);
 
     // This function is called when you have used the Histogram(int)
     // constructor.  No bounds checking is used; you must ensure that the
@@ -44,29 +55,46 @@ public:
     // constructor.  Bounds checking is used.
     void InsertCheck (int value);
 
+    // Insert a batch of samples, mapped to the buckets by the range of the
+    // histogram:  [0,numBuckets-1] for the Histogram(int) constructor and
+    // for integer samples without rescaling, [minValue,maxValue] for the
+    // constructor with a range, and the extremes of the samples passed to
+    // the other constructors.  The samples outside the range are counted
+    // by the excess counters.
+    void Insert (int numSamples, int const* samples,
+        unsigned int numThreads = 1);
+    void Insert (int numSamples, float const* samples,
+        unsigned int numThreads = 1);
+    void Insert (int numSamples, double const* samples,
+        unsigned int numThreads = 1);
+
     // Member access.
     inline int GetNumBuckets () const;
     inline int const* GetBuckets () const;
     inline int GetExcessLess () const;
     inline int GetExcessGreater () const;
+    inline double GetMinValue () const;
+    inline double GetMaxValue () const;
 
     // In the following, define cdf(V) = sum_{i=0}^{V} bucket[i], where
     // 0 <= V < B and B is the number of buckets.  Define N = cdf(B-1),
-    // which must be the number of pixels in the image.
+    // which must be the number of pixels in the image.  N is maintained by
+    // the insertions, so a query scans only the buckets up to the tail.
+    inline int GetNumInBuckets () const;
 
     // Get the lower tail of the histogram.  The returned index L has the
     // properties:  cdf(L-1)/N < tailAmount and cdf(L)/N >= tailAmount.
-    int GetLowerTail (double tailAmount);
+    int GetLowerTail (double tailAmount) const;
 
     // Get the upper tail of the histogram.  The returned index U has the
     // properties:  cdf(U)/N >= 1-tailAmount and cdf(U+1) < 1-tailAmount.
-    int GetUpperTail (double tailAmount);
+    int GetUpperTail (double tailAmount) const;
 
     // Get the lower and upper tails of the histogram.  The returned indices
     // are L and U and have the properties:
     // cdf(L-1)/N < tailAmount/2, cdf(L)/N >= tailAmount/2,
     // cdf(U)/N >= 1-tailAmount/2, and cdf(U+1) < 1-tailAmount/2.
-    void GetTails (double tailAmount, int& lower, int& upper);
+    void GetTails (double tailAmount, int& lower, int& upper) const;
 
     // Save the histogram to a text file with two columns.  The first
     // column is the bucket index and the second column is the number of
@@ -79,9 +107,47 @@ public:
     void SaveAsImage (std::string const& name, int dimension0);
 
 private:
+    // Map the samples to the buckets using the range [mMinValue,mMaxValue].
+    // When checkRange is false, the samples must be in the range.
+    template <typename Real>
+    void Accumulate (int numSamples, Real const* samples, bool checkRange,
+        unsigned int numThreads);
+
+    // The mapping of samples to the slots of Accumulate.  The minimum and
+    // maximum are the range of the histogram, realMin and realMax are their
+    // values in the sample type, and mult = (numBuckets-1)/(realMax-realMin)
+    // or 0 for a constant range.
+    struct SlotRange
+    {
+        double minValue, maxValue, realMin, realMax, mult;
+        int numSlots;
+    };
+
+    // Compute the slots of a block of samples.  The bucket indices are
+    // computed with SSE2 for two (int, double) or four (float) samples at a
+    // time, with the same differences and truncation as GetSlot, which
+    // handles the remaining samples.
+    static void GetSlots (int numValues, int const* values, bool checkRange,
+        SlotRange const& range, int* slots);
+    static void GetSlots (int numValues, float const* values,
+        bool checkRange, SlotRange const& range, int* slots);
+    static void GetSlots (int numValues, double const* values,
+        bool checkRange, SlotRange const& range, int* slots);
+    static int GetSlot (double value, bool checkRange,
+        SlotRange const& range);
+    static int GetSlot (double value, double difference, bool checkRange,
+        SlotRange const& range);
+
+    // Compute the extremes of the samples.
+    template <typename Real>
+    static void GetExtremes (int numSamples, Real const* samples,
+        unsigned int numThreads, Real& minValue, Real& maxValue);
+
     int mNumBuckets;
     int* mBuckets;
     int mExcessLess, mExcessGreater;
+    int mNumInBuckets;
+    double mMinValue, mMaxValue;
 };
 
 #include "GteHistogram.inl"
@@ -9,6 +9,7 @@
 inline void Histogram::Insert (int value)
 {
     ++mBuckets[value];
+    ++mNumInBuckets;
 }
 //----------------------------------------------------------------------------
 inline int Histogram::GetNumBuckets () const
@@ -31,3 +32,18 @@ inline int Histogram::GetExcessGreater () const
     return mExcessGreater;
 }
 //----------------------------------------------------------------------------
+inline double Histogram::GetMinValue () const
+{
+    return mMinValue;
+}
+//----------------------------------------------------------------------------
+inline double Histogram::GetMaxValue () const
+{
+    return mMaxValue;
+}
+//----------------------------------------------------------------------------
+inline int Histogram::GetNumInBuckets () const
+{
+    return mNumInBuckets;
+}
+//----------------------------------------------------------------------------
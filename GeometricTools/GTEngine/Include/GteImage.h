@@ -50,6 +50,7 @@ public:
     inline char const* GetRawPixels() const;
     inline char* GetRawPixels();
     inline bool IsNullImage() const;
+    inline bool IsMapped() const;
 
     // The input array must have the correct number of pixels as determined by
     // the image parameters.  Use at your own risk, because we cannot verify
@@ -98,6 +99,24 @@ public:
 
     bool Save(std::string const& name) const;
 
+    // Out-of-core access to an image file written by Save.  The header and
+    // the metadata are read as in Load, but the pixels are not: the file is
+    // mapped into the address space, and the raw pixels point into the
+    // mapping, so the operating system reads and evicts the pixels on demand
+    // and the image may be larger than physical memory.  When 'writable' is
+    // 'true', pixel modifications are written to the file.  Otherwise, the
+    // mapping is copy-on-write; the pixels may still be modified, but the
+    // modifications are discarded when the image is unmapped.  The mapping
+    // is released by the destructor, by SetRawPixels, and by any operation
+    // that reallocates the image.  A copy of a mapped image (constructor or
+    // assignment to an incompatible image) is an in-memory image.  The
+    // pixels start at an offset in the file that is not necessarily a
+    // multiple of the pixel size, which is not an issue for the scalar
+    // accesses of the image classes on x86 and x64 processors.
+    bool Map(std::string const& name, bool writable,
+        std::vector<int> const* requiredNumDimensions,
+        std::vector<std::string> const* requiredPixelTypes);
+
 protected:
     // Deallocate arrays and initialize all data members to zero.
     void CreateNullImage();
@@ -117,6 +136,27 @@ protected:
     // Support for copying that avoids reallocation when possible.
     bool Copy(Image const& image);
 
+    // Create an image file for the current pixel type and the specified
+    // dimensions, all of which must be positive, and map it as writable.
+    // The pixels of the file are zero.  They are not written explicitly, so
+    // file systems that support sparse files allocate the pixel storage
+    // only when the pixels are modified.
+    bool CreateMapped(std::string const& name, int numDimensions, ...);
+
+    // Support for Load, Save, Map, and CreateMapped.  The information is
+    // everything in the file that precedes the pixels and the metadata is
+    // everything that follows them.
+    bool LoadInfo(std::ifstream& input,
+        std::vector<int> const* requiredNumDimensions,
+        std::vector<std::string> const* requiredPixelTypes);
+    bool LoadMetaData(std::ifstream& input);
+    bool SaveInfo(std::ofstream& output) const;
+    bool SaveMetaData(std::ofstream& output) const;
+
+    // Map the first 'size' bytes of the file, setting mMapView and mMapSize.
+    bool MapPixels(std::string const& name, size_t size, bool writable);
+    void UnmapPixels();
+
     // Information needed for typecasting to ImageD<T>, where D is the number
     // of dimensions and T is the pixel type.
     std::string mPixelType;
@@ -130,6 +170,11 @@ protected:
     char* mRawPixels;
     bool mOwnerRawPixels;
 
+    // The file mapping when the image is mapped; see Map.  The raw pixels
+    // are then owned by the mapping.
+    void* mMapView;
+    size_t mMapSize;
+
     // Per-image metadata.
     std::string mImageMetaData;
 
@@ -52,6 +52,11 @@ inline bool Image::IsNullImage() const
     return mRawPixels == nullptr;
 }
 //----------------------------------------------------------------------------
+inline bool Image::IsMapped() const
+{
+    return mMapView != nullptr;
+}
+//----------------------------------------------------------------------------
 inline void Image::SetImageMetaData(std::string const& metadata)
 {
     mImageMetaData = metadata;
@@ -90,6 +90,14 @@ public:
     // object.
     bool Load (std::string const& filename);
 
+    // Out-of-core storage; see Image::Map.  The required dimensions and
+    // pixel type are that of the current image object.  CreateMapped
+    // creates a file for an image with the specified dimensions and zero
+    // pixels, and it maps the file as writable.
+    bool Map (std::string const& filename, bool writable = false);
+    bool CreateMapped (std::string const& filename, int dimension0,
+        int dimension1);
+
 private:
     void AllocatePointers ();
     void DeallocatePointers ();
@@ -437,6 +437,37 @@ bool Image2<PixelType>::Load (std::string const& filename)
 }
 //----------------------------------------------------------------------------
 template <typename PixelType>
+bool Image2<PixelType>::Map (std::string const& filename, bool writable)
+{
+    std::vector<int> numDimensions(1);
+    numDimensions[0] = mNumDimensions;
+
+    std::vector<std::string> pixelTypes(1);
+    pixelTypes[0] = mPixelType;
+
+    if (Image::Map(filename, writable, &numDimensions, &pixelTypes))
+    {
+        AllocatePointers();
+        return true;
+    }
+
+    return false;
+}
+//----------------------------------------------------------------------------
+template <typename PixelType>
+bool Image2<PixelType>::CreateMapped (std::string const& filename,
+    int dimension0, int dimension1)
+{
+    if (Image::CreateMapped(filename, 2, dimension0, dimension1))
+    {
+        AllocatePointers();
+        return true;
+    }
+
+    return false;
+}
+//----------------------------------------------------------------------------
+template <typename PixelType>
 void Image2<PixelType>::AllocatePointers ()
 {
     if (mPixels)
@@ -474,6 +474,38 @@ bool Image3<PixelType>::Load (std::string const& filename)
 }
 //----------------------------------------------------------------------------
 template <typename PixelType>
+bool Image3<PixelType>::Map (std::string const& filename, bool writable)
+{
+    std::vector<int> numDimensions(1);
+    numDimensions[0] = mNumDimensions;
+
+    std::vector<std::string> pixelTypes(1);
+    pixelTypes[0] = mPixelType;
+
+    if (Image::Map(filename, writable, &numDimensions, &pixelTypes))
+    {
+        AllocatePointers();
+        return true;
+    }
+
+    return false;
+}
+//----------------------------------------------------------------------------
+template <typename PixelType>
+bool Image3<PixelType>::CreateMapped (std::string const& filename,
+    int dimension0, int dimension1, int dimension2)
+{
+    if (Image::CreateMapped(filename, 3, dimension0, dimension1,
+        dimension2))
+    {
+        AllocatePointers();
+        return true;
+    }
+
+    return false;
+}
+//----------------------------------------------------------------------------
+template <typename PixelType>
 void Image3<PixelType>::AllocatePointers ()
 {
     if (mPixels)
@@ -0,0 +1,123 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GteImage2.h"
+#include "GteImage3.h"
+
+// Median filtering and convolution of float images on the CPU.  These are
+// the equivalents of the compute shaders of the MedianFiltering and
+// Convolution samples.  As in those shaders, the pixels outside the image
+// have the value 0, and the window of a filter with radius r is the square
+// (cube) of (2r+1)^2 ((2r+1)^3) pixels centered at the output pixel.  The
+// output image is resized to the dimensions of the input and must be a
+// different object.  The rows of the output are partitioned among the
+// threads.
+
+namespace gte
+{
+
+class GTE_IMPEXP ImageFilter
+{
+public:
+    // The median of the window.  A row of output pixels is processed in
+    // blocks of 64 pixels; sample k of the windows of a block is stored
+    // contiguously, so each compare-exchange of a sorting network is a loop
+    // of SSE min/max operations on four windows at a time.  The networks for
+    // radius 1 (19 compare-exchanges) and radius 2 (99 compare-exchanges)
+    // select the median without sorting the window.  The larger windows use
+    // a selection per pixel, which has cost O(r^2); use MedianByHistogram
+    // instead for those.
+    static void Median(Image2<float> const& input, int radius,
+        Image2<float>& output, unsigned int numThreads = 1);
+
+    // The median of the window by the algorithm of Perreault and Hebert,
+    // "Median Filtering in Constant Time".  The pixel values are quantized
+    // to 'numLevels' equally spaced levels spanning the minimum and maximum
+    // of the image and 0.  Each column maintains a histogram of the 2r+1
+    // pixels of the window rows, and the window histogram is updated by
+    // adding one column histogram and subtracting another, so the cost per
+    // pixel is O(numLevels) independent of the radius.  The output is the
+    // level of the median, which is exact when the image has at most
+    // numLevels equally spaced values that include the minimum and maximum
+    // (for example, 8-bit images with numLevels = 256).  The number of
+    // levels must be at least 2.
+    static void MedianByHistogram(Image2<float> const& input, int radius,
+        int numLevels, Image2<float>& output, unsigned int numThreads = 1);
+
+    // The median of the window by a selection per voxel.
+    static void Median(Image3<float> const& input, int radius,
+        Image3<float>& output, unsigned int numThreads = 1);
+
+    // The convolution output(x,y) = sum_{dx,dy} w(dx,dy)*input(x+dx,y+dy)
+    // for the weights w(dx,dy) = weights[(dx+r) + (2r+1)*(dy+r)].  The
+    // weights are applied a row at a time to a zero-padded copy of the
+    // input row, so the inner loop is an SSE multiply-add of four pixels at
+    // a time.
+    static void Convolve(Image2<float> const& input, int radius,
+        float const* weights, Image2<float>& output,
+        unsigned int numThreads = 1);
+
+    // The convolution with the weights w(dx,dy,dz) =
+    // weights[(dx+r) + (2r+1)*((dy+r) + (2r+1)*(dz+r))].
+    static void Convolve(Image3<float> const& input, int radius,
+        float const* weights, Image3<float>& output,
+        unsigned int numThreads = 1);
+
+    // The convolution with the separable weights w(dx)*w(dy) (w(dx)*w(dy)*
+    // w(dz) in 3D), where w(d) = weights[d+r].  The image is convolved
+    // with the 1D weights in x, then in y, then in z, which costs 2r+1
+    // multiply-adds per pixel and dimension rather than (2r+1)^n.
+    static void ConvolveSeparable(Image2<float> const& input, int radius,
+        float const* weights, Image2<float>& output,
+        unsigned int numThreads = 1);
+
+    static void ConvolveSeparable(Image3<float> const& input, int radius,
+        float const* weights, Image3<float>& output,
+        unsigned int numThreads = 1);
+
+    // The 2r+1 weights of the 1D Gaussian with standard deviation
+    // sigma = r/3.7169..., for which the weights at the ends are 0.001
+    // times the weight at the center, normalized to sum to 1.  These are
+    // the weights of the Convolution sample.
+    static void GetGaussianWeights(int radius, float* weights);
+
+private:
+    // Blocks of output pixels processed by the sorting networks.
+    enum { BLOCK_SIZE = 64 };
+
+    // Apply a median network to the n samples of each of the BLOCK_SIZE
+    // windows, where sample k of window i is samples[i + BLOCK_SIZE*k].
+    // The median of window i is in sample n/2 on return.
+    static void SelectMedian(int numPairs, int const pairs[][2],
+        float* samples);
+
+    // target[i] += weight*source[i] for 0 <= i < numValues, four values at
+    // a time.
+    static void MultiplyAdd(int numValues, float weight, float const* source,
+        float* target);
+
+    // Convolve the rows of length 'length' in x.  Row i of the input starts
+    // at source + i*length and row i of the output at target + i*length.
+    static void ConvolveRows(int length, int numRows, int radius,
+        float const* weights, float const* source, float* target,
+        unsigned int numThreads);
+
+    // Convolve in the direction whose consecutive samples are 'stride'
+    // floats apart.  The image consists of 'numOuter' blocks of
+    // 'numSamples*stride' floats.
+    static void ConvolveStrided(int stride, int numSamples, int numOuter,
+        int radius, float const* weights, float const* source,
+        float* target, unsigned int numThreads);
+
+    // The sorting networks for the medians of 9 and 25 samples.
+    static int const msMedian9[19][2];
+    static int const msMedian25[99][2];
+};
+
+}
@@ -8,7 +8,11 @@
 #pragma once
 
 #include "GTEngineDEF.h"
+#include "GteBinaryImage2.h"
+#include "GteBinaryMorphology.h"
+#include "GteEuclideanDistanceTransform.h"
 #include "GteImage2.h"
+#include "GteUnionFindLabeler.h"
 
 namespace gte
 {
@@ -31,16 +35,23 @@ public:
     // Compute the 8-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  When
+    // numThreads > 1, the components are computed by UnionFindLabeler using
+    // that many threads; the labels and the component lists are the same.
+    // The union-find labeling does more work than the depth-first search,
+    // so use numThreads > 1 only when that many cores are available.
     static void GetComponents8(Image2<int>& image,
-        std::vector<std::vector<int> >& components);
+        std::vector<std::vector<int> >& components,
+        unsigned int numThreads = 1);
 
     // Compute the 4-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  The parameter
+    // numThreads is as described for GetComponents8.
     static void GetComponents4(Image2<int>& image,
-        std::vector<std::vector<int> >& components);
+        std::vector<std::vector<int> >& components,
+        unsigned int numThreads = 1);
 
     // Compute a dilation with a structuring element consisting of the
     // 4-connected neighbors of each pixel.  The input image is binary with 0
@@ -148,6 +159,41 @@ public:
         int numNeighbors, std::pair<int, int> const neighbors[],
         Image2<int>& output);
 
+    // Morphology for bit-packed binary images.  The structuring elements and
+    // the handling of the image exterior are those of the functions for
+    // Image2<int>.  A word operation processes 64 pixels, and the rows are
+    // partitioned among numThreads threads; see GteBinaryMorphology.h.  The
+    // output image must be an object different from the input image, and it
+    // is resized when necessary.
+    static void Dilate4(BinaryImage2 const& input, BinaryImage2& output,
+        unsigned int numThreads = 1);
+    static void Dilate8(BinaryImage2 const& input, BinaryImage2& output,
+        unsigned int numThreads = 1);
+    static void Dilate(BinaryImage2 const& input, int numNeighbors,
+        std::pair<int, int> const neighbors[], BinaryImage2& output,
+        unsigned int numThreads = 1);
+    static void Erode4(BinaryImage2 const& input, bool zeroExterior,
+        BinaryImage2& output, unsigned int numThreads = 1);
+    static void Erode8(BinaryImage2 const& input, bool zeroExterior,
+        BinaryImage2& output, unsigned int numThreads = 1);
+    static void Erode(BinaryImage2 const& input, bool zeroExterior,
+        int numNeighbors, std::pair<int, int> const neighbors[],
+        BinaryImage2& output, unsigned int numThreads = 1);
+    static void Open4(BinaryImage2 const& input, bool zeroExterior,
+        BinaryImage2& output, unsigned int numThreads = 1);
+    static void Open8(BinaryImage2 const& input, bool zeroExterior,
+        BinaryImage2& output, unsigned int numThreads = 1);
+    static void Open(BinaryImage2 const& input, bool zeroExterior,
+        int numNeighbors, std::pair<int, int> const neighbors[],
+        BinaryImage2& output, unsigned int numThreads = 1);
+    static void Close4(BinaryImage2 const& input, bool zeroExterior,
+        BinaryImage2& output, unsigned int numThreads = 1);
+    static void Close8(BinaryImage2 const& input, bool zeroExterior,
+        BinaryImage2& output, unsigned int numThreads = 1);
+    static void Close(BinaryImage2 const& input, bool zeroExterior,
+        int numNeighbors, std::pair<int, int> const neighbors[],
+        BinaryImage2& output, unsigned int numThreads = 1);
+
     // Locate a pixel and walk around the edge of a component.  The input
     // (x,y) is where the search starts for a nonzero pixel.  If (x,y) is
     // outside the component, the walk is around the outside the component.
@@ -179,6 +225,26 @@ public:
     static void GetL2Distance(Image2<int> const& image, float& maxDistance,
         int& xMax, int& yMax, Image2<float>& transform);
 
+    // Compute the exact L2-distance transform of the binary image.  Each
+    // pixel is assigned the distance to its nearest 0-valued pixel, and
+    // unlike GetL2Distance there is no bound on the distances.  The
+    // separable linear-time algorithm is described in
+    // GteEuclideanDistanceTransform.h; its passes over the rows and the
+    // columns use numThreads threads.  The function returns the maximum
+    // distance and a point at which the maximum distance is attained, and
+    // 'transform' is resized when necessary.  The second function also
+    // returns for each pixel the index of its nearest 0-valued pixel (use
+    // Image2::GetCoordinates).  If the image has no 0-valued pixels, the
+    // distances are sqrt(INT_MAX) and the indices are -1.  The transform
+    // needs no memory other than the outputs and per-thread buffers, so
+    // the outputs may be mapped images.
+    static void GetExactL2Distance(Image2<int> const& image,
+        float& maxDistance, int& xMax, int& yMax, Image2<float>& transform,
+        unsigned int numThreads = 1);
+    static void GetExactL2Distance(Image2<int> const& image,
+        float& maxDistance, int& xMax, int& yMax, Image2<float>& transform,
+        Image2<int>& nearest, unsigned int numThreads = 1);
+
     // Compute a skeleton of a binary image.  Boundary pixels are trimmed from
     // the object one layer at a time based on their adjacency to interior
     // pixels.  At each step the connectivity and cycles of the object are
@@ -221,7 +287,13 @@ public:
 private:
     // Connected component labeling using depth-first search.
     static void GetComponents(int numNeighbors, int const delta[],
-        Image2<int>& image, std::vector<std::vector<int> >& components);
+        Image2<int>& image, std::vector<std::vector<int> >& components,
+        unsigned int numThreads);
+
+    // Support for GetExactL2Distance.  The 'nearest' input may be null.
+    static void GetExactL2Distance(Image2<int> const& image,
+        float& maxDistance, int& xMax, int& yMax, Image2<float>& transform,
+        Image2<int>* nearest, unsigned int numThreads);
 
     // Support for GetL2Distance.
     static void L2Check(int x, int y, int dx, int dy, Image2<int>& xNear,
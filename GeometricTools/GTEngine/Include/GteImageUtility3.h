@@ -8,7 +8,12 @@
 #pragma once
 
 #include "GTEngineDEF.h"
+#include "GteBinaryImage3.h"
+#include "GteBinaryMorphology.h"
+#include "GteBrickedImage3.h"
+#include "GteEuclideanDistanceTransform.h"
 #include "GteImage3.h"
+#include "GteUnionFindLabeler.h"
 
 namespace gte
 {
@@ -24,6 +29,16 @@ public:
     // operations, to save memory and time the input image is modified by the
     // algorithms.  If you need to preserve the input image, make a copy of it
     // before calling these functions.
+    //
+    // The images may be mapped to files (Image3::Map, Image3::CreateMapped),
+    // in which case they may be larger than physical memory.  The Dilate*
+    // functions make a single pass over the voxels in the order of their
+    // indices, so the slices are paged in and out sequentially.
+    // ComputeCDConvex works in place.  The GetComponents* functions work in
+    // place and allocate, in addition to the output, only memory that is
+    // proportional to the search depth and to the number of components.
+    // Their depth-first search visits the neighbors of the current voxel,
+    // so the accesses are local when the components are compact.
 
     // Dilate the image using a structuring element that contains the
     // 26-connected neighbors.
@@ -44,26 +59,98 @@ public:
     // coordinate directions.
     static void ComputeCDConvex(Image3<int>& image);
 
+    // Compute the exact L2-distance transform of the binary image.  Each
+    // voxel is assigned the distance to its nearest 0-valued voxel.  The
+    // separable linear-time algorithm is described in
+    // GteEuclideanDistanceTransform.h; its passes along the x-, y-, and
+    // z-lines use numThreads threads.  The function returns the maximum
+    // distance and a point at which the maximum distance is attained, and
+    // 'transform' is resized when necessary.  The second function also
+    // returns for each voxel the index of its nearest 0-valued voxel (use
+    // Image3::GetCoordinates).  If the image has no 0-valued voxels, the
+    // distances are sqrt(INT_MAX) and the indices are -1.  The transform
+    // needs no memory other than the outputs and per-thread buffers, so
+    // the outputs may be mapped images.
+    static void GetExactL2Distance(Image3<int> const& image,
+        float& maxDistance, int& xMax, int& yMax, int& zMax,
+        Image3<float>& transform, unsigned int numThreads = 1);
+    static void GetExactL2Distance(Image3<int> const& image,
+        float& maxDistance, int& xMax, int& yMax, int& zMax,
+        Image3<float>& transform, Image3<int>& nearest,
+        unsigned int numThreads = 1);
+
     // Compute the 26-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  When
+    // numThreads > 1, the components are computed by UnionFindLabeler using
+    // that many threads; the labels and the component lists are the same.
+    // The union-find labeling does more work than the depth-first search,
+    // so use numThreads > 1 only when that many cores are available.
     static void GetComponents26(Image3<int>& image,
-        std::vector<std::vector<int> >& components);
+        std::vector<std::vector<int> >& components,
+        unsigned int numThreads = 1);
 
     // Compute the 18-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  The parameter
+    // numThreads is as described for GetComponents26.
     static void GetComponents18(Image3<int>& image,
-        std::vector<std::vector<int> >& components);
+        std::vector<std::vector<int> >& components,
+        unsigned int numThreads = 1);
 
     // Compute the 6-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  The parameter
+    // numThreads is as described for GetComponents26.
     static void GetComponents6(Image3<int>& image,
+        std::vector<std::vector<int> >& components,
+        unsigned int numThreads = 1);
+
+    // Dilation and connected component labeling for images with the bricked
+    // layout.  The requirements and the results are those of the functions
+    // for Image3, except that the indices stored in 'components' are the
+    // bricked indices of the voxels (use BrickedImage3::GetCoordinates) and
+    // the components are numbered in the order of their first voxels in the
+    // bricked storage.  The dilation visits the voxels a brick at a time.
+    // The neighbors of a voxel are located by adding one of 27 precomputed
+    // sets of index differences, selected by whether each of its brick
+    // coordinates is first, last, or neither.
+    //
+    // The bricked layout is opt-in; nothing converts an image to it
+    // implicitly.  It reduces the time of the dilations, which read every
+    // neighbor of every voxel.  It does not reduce the time of the labeling,
+    // which is dominated by the depth-first search and was slightly slower
+    // than the Image3 version on 512x512x256 and 1024x1024x128 images.  Use
+    // the bricked GetComponents* only when the image is already bricked, and
+    // the Image3 version otherwise.
+    static void Dilate26(BrickedImage3<int> const& inImage,
+        BrickedImage3<int>& outImage);
+    static void Dilate18(BrickedImage3<int> const& inImage,
+        BrickedImage3<int>& outImage);
+    static void Dilate6(BrickedImage3<int> const& inImage,
+        BrickedImage3<int>& outImage);
+    static void GetComponents26(BrickedImage3<int>& image,
         std::vector<std::vector<int> >& components);
+    static void GetComponents18(BrickedImage3<int>& image,
+        std::vector<std::vector<int> >& components);
+    static void GetComponents6(BrickedImage3<int>& image,
+        std::vector<std::vector<int> >& components);
+
+    // Dilation for bit-packed binary images.  A word operation processes 64
+    // voxels, and the rows are partitioned among numThreads threads; see
+    // GteBinaryMorphology.h.  Unlike the functions for Image3<int>, all the
+    // output voxels are computed, including those on the image boundary.
+    // The output image must be an object different from the input image,
+    // and it is resized when necessary.
+    static void Dilate26(BinaryImage3 const& inImage, BinaryImage3& outImage,
+        unsigned int numThreads = 1);
+    static void Dilate18(BinaryImage3 const& inImage, BinaryImage3& outImage,
+        unsigned int numThreads = 1);
+    static void Dilate6(BinaryImage3 const& inImage, BinaryImage3& outImage,
+        unsigned int numThreads = 1);
 
     // Use a depth-first search for filling a 6-connected region.  This is
     // nonrecursive, simulated by using a heap-allocated "stack".  The input
@@ -78,13 +165,40 @@ public:
         std::function<void(int, int, int)> const& callback);
 
 private:
+    // The structuring elements of the dilations.
+    static std::array<int, 3> const msNeighbors26[26];
+    static std::array<int, 3> const msNeighbors18[18];
+    static std::array<int, 3> const msNeighbors6[6];
+
     // Dilation using the specified structuring element.
     static void Dilate(int numNeighbors, std::array<int, 3> const delta[],
         Image3<int> const& inImage, Image3<int>& outImage);
+    static void Dilate(int numNeighbors, std::array<int, 3> const delta[],
+        BrickedImage3<int> const& inImage, BrickedImage3<int>& outImage);
+    static void Dilate(int numNeighbors, std::array<int, 3> const delta[],
+        BinaryImage3 const& inImage, BinaryImage3& outImage,
+        unsigned int numThreads);
+
+    // Support for GetExactL2Distance.  The 'nearest' input may be null.
+    static void GetExactL2Distance(Image3<int> const& image,
+        float& maxDistance, int& xMax, int& yMax, int& zMax,
+        Image3<float>& transform, Image3<int>* nearest,
+        unsigned int numThreads);
 
     // Connected component labeling using depth-first search.
     static void GetComponents(int numNeighbors, int const delta[],
-        Image3<int>& image, std::vector<std::vector<int> >& components);
+        Image3<int>& image, std::vector<std::vector<int> >& components,
+        unsigned int numThreads);
+    static void GetComponents(int numNeighbors,
+        std::array<int, 3> const delta[], BrickedImage3<int>& image,
+        std::vector<std::vector<int> >& components);
+
+    // The differences of the bricked indices of a voxel and its neighbors.
+    // The 27*numNeighbors differences are grouped by the position of the
+    // voxel in its brick; see the comments in the implementation.
+    static void GetBrickedOffsets(int numNeighbors,
+        std::array<int, 3> const delta[], BrickedImage3<int> const& image,
+        std::vector<int>& offsets);
 };
 
 #include "GteImageUtility3.inl"
@@ -0,0 +1,155 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+// Maintain the convex hull of a 3D point set that changes by batches of
+// insertions and removals.  ConvexHull3 computes the hull of a fixed point
+// set from scratch; this class is persistent, so the cost of a batch is
+// proportional to the changes rather than to the size of the point set.  As
+// with ConvexHull3, the only way to ensure a correct result is to choose
+// ComputeType for exact rational arithmetic.  You may use BSNumber.  No
+// divisions are performed in this computation, so you do not have to use
+// BSRational.
+//
+// The hull is stored in an ETManifoldMesh whose triangles carry conflict
+// lists.  Each point outside the hull that is waiting to be processed is in
+// the conflict list of exactly one hull triangle that is visible to it.
+// Inserting a point removes the triangles visible to it, which are found by
+// a search over the triangle adjacencies starting at its conflict triangle,
+// and adds the triangles formed by the point and the boundary edges of the
+// visible region.  The waiting points in the conflict lists of the removed
+// triangles are redistributed to the new triangles; a point that sees none
+// of the new triangles is inside the hull and is discarded.
+//
+// Inserting a batch tests each new point against the hull triangles until a
+// visible one is found, so a point inside the hull is rejected after one
+// pass over the hull triangles.  Removing a batch leaves the hull unchanged
+// when none of the removed points is a hull vertex.  Otherwise, the hull of
+// the surviving hull vertices is computed, and the triangles of that hull
+// that are not triangles of the previous hull are the only ones a remaining
+// point can see (every remaining point was inside the previous hull).  The
+// interior points are tested against only those triangles, and the ones
+// that see a triangle are inserted.
+//
+// The point indices are stable: the points of a batch are appended to the
+// point array and removal only marks the points as removed.  Use Clear() to
+// reset the object when the point array has accumulated many removed
+// points.
+
+#include "GtePrimalQuery3.h"
+#include "GteETManifoldMesh.h"
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace gte
+{
+
+template <typename InputType, typename ComputeType>
+class IncrementalConvexHull3
+{
+public:
+    // Construction.  The epsilon value is used, as in ConvexHull3, to
+    // determine the intrinsic dimensionality of the points when the initial
+    // tetrahedron is selected.
+    IncrementalConvexHull3(InputType epsilon = (InputType)0);
+
+    // Remove all points and the hull.
+    void Clear();
+
+    // Insert a batch of points.  The returned value is the index assigned to
+    // points[0]; points[i] is assigned the index of points[0] plus i.  The
+    // hull is computed once the points are not (nearly) coplanar.
+    int Insert(int numPoints, Vector3<InputType> const* points);
+
+    // Remove a batch of points specified by their indices.  Indices of
+    // points that are out of range or already removed are ignored.
+    void Remove(int numIndices, int const* indices);
+
+    // The dimension is 3 when the hull exists.  Otherwise, the dimension is
+    // that of the (nearly) degenerate set of points that are not removed,
+    // and the hull is empty.
+    inline int GetDimension() const;
+
+    // Member access.  The points include those that were removed.
+    inline int GetNumPoints() const;
+    inline int GetNumActivePoints() const;
+    inline std::vector<Vector3<InputType>> const& GetPoints() const;
+    inline bool IsRemoved(int i) const;
+    inline bool IsHullVertex(int i) const;
+    inline PrimalQuery3<ComputeType> const& GetQuery() const;
+
+    // The convex hull is a convex polyhedron with triangular faces.
+    inline ETManifoldMesh const& GetHullMesh() const;
+    void GetHullUnordered(std::vector<TriangleKey<true>>& hull) const;
+
+private:
+    // The hull triangles.  The triangles visited during a search for the
+    // triangles visible to a point are marked by 'visit' and, of those,
+    // the visible ones by 'visible'.
+    class Face : public ETManifoldMesh::Triangle
+    {
+    public:
+        Face(int v0, int v1, int v2);
+
+        std::vector<int> conflicts;
+        unsigned int visit;
+        bool visible;
+    };
+
+    static ETManifoldMesh::Triangle* CreateFace(int v0, int v1, int v2);
+
+    // Update the compute points and the query after the points have been
+    // appended.
+    void UpdateComputePoints(int numOldPoints);
+
+    // Compute the hull of the specified points from scratch.  The function
+    // returns 'false' when the points are (nearly) coplanar, in which case
+    // mDimension is set to their dimension and the hull is empty.
+    bool Build(std::vector<int> const& candidates);
+
+    // Assign the point to the first of the faces that is visible to it.  The
+    // function returns 'false' when none of the faces is visible.
+    bool AssignConflict(int i, std::vector<Face*> const& faces);
+
+    // Insert the points in mPending that are still outside the hull.
+    void ProcessPending();
+
+    // Insert point i, which is outside the hull and sees mConflict[i].
+    void InsertPoint(int i);
+
+    // The current faces of the hull.
+    void GetFaces(std::vector<Face*>& faces) const;
+
+    InputType mEpsilon;
+    int mDimension;
+
+    // The points, their compute-type copies for the queries, and their
+    // states.  The conflict face is nullptr for a point that is not waiting
+    // to be inserted.  The valence is the number of hull faces sharing the
+    // point, so the point is a hull vertex when it is positive.
+    std::vector<Vector3<InputType>> mPoints;
+    std::vector<Vector3<ComputeType>> mComputePoints;
+    PrimalQuery3<ComputeType> mQuery;
+    std::vector<char> mRemoved;
+    std::vector<Face*> mConflict;
+    std::vector<int> mValence;
+    int mNumActivePoints;
+
+    ETManifoldMesh mHullMesh;
+    unsigned int mVisit;
+
+    // Scratch storage for the insertion.
+    std::vector<int> mPending;
+    std::vector<Face*> mVisible, mNewFaces, mStack;
+    std::vector<int> mOrphans;
+};
+
+#include "GteIncrementalConvexHull3.inl"
+
+}
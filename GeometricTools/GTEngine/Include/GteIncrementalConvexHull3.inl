@@ -0,0 +1,519 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+IncrementalConvexHull3<InputType, ComputeType>::IncrementalConvexHull3(
+    InputType epsilon)
+    :
+    mEpsilon(std::max(epsilon, (InputType)0)),
+    mDimension(0),
+    mNumActivePoints(0),
+    mHullMesh(nullptr, CreateFace),
+    mVisit(0)
+{
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+void IncrementalConvexHull3<InputType, ComputeType>::Clear()
+{
+    std::vector<Face*> faces;
+    GetFaces(faces);
+    for (auto face : faces)
+    {
+        mHullMesh.Remove(face->V[0], face->V[1], face->V[2]);
+    }
+
+    mDimension = 0;
+    mPoints.clear();
+    mComputePoints.clear();
+    mQuery.Set(0, nullptr);
+    mRemoved.clear();
+    mConflict.clear();
+    mValence.clear();
+    mNumActivePoints = 0;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+int IncrementalConvexHull3<InputType, ComputeType>::Insert(int numPoints,
+    Vector3<InputType> const* points)
+{
+    int const numOldPoints = static_cast<int>(mPoints.size());
+    if (numPoints <= 0 || !points)
+    {
+        return numOldPoints;
+    }
+
+    mPoints.insert(mPoints.end(), points, points + numPoints);
+    mRemoved.resize(mPoints.size(), 0);
+    mConflict.resize(mPoints.size(), nullptr);
+    mValence.resize(mPoints.size(), 0);
+    mNumActivePoints += numPoints;
+    UpdateComputePoints(numOldPoints);
+
+    int const numNewPoints = static_cast<int>(mPoints.size());
+    if (mDimension < 3)
+    {
+        // The hull does not exist yet.  Try to compute it from all the
+        // active points.
+        std::vector<int> candidates;
+        candidates.reserve(mNumActivePoints);
+        for (int i = 0; i < numNewPoints; ++i)
+        {
+            if (!mRemoved[i])
+            {
+                candidates.push_back(i);
+            }
+        }
+        Build(candidates);
+        return numOldPoints;
+    }
+
+    // Assign each new point to a visible face of the hull.  The points
+    // that see no face are inside the hull and are not processed further.
+    std::vector<Face*> faces;
+    GetFaces(faces);
+    mPending.clear();
+    for (int i = numOldPoints; i < numNewPoints; ++i)
+    {
+        if (AssignConflict(i, faces))
+        {
+            mPending.push_back(i);
+        }
+    }
+    ProcessPending();
+    return numOldPoints;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+void IncrementalConvexHull3<InputType, ComputeType>::Remove(int numIndices,
+    int const* indices)
+{
+    int const numPoints = static_cast<int>(mPoints.size());
+    bool removedHullVertex = false;
+    for (int k = 0; k < numIndices; ++k)
+    {
+        int i = indices[k];
+        if (0 <= i && i < numPoints && !mRemoved[i])
+        {
+            mRemoved[i] = 1;
+            --mNumActivePoints;
+            if (mValence[i] > 0)
+            {
+                removedHullVertex = true;
+            }
+        }
+    }
+
+    if (mDimension == 3 && !removedHullVertex)
+    {
+        // The removed points are inside the hull, so the hull is unchanged.
+        return;
+    }
+
+    // Partition the remaining points into the surviving hull vertices and
+    // the points inside the previous hull.
+    std::vector<int> vertices, interior;
+    for (int i = 0; i < numPoints; ++i)
+    {
+        if (!mRemoved[i])
+        {
+            if (mValence[i] > 0)
+            {
+                vertices.push_back(i);
+            }
+            else
+            {
+                interior.push_back(i);
+            }
+        }
+    }
+
+    if (mDimension < 3 || vertices.size() < 4)
+    {
+        // There is no previous hull to reuse.
+        vertices.insert(vertices.end(), interior.begin(), interior.end());
+        Build(vertices);
+        return;
+    }
+
+    // Remember the faces of the previous hull whose vertices all survived.
+    std::set<TriangleKey<true>> oldFaces;
+    std::vector<Face*> faces;
+    GetFaces(faces);
+    for (auto face : faces)
+    {
+        if (!mRemoved[face->V[0]] && !mRemoved[face->V[1]]
+            && !mRemoved[face->V[2]])
+        {
+            oldFaces.insert(TriangleKey<true>(face->V[0], face->V[1],
+                face->V[2]));
+        }
+    }
+
+    if (!Build(vertices))
+    {
+        // The surviving hull vertices are (nearly) coplanar, so the interior
+        // points must be included to find a tetrahedron.
+        vertices.insert(vertices.end(), interior.begin(), interior.end());
+        Build(vertices);
+        return;
+    }
+
+    // The interior points are inside the previous hull, so they cannot see
+    // a face of the new hull that is also a face of the previous hull.
+    GetFaces(faces);
+    std::vector<Face*> newFaces;
+    for (auto face : faces)
+    {
+        TriangleKey<true> key(face->V[0], face->V[1], face->V[2]);
+        if (oldFaces.find(key) == oldFaces.end())
+        {
+            newFaces.push_back(face);
+        }
+    }
+
+    mPending.clear();
+    for (auto i : interior)
+    {
+        if (AssignConflict(i, newFaces))
+        {
+            mPending.push_back(i);
+        }
+    }
+    ProcessPending();
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType> inline
+int IncrementalConvexHull3<InputType, ComputeType>::GetDimension() const
+{
+    return mDimension;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType> inline
+int IncrementalConvexHull3<InputType, ComputeType>::GetNumPoints() const
+{
+    return static_cast<int>(mPoints.size());
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType> inline
+int IncrementalConvexHull3<InputType, ComputeType>::GetNumActivePoints()
+    const
+{
+    return mNumActivePoints;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType> inline
+std::vector<Vector3<InputType>> const&
+IncrementalConvexHull3<InputType, ComputeType>::GetPoints() const
+{
+    return mPoints;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType> inline
+bool IncrementalConvexHull3<InputType, ComputeType>::IsRemoved(int i) const
+{
+    return mRemoved[i] != 0;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType> inline
+bool IncrementalConvexHull3<InputType, ComputeType>::IsHullVertex(int i)
+    const
+{
+    return mValence[i] > 0;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType> inline
+PrimalQuery3<ComputeType> const&
+IncrementalConvexHull3<InputType, ComputeType>::GetQuery() const
+{
+    return mQuery;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType> inline
+ETManifoldMesh const&
+IncrementalConvexHull3<InputType, ComputeType>::GetHullMesh() const
+{
+    return mHullMesh;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+void IncrementalConvexHull3<InputType, ComputeType>::GetHullUnordered(
+    std::vector<TriangleKey<true>>& hull) const
+{
+    hull.clear();
+    hull.reserve(mHullMesh.GetTriangles().size());
+    for (auto const& element : mHullMesh.GetTriangles())
+    {
+        hull.push_back(element.first);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+IncrementalConvexHull3<InputType, ComputeType>::Face::Face(int v0, int v1,
+    int v2)
+    :
+    ETManifoldMesh::Triangle(v0, v1, v2),
+    visit(0),
+    visible(false)
+{
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+ETManifoldMesh::Triangle*
+IncrementalConvexHull3<InputType, ComputeType>::CreateFace(int v0, int v1,
+    int v2)
+{
+    return new Face(v0, v1, v2);
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+void IncrementalConvexHull3<InputType, ComputeType>::UpdateComputePoints(
+    int numOldPoints)
+{
+    // The query stores a pointer to the compute points, so it must be set
+    // again whether or not the array was reallocated.
+    int const numPoints = static_cast<int>(mPoints.size());
+    mComputePoints.resize(mPoints.size());
+    for (int i = numOldPoints; i < numPoints; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            mComputePoints[i][j] = mPoints[i][j];
+        }
+    }
+    mQuery.Set(numPoints, &mComputePoints[0]);
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+bool IncrementalConvexHull3<InputType, ComputeType>::Build(
+    std::vector<int> const& candidates)
+{
+    std::vector<Face*> faces;
+    GetFaces(faces);
+    for (auto face : faces)
+    {
+        mHullMesh.Remove(face->V[0], face->V[1], face->V[2]);
+    }
+    std::fill(mConflict.begin(), mConflict.end(), nullptr);
+    std::fill(mValence.begin(), mValence.end(), 0);
+    mDimension = 0;
+
+    int const numCandidates = static_cast<int>(candidates.size());
+    if (numCandidates < 4)
+    {
+        mDimension = std::min(numCandidates - 1, 2);
+        mDimension = std::max(mDimension, 0);
+        return false;
+    }
+
+    std::vector<Vector3<InputType>> points(numCandidates);
+    for (int k = 0; k < numCandidates; ++k)
+    {
+        points[k] = mPoints[candidates[k]];
+    }
+    IntrinsicsVector3<InputType> info(numCandidates, &points[0], mEpsilon);
+    if (info.dimension < 3)
+    {
+        mDimension = info.dimension;
+        return false;
+    }
+
+    // The tetrahedron is selected by floating-point arithmetic, so verify
+    // that it is not degenerate for the exact queries.  The faces are
+    // ordered so that the fourth vertex is on their negative side.
+    int extreme[4];
+    for (int k = 0; k < 4; ++k)
+    {
+        extreme[k] = candidates[info.extreme[k]];
+    }
+    int sign = mQuery.ToPlane(extreme[0], extreme[1], extreme[2], extreme[3]);
+    if (sign == 0)
+    {
+        mDimension = 2;
+        return false;
+    }
+    if (sign > 0)
+    {
+        std::swap(extreme[2], extreme[3]);
+    }
+    mDimension = 3;
+
+    int const tetra[4][3] =
+    {
+        { extreme[1], extreme[2], extreme[3] },
+        { extreme[0], extreme[3], extreme[2] },
+        { extreme[0], extreme[1], extreme[3] },
+        { extreme[0], extreme[2], extreme[1] }
+    };
+    faces.resize(4);
+    for (int k = 0; k < 4; ++k)
+    {
+        faces[k] = static_cast<Face*>(mHullMesh.Insert(tetra[k][0],
+            tetra[k][1], tetra[k][2]));
+        for (int j = 0; j < 3; ++j)
+        {
+            ++mValence[tetra[k][j]];
+        }
+    }
+
+    // Assign the remaining candidates to faces of the tetrahedron and
+    // insert them.
+    mPending.clear();
+    for (auto i : candidates)
+    {
+        if (mValence[i] == 0 && AssignConflict(i, faces))
+        {
+            mPending.push_back(i);
+        }
+    }
+    ProcessPending();
+    return true;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+bool IncrementalConvexHull3<InputType, ComputeType>::AssignConflict(int i,
+    std::vector<Face*> const& faces)
+{
+    for (auto face : faces)
+    {
+        if (mQuery.ToPlane(i, face->V[0], face->V[1], face->V[2]) > 0)
+        {
+            face->conflicts.push_back(i);
+            mConflict[i] = face;
+            return true;
+        }
+    }
+    mConflict[i] = nullptr;
+    return false;
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+void IncrementalConvexHull3<InputType, ComputeType>::ProcessPending()
+{
+    // Each pending point is in the conflict list of a visible face.  When
+    // the point is reached, it is inserted if it is still outside the hull;
+    // otherwise, an earlier insertion discarded it.
+    for (size_t k = 0; k < mPending.size(); ++k)
+    {
+        int i = mPending[k];
+        if (mConflict[i])
+        {
+            InsertPoint(i);
+        }
+    }
+    mPending.clear();
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+void IncrementalConvexHull3<InputType, ComputeType>::InsertPoint(int i)
+{
+    // Locate the faces visible to the point.  These form a connected set
+    // that contains the conflict face of the point.  Faces coplanar with the
+    // point are not visible, as in ConvexHull3.
+    ++mVisit;
+    mVisible.clear();
+    mStack.clear();
+    Face* start = mConflict[i];
+    start->visit = mVisit;
+    start->visible = true;
+    mStack.push_back(start);
+    while (mStack.size() > 0)
+    {
+        Face* face = mStack.back();
+        mStack.pop_back();
+        mVisible.push_back(face);
+        for (int j = 0; j < 3; ++j)
+        {
+            Face* adj = static_cast<Face*>(face->T[j]);
+            if (adj->visit != mVisit)
+            {
+                adj->visit = mVisit;
+                adj->visible = (mQuery.ToPlane(i, adj->V[0], adj->V[1],
+                    adj->V[2]) > 0);
+                if (adj->visible)
+                {
+                    mStack.push_back(adj);
+                }
+            }
+        }
+    }
+
+    // Save the horizon edges, which are the edges shared by a visible and a
+    // nonvisible face, and the points waiting on the visible faces.  Then
+    // remove the visible faces.
+    std::vector<std::pair<int, int>> horizon;
+    mOrphans.clear();
+    for (auto face : mVisible)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            // Every face adjacent to a visible face was visited, so its
+            // 'visible' flag is current.
+            if (!static_cast<Face*>(face->T[j])->visible)
+            {
+                horizon.push_back(std::make_pair(face->V[j],
+                    face->V[(j + 1) % 3]));
+            }
+        }
+        for (auto k : face->conflicts)
+        {
+            if (k != i)
+            {
+                mOrphans.push_back(k);
+            }
+        }
+    }
+    for (auto face : mVisible)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            --mValence[face->V[j]];
+        }
+        mHullMesh.Remove(face->V[0], face->V[1], face->V[2]);
+    }
+
+    // Insert the faces formed by the point and the horizon edges.  The
+    // visible face had the edge ordered as <v0,v1>, so the new face
+    // <i,v0,v1> has the same winding.
+    mNewFaces.clear();
+    for (auto const& edge : horizon)
+    {
+        Face* face = static_cast<Face*>(mHullMesh.Insert(i, edge.first,
+            edge.second));
+        if (!face)
+        {
+            LogError("Unexpected condition.");
+            return;
+        }
+        mNewFaces.push_back(face);
+        ++mValence[i];
+        ++mValence[edge.first];
+        ++mValence[edge.second];
+    }
+    mConflict[i] = nullptr;
+
+    // A waiting point that was visible to a removed face and is still
+    // outside the hull must be visible to one of the new faces.
+    for (auto k : mOrphans)
+    {
+        AssignConflict(k, mNewFaces);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename InputType, typename ComputeType>
+void IncrementalConvexHull3<InputType, ComputeType>::GetFaces(
+    std::vector<Face*>& faces) const
+{
+    faces.clear();
+    faces.reserve(mHullMesh.GetTriangles().size());
+    for (auto const& element : mHullMesh.GetTriangles())
+    {
+        faces.push_back(static_cast<Face*>(element.second));
+    }
+}
+//----------------------------------------------------------------------------
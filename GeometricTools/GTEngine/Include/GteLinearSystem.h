@@ -8,10 +8,13 @@
 #pragma once
 
 #include "GTEngineDEF.h"
+#include "GteBarrier.h"
+#include "GteCSRMatrix.h"
 #include "GteGaussianElimination.h"
 #include "GteMatrix2x2.h"
 #include "GteMatrix3x3.h"
 #include "GteMatrix4x4.h"
+#include "GteParallelFor.h"
 #include <map>
 
 // Solve linear systems of equations where the matrix A is NxN.  The return
@@ -80,16 +83,42 @@ public:
     // The column vector B is stored as an array of contiguous values.  You
     // must specify the maximum number of iterations and a tolerance for
     // terminating the iterations.  Reasonable choices for tolerance are
-    // 1e-06f for 'float' or 1e-08 for 'double'.
+    // 1e-06f for 'float' or 1e-08 for 'double'.  The map is converted to a
+    // CSRMatrix for the matrix-vector products.  For large systems, build
+    // the CSRMatrix directly and use the preconditioned solver.
     typedef std::map<std::array<int, 2>, Real> SparseMatrix;
     static unsigned int SolveSymmetricCG(int N, SparseMatrix const& A,
         Real const* B, Real* X, unsigned int maxIterations, Real tolerance);
 
+    // Solve A*X = B using the preconditioned conjugate gradient method,
+    // where A is symmetric positive definite and both of its triangles are
+    // stored in the CSRMatrix.  The Jacobi preconditioner divides by the
+    // diagonal of A.  The incomplete Cholesky preconditioner uses the IC(0)
+    // factorization of A, which usually reduces the number of iterations
+    // considerably, but its triangular solves are sequential; if the
+    // factorization fails, the Jacobi preconditioner is used.  The rows are
+    // partitioned among numThreads threads, which are started once per
+    // solve and synchronize at three barriers per iteration (five for the
+    // incomplete Cholesky preconditioner), so the threads pay off only when
+    // the matrix has at least tens of thousands of elements.  The
+    // iterations terminate when |R| <= tolerance*|B| for the residual
+    // R = B - A*X.  The return value is the number of iterations.
+    enum Preconditioner
+    {
+        PC_NONE,
+        PC_JACOBI,
+        PC_INCOMPLETE_CHOLESKY
+    };
+
+    static unsigned int SolveSymmetricCG(CSRMatrix<Real> const& A,
+        Real const* B, Real* X, unsigned int maxIterations, Real tolerance,
+        Preconditioner preconditioner = PC_JACOBI,
+        unsigned int numThreads = 1);
+
 private:
     // Support for the conjugate gradient method.
     static Real Dot(int N, Real const* U, Real const* V);
     static void Mul(int N, Real const* A, Real const* X, Real* P);
-    static void Mul(int N, SparseMatrix const& A, Real const* X, Real* P);
     static void UpdateX(int N, Real* X, Real alpha, Real const* P);
     static void UpdateR(int N, Real* R, Real alpha, Real const* W);
     static void UpdateP(int N, Real* P, Real beta, Real const* R);
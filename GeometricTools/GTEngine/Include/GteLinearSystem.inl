@@ -192,6 +192,8 @@ unsigned int LinearSystem<Real>::SolveSymmetricCG(int N,
     SparseMatrix const& A, Real const* B, Real* X, unsigned int maxIterations,
     Real tolerance)
 {
+    CSRMatrix<Real> csrA(N, N, A, true);
+
     // The first iteration.
     std::vector<Real> tmpR(N), tmpP(N), tmpW(N);
     Real* R = &tmpR[0];
@@ -202,7 +204,7 @@ unsigned int LinearSystem<Real>::SolveSymmetricCG(int N,
     memcpy_s(R, numBytes, B, numBytes);
     Real rho0 = Dot(N, R, R);
     memcpy_s(P, numBytes, R, numBytes);
-    Mul(N, A, P, W);
+    csrA.Multiply(P, W);
     Real alpha = rho0 / Dot(N, P, W);
     UpdateX(N, X, alpha, P);
     UpdateR(N, R, alpha, W);
@@ -222,7 +224,7 @@ unsigned int LinearSystem<Real>::SolveSymmetricCG(int N,
 
         Real beta = rho1 / rho0;
         UpdateP(N, P, beta, R);
-        Mul(N, A, P, W);
+        csrA.Multiply(P, W);
         alpha = rho1 / Dot(N, P, W);
         UpdateX(N, X, alpha, P);
         UpdateR(N, R, alpha, W);
@@ -233,6 +235,191 @@ unsigned int LinearSystem<Real>::SolveSymmetricCG(int N,
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+unsigned int LinearSystem<Real>::SolveSymmetricCG(CSRMatrix<Real> const& A,
+    Real const* B, Real* X, unsigned int maxIterations, Real tolerance,
+    Preconditioner preconditioner, unsigned int numThreads)
+{
+    int const N = A.GetNumRows();
+    if (N <= 0 || A.GetNumColumns() != N)
+    {
+        LogError("The matrix must be square.");
+        return 0;
+    }
+
+    CSRMatrix<Real> factor;
+    if (preconditioner == PC_INCOMPLETE_CHOLESKY
+        && !A.GetIncompleteCholesky(factor))
+    {
+        preconditioner = PC_JACOBI;
+    }
+
+    std::vector<Real> invDiagonal;
+    if (preconditioner == PC_JACOBI)
+    {
+        invDiagonal.resize(N);
+        A.GetDiagonal(&invDiagonal[0]);
+        for (auto& value : invDiagonal)
+        {
+            value = (value != (Real)0 ? (Real)1 / value : (Real)1);
+        }
+    }
+
+    std::vector<Real> tmpR(N), tmpZ(N), tmpP(N), tmpW(N);
+    Real* R = &tmpR[0];
+    Real* Z = &tmpZ[0];
+    Real* P = &tmpP[0];
+    Real* W = &tmpW[0];
+
+    // The threads are started once and each thread runs all iterations on
+    // the rows [partition[t],partition[t+1]).  A barrier separates the
+    // phases in which a thread reads values written by other threads.  The
+    // dot products are computed with the vector updates and then summed in
+    // thread order by every thread, so all threads compute the same alpha
+    // and beta and terminate after the same iteration.
+    numThreads = ParallelFor::GetNumThreads(numThreads, N);
+    std::vector<int> partition;
+    A.GetRowPartition(numThreads, partition);
+    Barrier barrier(numThreads);
+    std::vector<Real> partialPW(numThreads), partialRR(numThreads);
+    std::vector<Real> partialRZ(numThreads);
+    auto Sum = [](std::vector<Real> const& partial)
+    {
+        Real sum = (Real)0;
+        for (auto const& value : partial)
+        {
+            sum += value;
+        }
+        return sum;
+    };
+
+    unsigned int numIterations = 0;
+    ParallelFor::Execute(numThreads, [&](unsigned int t)
+    {
+        int const imin = partition[t], imax = partition[t + 1];
+
+        // Solve M*Z = R for the preconditioner M and compute the partial
+        // sum of Dot(R,Z).  The incomplete Cholesky solves are sequential
+        // and are done by thread 0.
+        auto Precondition = [&]()
+        {
+            Real rz = (Real)0;
+            if (preconditioner == PC_INCOMPLETE_CHOLESKY)
+            {
+                barrier.Wait();
+                if (t == 0)
+                {
+                    std::copy(R, R + N, Z);
+                    factor.SolveLower(Z);
+                    factor.SolveLowerTranspose(Z);
+                }
+                barrier.Wait();
+                for (int i = imin; i < imax; ++i)
+                {
+                    rz += R[i] * Z[i];
+                }
+            }
+            else if (preconditioner == PC_JACOBI)
+            {
+                Real const* D = &invDiagonal[0];
+                for (int i = imin; i < imax; ++i)
+                {
+                    Z[i] = D[i] * R[i];
+                    rz += R[i] * Z[i];
+                }
+            }
+            else
+            {
+                for (int i = imin; i < imax; ++i)
+                {
+                    Z[i] = R[i];
+                    rz += R[i] * Z[i];
+                }
+            }
+            partialRZ[t] = rz;
+        };
+
+        Real bb = (Real)0;
+        for (int i = imin; i < imax; ++i)
+        {
+            X[i] = (Real)0;
+            R[i] = B[i];
+            bb += B[i] * B[i];
+        }
+        partialRR[t] = bb;
+        barrier.Wait();
+        Real const normB = sqrt(Sum(partialRR));
+        if (normB == (Real)0)
+        {
+            return;
+        }
+
+        Precondition();
+        for (int i = imin; i < imax; ++i)
+        {
+            P[i] = Z[i];
+        }
+        barrier.Wait();
+        Real rho = Sum(partialRZ);
+
+        unsigned int iteration = 0;
+        while (iteration < maxIterations)
+        {
+            A.Multiply(imin, imax, P, W);
+            Real pw = (Real)0;
+            for (int i = imin; i < imax; ++i)
+            {
+                pw += P[i] * W[i];
+            }
+            partialPW[t] = pw;
+            barrier.Wait();
+
+            Real const alpha = rho / Sum(partialPW);
+            Real rr = (Real)0;
+            for (int i = imin; i < imax; ++i)
+            {
+                X[i] += alpha * P[i];
+                R[i] -= alpha * W[i];
+                rr += R[i] * R[i];
+            }
+            partialRR[t] = rr;
+            if (preconditioner != PC_INCOMPLETE_CHOLESKY)
+            {
+                // The preconditioned residual is computed with the update
+                // and is wasted only by the last iteration.
+                Precondition();
+            }
+            barrier.Wait();
+
+            ++iteration;
+            if (sqrt(Sum(partialRR)) <= tolerance * normB)
+            {
+                break;
+            }
+
+            if (preconditioner == PC_INCOMPLETE_CHOLESKY)
+            {
+                Precondition();
+                barrier.Wait();
+            }
+            Real const rhoNext = Sum(partialRZ);
+            Real const beta = rhoNext / rho;
+            rho = rhoNext;
+            for (int i = imin; i < imax; ++i)
+            {
+                P[i] = Z[i] + beta * P[i];
+            }
+            barrier.Wait();
+        }
+
+        if (t == 0)
+        {
+            numIterations = iteration;
+        }
+    });
+    return numIterations;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 Real LinearSystem<Real>::Dot(int N, Real const* U, Real const* V)
 {
     Real dot = (Real)0;
@@ -263,24 +450,6 @@ void LinearSystem<Real>::Mul(int N, Real const* A, Real const* X, Real* P)
 }
 //----------------------------------------------------------------------------
 template <typename Real>
-void LinearSystem<Real>::Mul(int N, SparseMatrix const& A, Real const* X,
-    Real* P)
-{
-    memset(P, 0, N * sizeof(Real));
-    for (auto const& element : A)
-    {
-        int i = element.first[0];
-        int j = element.first[1];
-        Real value = element.second;
-        P[i] += value * X[j];
-        if (i != j)
-        {
-            P[j] += value * X[i];
-        }
-    }
-}
-//----------------------------------------------------------------------------
-template <typename Real>
 void LinearSystem<Real>::UpdateX(int N, Real* X, Real alpha, Real const* P)
 {
     for (int i = 0; i < N; ++i)
@@ -9,6 +9,8 @@
 
 #include "GteVector.h"
 #include "GteLogger.h"
+#include "GteParallelFor.h"
+#include <thread>
 #include <vector>
 
 namespace gte
@@ -23,13 +25,22 @@ namespace gte
 // 'Vector<N,Real> GetPosition () const'.  The Site template parameter
 // allows the query to be applied even when it has more local information
 // than just point location.
+//
+// The nodes are stored in depth-first (preorder) layout, so the left child
+// of a node immediately follows it in memory and the subtree of a node is a
+// contiguous block of nodes.  The site positions of a leaf are stored in a
+// contiguous block as a structure of arrays: the first coordinates of its
+// sites, then the second coordinates, and so on.  The subtrees of a node
+// are built from disjoint subranges of the sites, so the upper levels of the
+// tree are built on multiple threads when requested.
 template <int N, typename Real, typename Site, int MaxNeighbors>
 class NearestNeighborQuery
 {
 public:
-    // Construction.
+    // Construction.  The kd-tree is built using 'numThreads' threads; the
+    // value 0 or 1 builds it on the calling thread.
     NearestNeighborQuery(std::vector<Site> const& sites, int maxLeafSize,
-        int maxLevel);
+        int maxLevel, unsigned int numThreads = 1);
 
     // Member access.
     inline int GetMaxLeafSize () const;
@@ -42,6 +53,35 @@ public:
     int FindNeighbors(Vector<N,Real> const& point, Real radius,
         std::array<int, MaxNeighbors>& neighbors) const;
 
+    // Compute the k nearest neighbors of the point, where k is specified at
+    // run time and there is no radius constraint.  The caller must provide
+    // arrays of at least k elements.  The returned integer is min(k,S),
+    // where S is the number of sites.  The neighbors are sorted by
+    // increasing distance; neighbors[] stores indices into the array passed
+    // to the constructor and sqrDistances[] stores the squared distances.
+    // The search uses the sqrDistances[] array as a bounded max-heap, so no
+    // memory is allocated.
+    int FindNearest(Vector<N, Real> const& point, int k, int* neighbors,
+        Real* sqrDistances) const;
+
+    // Batched queries for numPoints points.  The outputs are flat arrays.
+    // For FindNeighbors, neighbors[] has numPoints*MaxNeighbors elements and
+    // numNeighbors[] has numPoints elements; the neighbors of points[i] are
+    // neighbors[i*MaxNeighbors+j] for 0 <= j < numNeighbors[i].  For
+    // FindNearest, neighbors[] and sqrDistances[] have numPoints*k elements
+    // and the results for points[i] start at index i*k.  When there are
+    // fewer than k sites, the unused elements are set to -1 and to
+    // std::numeric_limits<Real>::max().  The queries are partitioned among
+    // 'numThreads' threads; the value 0 or 1 executes the queries on the
+    // calling thread.
+    void FindNeighbors(int numPoints, Vector<N, Real> const* points,
+        Real radius, int* neighbors, int* numNeighbors,
+        unsigned int numThreads = 1) const;
+
+    void FindNearest(int numPoints, Vector<N, Real> const* points, int k,
+        int* neighbors, Real* sqrDistances, unsigned int numThreads = 1)
+        const;
+
 private:
     typedef std::pair<Vector<N, Real>, int> SortedPoint;
 
@@ -55,9 +95,23 @@ private:
         int right;
     };
 
-    // Populate the node so that it contains the points split along the
-    // coordinate axes.
-    void Build(int numSites, int siteOffset, int nodeIndex, int level);
+    // Create the nodes in preorder.  The tree shape depends only on the
+    // number of sites, because each split is at the median, so the nodes are
+    // created before any sorting.  The returned value is the node index.
+    int CreateNodes(int numSites, int siteOffset, int level);
+
+    // Split the sites of the subtree rooted at the node at the medians along
+    // the coordinate axes, and copy the sites of the leaves to the position
+    // arrays.  The sites of the subtree start at index siteOffset.  The
+    // subtrees are processed on separate threads while numThreads is larger
+    // than 1.
+    void Build(int nodeIndex, int siteOffset, unsigned int numThreads);
+
+    // Support for the k-nearest query.  The heap is a max-heap on the
+    // squared distances, with the neighbor indices moved in parallel.
+    static void HeapSiftUp(int* neighbors, Real* sqrDistances, int i);
+    static void HeapSiftDown(int* neighbors, Real* sqrDistances, int i,
+        int numElements);
 
     // Helper class for sorting along axes.
     class SortFunctor
@@ -72,8 +126,16 @@ private:
 
     int mMaxLeafSize;
     int mMaxLevel;
-    std::vector<SortedPoint> mSortedPoints;
     std::vector<Node> mNodes;
+
+    // The sites sorted into the leaves.  The sorted points are required only
+    // during construction.  For a leaf with m sites starting at sorted
+    // index j0, coordinate d of the sorted site j0+i is
+    // mPositions[N*j0+d*m+i], and mSiteIndices[j0+i] is the index of that
+    // site in the array passed to the constructor.
+    std::vector<SortedPoint> mSortedPoints;
+    std::vector<Real> mPositions;
+    std::vector<int> mSiteIndices;
 };
 
 #include "GteNearestNeighborQuery.inl"
@@ -8,20 +8,26 @@
 //----------------------------------------------------------------------------
 template <int N, typename Real, typename Site, int MaxNeighbors>
 NearestNeighborQuery<N, Real, Site, MaxNeighbors>::NearestNeighborQuery(
-    std::vector<Site> const& sites, int maxLeafSize, int maxLevel)
+    std::vector<Site> const& sites, int maxLeafSize, int maxLevel,
+    unsigned int numThreads)
     :
     mMaxLeafSize(maxLeafSize),
     mMaxLevel(maxLevel),
-    mSortedPoints(sites.size())
+    mSortedPoints(sites.size()),
+    mPositions(N * sites.size()),
+    mSiteIndices(sites.size())
 {
     int const numSites = static_cast<int>(sites.size());
+    LogAssert(numSites > 0, "Empty point list.");
     for (int i = 0; i < numSites; ++i)
     {
         mSortedPoints[i] = std::make_pair(sites[i].GetPosition(), i);
     }
+    CreateNodes(numSites, 0, 0);
+    Build(0, 0, numThreads);
 
-    mNodes.push_back(Node());
-    Build(numSites, 0, 0, 0);
+    // The sorted points are no longer needed.
+    std::vector<SortedPoint>().swap(mSortedPoints);
 }
 //----------------------------------------------------------------------------
 template <int N, typename Real, typename Site, int MaxNeighbors> inline
@@ -60,14 +66,20 @@ int NearestNeighborQuery<N, Real, Site, MaxNeighbors>::FindNeighbors(
 
     while (top >= 0)
     {
-        Node node = mNodes[stack[top--]];
+        Node const& node = mNodes[stack[top--]];
 
         if (node.siteOffset != -1)
         {
+            Real const* positions =
+                &mPositions[N * static_cast<size_t>(node.siteOffset)];
             for (int i = 0, j = node.siteOffset; i < node.numSites; ++i, ++j)
             {
-                Vector<N, Real> diff = mSortedPoints[j].first - point;
-                Real sqrLength = Dot(diff, diff);
+                Real sqrLength = (Real)0;
+                for (int d = 0; d < N; ++d)
+                {
+                    Real diff = positions[d * node.numSites + i] - point[d];
+                    sqrLength += diff * diff;
+                }
                 if (sqrLength <= sqrRadius)
                 {
                     // Maintain the nearest neighbors.
@@ -86,7 +98,7 @@ int NearestNeighborQuery<N, Real, Site, MaxNeighbors>::FindNeighbors(
                     }
                     if (k < MaxNeighbors)
                     {
-                        localNeighbors[k] = mSortedPoints[j].second;
+                        localNeighbors[k] = mSiteIndices[j];
                         neighborSqrLength[k] = sqrLength;
                     }
                     if (numNeighbors < MaxNeighbors)
@@ -117,57 +129,226 @@ int NearestNeighborQuery<N, Real, Site, MaxNeighbors>::FindNeighbors(
 }
 //----------------------------------------------------------------------------
 template <int N, typename Real, typename Site, int MaxNeighbors>
-void NearestNeighborQuery<N, Real, Site, MaxNeighbors>::Build(int numSites,
-    int siteOffset, int nodeIndex, int level)
+int NearestNeighborQuery<N, Real, Site, MaxNeighbors>::FindNearest(
+    Vector<N, Real> const& point, int k, int* neighbors, Real* sqrDistances)
+    const
 {
-    LogAssert(siteOffset != -1, "Invalid site offset.");
-    LogAssert(nodeIndex != -1, "Invalid node index.");
-    LogAssert(numSites > 0, "Empty point list.");
+    if (k <= 0)
+    {
+        return 0;
+    }
 
-    Node& node = mNodes[nodeIndex];
-    node.numSites = numSites;
+    // The nodes are visited depth first, the child containing the point
+    // before the other child.  The stack stores each node with a lower
+    // bound on the squared distance from the point to the sites of the
+    // node.  The sites of a left child have coordinates no larger than the
+    // split value and those of a right child have coordinates no smaller
+    // than it, so the squared distance to the splitting plane is a lower
+    // bound for the child not containing the point.  A node is skipped when
+    // k neighbors are known and its bound is larger than the largest of
+    // their squared distances.  Each internal node pushes two children and
+    // the tree depth is at most 32 (see FindNeighbors), so the stack size
+    // is sufficient.
+    std::array<std::pair<int, Real>, 64> stack;
+    int top = 0;
+    stack[0] = std::make_pair(0, (Real)0);
+    int numNeighbors = 0;
+
+    while (top >= 0)
+    {
+        std::pair<int, Real> item = stack[top--];
+        if (numNeighbors == k && item.second > sqrDistances[0])
+        {
+            continue;
+        }
+
+        Node const& node = mNodes[item.first];
+        if (node.siteOffset != -1)
+        {
+            Real const* positions =
+                &mPositions[N * static_cast<size_t>(node.siteOffset)];
+            for (int i = 0, j = node.siteOffset; i < node.numSites; ++i, ++j)
+            {
+                Real sqrLength = (Real)0;
+                for (int d = 0; d < N; ++d)
+                {
+                    Real diff = positions[d * node.numSites + i] - point[d];
+                    sqrLength += diff * diff;
+                }
+                if (numNeighbors < k)
+                {
+                    neighbors[numNeighbors] = mSiteIndices[j];
+                    sqrDistances[numNeighbors] = sqrLength;
+                    HeapSiftUp(neighbors, sqrDistances, numNeighbors);
+                    ++numNeighbors;
+                }
+                else if (sqrLength < sqrDistances[0])
+                {
+                    neighbors[0] = mSiteIndices[j];
+                    sqrDistances[0] = sqrLength;
+                    HeapSiftDown(neighbors, sqrDistances, 0, numNeighbors);
+                }
+            }
+        }
+        else
+        {
+            Real delta = point[node.axis] - node.split;
+            Real bound = std::max(item.second, delta * delta);
+            if (delta <= (Real)0)
+            {
+                stack[++top] = std::make_pair(node.right, bound);
+                stack[++top] = std::make_pair(node.left, item.second);
+            }
+            else
+            {
+                stack[++top] = std::make_pair(node.left, bound);
+                stack[++top] = std::make_pair(node.right, item.second);
+            }
+        }
+    }
+
+    // Sort the heap so that the neighbors are in increasing order of
+    // distance.
+    for (int i = numNeighbors - 1; i > 0; --i)
+    {
+        std::swap(neighbors[0], neighbors[i]);
+        std::swap(sqrDistances[0], sqrDistances[i]);
+        HeapSiftDown(neighbors, sqrDistances, 0, i);
+    }
+    return numNeighbors;
+}
+//----------------------------------------------------------------------------
+template <int N, typename Real, typename Site, int MaxNeighbors>
+void NearestNeighborQuery<N, Real, Site, MaxNeighbors>::FindNeighbors(
+    int numPoints, Vector<N, Real> const* points, Real radius,
+    int* neighbors, int* numNeighbors, unsigned int numThreads) const
+{
+    ParallelFor::Execute(numPoints, numThreads,
+        [this, points, radius, neighbors, numNeighbors](int imin, int imax)
+        {
+            std::array<int, MaxNeighbors> local;
+            for (int i = imin; i < imax; ++i)
+            {
+                int numLocal = FindNeighbors(points[i], radius, local);
+                std::copy(local.begin(), local.begin() + numLocal,
+                    neighbors + static_cast<size_t>(i) * MaxNeighbors);
+                numNeighbors[i] = numLocal;
+            }
+        });
+}
+//----------------------------------------------------------------------------
+template <int N, typename Real, typename Site, int MaxNeighbors>
+void NearestNeighborQuery<N, Real, Site, MaxNeighbors>::FindNearest(
+    int numPoints, Vector<N, Real> const* points, int k, int* neighbors,
+    Real* sqrDistances, unsigned int numThreads) const
+{
+    if (k <= 0)
+    {
+        return;
+    }
+
+    ParallelFor::Execute(numPoints, numThreads,
+        [this, points, k, neighbors, sqrDistances](int imin, int imax)
+        {
+            for (int i = imin; i < imax; ++i)
+            {
+                size_t offset = static_cast<size_t>(i) * k;
+                int numFound = FindNearest(points[i], k, neighbors + offset,
+                    sqrDistances + offset);
+                for (int j = numFound; j < k; ++j)
+                {
+                    neighbors[offset + j] = -1;
+                    sqrDistances[offset + j] =
+                        std::numeric_limits<Real>::max();
+                }
+            }
+        });
+}
+//----------------------------------------------------------------------------
+template <int N, typename Real, typename Site, int MaxNeighbors>
+int NearestNeighborQuery<N, Real, Site, MaxNeighbors>::CreateNodes(
+    int numSites, int siteOffset, int level)
+{
+    int nodeIndex = static_cast<int>(mNodes.size());
+    mNodes.push_back(Node());
+    mNodes[nodeIndex].numSites = numSites;
 
     if (numSites > mMaxLeafSize && level <= mMaxLevel)
     {
-        int halfNumSites = numSites/2;
-
-        // The point set is too large for a leaf node, so split it at the
-        // median.  The O(m log m) sort is not needed; rather, we locate the
-        // median using an order statistic construction that is expected
-        // time O(m).
-        int const axis = level % N;
-        SortFunctor sorter(axis);
-        auto begin = mSortedPoints.begin() + siteOffset;
-        auto mid = mSortedPoints.begin() + siteOffset + halfNumSites;
-        auto end = mSortedPoints.begin() + siteOffset + numSites;
-        std::nth_element(begin, mid, end, sorter);
+        // The point set is too large for a leaf node, so it will be split
+        // at the median.  The split value is computed by Build.
+        int halfNumSites = numSites / 2;
+        int nextLevel = level + 1;
+        int left = CreateNodes(halfNumSites, siteOffset, nextLevel);
+        int right = CreateNodes(numSites - halfNumSites,
+            siteOffset + halfNumSites, nextLevel);
 
-        // Get the median position.
-        node.split = mSortedPoints[siteOffset + halfNumSites].first[axis];
-        node.axis = axis;
+        Node& node = mNodes[nodeIndex];
+        node.split = (Real)0;
+        node.axis = level % N;
         node.siteOffset = -1;
-        
-        // Apply a divide-and-conquer step.
-        int left = (int)mNodes.size(), right = left + 1;
         node.left = left;
         node.right = right;
-        mNodes.push_back(Node());
-        mNodes.push_back(Node());
-
-        int nextLevel = level + 1;
-        Build(halfNumSites, siteOffset, left, nextLevel);
-        Build(numSites - halfNumSites, siteOffset + halfNumSites, right,
-            nextLevel);
     }
     else
     {
         // The number of points is small enough, so make this node a leaf.
+        Node& node = mNodes[nodeIndex];
         node.split = std::numeric_limits<Real>::max();
         node.axis = -1;
         node.siteOffset = siteOffset;
         node.left = -1;
         node.right = -1;
     }
+    return nodeIndex;
+}
+//----------------------------------------------------------------------------
+template <int N, typename Real, typename Site, int MaxNeighbors>
+void NearestNeighborQuery<N, Real, Site, MaxNeighbors>::Build(int nodeIndex,
+    int siteOffset, unsigned int numThreads)
+{
+    Node& node = mNodes[nodeIndex];
+    if (node.siteOffset == -1)
+    {
+        // Locate the median using an order statistic construction that is
+        // expected time O(m); the O(m log m) sort is not needed.  The left
+        // child has the first half of the sites of the node.
+        int const halfNumSites = mNodes[node.left].numSites;
+        SortFunctor sorter(node.axis);
+        auto begin = mSortedPoints.begin() + siteOffset;
+        auto mid = begin + halfNumSites;
+        auto end = begin + node.numSites;
+        std::nth_element(begin, mid, end, sorter);
+        node.split = mid->first[node.axis];
+
+        // Apply a divide-and-conquer step.
+        if (numThreads > 1)
+        {
+            std::thread leftThread(&NearestNeighborQuery::Build, this,
+                node.left, siteOffset, numThreads / 2);
+            Build(node.right, siteOffset + halfNumSites,
+                numThreads - numThreads / 2);
+            leftThread.join();
+        }
+        else
+        {
+            Build(node.left, siteOffset, 1);
+            Build(node.right, siteOffset + halfNumSites, 1);
+        }
+    }
+    else
+    {
+        // Copy the sites of the leaf to its block of positions.
+        Real* positions = &mPositions[N * static_cast<size_t>(siteOffset)];
+        for (int i = 0, j = siteOffset; i < node.numSites; ++i, ++j)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                positions[d * node.numSites + i] = mSortedPoints[j].first[d];
+            }
+            mSiteIndices[j] = mSortedPoints[j].second;
+        }
+    }
 }
 //----------------------------------------------------------------------------
 template <int N, typename Real, typename Site, int MaxNeighbors> inline
@@ -185,3 +366,49 @@ operator()(SortedPoint const& sorted0, SortedPoint const& sorted1) const
     return sorted0.first[mAxis] < sorted1.first[mAxis];
 }
 //----------------------------------------------------------------------------
+template <int N, typename Real, typename Site, int MaxNeighbors>
+void NearestNeighborQuery<N, Real, Site, MaxNeighbors>::HeapSiftUp(
+    int* neighbors, Real* sqrDistances, int i)
+{
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (!(sqrDistances[parent] < sqrDistances[i]))
+        {
+            break;
+        }
+        std::swap(neighbors[parent], neighbors[i]);
+        std::swap(sqrDistances[parent], sqrDistances[i]);
+        i = parent;
+    }
+}
+//----------------------------------------------------------------------------
+template <int N, typename Real, typename Site, int MaxNeighbors>
+void NearestNeighborQuery<N, Real, Site, MaxNeighbors>::HeapSiftDown(
+    int* neighbors, Real* sqrDistances, int i, int numElements)
+{
+    for (;;)
+    {
+        int largest = i;
+        int child = 2 * i + 1;
+        if (child < numElements
+            && sqrDistances[largest] < sqrDistances[child])
+        {
+            largest = child;
+        }
+        ++child;
+        if (child < numElements
+            && sqrDistances[largest] < sqrDistances[child])
+        {
+            largest = child;
+        }
+        if (largest == i)
+        {
+            break;
+        }
+        std::swap(neighbors[largest], neighbors[i]);
+        std::swap(sqrDistances[largest], sqrDistances[i]);
+        i = largest;
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,52 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Support for splitting a computation among threads.  Each Execute call
+// starts a std::thread per task and joins all of them before returning, so
+// the tasks of a call may share data that is read-only during the call.
+// When only one task is required, it is called on the calling thread and no
+// thread is started.
+
+namespace gte
+{
+
+class ParallelFor
+{
+public:
+    // The number of ranges into which numItems items are split for
+    // numThreads threads, which is numThreads clamped to [1,numItems], or 1
+    // when numItems <= 0.
+    inline static unsigned int GetNumThreads(unsigned int numThreads,
+        int numItems);
+
+    // The range [imin,imax) of thread t when numItems items are split into
+    // numThreads contiguous ranges.  The ranges are in increasing order and
+    // their sizes differ by at most 1.
+    inline static void GetRange(int numItems, unsigned int numThreads,
+        unsigned int t, int& imin, int& imax);
+
+    // Call task(t) for 0 <= t < numThreads.
+    template <typename Task>
+    static void Execute(unsigned int numThreads, Task const& task);
+
+    // Split [0,numItems) into GetNumThreads(numThreads,numItems) ranges and
+    // call task(imin,imax) for each range [imin,imax).
+    template <typename Task>
+    static void Execute(int numItems, unsigned int numThreads,
+        Task const& task);
+};
+
+#include "GteParallelFor.inl"
+
+}
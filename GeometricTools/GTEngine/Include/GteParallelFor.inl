@@ -0,0 +1,68 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+inline unsigned int ParallelFor::GetNumThreads(unsigned int numThreads,
+    int numItems)
+{
+    if (numItems <= 0 || numThreads < 1)
+    {
+        return 1;
+    }
+    if (numThreads > (unsigned int)numItems)
+    {
+        return (unsigned int)numItems;
+    }
+    return numThreads;
+}
+//----------------------------------------------------------------------------
+inline void ParallelFor::GetRange(int numItems, unsigned int numThreads,
+    unsigned int t, int& imin, int& imax)
+{
+    imin = (int)(((int64_t)numItems*t)/numThreads);
+    imax = (int)(((int64_t)numItems*(t + 1))/numThreads);
+}
+//----------------------------------------------------------------------------
+template <typename Task>
+void ParallelFor::Execute(unsigned int numThreads, Task const& task)
+{
+    if (numThreads <= 1)
+    {
+        task(0u);
+        return;
+    }
+
+    std::vector<std::thread> process(numThreads);
+    for (unsigned int t = 0; t < numThreads; ++t)
+    {
+        process[t] = std::thread([&task, t]() { task(t); });
+    }
+    for (unsigned int t = 0; t < numThreads; ++t)
+    {
+        process[t].join();
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Task>
+void ParallelFor::Execute(int numItems, unsigned int numThreads,
+    Task const& task)
+{
+    numThreads = GetNumThreads(numThreads, numItems);
+    if (numThreads == 1)
+    {
+        task(0, numItems);
+        return;
+    }
+
+    Execute(numThreads, [numItems, numThreads, &task](unsigned int t)
+    {
+        int imin, imax;
+        GetRange(numItems, numThreads, t, imin, imax);
+        task(imin, imax);
+    });
+}
+//----------------------------------------------------------------------------
@@ -8,6 +8,12 @@
 #pragma once
 
 #include "GteVector2.h"
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 // Queries about the relation of a point to various geometric objects.
 
@@ -20,15 +26,60 @@ class PrimalQuery2
 public:
     // The caller is responsible for ensuring that the array is not empty
     // before calling queries and that the indices passed to the queries are
-    // valid.  The class does no range checking.
+    // valid.  The class does no range checking.  The filter (see the comments
+    // for SetFilter) is enabled by default when Real is not a floating-point
+    // type.
     PrimalQuery2();
     PrimalQuery2(int numVertices, Vector2<Real> const* vertices);
 
+    // The counters (see SetCounting) are atomic, so copying is implemented
+    // explicitly.  The copy receives the current counts.
+    PrimalQuery2(PrimalQuery2 const& query);
+    PrimalQuery2& operator=(PrimalQuery2 const& query);
+
     // Member access.
-    inline void Set(int numVertices, Vector2<Real> const* vertices);
+    void Set(int numVertices, Vector2<Real> const* vertices);
     inline int GetNumVertices() const;
     inline Vector2<Real> const* GetVertices() const;
 
+    // Filtered predicates.  When Real is an arbitrary-precision type such as
+    // BSNumber or BSRational, most queries are not close to degenerate and
+    // their signs are determined correctly by floating-point arithmetic.
+    // When the filter is enabled, ToLine, ToTriangle and ToCircumcircle
+    // first compute their determinants in double precision together with an
+    // error bound proportional to the permanent of the determinant (the
+    // same expression evaluated with absolute values of the terms).  If the
+    // magnitude of the determinant exceeds the bound, its sign is exact and
+    // is returned; otherwise, the query is computed using Real.  The bounds
+    // follow the forward error analysis in
+    //   J. R. Shewchuk, "Adaptive precision floating-point arithmetic and
+    //   fast robust geometric predicates", Discrete & Computational
+    //   Geometry 18(3), pp. 305-363, 1997.
+    // applied to the evaluation orders used here.  The double-precision
+    // copies of the vertices are made by Set (or SetFilter), so if you
+    // modify the vertices afterwards, you must call Set again.  A coordinate
+    // participates in the filter only when it is exactly representable as a
+    // double and is zero or has magnitude in [2^{-100},2^{100}], a range in
+    // which the intermediate terms neither overflow nor underflow; queries
+    // involving other coordinates are always computed using Real.  Enabling
+    // the filter when Real is float changes the results, because some signs
+    // are then computed more accurately than float arithmetic allows.
+    void SetFilter(bool useFilter);
+    inline bool GetFilter() const;
+
+    // Optional statistics for the filter, disabled by default.  When counting
+    // is enabled, the queries evaluated while the filter is enabled are
+    // counted, as are those for which the filter was inconclusive and Real
+    // arithmetic was required.  The counters are atomic and are incremented
+    // with relaxed ordering, so the const queries may be called concurrently
+    // from multiple threads.  When counting is disabled, the queries do not
+    // write to the object.
+    void SetCounting(bool counting);
+    inline bool GetCounting() const;
+    inline uint64_t GetNumFilterQueries() const;
+    inline uint64_t GetNumExactQueries() const;
+    void ResetFilterCounts();
+
     // In the following, point P refers to vertices[i] or 'test' and Vi refers
     // to vertices[vi].
 
@@ -90,8 +141,36 @@ public:
         Vector2<Real> const& Q1) const;
 
 private:
+    // Conversion of a coordinate to double for the filter.  The returned
+    // value is a quiet NaN when the coordinate does not participate in the
+    // filter, which forces the filtered queries to be inconclusive.
+    static double ToFilter(Real const& value);
+    void ConvertFilterVertices();
+
+    // The filtered determinants.  The functions return 'true' when the sign
+    // of the determinant is certain, in which case 'sign' is set to it.
+    bool FilterToLine(Vector2<double> const& test, int v0, int v1,
+        int& sign) const;
+    bool FilterToCircumcircle(Vector2<double> const& test, int v0, int v1,
+        int v2, int& sign) const;
+
+    // Increment the counters when counting is enabled.
+    inline void CountFilterQuery() const;
+    inline void CountExactQuery() const;
+
+    // The queries computed using Real.
+    int ExactToLine(Vector2<Real> const& test, int v0, int v1) const;
+    int ExactToLine(Vector2<Real> const& test, int v0, int v1, int& order)
+        const;
+    int ExactToCircumcircle(Vector2<Real> const& test, int v0, int v1,
+        int v2) const;
+
     int mNumVertices;
     Vector2<Real> const* mVertices;
+    bool mUseFilter;
+    std::vector<Vector2<double>> mFilterVertices;
+    bool mCounting;
+    mutable std::atomic<uint64_t> mNumFilterQueries, mNumExactQueries;
 };
 
 #include "GtePrimalQuery2.inl"
@@ -10,7 +10,11 @@ template <typename Real>
 PrimalQuery2<Real>::PrimalQuery2()
     :
     mNumVertices(0),
-    mVertices(nullptr)
+    mVertices(nullptr),
+    mUseFilter(!std::is_floating_point<Real>::value),
+    mCounting(false),
+    mNumFilterQueries(0),
+    mNumExactQueries(0)
 {
 }
 //----------------------------------------------------------------------------
@@ -19,15 +23,48 @@ PrimalQuery2<Real>::PrimalQuery2(int numVertices,
     Vector2<Real> const* vertices)
     :
     mNumVertices(numVertices),
-    mVertices(vertices)
+    mVertices(vertices),
+    mUseFilter(!std::is_floating_point<Real>::value),
+    mCounting(false),
+    mNumFilterQueries(0),
+    mNumExactQueries(0)
 {
+    ConvertFilterVertices();
 }
 //----------------------------------------------------------------------------
-template <typename Real> inline
+template <typename Real>
+PrimalQuery2<Real>::PrimalQuery2(PrimalQuery2 const& query)
+    :
+    mNumVertices(query.mNumVertices),
+    mVertices(query.mVertices),
+    mUseFilter(query.mUseFilter),
+    mFilterVertices(query.mFilterVertices),
+    mCounting(query.mCounting),
+    mNumFilterQueries(query.GetNumFilterQueries()),
+    mNumExactQueries(query.GetNumExactQueries())
+{
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+PrimalQuery2<Real>& PrimalQuery2<Real>::operator=(PrimalQuery2 const& query)
+{
+    mNumVertices = query.mNumVertices;
+    mVertices = query.mVertices;
+    mUseFilter = query.mUseFilter;
+    mFilterVertices = query.mFilterVertices;
+    mCounting = query.mCounting;
+    mNumFilterQueries.store(query.GetNumFilterQueries(),
+        std::memory_order_relaxed);
+    mNumExactQueries.store(query.GetNumExactQueries(),
+        std::memory_order_relaxed);
+    return *this;
+}
+template <typename Real>
 void PrimalQuery2<Real>::Set(int numVertices, Vector2<Real> const* vertices)
 {
     mNumVertices = numVertices;
     mVertices = vertices;
+    ConvertFilterVertices();
 }
 //----------------------------------------------------------------------------
 template <typename Real> inline
@@ -43,101 +80,141 @@ Vector2<Real> const* PrimalQuery2<Real>::GetVertices() const
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+void PrimalQuery2<Real>::SetFilter(bool useFilter)
+{
+    mUseFilter = useFilter;
+    ConvertFilterVertices();
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+bool PrimalQuery2<Real>::GetFilter() const
+{
+    return mUseFilter;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void PrimalQuery2<Real>::SetCounting(bool counting)
+{
+    mCounting = counting;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+bool PrimalQuery2<Real>::GetCounting() const
+{
+    return mCounting;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+uint64_t PrimalQuery2<Real>::GetNumFilterQueries() const
+{
+    return mNumFilterQueries.load(std::memory_order_relaxed);
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+uint64_t PrimalQuery2<Real>::GetNumExactQueries() const
+{
+    return mNumExactQueries.load(std::memory_order_relaxed);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void PrimalQuery2<Real>::ResetFilterCounts()
+{
+    mNumFilterQueries.store(0, std::memory_order_relaxed);
+    mNumExactQueries.store(0, std::memory_order_relaxed);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 int PrimalQuery2<Real>::ToLine(int i, int v0, int v1) const
 {
-    return ToLine(mVertices[i], v0, v1);
+    if (mUseFilter)
+    {
+        CountFilterQuery();
+        int sign;
+        if (FilterToLine(mFilterVertices[i], v0, v1, sign))
+        {
+            return sign;
+        }
+        CountExactQuery();
+    }
+    return ExactToLine(mVertices[i], v0, v1);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 int PrimalQuery2<Real>::ToLine(Vector2<Real> const& test, int v0, int v1)
     const
 {
-    Vector2<Real> const& vec0 = mVertices[v0];
-    Vector2<Real> const& vec1 = mVertices[v1];
-
-    Real x0 = test[0] - vec0[0];
-    Real y0 = test[1] - vec0[1];
-    Real x1 = vec1[0] - vec0[0];
-    Real y1 = vec1[1] - vec0[1];
-    Real x0y1 = x0*y1;
-    Real x1y0 = x1*y0;
-    Real det = x0y1 - x1y0;
-    Real zero = (Real)0;
-
-    return (det > zero ? +1 : (det < zero ? -1 : 0));
+    if (mUseFilter)
+    {
+        CountFilterQuery();
+        Vector2<double> ftest(ToFilter(test[0]), ToFilter(test[1]));
+        int sign;
+        if (FilterToLine(ftest, v0, v1, sign))
+        {
+            return sign;
+        }
+        CountExactQuery();
+    }
+    return ExactToLine(test, v0, v1);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 int PrimalQuery2<Real>::ToLine(int i, int v0, int v1, int& order) const
 {
-    return ToLine(mVertices[i], v0, v1, order);
+    if (mUseFilter)
+    {
+        CountFilterQuery();
+        int sign;
+        if (FilterToLine(mFilterVertices[i], v0, v1, sign) && sign != 0)
+        {
+            order = 3 * sign;
+            return sign;
+        }
+        CountExactQuery();
+    }
+    return ExactToLine(mVertices[i], v0, v1, order);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 int PrimalQuery2<Real>::ToLine(Vector2<Real> const& test, int v0, int v1,
     int& order) const
 {
-    Vector2<Real> const& vec0 = mVertices[v0];
-    Vector2<Real> const& vec1 = mVertices[v1];
-
-    Real x0 = test[0] - vec0[0];
-    Real y0 = test[1] - vec0[1];
-    Real x1 = vec1[0] - vec0[0];
-    Real y1 = vec1[1] - vec0[1];
-    Real x0y1 = x0*y1;
-    Real x1y0 = x1*y0;
-    Real det = x0y1 - x1y0;
-    Real zero = (Real)0;
-
-    if (det > zero)
+    if (mUseFilter)
     {
-        order = +3;
-        return +1;
+        CountFilterQuery();
+        Vector2<double> ftest(ToFilter(test[0]), ToFilter(test[1]));
+        int sign;
+        if (FilterToLine(ftest, v0, v1, sign) && sign != 0)
+        {
+            order = 3 * sign;
+            return sign;
+        }
+        CountExactQuery();
     }
-
-    if (det < zero)
+    return ExactToLine(test, v0, v1, order);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int PrimalQuery2<Real>::ToTriangle(int i, int v0, int v1, int v2) const
+{
+    int sign0 = ToLine(i, v1, v2);
+    if (sign0 > 0)
     {
-        order = -3;
-        return -1;
+        return +1;
     }
 
-    Real x0x1 = x0*x1;
-    Real y0y1 = y0*y1;
-    Real dot = x0x1 + y0y1;
-    if (dot == zero)
-    {
-        order = -1;
-    }
-    else if (dot < zero)
+    int sign1 = ToLine(i, v0, v2);
+    if (sign1 < 0)
     {
-        order = -2;
+        return +1;
     }
-    else
+
+    int sign2 = ToLine(i, v0, v1);
+    if (sign2 > 0)
     {
-        Real x0x0 = x0*x0;
-        Real y0y0 = y0*y0;
-        Real sqrlen = x0x0 + y0y0;
-        if (dot == sqrlen)
-        {
-            order = +1;
-        }
-        else if (dot > sqrlen)
-        {
-            order = +2;
-        }
-        else
-        {
-            order = 0;
-        }
+        return +1;
     }
 
-    return 0;
-}
-//----------------------------------------------------------------------------
-template <typename Real>
-int PrimalQuery2<Real>::ToTriangle(int i, int v0, int v1, int v2) const
-{
-    return ToTriangle(mVertices[i], v0, v1, v2);
+    return ((sign0 && sign1 && sign2) ? -1 : 0);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -168,56 +245,35 @@ int PrimalQuery2<Real>::ToTriangle(Vector2<Real> const& test, int v0, int v1,
 template <typename Real>
 int PrimalQuery2<Real>::ToCircumcircle(int i, int v0, int v1, int v2) const
 {
-    return ToCircumcircle(mVertices[i], v0, v1, v2);
+    if (mUseFilter)
+    {
+        CountFilterQuery();
+        int sign;
+        if (FilterToCircumcircle(mFilterVertices[i], v0, v1, v2, sign))
+        {
+            return sign;
+        }
+        CountExactQuery();
+    }
+    return ExactToCircumcircle(mVertices[i], v0, v1, v2);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 int PrimalQuery2<Real>::ToCircumcircle(Vector2<Real> const& test, int v0,
     int v1, int v2) const
 {
-    Vector2<Real> const& vec0 = mVertices[v0];
-    Vector2<Real> const& vec1 = mVertices[v1];
-    Vector2<Real> const& vec2 = mVertices[v2];
-
-    Real x0 = vec0[0] - test[0];
-    Real y0 = vec0[1] - test[1];
-    Real s00 = vec0[0] + test[0];
-    Real s01 = vec0[1] + test[1];
-    Real t00 = s00*x0;
-    Real t01 = s01*y0;
-    Real z0 = t00 + t01;
-
-    Real x1 = vec1[0] - test[0];
-    Real y1 = vec1[1] - test[1];
-    Real s10 = vec1[0] + test[0];
-    Real s11 = vec1[1] + test[1];
-    Real t10 = s10*x1;
-    Real t11 = s11*y1;
-    Real z1 = t10 + t11;
-
-    Real x2 = vec2[0] - test[0];
-    Real y2 = vec2[1] - test[1];
-    Real s20 = vec2[0] + test[0];
-    Real s21 = vec2[1] + test[1];
-    Real t20 = s20*x2;
-    Real t21 = s21*y2;
-    Real z2 = t20 + t21;
-
-    Real y0z1 = y0*z1;
-    Real y0z2 = y0*z2;
-    Real y1z0 = y1*z0;
-    Real y1z2 = y1*z2;
-    Real y2z0 = y2*z0;
-    Real y2z1 = y2*z1;
-    Real c0 = y1z2 - y2z1;
-    Real c1 = y2z0 - y0z2;
-    Real c2 = y0z1 - y1z0;
-    Real x0c0 = x0*c0;
-    Real x1c1 = x1*c1;
-    Real x2c2 = x2*c2;
-    Real term = x0c0 + x1c1;
-    Real det = term + x2c2;
-    return (det < (Real)0 ? 1 : (det > (Real)0 ? -1 : 0));
+    if (mUseFilter)
+    {
+        CountFilterQuery();
+        Vector2<double> ftest(ToFilter(test[0]), ToFilter(test[1]));
+        int sign;
+        if (FilterToCircumcircle(ftest, v0, v1, v2, sign))
+        {
+            return sign;
+        }
+        CountExactQuery();
+    }
+    return ExactToCircumcircle(test, v0, v1, v2);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -293,3 +349,282 @@ typename PrimalQuery2<Real>::OrderType PrimalQuery2<Real>::ToLineExtended(
     }
 }
 //----------------------------------------------------------------------------
+template <typename Real> inline
+void PrimalQuery2<Real>::CountFilterQuery() const
+{
+    if (mCounting)
+    {
+        mNumFilterQueries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+void PrimalQuery2<Real>::CountExactQuery() const
+{
+    if (mCounting)
+    {
+        mNumExactQueries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+double PrimalQuery2<Real>::ToFilter(Real const& value)
+{
+    double const minMagnitude = std::ldexp(1.0, -100);
+    double const maxMagnitude = std::ldexp(1.0, +100);
+    double result = static_cast<double>(value);
+    double magnitude = std::abs(result);
+    if ((magnitude == 0.0 || (minMagnitude <= magnitude
+        && magnitude <= maxMagnitude)) && static_cast<Real>(result) == value)
+    {
+        return result;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void PrimalQuery2<Real>::ConvertFilterVertices()
+{
+    if (mUseFilter && mVertices)
+    {
+        mFilterVertices.resize(mNumVertices);
+        for (int i = 0; i < mNumVertices; ++i)
+        {
+            mFilterVertices[i][0] = ToFilter(mVertices[i][0]);
+            mFilterVertices[i][1] = ToFilter(mVertices[i][1]);
+        }
+    }
+    else
+    {
+        mFilterVertices.clear();
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool PrimalQuery2<Real>::FilterToLine(Vector2<double> const& test, int v0,
+    int v1, int& sign) const
+{
+    Vector2<double> const& vec0 = mFilterVertices[v0];
+    Vector2<double> const& vec1 = mFilterVertices[v1];
+
+    double x0 = test[0] - vec0[0];
+    double y0 = test[1] - vec0[1];
+    double x1 = vec1[0] - vec0[0];
+    double y1 = vec1[1] - vec0[1];
+    double x0y1 = x0*y1;
+    double x1y0 = x1*y0;
+    double det = x0y1 - x1y0;
+
+    // Each term of the determinant has 2 rounded differences as factors and
+    // is affected by 2 more roundings, so the rounding error is bounded by
+    // (4+1)*epsilon*permanent, where epsilon = 2^{-53}.
+    double permanent = std::abs(x0y1) + std::abs(x1y0);
+    double errorBound = 5.0 * std::ldexp(1.0, -53) * permanent;
+    if (det > errorBound)
+    {
+        sign = +1;
+        return true;
+    }
+    if (det < -errorBound)
+    {
+        sign = -1;
+        return true;
+    }
+    if (permanent == 0.0)
+    {
+        // All terms are exactly zero, because the filter coordinates are
+        // chosen so that the products cannot underflow.
+        sign = 0;
+        return true;
+    }
+    return false;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool PrimalQuery2<Real>::FilterToCircumcircle(Vector2<double> const& test,
+    int v0, int v1, int v2, int& sign) const
+{
+    Vector2<double> const& vec0 = mFilterVertices[v0];
+    Vector2<double> const& vec1 = mFilterVertices[v1];
+    Vector2<double> const& vec2 = mFilterVertices[v2];
+
+    // The third column of the determinant uses the squared lengths of the
+    // differences rather than the z-values of ExactToCircumcircle.  The
+    // columns differ by a linear combination of the first two columns, so
+    // the determinants are equal.
+    double x0 = vec0[0] - test[0];
+    double y0 = vec0[1] - test[1];
+    double z0 = x0*x0 + y0*y0;
+    double x1 = vec1[0] - test[0];
+    double y1 = vec1[1] - test[1];
+    double z1 = x1*x1 + y1*y1;
+    double x2 = vec2[0] - test[0];
+    double y2 = vec2[1] - test[1];
+    double z2 = x2*x2 + y2*y2;
+
+    double y0z1 = y0*z1;
+    double y0z2 = y0*z2;
+    double y1z0 = y1*z0;
+    double y1z2 = y1*z2;
+    double y2z0 = y2*z0;
+    double y2z1 = y2*z1;
+    double c0 = y1z2 - y2z1;
+    double c1 = y2z0 - y0z2;
+    double c2 = y0z1 - y1z0;
+    double det = x0*c0 + x1*c1 + x2*c2;
+
+    // Each term of the determinant has 4 rounded differences as factors and
+    // is affected by 7 more roundings, so the rounding error is bounded by
+    // (11+1)*epsilon*permanent, where epsilon = 2^{-53}.
+    double permanent =
+        std::abs(x0)*(std::abs(y1z2) + std::abs(y2z1)) +
+        std::abs(x1)*(std::abs(y2z0) + std::abs(y0z2)) +
+        std::abs(x2)*(std::abs(y0z1) + std::abs(y1z0));
+    double errorBound = 12.0 * std::ldexp(1.0, -53) * permanent;
+    if (det > errorBound)
+    {
+        sign = -1;
+        return true;
+    }
+    if (det < -errorBound)
+    {
+        sign = +1;
+        return true;
+    }
+    if (permanent == 0.0)
+    {
+        sign = 0;
+        return true;
+    }
+    return false;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int PrimalQuery2<Real>::ExactToLine(Vector2<Real> const& test, int v0,
+    int v1) const
+{
+    Vector2<Real> const& vec0 = mVertices[v0];
+    Vector2<Real> const& vec1 = mVertices[v1];
+
+    Real x0 = test[0] - vec0[0];
+    Real y0 = test[1] - vec0[1];
+    Real x1 = vec1[0] - vec0[0];
+    Real y1 = vec1[1] - vec0[1];
+    Real x0y1 = x0*y1;
+    Real x1y0 = x1*y0;
+    Real det = x0y1 - x1y0;
+    Real zero = (Real)0;
+
+    return (det > zero ? +1 : (det < zero ? -1 : 0));
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int PrimalQuery2<Real>::ExactToLine(Vector2<Real> const& test, int v0,
+    int v1, int& order) const
+{
+    Vector2<Real> const& vec0 = mVertices[v0];
+    Vector2<Real> const& vec1 = mVertices[v1];
+
+    Real x0 = test[0] - vec0[0];
+    Real y0 = test[1] - vec0[1];
+    Real x1 = vec1[0] - vec0[0];
+    Real y1 = vec1[1] - vec0[1];
+    Real x0y1 = x0*y1;
+    Real x1y0 = x1*y0;
+    Real det = x0y1 - x1y0;
+    Real zero = (Real)0;
+
+    if (det > zero)
+    {
+        order = +3;
+        return +1;
+    }
+
+    if (det < zero)
+    {
+        order = -3;
+        return -1;
+    }
+
+    Real x0x1 = x0*x1;
+    Real y0y1 = y0*y1;
+    Real dot = x0x1 + y0y1;
+    if (dot == zero)
+    {
+        order = -1;
+    }
+    else if (dot < zero)
+    {
+        order = -2;
+    }
+    else
+    {
+        Real x0x0 = x0*x0;
+        Real y0y0 = y0*y0;
+        Real sqrlen = x0x0 + y0y0;
+        if (dot == sqrlen)
+        {
+            order = +1;
+        }
+        else if (dot > sqrlen)
+        {
+            order = +2;
+        }
+        else
+        {
+            order = 0;
+        }
+    }
+
+    return 0;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int PrimalQuery2<Real>::ExactToCircumcircle(Vector2<Real> const& test,
+    int v0, int v1, int v2) const
+{
+    Vector2<Real> const& vec0 = mVertices[v0];
+    Vector2<Real> const& vec1 = mVertices[v1];
+    Vector2<Real> const& vec2 = mVertices[v2];
+
+    Real x0 = vec0[0] - test[0];
+    Real y0 = vec0[1] - test[1];
+    Real s00 = vec0[0] + test[0];
+    Real s01 = vec0[1] + test[1];
+    Real t00 = s00*x0;
+    Real t01 = s01*y0;
+    Real z0 = t00 + t01;
+
+    Real x1 = vec1[0] - test[0];
+    Real y1 = vec1[1] - test[1];
+    Real s10 = vec1[0] + test[0];
+    Real s11 = vec1[1] + test[1];
+    Real t10 = s10*x1;
+    Real t11 = s11*y1;
+    Real z1 = t10 + t11;
+
+    Real x2 = vec2[0] - test[0];
+    Real y2 = vec2[1] - test[1];
+    Real s20 = vec2[0] + test[0];
+    Real s21 = vec2[1] + test[1];
+    Real t20 = s20*x2;
+    Real t21 = s21*y2;
+    Real z2 = t20 + t21;
+
+    Real y0z1 = y0*z1;
+    Real y0z2 = y0*z2;
+    Real y1z0 = y1*z0;
+    Real y1z2 = y1*z2;
+    Real y2z0 = y2*z0;
+    Real y2z1 = y2*z1;
+    Real c0 = y1z2 - y2z1;
+    Real c1 = y2z0 - y0z2;
+    Real c2 = y0z1 - y1z0;
+    Real x0c0 = x0*c0;
+    Real x1c1 = x1*c1;
+    Real x2c2 = x2*c2;
+    Real term = x0c0 + x1c1;
+    Real det = term + x2c2;
+    return (det < (Real)0 ? 1 : (det > (Real)0 ? -1 : 0));
+}
+//----------------------------------------------------------------------------
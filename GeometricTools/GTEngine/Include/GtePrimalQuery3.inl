@@ -10,7 +10,11 @@ template <typename Real>
 PrimalQuery3<Real>::PrimalQuery3()
     :
     mNumVertices(0),
-    mVertices(nullptr)
+    mVertices(nullptr),
+    mUseFilter(!std::is_floating_point<Real>::value),
+    mCounting(false),
+    mNumFilterQueries(0),
+    mNumExactQueries(0)
 {
 }
 //----------------------------------------------------------------------------
@@ -19,15 +23,48 @@ PrimalQuery3<Real>::PrimalQuery3(int numVertices,
     Vector3<Real> const* vertices)
     :
     mNumVertices(numVertices),
-    mVertices(vertices)
+    mVertices(vertices),
+    mUseFilter(!std::is_floating_point<Real>::value),
+    mCounting(false),
+    mNumFilterQueries(0),
+    mNumExactQueries(0)
 {
+    ConvertFilterVertices();
 }
 //----------------------------------------------------------------------------
-template <typename Real> inline
+template <typename Real>
+PrimalQuery3<Real>::PrimalQuery3(PrimalQuery3 const& query)
+    :
+    mNumVertices(query.mNumVertices),
+    mVertices(query.mVertices),
+    mUseFilter(query.mUseFilter),
+    mFilterVertices(query.mFilterVertices),
+    mCounting(query.mCounting),
+    mNumFilterQueries(query.GetNumFilterQueries()),
+    mNumExactQueries(query.GetNumExactQueries())
+{
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+PrimalQuery3<Real>& PrimalQuery3<Real>::operator=(PrimalQuery3 const& query)
+{
+    mNumVertices = query.mNumVertices;
+    mVertices = query.mVertices;
+    mUseFilter = query.mUseFilter;
+    mFilterVertices = query.mFilterVertices;
+    mCounting = query.mCounting;
+    mNumFilterQueries.store(query.GetNumFilterQueries(),
+        std::memory_order_relaxed);
+    mNumExactQueries.store(query.GetNumExactQueries(),
+        std::memory_order_relaxed);
+    return *this;
+}
+template <typename Real>
 void PrimalQuery3<Real>::Set(int numVertices, Vector3<Real> const* vertices)
 {
     mNumVertices = numVertices;
     mVertices = vertices;
+    ConvertFilterVertices();
 }
 //----------------------------------------------------------------------------
 template <typename Real> inline
@@ -43,51 +80,113 @@ Vector3<Real> const* PrimalQuery3<Real>::GetVertices() const
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+void PrimalQuery3<Real>::SetFilter(bool useFilter)
+{
+    mUseFilter = useFilter;
+    ConvertFilterVertices();
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+bool PrimalQuery3<Real>::GetFilter() const
+{
+    return mUseFilter;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void PrimalQuery3<Real>::SetCounting(bool counting)
+{
+    mCounting = counting;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+bool PrimalQuery3<Real>::GetCounting() const
+{
+    return mCounting;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+uint64_t PrimalQuery3<Real>::GetNumFilterQueries() const
+{
+    return mNumFilterQueries.load(std::memory_order_relaxed);
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+uint64_t PrimalQuery3<Real>::GetNumExactQueries() const
+{
+    return mNumExactQueries.load(std::memory_order_relaxed);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void PrimalQuery3<Real>::ResetFilterCounts()
+{
+    mNumFilterQueries.store(0, std::memory_order_relaxed);
+    mNumExactQueries.store(0, std::memory_order_relaxed);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 int PrimalQuery3<Real>::ToPlane(int i, int v0, int v1, int v2) const
 {
-    return ToPlane(mVertices[i], v0, v1, v2);
+    if (mUseFilter)
+    {
+        CountFilterQuery();
+        int sign;
+        if (FilterToPlane(mFilterVertices[i], v0, v1, v2, sign))
+        {
+            return sign;
+        }
+        CountExactQuery();
+    }
+    return ExactToPlane(mVertices[i], v0, v1, v2);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 int PrimalQuery3<Real>::ToPlane(Vector3<Real> const& test, int v0, int v1,
     int v2) const
 {
-    Vector3<Real> const& vec0 = mVertices[v0];
-    Vector3<Real> const& vec1 = mVertices[v1];
-    Vector3<Real> const& vec2 = mVertices[v2];
-
-    Real x0 = test[0] - vec0[0];
-    Real y0 = test[1] - vec0[1];
-    Real z0 = test[2] - vec0[2];
-    Real x1 = vec1[0] - vec0[0];
-    Real y1 = vec1[1] - vec0[1];
-    Real z1 = vec1[2] - vec0[2];
-    Real x2 = vec2[0] - vec0[0];
-    Real y2 = vec2[1] - vec0[1];
-    Real z2 = vec2[2] - vec0[2];
-    Real y1z2 = y1*z2;
-    Real y2z1 = y2*z1;
-    Real y2z0 = y2*z0;
-    Real y0z2 = y0*z2;
-    Real y0z1 = y0*z1;
-    Real y1z0 = y1*z0;
-    Real c0 = y1z2 - y2z1;
-    Real c1 = y2z0 - y0z2;
-    Real c2 = y0z1 - y1z0;
-    Real x0c0 = x0*c0;
-    Real x1c1 = x1*c1;
-    Real x2c2 = x2*c2;
-    Real term = x0c0 + x1c1;
-    Real det = term + x2c2;
-
-    return (det > (Real)0 ? +1 : (det < (Real)0 ? -1 : 0));
+    if (mUseFilter)
+    {
+        CountFilterQuery();
+        Vector3<double> ftest(ToFilter(test[0]), ToFilter(test[1]),
+            ToFilter(test[2]));
+        int sign;
+        if (FilterToPlane(ftest, v0, v1, v2, sign))
+        {
+            return sign;
+        }
+        CountExactQuery();
+    }
+    return ExactToPlane(test, v0, v1, v2);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 int PrimalQuery3<Real>::ToTetrahedron(int i, int v0, int v1, int v2, int v3)
     const
 {
-    return ToTetrahedron(mVertices[i], v0, v1, v2, v3);
+    int sign0 = ToPlane(i, v1, v2, v3);
+    if (sign0 > 0)
+    {
+        return +1;
+    }
+
+    int sign1 = ToPlane(i, v0, v2, v3);
+    if (sign1 < 0)
+    {
+        return +1;
+    }
+
+    int sign2 = ToPlane(i, v0, v1, v3);
+    if (sign2 > 0)
+    {
+        return +1;
+    }
+
+    int sign3 = ToPlane(i, v0, v1, v2);
+    if (sign3 < 0)
+    {
+        return +1;
+    }
+
+    return ((sign0 && sign1 && sign2 && sign3) ? -1 : 0);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -125,12 +224,247 @@ template <typename Real>
 int PrimalQuery3<Real>::ToCircumsphere(int i, int v0, int v1, int v2, int v3)
     const
 {
-    return ToCircumsphere(mVertices[i], v0, v1, v2, v3);
+    if (mUseFilter)
+    {
+        CountFilterQuery();
+        int sign;
+        if (FilterToCircumsphere(mFilterVertices[i], v0, v1, v2, v3, sign))
+        {
+            return sign;
+        }
+        CountExactQuery();
+    }
+    return ExactToCircumsphere(mVertices[i], v0, v1, v2, v3);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 int PrimalQuery3<Real>::ToCircumsphere(Vector3<Real> const& test, int v0,
     int v1, int v2, int v3) const
+{
+    if (mUseFilter)
+    {
+        CountFilterQuery();
+        Vector3<double> ftest(ToFilter(test[0]), ToFilter(test[1]),
+            ToFilter(test[2]));
+        int sign;
+        if (FilterToCircumsphere(ftest, v0, v1, v2, v3, sign))
+        {
+            return sign;
+        }
+        CountExactQuery();
+    }
+    return ExactToCircumsphere(test, v0, v1, v2, v3);
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+void PrimalQuery3<Real>::CountFilterQuery() const
+{
+    if (mCounting)
+    {
+        mNumFilterQueries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+void PrimalQuery3<Real>::CountExactQuery() const
+{
+    if (mCounting)
+    {
+        mNumExactQueries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+double PrimalQuery3<Real>::ToFilter(Real const& value)
+{
+    double const minMagnitude = std::ldexp(1.0, -100);
+    double const maxMagnitude = std::ldexp(1.0, +100);
+    double result = static_cast<double>(value);
+    double magnitude = std::abs(result);
+    if ((magnitude == 0.0 || (minMagnitude <= magnitude
+        && magnitude <= maxMagnitude)) && static_cast<Real>(result) == value)
+    {
+        return result;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void PrimalQuery3<Real>::ConvertFilterVertices()
+{
+    if (mUseFilter && mVertices)
+    {
+        mFilterVertices.resize(mNumVertices);
+        for (int i = 0; i < mNumVertices; ++i)
+        {
+            mFilterVertices[i][0] = ToFilter(mVertices[i][0]);
+            mFilterVertices[i][1] = ToFilter(mVertices[i][1]);
+            mFilterVertices[i][2] = ToFilter(mVertices[i][2]);
+        }
+    }
+    else
+    {
+        mFilterVertices.clear();
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool PrimalQuery3<Real>::FilterToPlane(Vector3<double> const& test, int v0,
+    int v1, int v2, int& sign) const
+{
+    Vector3<double> const& vec0 = mFilterVertices[v0];
+    Vector3<double> const& vec1 = mFilterVertices[v1];
+    Vector3<double> const& vec2 = mFilterVertices[v2];
+
+    double x0 = test[0] - vec0[0];
+    double y0 = test[1] - vec0[1];
+    double z0 = test[2] - vec0[2];
+    double x1 = vec1[0] - vec0[0];
+    double y1 = vec1[1] - vec0[1];
+    double z1 = vec1[2] - vec0[2];
+    double x2 = vec2[0] - vec0[0];
+    double y2 = vec2[1] - vec0[1];
+    double z2 = vec2[2] - vec0[2];
+    double y1z2 = y1*z2;
+    double y2z1 = y2*z1;
+    double y2z0 = y2*z0;
+    double y0z2 = y0*z2;
+    double y0z1 = y0*z1;
+    double y1z0 = y1*z0;
+    double c0 = y1z2 - y2z1;
+    double c1 = y2z0 - y0z2;
+    double c2 = y0z1 - y1z0;
+    double det = x0*c0 + x1*c1 + x2*c2;
+
+    // Each term of the determinant has 3 rounded differences as factors and
+    // is affected by 5 more roundings, so the rounding error is bounded by
+    // (8+1)*epsilon*permanent, where epsilon = 2^{-53}.
+    double permanent =
+        std::abs(x0)*(std::abs(y1z2) + std::abs(y2z1)) +
+        std::abs(x1)*(std::abs(y2z0) + std::abs(y0z2)) +
+        std::abs(x2)*(std::abs(y0z1) + std::abs(y1z0));
+    double errorBound = 9.0 * std::ldexp(1.0, -53) * permanent;
+    if (det > errorBound)
+    {
+        sign = +1;
+        return true;
+    }
+    if (det < -errorBound)
+    {
+        sign = -1;
+        return true;
+    }
+    if (permanent == 0.0)
+    {
+        // All terms are exactly zero, because the filter coordinates are
+        // chosen so that the products cannot underflow.
+        sign = 0;
+        return true;
+    }
+    return false;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool PrimalQuery3<Real>::FilterToCircumsphere(Vector3<double> const& test,
+    int v0, int v1, int v2, int v3, int& sign) const
+{
+    // The fourth column of the determinant uses the squared lengths of the
+    // differences rather than the w-values of ExactToCircumsphere.  The
+    // columns differ by a linear combination of the first three columns, so
+    // the determinants are equal.
+    double x[4], y[4], z[4], w[4];
+    int const v[4] = { v0, v1, v2, v3 };
+    for (int j = 0; j < 4; ++j)
+    {
+        Vector3<double> const& vec = mFilterVertices[v[j]];
+        x[j] = vec[0] - test[0];
+        y[j] = vec[1] - test[1];
+        z[j] = vec[2] - test[2];
+        w[j] = x[j]*x[j] + y[j]*y[j] + z[j]*z[j];
+    }
+
+    // The 2x2 minors of the first two columns (a[]) and of the last two
+    // columns (b[]), in the order used by ExactToCircumsphere, and their
+    // absolute-value counterparts for the permanent.
+    int const i0[6] = { 0, 0, 0, 1, 1, 2 };
+    int const i1[6] = { 1, 2, 3, 2, 3, 3 };
+    double a[6], b[6], pa[6], pb[6];
+    for (int k = 0; k < 6; ++k)
+    {
+        double xy0 = x[i0[k]]*y[i1[k]];
+        double xy1 = x[i1[k]]*y[i0[k]];
+        double zw0 = z[i0[k]]*w[i1[k]];
+        double zw1 = z[i1[k]]*w[i0[k]];
+        a[k] = xy0 - xy1;
+        b[k] = zw0 - zw1;
+        pa[k] = std::abs(xy0) + std::abs(xy1);
+        pb[k] = std::abs(zw0) + std::abs(zw1);
+    }
+    double det = a[0]*b[5] - a[1]*b[4] + a[2]*b[3] + a[3]*b[2] - a[4]*b[1]
+        + a[5]*b[0];
+
+    // Each term of the determinant has 5 rounded differences as factors and
+    // is affected by 13 more roundings, so the rounding error is bounded by
+    // (18+1)*epsilon*permanent, where epsilon = 2^{-53}.
+    double permanent = pa[0]*pb[5] + pa[1]*pb[4] + pa[2]*pb[3] + pa[3]*pb[2]
+        + pa[4]*pb[1] + pa[5]*pb[0];
+    double errorBound = 19.0 * std::ldexp(1.0, -53) * permanent;
+    if (det > errorBound)
+    {
+        sign = +1;
+        return true;
+    }
+    if (det < -errorBound)
+    {
+        sign = -1;
+        return true;
+    }
+    if (permanent == 0.0)
+    {
+        sign = 0;
+        return true;
+    }
+    return false;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int PrimalQuery3<Real>::ExactToPlane(Vector3<Real> const& test, int v0,
+    int v1, int v2) const
+{
+    Vector3<Real> const& vec0 = mVertices[v0];
+    Vector3<Real> const& vec1 = mVertices[v1];
+    Vector3<Real> const& vec2 = mVertices[v2];
+
+    Real x0 = test[0] - vec0[0];
+    Real y0 = test[1] - vec0[1];
+    Real z0 = test[2] - vec0[2];
+    Real x1 = vec1[0] - vec0[0];
+    Real y1 = vec1[1] - vec0[1];
+    Real z1 = vec1[2] - vec0[2];
+    Real x2 = vec2[0] - vec0[0];
+    Real y2 = vec2[1] - vec0[1];
+    Real z2 = vec2[2] - vec0[2];
+    Real y1z2 = y1*z2;
+    Real y2z1 = y2*z1;
+    Real y2z0 = y2*z0;
+    Real y0z2 = y0*z2;
+    Real y0z1 = y0*z1;
+    Real y1z0 = y1*z0;
+    Real c0 = y1z2 - y2z1;
+    Real c1 = y2z0 - y0z2;
+    Real c2 = y0z1 - y1z0;
+    Real x0c0 = x0*c0;
+    Real x1c1 = x1*c1;
+    Real x2c2 = x2*c2;
+    Real term = x0c0 + x1c1;
+    Real det = term + x2c2;
+
+    return (det > (Real)0 ? +1 : (det < (Real)0 ? -1 : 0));
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int PrimalQuery3<Real>::ExactToCircumsphere(Vector3<Real> const& test,
+    int v0, int v1, int v2, int v3) const
 {
     Vector3<Real> const& vec0 = mVertices[v0];
     Vector3<Real> const& vec1 = mVertices[v1];
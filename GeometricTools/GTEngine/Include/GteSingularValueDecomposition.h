@@ -5,7 +5,13 @@
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 // File Version: 1.0.0 (2014/08/11)
 
+#include "GteBlockReflector.h"
+#include "GteLogger.h"
+#include "GteParallelFor.h"
+#include "GteRangeIteration.h"
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 // The SingularValueDecomposition class is an implementation of Algorithm
@@ -100,6 +106,10 @@
 // Householder reflections and Givens rotations to obtain the orthogonal
 // matrices of the decomposigion, and comperr is the computation E =
 // U^T*A*V - S.
+//
+// The bidiagonalization applies the reflections in panels of PANEL_SIZE
+// and U and V are computed by applying blocks of PANEL_SIZE reflections in
+// the compact WY form of BlockReflector to tiles of TILE_SIZE columns.
 
 namespace gte
 {
@@ -115,17 +125,24 @@ public:
     // diagonal matrix.  The goal is to compute MxM orthogonal U, NxN
     // orthogonal V, and MxN matrix S for which U^T*A*V = S.  The only
     // nonzero entries of S are on the diagonal; the diagonal entries are
-    // the singular values of the original matrix.
+    // the singular values of the original matrix.  The number of threads is
+    // used by the bidiagonalization and by the computation of U and V.  The
+    // results do not depend on numThreads; see the comments about the
+    // constructor of SymmetricEigensolver.
     SingularValueDecomposition(int numRows, int numCols,
-        unsigned int maxIterations);
+        unsigned int maxIterations, unsigned int numThreads = 1);
 
     // A copy of the MxN input is made internally.  The order of the singular
     // values is specified by sortType: -1 (decreasing), 0 (no sorting), or +1
     // (increasing).  When sorted, the columns of the orthogonal matrices
-    // are ordered accordingly.  The return value is the number of iterations
-    // consumed when convergence occurred, 0xFFFFFFFF when convergence did not
-    // occur or 0 when N <= 1 or M < N was passed to the constructor.
-    unsigned int Solve(Real const* input, int sortType);
+    // are ordered accordingly.  When you need only the singular values, set
+    // wantOrthogonalMatrices to 'false' so that the Givens rotations are not
+    // stored; GetU and GetV are then invalid.  The return value is the number
+    // of iterations consumed when convergence occurred, 0xFFFFFFFF when
+    // convergence did not occur or 0 when N <= 1 or M < N was passed to the
+    // constructor.
+    unsigned int Solve(Real const* input, int sortType,
+        bool wantOrthogonalMatrices = true);
 
     // Get the singular values of the matrix passed to Solve(...).  The input
     // 'singularValues' must have N elements.
@@ -139,16 +156,46 @@ public:
     void GetV(Real* vMatrix) const;
 
 private:
+    // The number of Householder reflections in a panel of the blocked
+    // bidiagonalization and in a block of the accumulation of U and V, and
+    // the number of columns of U or V that are processed together.
+    enum
+    {
+        PANEL_SIZE = 32,
+        TILE_SIZE = 128
+    };
+
     // Bidiagonalize using Householder reflections.  On input, mMatrix is a
-    // copy of the input matrix and has one extra row.  On output, the
-    // diagonal and superdiagonal contain the bidiagonalized results.  The
-    // lower-triangular portion stores the essential parts of the Householder
-    // u vectors (the elements of u after the leading 1-valued component) and
-    // the upper-triangular portion stores the essential parts of the
+    // copy of the input matrix.  On output, mDiagonal and mSuperdiagonal
+    // contain the bidiagonalized results.  The lower-triangular portion of
+    // mMatrix stores the essential parts of the Householder u vectors (the
+    // elements of u after the leading 1-valued component) and the
+    // upper-triangular portion stores the essential parts of the
     // Householder v vectors.  To avoid recomputing 2/Dot(u,u) and 2/Dot(v,v),
-    // these quantities are stored in mTwoInvUTU and mTwoInvVTV.
+    // these quantities are stored in mTwoInvUTU and mTwoInvVTV.  The
+    // reflections are computed in panels of PANEL_SIZE columns; see the
+    // LAPACK function DLABRD.  The left reflection for column i is applied
+    // to the remaining matrix B as B - u*y^T and the right reflection as
+    // B - x*v^T.  The vectors of a panel are accumulated and the matrix to
+    // the lower right of the panel is updated once per panel, and the update
+    // is a matrix-matrix product that visits that matrix once rather than
+    // twice per column.
     void Bidiagonalize();
 
+    // Compute Z = H*G*Z for the initial Z, where H is the product of the
+    // Householder reflections and G is the product of the Givens rotations
+    // for U (left is 'true') or for V (left is 'false').  The Givens
+    // rotations and then the blocked Householder reflections are applied to
+    // tiles of TILE_SIZE columns of Z; the tiles are partitioned among the
+    // threads.
+    void ComputeOrthogonalMatrix(bool left, Real* Z) const;
+
+    // Call task(imin,imax) on subranges of [0,numItems), one per thread,
+    // using fewer threads when a thread would have fewer than
+    // minItemsPerThread items.
+    void Run(int numItems, std::function<void(int, int)> const& task,
+        int minItemsPerThread) const;
+
     // A helper for generating Givens rotation sine and cosine robustly.
     void GetSinCos(Real u, Real v, Real& cs, Real& sn);
 
@@ -171,8 +218,8 @@ private:
     // Sort the singular values and compute the corresponding permutation of
     // the indices of the array storing the singular values.  The permutation
     // is used for reordering the singular values and the corresponding
-    // columns of the orthogonal matrix in the calls to GetSingularValues(...)
-    // and GetOrthogonalMatrices(...).
+    // columns of the orthogonal matrices in the calls to
+    // GetSingularValues(...), GetU(...) and GetV(...).
     void ComputePermutation(int sortType);
 
     // The number rows and columns of the matrices to be processed.
@@ -182,6 +229,12 @@ private:
     // to a diagonal matrix.
     unsigned int mMaxIterations;
 
+    // The number of threads to use.
+    unsigned int mNumThreads;
+
+    // The value of wantOrthogonalMatrices passed to Solve.
+    bool mWantOrthogonalMatrices;
+
     // The internal copy of a matrix passed to the solver.  See the comments
     // about function Bidiagonalize() about what is stored in the matrix.
     std::vector<Real> mMatrix;  // MxN elements
@@ -219,17 +272,18 @@ private:
 
     // When sorting is requested, the permutation associated with the sort is
     // stored in mPermutation.  When sorting is not requested, mPermutation[0]
-    // is set to -1.  mVisited is used for finding cycles in the permutation.
+    // is set to -1.
     std::vector<int> mPermutation;  // N elements
-    mutable std::vector<int> mVisited;  // N elements
 
-    // Temporary storage to compute Householder reflections and to support
-    // sorting of columns of the orthogonal matrices.
+    // Temporary storage to compute Householder reflections.  The panels
+    // store the vectors u, x (M elements each) and v, y (N elements each)
+    // of the reflections of a panel.
     std::vector<Real> mTwoInvUTU;  // N elements
     std::vector<Real> mTwoInvVTV;  // N-2 elements
-    mutable std::vector<Real> mUVector;  // M elements
-    mutable std::vector<Real> mVVector;  // N elements
-    mutable std::vector<Real> mWVector;  // max(M,N) elements
+    std::vector<Real> mUPanel;  // PANEL_SIZE*M elements
+    std::vector<Real> mXPanel;  // PANEL_SIZE*M elements
+    std::vector<Real> mVPanel;  // PANEL_SIZE*N elements
+    std::vector<Real> mYPanel;  // PANEL_SIZE*N elements
 };
 
 #include "GteSingularValueDecomposition.inl"
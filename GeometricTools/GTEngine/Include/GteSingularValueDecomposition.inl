@@ -8,11 +8,13 @@
 //----------------------------------------------------------------------------
 template <typename Real>
 SingularValueDecomposition<Real>::SingularValueDecomposition(int numRows,
-    int numCols, unsigned int maxIterations)
+    int numCols, unsigned int maxIterations, unsigned int numThreads)
     :
     mNumRows(0),
     mNumCols(0),
-    mMaxIterations(0)
+    mMaxIterations(0),
+    mNumThreads(numThreads > 0 ? numThreads : 1),
+    mWantOrthogonalMatrices(false)
 {
     if (numCols > 1 && numRows >= numCols && maxIterations > 0)
     {
@@ -26,23 +28,24 @@ SingularValueDecomposition<Real>::SingularValueDecomposition(int numRows,
         mLGivens.reserve(maxIterations*(numCols - 1));
         mFixupDiagonal.resize(numCols);
         mPermutation.resize(numCols);
-        mVisited.resize(numCols);
         mTwoInvUTU.resize(numCols);
-        mTwoInvVTV.resize(numCols - 2);
-        mUVector.resize(numRows);
-        mVVector.resize(numCols);
-        mWVector.resize(numRows);
+        mTwoInvVTV.resize(std::max(numCols - 2, 1));
+        mUPanel.resize(PANEL_SIZE*numRows);
+        mXPanel.resize(PANEL_SIZE*numRows);
+        mVPanel.resize(PANEL_SIZE*numCols);
+        mYPanel.resize(PANEL_SIZE*numCols);
     }
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 unsigned int SingularValueDecomposition<Real>::Solve(Real const* input,
-    int sortType)
+    int sortType, bool wantOrthogonalMatrices)
 {
     if (mNumRows > 0)
     {
         int numElements = mNumRows * mNumCols;
         std::copy(input, input + numElements, mMatrix.begin());
+        mWantOrthogonalMatrices = wantOrthogonalMatrices;
         Bidiagonalize();
 
         // Compute 'threshold = multiplier*epsilon*|B|' as the threshold for
@@ -168,96 +171,22 @@ void SingularValueDecomposition<Real>::GetU(Real* uMatrix) const
         return;
     }
 
-    // Start with the identity matrix.
-    std::fill(uMatrix, uMatrix + mNumRows*mNumRows, (Real)0);
-    for (int d = 0; d < mNumRows; ++d)
-    {
-        uMatrix[d + mNumRows*d] = (Real)1;
-    }
-
-    // Multiply the Householder reflections using backward accumulation.
-    int r, c;
-    for (int i0 = mNumCols - 1, i1 = i0 + 1; i0 >= 0; --i0, --i1)
+    if (!mWantOrthogonalMatrices)
     {
-        // Copy the u vector and 2/Dot(u,u) from the matrix.
-        Real twoinvudu = mTwoInvUTU[i0];
-        Real const* column = &mMatrix[i0];
-        mUVector[i0] = (Real)1;
-        for (r = i1; r < mNumRows; ++r)
-        {
-            mUVector[r] = column[mNumCols*r];
-        }
-
-        // Compute the w vector.
-        mWVector[i0] = twoinvudu;
-        for (r = i1; r < mNumRows; ++r)
-        {
-            mWVector[r] = (Real)0;
-            for (c = i1; c < mNumRows; ++c)
-            {
-                mWVector[r] += mUVector[c] * uMatrix[r + mNumRows*c];
-            }
-            mWVector[r] *= twoinvudu;
-        }
-
-        // Update the matrix, U <- U - u*w^T.
-        for (r = i0; r < mNumRows; ++r)
-        {
-            for (c = i0; c < mNumRows; ++c)
-            {
-                uMatrix[c + mNumRows*r] -= mUVector[r] * mWVector[c];
-            }
-        }
+        LogError("Solve was called with wantOrthogonalMatrices false.");
+        return;
     }
 
-    // Multiply the Givens rotations.
-    for (auto const& givens : mLGivens)
+    // Start with the identity matrix.  When sorting was requested, its
+    // first N columns are permuted accordingly.
+    std::fill(uMatrix, uMatrix + mNumRows*mNumRows, (Real)0);
+    for (int c = 0; c < mNumRows; ++c)
     {
-        int j0 = givens.index0;
-        int j1 = givens.index1;
-        for (r = 0; r < mNumRows; ++r, j0 += mNumRows, j1 += mNumRows)
-        {
-            Real& q0 = uMatrix[j0];
-            Real& q1 = uMatrix[j1];
-            Real prd0 = givens.cs * q0 - givens.sn * q1;
-            Real prd1 = givens.sn * q0 + givens.cs * q1;
-            q0 = prd0;
-            q1 = prd1;
-        }
+        int r = (c < mNumCols && mPermutation[0] >= 0 ? mPermutation[c] : c);
+        uMatrix[c + mNumRows*r] = (Real)1;
     }
 
-    if (mPermutation[0] >= 0)
-    {
-        // Sorting was requested.
-        std::fill(mVisited.begin(), mVisited.end(), 0);
-        for (c = 0; c < mNumCols; ++c)
-        {
-            if (mVisited[c] == 0 && mPermutation[c] != c)
-            {
-                // The item starts a cycle with 2 or more elements.
-                int start = c, current = c, next;
-                for (r = 0; r < mNumRows; ++r)
-                {
-                    mWVector[r] = uMatrix[c + mNumRows*r];
-                }
-                while ((next = mPermutation[current]) != start)
-                {
-                    mVisited[current] = 1;
-                    for (r = 0; r < mNumRows; ++r)
-                    {
-                        uMatrix[current + mNumRows*r] =
-                            uMatrix[next + mNumRows*r];
-                    }
-                    current = next;
-                }
-                mVisited[current] = 1;
-                for (r = 0; r < mNumRows; ++r)
-                {
-                    uMatrix[current + mNumRows*r] = mWVector[r];
-                }
-            }
-        }
-    }
+    ComputeOrthogonalMatrix(true, uMatrix);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -269,233 +198,269 @@ void SingularValueDecomposition<Real>::GetV(Real* vMatrix) const
         return;
     }
 
-    // Start with the identity matrix.
-    std::fill(vMatrix, vMatrix + mNumCols*mNumCols, (Real)0);
-    for (int d = 0; d < mNumCols; ++d)
-    {
-        vMatrix[d + mNumCols*d] = (Real)1;
-    }
-
-    // Multiply the Householder reflections using backward accumulation.
-    int i0 = mNumCols - 3;
-    int i1 = i0 + 1;
-    int i2 = i0 + 2;
-    int r, c;
-    for (/**/; i0 >= 0; --i0, --i1, --i2)
+    if (!mWantOrthogonalMatrices)
     {
-        // Copy the v vector and 2/Dot(v,v) from the matrix.
-        Real twoinvvdv = mTwoInvVTV[i0];
-        Real const* row = &mMatrix[mNumCols*i0];
-        mVVector[i1] = (Real)1;
-        for (r = i2; r < mNumCols; ++r)
-        {
-            mVVector[r] = row[r];
-        }
-
-        // Compute the w vector.
-        mWVector[i1] = twoinvvdv;
-        for (r = i2; r < mNumCols; ++r)
-        {
-            mWVector[r] = (Real)0;
-            for (c = i2; c < mNumCols; ++c)
-            {
-                mWVector[r] += mVVector[c] * vMatrix[r + mNumCols*c];
-            }
-            mWVector[r] *= twoinvvdv;
-        }
-
-        // Update the matrix, V <- V - v*w^T.
-        for (r = i1; r < mNumCols; ++r)
-        {
-            for (c = i1; c < mNumCols; ++c)
-            {
-                vMatrix[c + mNumCols*r] -= mVVector[r] * mWVector[c];
-            }
-        }
-    }
-
-    // Multiply the Givens rotations.
-    for (auto const& givens : mRGivens)
-    {
-        int j0 = givens.index0;
-        int j1 = givens.index1;
-        for (c = 0; c < mNumCols; ++c, j0 += mNumCols, j1 += mNumCols)
-        {
-            Real& q0 = vMatrix[j0];
-            Real& q1 = vMatrix[j1];
-            Real prd0 = givens.cs * q0 - givens.sn * q1;
-            Real prd1 = givens.sn * q0 + givens.cs * q1;
-            q0 = prd0;
-            q1 = prd1;
-        }
+        LogError("Solve was called with wantOrthogonalMatrices false.");
+        return;
     }
 
-    // Fix-up the diagonal.
-    for (int r = 0; r < mNumCols; ++r)
+    // Start with the diagonal fix-up matrix.  When sorting was requested,
+    // its columns are permuted accordingly.
+    std::fill(vMatrix, vMatrix + mNumCols*mNumCols, (Real)0);
+    for (int c = 0; c < mNumCols; ++c)
     {
-        for (int c = 0; c < mNumCols; ++c)
-        {
-            vMatrix[c + mNumCols*r] *= mFixupDiagonal[c];
-        }
+        int r = (mPermutation[0] >= 0 ? mPermutation[c] : c);
+        vMatrix[c + mNumCols*r] = mFixupDiagonal[r];
     }
 
-    if (mPermutation[0] >= 0)
-    {
-        // Sorting was requested.
-        std::fill(mVisited.begin(), mVisited.end(), 0);
-        for (c = 0; c < mNumCols; ++c)
-        {
-            if (mVisited[c] == 0 && mPermutation[c] != c)
-            {
-                // The item starts a cycle with 2 or more elements.
-                int start = c, current = c, next;
-                for (r = 0; r < mNumCols; ++r)
-                {
-                    mWVector[r] = vMatrix[c + mNumCols*r];
-                }
-                while ((next = mPermutation[current]) != start)
-                {
-                    mVisited[current] = 1;
-                    for (r = 0; r < mNumCols; ++r)
-                    {
-                        vMatrix[current + mNumCols*r] =
-                            vMatrix[next + mNumCols*r];
-                    }
-                    current = next;
-                }
-                mVisited[current] = 1;
-                for (r = 0; r < mNumCols; ++r)
-                {
-                    vMatrix[current + mNumCols*r] = mWVector[r];
-                }
-            }
-        }
-    }
+    ComputeOrthogonalMatrix(false, vMatrix);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 void SingularValueDecomposition<Real>::Bidiagonalize()
 {
+    int const M = mNumRows, N = mNumCols;
+    Real* A = &mMatrix[0];
     int r, c;
-    for (int i = 0, ip1 = 1; i < mNumCols; ++i, ++ip1)
+
+    for (int i0 = 0; i0 < N; i0 += PANEL_SIZE)
     {
-        // Compute the U-Householder vector.
-        Real length = (Real)0;
-        for (r = i; r < mNumRows; ++r)
-        {
-            Real ur = mMatrix[i + mNumCols*r];
-            mUVector[r] = ur;
-            length += ur * ur;
-        }
-        Real udu = (Real)1;
-        length = sqrt(length);
-        if (length > (Real)0)
+        int const numColumns = std::min((int)PANEL_SIZE, N - i0);
+        for (int k = 0, i = i0, ip1 = i0 + 1; k < numColumns;
+            ++k, ++i, ++ip1)
         {
-            Real& u1 = mUVector[i];
-            Real sgn = (u1 >= (Real)0 ? (Real)1 : (Real)-1);
-            Real invDenom = ((Real)1) / (u1 + sgn * length);
-            u1 = (Real)1;
-            for (r = ip1; r < mNumRows; ++r)
+            Real* u = &mUPanel[M*k];
+            Real* x = &mXPanel[M*k];
+            Real* v = &mVPanel[N*k];
+            Real* y = &mYPanel[N*k];
+
+            // Apply the reflections of the panel to column i.
+            for (int j = 0; j < k; ++j)
             {
-                Real& ur = mUVector[r];
-                ur *= invDenom;
-                udu += ur * ur;
+                Real const* uj = &mUPanel[M*j];
+                Real const* xj = &mXPanel[M*j];
+                Real yji = mYPanel[i + N*j], vji = mVPanel[i + N*j];
+                for (r = i; r < M; ++r)
+                {
+                    A[i + N*r] -= uj[r] * yji + xj[r] * vji;
+                }
             }
-        }
 
-        // Compute the rank-1 offset u*w^T.
-        Real invudu = (Real)1 / udu;
-        Real twoinvudu = invudu * (Real)2;
-        for (c = i; c < mNumCols; ++c)
-        {
-            mWVector[c] = (Real)0;
-            for (r = i; r < mNumRows; ++r)
+            // Compute the U-Householder vector.  A zero vector requires no
+            // reflection, which is represented by 2/Dot(u,u) = 0.
+            Real length = (Real)0;
+            for (r = i; r < M; ++r)
             {
-                mWVector[c] += mMatrix[c + mNumCols*r] * mUVector[r];
+                Real ur = A[i + N*r];
+                length += ur * ur;
             }
-            mWVector[c] *= twoinvudu;
-        }
-
-        // Update the input matrix.
-        for (r = i; r < mNumRows; ++r)
-        {
-            for (c = i; c < mNumCols; ++c)
+            length = sqrt(length);
+            std::fill(u, u + i, (Real)0);
+            u[i] = (Real)1;
+            Real twoinvudu = (Real)0;
+            mDiagonal[i] = (Real)0;
+            if (length > (Real)0)
             {
-                mMatrix[c + mNumCols*r] -= mUVector[r] * mWVector[c];
+                Real u1 = A[i + N*i];
+                Real sgn = (u1 >= (Real)0 ? (Real)1 : (Real)-1);
+                Real invDenom = ((Real)1) / (u1 + sgn * length);
+                Real udu = (Real)1;
+                for (r = ip1; r < M; ++r)
+                {
+                    Real ur = A[i + N*r] * invDenom;
+                    u[r] = ur;
+                    udu += ur * ur;
+                }
+                twoinvudu = (Real)2 / udu;
+                mDiagonal[i] = -sgn * length;
             }
-        }
-
-        if (i < mNumCols - 2)
-        {
-            // Compute the V-Householder vectors.
-            length = (Real)0;
-            for (c = ip1; c < mNumCols; ++c)
+            else
             {
-                Real vc = mMatrix[c + mNumCols*i];
-                mVVector[c] = vc;
-                length += vc * vc;
+                std::fill(u + ip1, u + M, (Real)0);
             }
-            Real vdv = (Real)1;
-            length = sqrt(length);
-            if (length > (Real)0)
+
+            // Compute y = (2/Dot(u,u))*B^T*u for the remaining matrix B,
+            // which is the current matrix with the reflections of the panel
+            // applied.
+            std::fill(y, y + N, (Real)0);
+            if (twoinvudu > (Real)0 && ip1 < N)
             {
-                Real& v1 = mVVector[ip1];
-                Real sgn = (v1 >= (Real)0 ? (Real)1 : (Real)-1);
-                Real invDenom = ((Real)1) / (v1 + sgn * length);
-                v1 = (Real)1;
-                for (c = ip1 + 1; c < mNumCols; ++c)
+                Run(N - ip1, [A, u, y, M, N, i, ip1](int cmin, int cmax)
+                {
+                    for (int r = i; r < M; ++r)
+                    {
+                        Real const* Arow = &A[N*r];
+                        Real ur = u[r];
+                        for (int c = ip1 + cmin; c < ip1 + cmax; ++c)
+                        {
+                            y[c] += Arow[c] * ur;
+                        }
+                    }
+                }, 64);
+
+                for (int j = 0; j < k; ++j)
                 {
-                    Real& vc = mVVector[c];
-                    vc *= invDenom;
-                    vdv += vc * vc;
+                    Real const* uj = &mUPanel[M*j];
+                    Real const* xj = &mXPanel[M*j];
+                    Real const* vj = &mVPanel[N*j];
+                    Real const* yj = &mYPanel[N*j];
+                    Real ujdu = (Real)0, xjdu = (Real)0;
+                    for (r = i; r < M; ++r)
+                    {
+                        ujdu += uj[r] * u[r];
+                        xjdu += xj[r] * u[r];
+                    }
+                    for (c = ip1; c < N; ++c)
+                    {
+                        y[c] -= yj[c] * ujdu + vj[c] * xjdu;
+                    }
+                }
+
+                for (c = ip1; c < N; ++c)
+                {
+                    y[c] *= twoinvudu;
                 }
             }
 
-            // Compute the rank-1 offset w*v^T.
-            Real invvdv = (Real)1 / vdv;
-            Real twoinvvdv = invvdv * (Real)2;
-            for (r = i; r < mNumRows; ++r)
+            // Apply the reflections of the panel, including the current
+            // U-Householder reflection, to row i.
+            Real* row = &A[N*i];
+            for (int j = 0; j <= k; ++j)
             {
-                mWVector[r] = (Real)0;
-                for (c = ip1; c < mNumCols; ++c)
+                Real const* vj = &mVPanel[N*j];
+                Real const* yj = &mYPanel[N*j];
+                Real uji = mUPanel[i + M*j];
+                Real xji = (j < k ? mXPanel[i + M*j] : (Real)0);
+                for (c = ip1; c < N; ++c)
                 {
-                    mWVector[r] += mMatrix[c + mNumCols*r] * mVVector[c];
+                    row[c] -= uji * yj[c] + xji * vj[c];
                 }
-                mWVector[r] *= twoinvvdv;
             }
 
-            // Update the input matrix.
-            for (r = i; r < mNumRows; ++r)
+            std::fill(v, v + N, (Real)0);
+            std::fill(x, x + M, (Real)0);
+            if (i < N - 2)
             {
-                for (c = ip1; c < mNumCols; ++c)
+                // Compute the V-Householder vector.
+                length = (Real)0;
+                for (c = ip1; c < N; ++c)
+                {
+                    length += row[c] * row[c];
+                }
+                length = sqrt(length);
+                v[ip1] = (Real)1;
+                Real twoinvvdv = (Real)0;
+                mSuperdiagonal[i] = (Real)0;
+                if (length > (Real)0)
+                {
+                    Real v1 = row[ip1];
+                    Real sgn = (v1 >= (Real)0 ? (Real)1 : (Real)-1);
+                    Real invDenom = ((Real)1) / (v1 + sgn * length);
+                    Real vdv = (Real)1;
+                    for (c = ip1 + 1; c < N; ++c)
+                    {
+                        Real vc = row[c] * invDenom;
+                        v[c] = vc;
+                        vdv += vc * vc;
+                    }
+                    twoinvvdv = (Real)2 / vdv;
+                    mSuperdiagonal[i] = -sgn * length;
+                }
+
+                // Compute x = (2/Dot(v,v))*B*v for the remaining matrix B.
+                if (twoinvvdv > (Real)0)
+                {
+                    Run(M - ip1, [A, v, x, N, ip1](int rmin, int rmax)
+                    {
+                        for (int r = ip1 + rmin; r < ip1 + rmax; ++r)
+                        {
+                            Real const* Arow = &A[N*r];
+                            Real sum = (Real)0;
+                            for (int c = ip1; c < N; ++c)
+                            {
+                                sum += Arow[c] * v[c];
+                            }
+                            x[r] = sum;
+                        }
+                    }, 64);
+
+                    for (int j = 0; j <= k; ++j)
+                    {
+                        Real const* uj = &mUPanel[M*j];
+                        Real const* yj = &mYPanel[N*j];
+                        Real yjdv = (Real)0;
+                        for (c = ip1; c < N; ++c)
+                        {
+                            yjdv += yj[c] * v[c];
+                        }
+                        for (r = ip1; r < M; ++r)
+                        {
+                            x[r] -= uj[r] * yjdv;
+                        }
+                    }
+                    for (int j = 0; j < k; ++j)
+                    {
+                        Real const* xj = &mXPanel[M*j];
+                        Real const* vj = &mVPanel[N*j];
+                        Real vjdv = (Real)0;
+                        for (c = ip1; c < N; ++c)
+                        {
+                            vjdv += vj[c] * v[c];
+                        }
+                        for (r = ip1; r < M; ++r)
+                        {
+                            x[r] -= xj[r] * vjdv;
+                        }
+                    }
+
+                    for (r = ip1; r < M; ++r)
+                    {
+                        x[r] *= twoinvvdv;
+                    }
+                }
+
+                mTwoInvVTV[i] = twoinvvdv;
+                for (c = i + 2; c < N; ++c)
                 {
-                    mMatrix[c + mNumCols*r] -= mWVector[r] * mVVector[c];
+                    row[c] = v[c];
                 }
             }
+            else if (i == N - 2)
+            {
+                mSuperdiagonal[i] = row[ip1];
+            }
 
-            mTwoInvVTV[i] = twoinvvdv;
-            for (c = i + 2; c < mNumCols; ++c)
+            mTwoInvUTU[i] = twoinvudu;
+            for (r = ip1; r < M; ++r)
             {
-                mMatrix[c + mNumCols*i] = mVVector[c];
+                A[i + N*r] = u[r];
             }
         }
 
-        mTwoInvUTU[i] = twoinvudu;
-        for (r = ip1; r < mNumRows; ++r)
+        // Update the matrix to the lower right of the panel,
+        // B = B - U*Y^T - X*V^T.
+        int const i1 = i0 + numColumns;
+        if (i1 < N)
         {
-            mMatrix[i + mNumCols*r] = mUVector[r];
+            Run(M - i1, [this, A, M, N, i1, numColumns](int rmin, int rmax)
+            {
+                for (int r = i1 + rmin; r < i1 + rmax; ++r)
+                {
+                    Real* Arow = &A[N*r];
+                    for (int j = 0; j < numColumns; ++j)
+                    {
+                        Real const* vj = &mVPanel[N*j];
+                        Real const* yj = &mYPanel[N*j];
+                        Real ujr = mUPanel[r + M*j], xjr = mXPanel[r + M*j];
+                        for (int c = i1; c < N; ++c)
+                        {
+                            Arow[c] -= ujr * yj[c] + xjr * vj[c];
+                        }
+                    }
+                }
+            }, 32);
         }
     }
-
-    // Copy the diagonal and subdiagonal for cache coherence in the
-    // Golub-Kahan iterations.
-    int k, ksup = mNumCols - 1, index = 0, delta = mNumCols + 1;
-    for (k = 0; k < ksup; ++k, index += delta)
-    {
-        mDiagonal[k] = mMatrix[index];
-        mSuperdiagonal[k] = mMatrix[index + 1];
-    }
-    mDiagonal[k] = mMatrix[index];
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -543,7 +508,12 @@ bool SingularValueDecomposition<Real>::DiagonalEntriesNonzero(int imin,
             {
                 x = mDiagonal[j];
                 GetSinCos(x, y, cs, sn);
-                mLGivens.push_back(GivensRotation(i, j, cs, sn));
+                if (mWantOrthogonalMatrices)
+                {
+                    // The rotation replaces row j by cs*row(j)-sn*row(i)
+                    // and row i by sn*row(j)+cs*row(i), so index0 is j.
+                    mLGivens.push_back(GivensRotation(j, i, cs, sn));
+                }
                 mDiagonal[j] = cs*x - sn*y;
                 if (j <= imax)
                 {
@@ -585,7 +555,10 @@ void SingularValueDecomposition<Real>::DoGolubKahanStep(int imin, int imax)
         // Compute the Givens rotation G and save it for use in computing
         // V in U^T*A*V = S.
         GetSinCos(x, y, cs, sn);
-        mRGivens.push_back(GivensRotation(i1, i2, cs, sn));
+        if (mWantOrthogonalMatrices)
+        {
+            mRGivens.push_back(GivensRotation(i1, i2, cs, sn));
+        }
 
         // Update B0 = B*G.
         if (i1 > imin)
@@ -608,7 +581,10 @@ void SingularValueDecomposition<Real>::DoGolubKahanStep(int imin, int imax)
         // Compute the Givens rotation G and save it for use in computing
         // U in U^T*A*V = S.
         GetSinCos(x, y, cs, sn);
-        mLGivens.push_back(GivensRotation(i1, i2, cs, sn));
+        if (mWantOrthogonalMatrices)
+        {
+            mLGivens.push_back(GivensRotation(i1, i2, cs, sn));
+        }
 
         // Update B1 = G^T*B0.
         a11 = mDiagonal[i1];
@@ -653,8 +629,8 @@ void SingularValueDecomposition<Real>::ComputePermutation(int sortType)
 {
     if (sortType == 0)
     {
-        // Set a flag for GetSingularValues() and GetOrthogonalMatrices() to
-        // know that sorted output was not requested.
+        // Set a flag for GetSingularValues(), GetU() and GetV() to know
+        // that sorted output was not requested.
         mPermutation[0] = -1;
         return;
     }
@@ -700,21 +676,121 @@ void SingularValueDecomposition<Real>::ComputePermutation(int sortType)
         mPermutation[i++] = item.index;
     }
 
-    // GetOrthogonalMatrices() has nontrivial code for computing the
-    // orthogonal U and V from the reflections and rotations.  To avoid
-    // complicating the code further when sorting is requested, U and V are
-    // computed as in the unsorted case.  We then need to swap columns of
-    // U and V to be consistent with the sorting of the singular values.  To
-    // minimize copying due to column swaps, we use permutation P.  The
-    // minimum number of transpositions to obtain P from I is N minus the
-    // number of cycles of P.  Each cycle is reordered with a minimum number
-    // of transpositions; that is, the singular items are cyclically swapped,
-    // leading to a minimum amount of copying.  For example, if there is a
-    // cycle i0 -> i1 -> i2 -> i3, then the copying is
-    //   save = singularitem[i0];
-    //   singularitem[i1] = singularitem[i2];
-    //   singularitem[i2] = singularitem[i3];
-    //   singularitem[i3] = save;
+    // GetU() and GetV() start with the columns of the identity permuted by
+    // P, so the columns of U and V are consistent with the sorting of the
+    // singular values without copying columns afterwards.
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SingularValueDecomposition<Real>::ComputeOrthogonalMatrix(bool left,
+    Real* Z) const
+{
+    // The u vector of reflection i has its 1-valued component at index i
+    // and the v vector at index i+1.
+    int const N = mNumCols;
+    int const size = (left ? mNumRows : mNumCols);
+    int const numReflections = (left ? mNumCols : mNumCols - 2);
+    int const first = (left ? 0 : 1);
+    Real const* tau = (left ? &mTwoInvUTU[0] : &mTwoInvVTV[0]);
+    std::vector<GivensRotation> const& rotations =
+        (left ? mLGivens : mRGivens);
+
+    // Copy the Householder vectors of each block of reflections to a matrix
+    // Y whose first row corresponds to row i0+first of Z, where i0 is the
+    // index of the first reflection of the block, and compute its matrix T.
+    int const numBlocks = (numReflections + PANEL_SIZE - 1) / PANEL_SIZE;
+    int const sizeT = PANEL_SIZE*PANEL_SIZE;
+    std::vector<int> offsetY(numBlocks + 1);
+    offsetY[0] = 0;
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        int i0 = PANEL_SIZE*b;
+        int K = std::min((int)PANEL_SIZE, numReflections - i0);
+        offsetY[b + 1] = offsetY[b] + K*(size - first - i0);
+    }
+    std::vector<Real> Y(std::max(offsetY[numBlocks], 1));
+    std::vector<Real> T(std::max(sizeT*numBlocks, 1));
+
+    Run(numBlocks, [this, left, N, size, numReflections, first, tau,
+        &offsetY, &Y, &T](int bmin, int bmax)
+    {
+        for (int b = bmin; b < bmax; ++b)
+        {
+            int i0 = PANEL_SIZE*b;
+            int K = std::min((int)PANEL_SIZE, numReflections - i0);
+            int r0 = i0 + first;
+            Real* Yb = &Y[offsetY[b]];
+            for (int k = 0, i = i0; k < K; ++k, ++i)
+            {
+                for (int r = r0; r < size; ++r)
+                {
+                    Real& y = Yb[k + K*(r - r0)];
+                    if (r > i + first)
+                    {
+                        y = (left ? mMatrix[i + N*r] : mMatrix[r + N*i]);
+                    }
+                    else
+                    {
+                        y = (r == i + first ? (Real)1 : (Real)0);
+                    }
+                }
+            }
+            BlockReflector<Real>::ComputeT(size - r0, K, Yb, tau + i0,
+                &T[sizeT*b]);
+        }
+    }, 1);
+
+    // The Givens rotations involve only the first N rows, and the columns
+    // of Z after the first N are the standard basis vectors for the other
+    // rows, so the rotations are applied only to the first N columns.
+    Run(size, [this, N, size, numBlocks, numReflections, first, &rotations,
+        sizeT, &offsetY, &Y, &T, Z](int cmin, int cmax)
+    {
+        std::vector<Real> work(PANEL_SIZE*TILE_SIZE);
+        for (int c0 = cmin; c0 < cmax; c0 += TILE_SIZE)
+        {
+            int const numTileColumns = std::min((int)TILE_SIZE, cmax - c0);
+            int const numRotatedColumns =
+                std::max(std::min(numTileColumns, N - c0), 0);
+            Real* tile = Z + c0;
+
+            for (auto const& givens : gte::reverse(rotations))
+            {
+                Real* z0 = tile + size*givens.index0;
+                Real* z1 = tile + size*givens.index1;
+                Real cs = givens.cs, sn = givens.sn;
+                for (int c = 0; c < numRotatedColumns; ++c)
+                {
+                    Real tmp0 = cs * z0[c] + sn * z1[c];
+                    Real tmp1 = -sn * z0[c] + cs * z1[c];
+                    z0[c] = tmp0;
+                    z1[c] = tmp1;
+                }
+            }
+
+            for (int b = numBlocks - 1; b >= 0; --b)
+            {
+                int i0 = PANEL_SIZE*b;
+                int K = std::min((int)PANEL_SIZE, numReflections - i0);
+                int r0 = i0 + first;
+                BlockReflector<Real>::Apply(size - r0, K, &Y[offsetY[b]],
+                    &T[sizeT*b], numTileColumns, size, tile + size*r0,
+                    &work[0]);
+            }
+        }
+    }, TILE_SIZE);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SingularValueDecomposition<Real>::Run(int numItems,
+    std::function<void(int, int)> const& task, int minItemsPerThread) const
+{
+    unsigned int numThreads = mNumThreads;
+    if ((int64_t)minItemsPerThread*numThreads > (int64_t)numItems)
+    {
+        numThreads = std::max(numItems / minItemsPerThread, 1);
+    }
+    ParallelFor::Execute(numItems, numThreads, task);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
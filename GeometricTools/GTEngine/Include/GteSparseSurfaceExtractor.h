@@ -0,0 +1,113 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GteSurfaceExtractor.h"
+#include "GteParallelFor.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Extract level surfaces of a 3D image when the surfaces pass through a small
+// fraction of the voxels.  The voxels are partitioned into cubic blocks, and
+// the minimum and maximum of the samples of each block are stored in the
+// finest level of a pyramid.  Each coarser level stores the minimum and
+// maximum of 2x2x2 groups of the level below it, so the top level is a
+// single node for the entire image.  A block contains a voxel that
+// intersects the level surface only when its minimum is smaller than the
+// level and its maximum is not (a sample equal to the level is treated as
+// positive, as in SurfaceExtractor), so the extraction descends the pyramid
+// from the top, skipping every node that does not straddle the level, and
+// applies the marching cubes table only to the voxels of the blocks that
+// are reached.
+//
+// The pyramid is built once, by the constructor, and depends only on the
+// image; the surfaces for any number of levels may be extracted from it.
+// The image is referenced, not copied, so it must exist as long as the
+// extractor does.  If the pixels are modified, a new extractor must be
+// constructed.  The output is the same indexed mesh (without duplicate
+// vertices) that SurfaceExtractor::Extract(image,...) produces, although the
+// vertices and triangles are ordered by block.
+
+namespace gte
+{
+
+template <typename Real>
+class SparseSurfaceExtractor : public SurfaceExtractor<Real>
+{
+public:
+    // Construction.  The blocks have blockSize^3 voxels.  The pyramid is
+    // built using 'numThreads' threads; the value 0 or 1 builds it on the
+    // calling thread.
+    SparseSurfaceExtractor(Image3<Real> const& image, int blockSize = 8,
+        unsigned int numThreads = 1);
+
+    // Member access.
+    inline Image3<Real> const& GetImage() const;
+    inline int GetBlockSize() const;
+    inline int GetNumPyramidLevels() const;
+
+    // The extraction for the entire image and for a single voxel are still
+    // available.
+    using SurfaceExtractor<Real>::Extract;
+
+    // Extract the level surface F(x,y,z) = level, where F is the trilinear
+    // interpolation of the pixel values.  The vertices are in pixel
+    // coordinates.  The active blocks are partitioned among 'numThreads'
+    // threads; the value 0 or 1 processes them on the calling thread.  The
+    // function returns the number of active blocks, which are the only
+    // blocks whose voxels were visited.
+    int Extract(Real level, std::vector<Vector3<Real>>& vertices,
+        std::vector<std::array<int, 3>>& triangles,
+        unsigned int numThreads = 1) const;
+
+private:
+    // A level of the pyramid.  The node (x,y,z) has its minimum and maximum
+    // stored at index x+size[0]*(y+size[1]*z).
+    struct Level
+    {
+        int size[3];
+        std::vector<Real> minimum, maximum;
+    };
+
+    // The mesh generated for a range of blocks.  The vertices on the faces
+    // of a block are stored with the keys of their lattice edges, 3*i+axis
+    // for the edge starting at the pixel of index i, so that the vertices
+    // shared by blocks can be identified when the meshes are concatenated.
+    // The other vertices have the key NOT_SHARED.
+    static uint64_t const NOT_SHARED = 0xFFFFFFFFFFFFFFFFull;
+
+    struct BlockMesh
+    {
+        std::vector<uint64_t> keys;
+        std::vector<Vector3<Real>> vertices;
+        std::vector<std::array<int, 3>> triangles;
+    };
+
+    // Compute the minima and maxima of the blocks with z in [zmin,zmax).
+    void ComputeBlocks(int zmin, int zmax);
+
+    // Append to 'active' the blocks of the subtree rooted at the specified
+    // node that straddle the level.
+    void FindActiveBlocks(int level, int x, int y, int z, Real value,
+        std::vector<std::array<int, 3>>& active) const;
+
+    // Extract the mesh of the active blocks in [bmin,bmax).
+    void ExtractBlocks(Real level, std::vector<std::array<int, 3>> const&
+        active, int bmin, int bmax, BlockMesh& mesh) const;
+
+    Image3<Real> const& mImage;
+    int mBlockSize;
+
+    // mPyramid[0] is the finest level, each of whose nodes is a block.
+    std::vector<Level> mPyramid;
+};
+
+#include "GteSparseSurfaceExtractor.inl"
+
+}
@@ -0,0 +1,348 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+template <typename Real>
+SparseSurfaceExtractor<Real>::SparseSurfaceExtractor(
+    Image3<Real> const& image, int blockSize, unsigned int numThreads)
+    :
+    mImage(image),
+    mBlockSize(std::max(blockSize, 1))
+{
+    int numVoxels[3];
+    for (int d = 0; d < 3; ++d)
+    {
+        numVoxels[d] = mImage.GetDimension(d) - 1;
+    }
+    if (mImage.GetNumDimensions() != 3 || numVoxels[0] < 1
+        || numVoxels[1] < 1 || numVoxels[2] < 1)
+    {
+        LogError("The image must have at least 2 samples per dimension.");
+        return;
+    }
+
+    // The finest level has a node per block.  The blocks on the upper
+    // boundary have fewer voxels when the block size does not divide the
+    // number of voxels.
+    Level finest;
+    for (int d = 0; d < 3; ++d)
+    {
+        finest.size[d] = (numVoxels[d] + mBlockSize - 1) / mBlockSize;
+    }
+    size_t numBlocks = static_cast<size_t>(finest.size[0]) *
+        finest.size[1] * finest.size[2];
+    finest.minimum.resize(numBlocks);
+    finest.maximum.resize(numBlocks);
+    mPyramid.push_back(finest);
+
+    ParallelFor::Execute(finest.size[2], numThreads, [this](int zmin,
+        int zmax)
+    {
+        ComputeBlocks(zmin, zmax);
+    });
+
+    // Each coarser level combines 2x2x2 nodes of the level below it.  The
+    // coarser levels have at most 1/7 of the nodes of the finest level, so
+    // they are computed on the calling thread.
+    while (mPyramid.back().size[0] > 1 || mPyramid.back().size[1] > 1
+        || mPyramid.back().size[2] > 1)
+    {
+        Level const& fine = mPyramid.back();
+        Level coarse;
+        for (int d = 0; d < 3; ++d)
+        {
+            coarse.size[d] = (fine.size[d] + 1) / 2;
+        }
+        size_t numNodes = static_cast<size_t>(coarse.size[0]) *
+            coarse.size[1] * coarse.size[2];
+        coarse.minimum.resize(numNodes);
+        coarse.maximum.resize(numNodes);
+
+        for (int z = 0, i = 0; z < coarse.size[2]; ++z)
+        {
+            for (int y = 0; y < coarse.size[1]; ++y)
+            {
+                for (int x = 0; x < coarse.size[0]; ++x, ++i)
+                {
+                    Real vmin = std::numeric_limits<Real>::max();
+                    Real vmax = -std::numeric_limits<Real>::max();
+                    int const x1 = std::min(2 * x + 2, fine.size[0]);
+                    int const y1 = std::min(2 * y + 2, fine.size[1]);
+                    int const z1 = std::min(2 * z + 2, fine.size[2]);
+                    for (int fz = 2 * z; fz < z1; ++fz)
+                    {
+                        for (int fy = 2 * y; fy < y1; ++fy)
+                        {
+                            for (int fx = 2 * x; fx < x1; ++fx)
+                            {
+                                size_t j = fx + fine.size[0] *
+                                    (fy + static_cast<size_t>(fine.size[1])
+                                    * fz);
+                                vmin = std::min(vmin, fine.minimum[j]);
+                                vmax = std::max(vmax, fine.maximum[j]);
+                            }
+                        }
+                    }
+                    coarse.minimum[i] = vmin;
+                    coarse.maximum[i] = vmax;
+                }
+            }
+        }
+        mPyramid.push_back(coarse);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+Image3<Real> const& SparseSurfaceExtractor<Real>::GetImage() const
+{
+    return mImage;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+int SparseSurfaceExtractor<Real>::GetBlockSize() const
+{
+    return mBlockSize;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+int SparseSurfaceExtractor<Real>::GetNumPyramidLevels() const
+{
+    return static_cast<int>(mPyramid.size());
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int SparseSurfaceExtractor<Real>::Extract(Real level,
+    std::vector<Vector3<Real>>& vertices,
+    std::vector<std::array<int, 3>>& triangles, unsigned int numThreads)
+    const
+{
+    vertices.clear();
+    triangles.clear();
+    if (mPyramid.size() == 0)
+    {
+        return 0;
+    }
+
+    std::vector<std::array<int, 3>> active;
+    FindActiveBlocks(static_cast<int>(mPyramid.size()) - 1, 0, 0, 0, level,
+        active);
+    int const numActive = static_cast<int>(active.size());
+    if (numActive == 0)
+    {
+        return 0;
+    }
+
+    // Partition the active blocks into contiguous ranges, one per thread.
+    int const numRanges = static_cast<int>(ParallelFor::GetNumThreads(
+        numThreads, numActive));
+    std::vector<BlockMesh> meshes(numRanges);
+    ParallelFor::Execute(numRanges, [this, level, &active, numActive,
+        numRanges, &meshes](unsigned int t)
+    {
+        int bmin, bmax;
+        ParallelFor::GetRange(numActive, numRanges, t, bmin, bmax);
+        ExtractBlocks(level, active, bmin, bmax, meshes[t]);
+    });
+
+    // Concatenate the meshes.  A vertex on a face shared by two active
+    // blocks is generated by both, so the vertices on block faces are
+    // identified by their edge keys.  The vertices are kept in the order of
+    // their first occurrence, which does not depend on the number of
+    // threads.
+    std::unordered_map<uint64_t, int> keyToIndex;
+    std::vector<int> remap;
+    for (auto& mesh : meshes)
+    {
+        int const numVertices = static_cast<int>(mesh.vertices.size());
+        remap.resize(numVertices);
+        for (int i = 0; i < numVertices; ++i)
+        {
+            if (mesh.keys[i] == NOT_SHARED)
+            {
+                remap[i] = static_cast<int>(vertices.size());
+                vertices.push_back(mesh.vertices[i]);
+                continue;
+            }
+
+            auto result = keyToIndex.insert(std::make_pair(mesh.keys[i],
+                static_cast<int>(vertices.size())));
+            if (result.second)
+            {
+                vertices.push_back(mesh.vertices[i]);
+            }
+            remap[i] = result.first->second;
+        }
+
+        for (auto const& tri : mesh.triangles)
+        {
+            std::array<int, 3> global = {{ remap[tri[0]], remap[tri[1]],
+                remap[tri[2]] }};
+            triangles.push_back(global);
+        }
+
+        mesh = BlockMesh();
+    }
+    return numActive;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SparseSurfaceExtractor<Real>::ComputeBlocks(int zmin, int zmax)
+{
+    int const numX = mImage.GetDimension(0);
+    int const numY = mImage.GetDimension(1);
+    int const numZ = mImage.GetDimension(2);
+    size_t const numXY = static_cast<size_t>(numX) * numY;
+    Real const* pixels = mImage.GetPixels1D();
+    Level& finest = mPyramid[0];
+
+    // The block (bx,by,bz) has the voxels with x in [B*bx,B*bx+B), limited
+    // by the number of voxels, so its samples have x in [B*bx,B*bx+B].
+    for (int bz = zmin; bz < zmax; ++bz)
+    {
+        int const z0 = mBlockSize * bz;
+        int const z1 = std::min(z0 + mBlockSize, numZ - 1);
+        for (int by = 0; by < finest.size[1]; ++by)
+        {
+            int const y0 = mBlockSize * by;
+            int const y1 = std::min(y0 + mBlockSize, numY - 1);
+            for (int bx = 0; bx < finest.size[0]; ++bx)
+            {
+                int const x0 = mBlockSize * bx;
+                int const x1 = std::min(x0 + mBlockSize, numX - 1);
+                Real vmin = std::numeric_limits<Real>::max();
+                Real vmax = -std::numeric_limits<Real>::max();
+                for (int z = z0; z <= z1; ++z)
+                {
+                    for (int y = y0; y <= y1; ++y)
+                    {
+                        Real const* row = pixels + z * numXY +
+                            static_cast<size_t>(y) * numX;
+                        for (int x = x0; x <= x1; ++x)
+                        {
+                            vmin = std::min(vmin, row[x]);
+                            vmax = std::max(vmax, row[x]);
+                        }
+                    }
+                }
+                size_t i = bx + finest.size[0] *
+                    (by + static_cast<size_t>(finest.size[1]) * bz);
+                finest.minimum[i] = vmin;
+                finest.maximum[i] = vmax;
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SparseSurfaceExtractor<Real>::FindActiveBlocks(int level, int x, int y,
+    int z, Real value, std::vector<std::array<int, 3>>& active) const
+{
+    Level const& node = mPyramid[level];
+    size_t i = x + node.size[0] * (y + static_cast<size_t>(node.size[1]) * z);
+    if (!(node.minimum[i] < value && node.maximum[i] >= value))
+    {
+        // The samples of the subtree are all negative or all positive.
+        return;
+    }
+
+    if (level == 0)
+    {
+        std::array<int, 3> block = {{ x, y, z }};
+        active.push_back(block);
+        return;
+    }
+
+    Level const& child = mPyramid[level - 1];
+    int const x1 = std::min(2 * x + 2, child.size[0]);
+    int const y1 = std::min(2 * y + 2, child.size[1]);
+    int const z1 = std::min(2 * z + 2, child.size[2]);
+    for (int cz = 2 * z; cz < z1; ++cz)
+    {
+        for (int cy = 2 * y; cy < y1; ++cy)
+        {
+            for (int cx = 2 * x; cx < x1; ++cx)
+            {
+                FindActiveBlocks(level - 1, cx, cy, cz, value, active);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SparseSurfaceExtractor<Real>::ExtractBlocks(Real level,
+    std::vector<std::array<int, 3>> const& active, int bmin, int bmax,
+    BlockMesh& mesh) const
+{
+    int const numX = mImage.GetDimension(0);
+    int const numY = mImage.GetDimension(1);
+    int const numZ = mImage.GetDimension(2);
+    size_t const numXY = static_cast<size_t>(numX) * numY;
+    Real const* pixels = mImage.GetPixels1D();
+
+    // The vertex indices for the lattice edges of a block, stored at
+    // 3*(x+S*(y+S*z))+axis for the edge starting at the block-relative
+    // sample (x,y,z), where S = blockSize+1.  The value -1 indicates that
+    // the vertex has not been generated.
+    int const S = mBlockSize + 1;
+    std::vector<int> cache(3 * static_cast<size_t>(S) * S * S);
+
+    typename SurfaceExtractor<Real>::Voxel voxel;
+    int index[MarchingCubes::MAX_VERTICES];
+    for (int b = bmin; b < bmax; ++b)
+    {
+        std::fill(cache.begin(), cache.end(), -1);
+        int const x0 = mBlockSize * active[b][0];
+        int const y0 = mBlockSize * active[b][1];
+        int const z0 = mBlockSize * active[b][2];
+        int const x1 = std::min(x0 + mBlockSize, numX - 1);
+        int const y1 = std::min(y0 + mBlockSize, numY - 1);
+        int const z1 = std::min(z0 + mBlockSize, numZ - 1);
+
+        for (int z = z0; z < z1; ++z)
+        {
+            for (int y = y0; y < y1; ++y)
+            {
+                Real const* sample = &pixels[static_cast<size_t>(z) * numXY
+                    + static_cast<size_t>(y) * numX + x0];
+                for (int x = x0; x < x1; ++x, ++sample)
+                {
+                    if (!this->ExtractVoxel(sample, numX, numXY, level, x,
+                        y, z, voxel))
+                    {
+                        continue;
+                    }
+
+                    for (int i = 0; i < voxel.numVertices; ++i)
+                    {
+                        int const* edge = voxel.edge[i];
+                        int const ex = edge[0], ey = edge[1], ez = edge[2];
+                        int const axis = edge[3];
+                        int& cached = cache[3 * ((ex - x0) + S * ((ey - y0) +
+                            S * (ez - z0))) + axis];
+                        if (cached == -1)
+                        {
+                            // Only the vertices on the faces of the block can
+                            // be shared with other blocks.
+                            bool onFace =
+                                (axis != 0 && (ex == x0 || ex == x1)) ||
+                                (axis != 1 && (ey == y0 || ey == y1)) ||
+                                (axis != 2 && (ez == z0 || ez == z1));
+                            mesh.keys.push_back(onFace ? 3 * (ex + numX *
+                                (ey + static_cast<uint64_t>(numY) * ez)) +
+                                axis : NOT_SHARED);
+                        }
+                        index[i] = this->WeldVertex(voxel, i, cached,
+                            mesh.vertices);
+                    }
+
+                    this->AppendTriangles(voxel, index, mesh.triangles);
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
@@ -8,6 +8,10 @@
 #pragma once
 
 #include "GteMarchingCubes.h"
+#include "GteImage3.h"
+#include "GteParallelFor.h"
+#include "GteVector3.h"
+#include <vector>
 
 namespace gte
 {
@@ -40,6 +44,91 @@ public:
     };
 
     bool Extract(Real const F[8], Mesh& mesh) const;
+
+    // Extract the level surface F(x,y,z) = level for the entire image, where
+    // F is the trilinear interpolation of the pixel values.  The sign of a
+    // sample is that of image(x,y,z) - level, and samples equal to the level
+    // are treated as positive (as in the GPU extraction of the Surface
+    // Extraction sample), so the table's assumption of nonzero samples is
+    // satisfied.  The vertices are in pixel coordinates.  Each vertex is
+    // generated once for the lattice edge containing it, so the mesh has no
+    // duplicate vertices and the triangles share vertices along the voxel
+    // faces.  When a sample equals the level, the vertices of its incident
+    // edges can be at the sample location, in which case they are distinct
+    // vertices with the same position and the triangles sharing them are
+    // degenerate.  The triangles are counterclockwise ordered when viewed
+    // from the negative side of the level surface.
+    //
+    // The voxels are partitioned into 'numThreads' slabs of consecutive z
+    // values that are processed in parallel; the value 0 or 1 processes the
+    // image on the calling thread.  The vertices of each slab are cached for
+    // the lattice edges of two planes z and z+1 at a time.  The vertices on
+    // the plane shared by two slabs are generated by the lower slab and the
+    // references to them from the upper slab are resolved when the slab
+    // meshes are concatenated.
+    void Extract(Image3<Real> const& image, Real level,
+        std::vector<Vector3<Real>>& vertices,
+        std::vector<std::array<int, 3>>& triangles,
+        unsigned int numThreads = 1) const;
+
+protected:
+    // The marching cubes table applied to the voxel whose minimum corner is
+    // the sample (x,y,z) of an image.  The i-th vertex of the voxel mesh is
+    // on the lattice edge that starts at the sample edge[i][0..2] and has
+    // axis edge[i][3]; it is interpolated between the voxel corners
+    // corner[i][0] and corner[i][1], which are indexed as in F[].  The
+    // triangles are triples of indices into the voxel vertices.
+    struct Voxel
+    {
+        Real F[8];
+        int numVertices, numTriangles;
+        int edge[MAX_VERTICES][4];
+        int corner[MAX_VERTICES][2];
+        int itriple[3 * MAX_TRIANGLES];
+    };
+
+    // Look up the voxel with minimum corner (x,y,z) in the table, where
+    // 'sample' points to the sample (x,y,z) of an image with numX*numY*numZ
+    // samples and numXY = numX*numY.  The function returns 'false' when the
+    // voxel does not intersect the level surface, in which case 'voxel' is
+    // not complete.
+    inline bool ExtractVoxel(Real const* sample, int numX, size_t numXY,
+        Real level, int x, int y, int z, Voxel& voxel) const;
+
+    // Look up the vertices and triangles of a voxel with table entry
+    // 'entry' that intersects the level surface.  This is the part of
+    // ExtractVoxel that is not inlined.
+    void UnpackVoxel(int entry, int x, int y, int z, Voxel& voxel) const;
+
+    // Return the index of the i-th voxel vertex, where 'cached' is the
+    // storage for the lattice edge containing it.  When 'cached' is -1, the
+    // vertex is interpolated and appended to 'vertices' and 'cached' is set
+    // to its index.
+    inline int WeldVertex(Voxel const& voxel, int i, int& cached,
+        std::vector<Vector3<Real>>& vertices) const;
+
+    // Append the voxel triangles, where index[] maps the voxel vertices to
+    // the indices returned by WeldVertex.
+    inline void AppendTriangles(Voxel const& voxel, int const* index,
+        std::vector<std::array<int, 3>>& triangles) const;
+
+private:
+    // The mesh of the voxels with z in [zmin,zmax).  The triangle indices
+    // are into the slab vertices.  A negative index -2-e refers to the
+    // vertex of edge e of the bottom plane generated by the previous slab,
+    // where e < numX*numY is the x-edge starting at e and otherwise e is the
+    // y-edge starting at e-numX*numY.  The vertex indices for the edges of
+    // the top plane are stored in topEdges for the next slab.
+    struct Slab
+    {
+        int zmin, zmax;
+        std::vector<Vector3<Real>> vertices;
+        std::vector<std::array<int, 3>> triangles;
+        std::vector<int> topEdges;
+    };
+
+    void ExtractSlab(Image3<Real> const& image, Real level, bool shareBottom,
+        Slab& slab) const;
 };
 
 #include "GteSurfaceExtractor.inl"
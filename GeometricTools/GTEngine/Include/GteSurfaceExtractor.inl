@@ -66,3 +66,253 @@ bool SurfaceExtractor<Real>::Extract(Real const F[8], Mesh& mesh) const
     return true;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void SurfaceExtractor<Real>::Extract(Image3<Real> const& image, Real level,
+    std::vector<Vector3<Real>>& vertices,
+    std::vector<std::array<int, 3>>& triangles, unsigned int numThreads)
+    const
+{
+    vertices.clear();
+    triangles.clear();
+
+    int const numX = image.GetDimension(0);
+    int const numY = image.GetDimension(1);
+    int const numZ = image.GetDimension(2);
+    if (image.GetNumDimensions() != 3 || numX < 2 || numY < 2 || numZ < 2)
+    {
+        return;
+    }
+
+    // Partition the voxel layers z = 0..numZ-2 into slabs.
+    int const numLayers = numZ - 1;
+    int const numSlabs = static_cast<int>(ParallelFor::GetNumThreads(
+        numThreads, numLayers));
+    std::vector<Slab> slabs(numSlabs);
+    for (int t = 0; t < numSlabs; ++t)
+    {
+        ParallelFor::GetRange(numLayers, numSlabs, t, slabs[t].zmin,
+            slabs[t].zmax);
+    }
+
+    ParallelFor::Execute(numSlabs, [this, &image, level, &slabs]
+        (unsigned int t)
+    {
+        ExtractSlab(image, level, t > 0, slabs[t]);
+    });
+
+    // Concatenate the slab meshes.  The references to the bottom-plane
+    // vertices of a slab are resolved using the top-plane vertices of the
+    // previous slab.
+    std::vector<int> vertexOffset(numSlabs);
+    size_t numVertices = 0, numTriangles = 0;
+    for (int t = 0; t < numSlabs; ++t)
+    {
+        vertexOffset[t] = static_cast<int>(numVertices);
+        numVertices += slabs[t].vertices.size();
+        numTriangles += slabs[t].triangles.size();
+    }
+    vertices.reserve(numVertices);
+    triangles.reserve(numTriangles);
+    for (int t = 0; t < numSlabs; ++t)
+    {
+        Slab& slab = slabs[t];
+        vertices.insert(vertices.end(), slab.vertices.begin(),
+            slab.vertices.end());
+        for (auto const& tri : slab.triangles)
+        {
+            std::array<int, 3> global;
+            for (int j = 0; j < 3; ++j)
+            {
+                if (tri[j] >= 0)
+                {
+                    global[j] = vertexOffset[t] + tri[j];
+                }
+                else
+                {
+                    global[j] = vertexOffset[t - 1] +
+                        slabs[t - 1].topEdges[-2 - tri[j]];
+                }
+            }
+            triangles.push_back(global);
+        }
+
+        // The slab storage is no longer needed, except for the top edges
+        // used by the next slab.
+        std::vector<Vector3<Real>>().swap(slab.vertices);
+        std::vector<std::array<int, 3>>().swap(slab.triangles);
+        if (t > 0)
+        {
+            std::vector<int>().swap(slabs[t - 1].topEdges);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SurfaceExtractor<Real>::ExtractSlab(Image3<Real> const& image,
+    Real level, bool shareBottom, Slab& slab) const
+{
+    int const numX = image.GetDimension(0);
+    int const numY = image.GetDimension(1);
+    size_t const numXY = static_cast<size_t>(numX) * numY;
+    Real const* pixels = image.GetPixels1D();
+
+    // The vertex indices for the x-edges and y-edges of the planes z and
+    // z+1 and for the z-edges between them.  The x-edge starting at (x,y)
+    // is stored at y*numX+x and the y-edge starting at (x,y) is stored at
+    // numX*numY+y*numX+x.  The value -1 indicates that the vertex has not
+    // been generated.
+    std::vector<int> planeEdges[2];
+    planeEdges[0].resize(2 * numXY);
+    planeEdges[1].resize(2 * numXY);
+    std::vector<int> zEdges(numXY);
+    std::fill(planeEdges[0].begin(), planeEdges[0].end(), -1);
+    int bottom = 0;
+
+    Voxel voxel;
+    int index[MAX_VERTICES];
+    for (int z = slab.zmin; z < slab.zmax; ++z)
+    {
+        int const top = 1 - bottom;
+        std::fill(planeEdges[top].begin(), planeEdges[top].end(), -1);
+        std::fill(zEdges.begin(), zEdges.end(), -1);
+        bool const external = (shareBottom && z == slab.zmin);
+
+        for (int y = 0; y + 1 < numY; ++y)
+        {
+            Real const* sample = &pixels[static_cast<size_t>(z) * numXY +
+                static_cast<size_t>(y) * numX];
+            for (int x = 0; x + 1 < numX; ++x, ++sample)
+            {
+                if (!ExtractVoxel(sample, numX, numXY, level, x, y, z,
+                    voxel))
+                {
+                    continue;
+                }
+
+                for (int i = 0; i < voxel.numVertices; ++i)
+                {
+                    int const* edge = voxel.edge[i];
+                    size_t e = static_cast<size_t>(edge[1]) * numX + edge[0];
+                    int* cached;
+                    if (edge[3] == 2)
+                    {
+                        cached = &zEdges[e];
+                    }
+                    else
+                    {
+                        if (edge[3] == 1)
+                        {
+                            e += numXY;
+                        }
+                        if (edge[2] == z && external)
+                        {
+                            // The vertex is generated by the previous slab.
+                            index[i] = -2 - static_cast<int>(e);
+                            continue;
+                        }
+                        cached = &planeEdges[edge[2] == z ? bottom : top][e];
+                    }
+                    index[i] = WeldVertex(voxel, i, *cached, slab.vertices);
+                }
+
+                AppendTriangles(voxel, index, slab.triangles);
+            }
+        }
+
+        bottom = top;
+    }
+
+    // After the last layer, the top plane of the slab is at 'bottom'.
+    slab.topEdges = std::move(planeEdges[bottom]);
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+bool SurfaceExtractor<Real>::ExtractVoxel(Real const* sample, int numX,
+    size_t numXY, Real level, int x, int y, int z, Voxel& voxel) const
+{
+    size_t const i010 = numX, i001 = numXY, i011 = numXY + numX;
+    Real F[8];
+    F[0] = sample[0] - level;
+    F[1] = sample[1] - level;
+    F[2] = sample[i010] - level;
+    F[3] = sample[i010 + 1] - level;
+    F[4] = sample[i001] - level;
+    F[5] = sample[i001 + 1] - level;
+    F[6] = sample[i011] - level;
+    F[7] = sample[i011 + 1] - level;
+
+    int entry = 0;
+    for (int k = 0, mask = 1; k < 8; ++k, mask <<= 1)
+    {
+        if (F[k] < (Real)0)
+        {
+            entry |= mask;
+        }
+    }
+    if (entry == 0 || entry == 255)
+    {
+        return false;
+    }
+
+    std::copy(F, F + 8, voxel.F);
+    UnpackVoxel(entry, x, y, z, voxel);
+    return true;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SurfaceExtractor<Real>::UnpackVoxel(int entry, int x, int y, int z,
+    Voxel& voxel) const
+{
+    int vpair[2 * MAX_VERTICES];
+    Unpack(entry, voxel.numVertices, vpair, voxel.numTriangles,
+        voxel.itriple);
+    for (int i = 0; i < voxel.numVertices; ++i)
+    {
+        // The corners of the edge differ in one bit, which identifies the
+        // axis of the edge.
+        int j0 = std::min(vpair[2 * i], vpair[2 * i + 1]);
+        int j1 = std::max(vpair[2 * i], vpair[2 * i + 1]);
+        int* edge = voxel.edge[i];
+        edge[0] = x + (j0 & 1);
+        edge[1] = y + ((j0 & 2) >> 1);
+        edge[2] = z + ((j0 & 4) >> 2);
+        edge[3] = (j1 - j0 == 1 ? 0 : (j1 - j0 == 2 ? 1 : 2));
+        voxel.corner[i][0] = j0;
+        voxel.corner[i][1] = j1;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+int SurfaceExtractor<Real>::WeldVertex(Voxel const& voxel, int i,
+    int& cached, std::vector<Vector3<Real>>& vertices) const
+{
+    if (cached == -1)
+    {
+        // F[j0] and F[j1] have opposite signs, so the denominator is not
+        // zero.
+        int const* edge = voxel.edge[i];
+        Real F0 = voxel.F[voxel.corner[i][0]];
+        Real F1 = voxel.F[voxel.corner[i][1]];
+        Vector3<Real> vertex{ static_cast<Real>(edge[0]),
+            static_cast<Real>(edge[1]), static_cast<Real>(edge[2]) };
+        vertex[edge[3]] += F0 / (F0 - F1);
+        cached = static_cast<int>(vertices.size());
+        vertices.push_back(vertex);
+    }
+    return cached;
+}
+//----------------------------------------------------------------------------
+template <typename Real> inline
+void SurfaceExtractor<Real>::AppendTriangles(Voxel const& voxel,
+    int const* index, std::vector<std::array<int, 3>>& triangles) const
+{
+    for (int i = 0; i < voxel.numTriangles; ++i)
+    {
+        std::array<int, 3> tri;
+        tri[0] = index[voxel.itriple[3 * i]];
+        tri[1] = index[voxel.itriple[3 * i + 1]];
+        tri[2] = index[voxel.itriple[3 * i + 2]];
+        triangles.push_back(tri);
+    }
+}
+//----------------------------------------------------------------------------
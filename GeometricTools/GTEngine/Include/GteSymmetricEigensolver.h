@@ -7,8 +7,13 @@
 
 #pragma once
 
+#include "GteBlockReflector.h"
+#include "GteLogger.h"
+#include "GteParallelFor.h"
 #include "GteRangeIteration.h"
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 // The SymmetricEigensolver class is an implementation of Algorithm 8.2.3
@@ -97,6 +102,11 @@
 // comperr is the computation E = Q^T*A*Q - D.  The construction of the full
 // eigenvector matrix is, of course, quite expensive.  If you need only a
 // small number of eigenvectors, use function GetEigenvector(int,Real*).
+//
+// The tridiagonalization applies the reflections in panels of PANEL_SIZE
+// and the eigenvectors are computed by applying blocks of PANEL_SIZE
+// reflections in the compact WY form of BlockReflector to tiles of
+// TILE_SIZE columns.
 
 namespace gte
 {
@@ -109,16 +119,28 @@ public:
     // and the matrix is stored in row-major order.  The maximum number of
     // iterations ('maxIterations') must be specified for the reduction of a
     // tridiagonal matrix to a diagonal matrix.  The goal is to compute
-    // NxN orthogonal Q and NxN diagonal D for which Q^T*A*Q = D.
-    SymmetricEigensolver(int size, unsigned int maxIterations);
+    // NxN orthogonal Q and NxN diagonal D for which Q^T*A*Q = D.  The
+    // number of threads is used by the tridiagonalization and by the
+    // computation of eigenvectors.  Each element of the results is
+    // computed by one thread in the same order for any number of threads,
+    // so the results do not depend on numThreads.  They can differ in the
+    // last bits between builds, because a compiler that vectorizes the
+    // inner loops changes the order of their sums.
+    SymmetricEigensolver(int size, unsigned int maxIterations,
+        unsigned int numThreads = 1);
 
-    // A copy of the NxN symmetric input is made internally.  The order of
-    // the eigenvalues is specified by sortType: -1 (decreasing), 0 (no
-    // sorting), or +1 (increasing).  When sorted, the eigenvectors are
-    // ordered accordingly.  The return value is the number of iterations
-    // consumed when convergence occurred, 0xFFFFFFFF when convergence did
-    // not occur, or 0 when N <= 1 was passed to the constructor.
-    unsigned int Solve(Real const* input, int sortType);
+    // A copy of the NxN symmetric input is made internally; only its upper
+    // triangular part is used and the elements below the diagonal are
+    // ignored.  The order of the eigenvalues is specified
+    // by sortType: -1 (decreasing), 0 (no sorting), or +1 (increasing).
+    // When sorted, the eigenvectors are ordered accordingly.  When you need
+    // only the eigenvalues, set wantEigenvectors to 'false' so that the
+    // Givens rotations are not stored; the eigenvector queries are then
+    // invalid.  The return value is the number of iterations consumed when
+    // convergence occurred, 0xFFFFFFFF when convergence did not occur, or 0
+    // when N <= 1 was passed to the constructor.
+    unsigned int Solve(Real const* input, int sortType,
+        bool wantEigenvectors = true);
 
     // Get the eigenvalues of the matrix passed to Solve(...).  The input
     // 'eigenvalues' must have N elements.
@@ -129,6 +151,15 @@ public:
     // 'eigenvectors' must be NxN and stored in row-major order.
     void GetEigenvectors(Real* eigenvectors) const;
 
+    // Compute the eigenvectors for the eigenvalues of the specified indices
+    // (into the sorted eigenvalues when sorting was requested).  The input
+    // 'eigenvectors' must have numIndices*N elements; eigenvector j is
+    // stored contiguously starting at eigenvectors[N*j].  The cost is
+    // proportional to numIndices, so this is useful when you want, say,
+    // the eigenvectors for the smallest few eigenvalues of a Laplacian.
+    void GetEigenvectors(int numIndices, int const* indices,
+        Real* eigenvectors) const;
+
     // With no sorting, when N is odd the matrix returned by GetEigenvectors
     // is a reflection and when N is even it is a rotation.  With sorting
     // enabled, the type of matrix returned depends on the permutation of
@@ -144,15 +175,45 @@ public:
     Real GetEigenvalue(int c) const;
 
 private:
+    // The number of Householder reflections in a panel of the blocked
+    // tridiagonalization and in a block of the eigenvector accumulation, and
+    // the number of columns of Q that are processed together.
+    enum
+    {
+        PANEL_SIZE = 32,
+        TILE_SIZE = 128
+    };
+
     // Tridiagonalize using Householder reflections.  On input, mMatrix is a
-    // copy of the input matrix.  On output, the upper-triangular part of
-    // mMatrix including the diagonal stores the tridiagonalization.  The
-    // lower-triangular part contains 2/Dot(v,v) that are used in computing
-    // eigenvectors and the part below the subdiagonal stores the essential
-    // parts of the Householder vectors v (the elements of v after the
-    // leading 1-valued component).
+    // copy of the input matrix.  On output, mDiagonal and mSuperdiagonal
+    // store the tridiagonalization.  The lower-triangular part of mMatrix
+    // contains 2/Dot(v,v) that are used in computing eigenvectors and the
+    // part below the subdiagonal stores the essential parts of the
+    // Householder vectors v (the elements of v after the leading 1-valued
+    // component).  The reflections are computed in panels of PANEL_SIZE
+    // columns; see the LAPACK function DLATRD.  Each reflection H = I-t*v*v^T
+    // is applied to the remaining matrix B as B - v*w^T - w*v^T.  The vector
+    // pairs (v,w) of a panel are accumulated and the matrix to the lower
+    // right of the panel is updated once per panel, and the update is a
+    // matrix-matrix product that visits that matrix once rather than once
+    // per reflection.
     void Tridiagonalize();
 
+    // Compute Q*E, where the column j of E is the standard basis vector for
+    // the eigenvalue indices[j] (all eigenvalues when indices is null).  The
+    // output Z has numColumns columns and is stored in row-major order.  The
+    // Givens rotations and then the blocked Householder reflections are
+    // applied to tiles of TILE_SIZE columns of Z; the tiles are partitioned
+    // among the threads.
+    void ComputeEigenvectors(int numColumns, int const* indices, Real* Z)
+        const;
+
+    // Call task(imin,imax) on subranges of [0,numItems), one per thread,
+    // using fewer threads when a thread would have fewer than
+    // minItemsPerThread items.
+    void Run(int numItems, std::function<void(int, int)> const& task,
+        int minItemsPerThread) const;
+
     // A helper for generating Givens rotation sine and cosine robustly.
     void GetSinCos(Real u, Real v, Real& cs, Real& sn);
 
@@ -179,6 +240,12 @@ private:
     // to a diagonal matrix.
     unsigned int mMaxIterations;
 
+    // The number of threads to use.
+    unsigned int mNumThreads;
+
+    // The value of wantEigenvectors passed to Solve.
+    bool mWantEigenvectors;
+
     // The internal copy of a matrix passed to the solver.  See the comments
     // about function Tridiagonalize() about what is stored in the matrix.
     std::vector<Real> mMatrix;  // NxN elements
@@ -213,11 +280,12 @@ private:
     mutable std::vector<int> mVisited;  // N elements
     mutable int mIsRotation;  // 1 = rotation, 0 = reflection, -1 = unknown
 
-    // Temporary storage to compute Householder reflections and to support
-    // sorting of eigenvectors.
+    // Temporary storage to compute Householder reflections and single
+    // eigenvectors.  The panels store the vectors v and w of the reflections
+    // of a panel, each vector with N elements.
     mutable std::vector<Real> mPVector;  // N elements
-    mutable std::vector<Real> mVVector;  // N elements
-    mutable std::vector<Real> mWVector;  // N elements
+    std::vector<Real> mVPanel;  // PANEL_SIZE*N elements
+    std::vector<Real> mWPanel;  // PANEL_SIZE*N elements
 };
 
 #include "GteSymmetricEigensolver.inl"
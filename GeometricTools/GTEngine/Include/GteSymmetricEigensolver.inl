@@ -8,10 +8,12 @@
 //----------------------------------------------------------------------------
 template <typename Real>
 SymmetricEigensolver<Real>::SymmetricEigensolver(int size,
-    unsigned int maxIterations)
+    unsigned int maxIterations, unsigned int numThreads)
     :
     mSize(0),
     mMaxIterations(0),
+    mNumThreads(numThreads > 0 ? numThreads : 1),
+    mWantEigenvectors(false),
     mIsRotation(-1)
 {
     if (size > 1 && maxIterations > 0)
@@ -25,18 +27,19 @@ SymmetricEigensolver<Real>::SymmetricEigensolver(int size,
         mPermutation.resize(size);
         mVisited.resize(size);
         mPVector.resize(size);
-        mVVector.resize(size);
-        mWVector.resize(size);
+        mVPanel.resize(PANEL_SIZE*size);
+        mWPanel.resize(PANEL_SIZE*size);
     }
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 unsigned int SymmetricEigensolver<Real>::Solve(Real const* input,
-    int sortType)
+    int sortType, bool wantEigenvectors)
 {
     if (mSize > 0)
     {
         std::copy(input, input + mSize*mSize, mMatrix.begin());
+        mWantEigenvectors = wantEigenvectors;
         Tridiagonalize();
 
         mGivens.clear();
@@ -115,98 +118,46 @@ void SymmetricEigensolver<Real>::GetEigenvectors(Real* eigenvectors) const
 {
     if (eigenvectors && mSize > 0)
     {
-        // Start with the identity matrix.
-        std::fill(eigenvectors, eigenvectors + mSize*mSize, (Real)0);
-        for (int d = 0; d < mSize; ++d)
+        if (!mWantEigenvectors)
         {
-            eigenvectors[d + mSize*d] = (Real)1;
+            LogError("Solve was called with wantEigenvectors set to false.");
+            return;
         }
 
-        // Multiply the Householder reflections using backward accumulation.
-        int r, c;
-        for (int i = mSize - 3, rmin = i + 1; i >= 0; --i, --rmin)
+        ComputeEigenvectors(mSize, nullptr, eigenvectors);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SymmetricEigensolver<Real>::GetEigenvectors(int numIndices,
+    int const* indices, Real* eigenvectors) const
+{
+    if (eigenvectors && mSize > 0 && numIndices > 0)
+    {
+        if (!mWantEigenvectors)
         {
-            // Copy the v vector and 2/Dot(v,v) from the matrix.
-            Real const* column = &mMatrix[i];
-            Real twoinvvdv = column[mSize*(i + 1)];
-            for (r = 0; r < i + 1; ++r)
-            {
-                mVVector[r] = (Real)0;
-            }
-            mVVector[r] = (Real)1;
-            for (++r; r < mSize; ++r)
-            {
-                mVVector[r] = column[mSize*r];
-            }
-
-            // Compute the w vector.
-            for (r = 0; r < mSize; ++r)
-            {
-                mWVector[r] = (Real)0;
-                for (c = rmin; c < mSize; ++c)
-                {
-                    mWVector[r] += mVVector[c]*eigenvectors[r + mSize*c];
-                }
-                mWVector[r] *= twoinvvdv;
-            }
-
-            // Update the matrix, Q <- Q - v*w^T.
-            for (r = rmin; r < mSize; ++r)
-            {
-                for (c = 0; c < mSize; ++c)
-                {
-                    eigenvectors[c + mSize*r] -= mVVector[r]*mWVector[c];
-                }
-            }
+            LogError("Solve was called with wantEigenvectors set to false.");
+            return;
         }
 
-        // Multiply the Givens rotations.
-        for (auto const& givens : mGivens)
+        for (int j = 0; j < numIndices; ++j)
         {
-            for (r = 0; r < mSize; ++r)
+            if (indices[j] < 0 || indices[j] >= mSize)
             {
-                int j = givens.index + mSize*r;
-                Real& q0 = eigenvectors[j];
-                Real& q1 = eigenvectors[j + 1];
-                Real prd0 = givens.cs * q0 - givens.sn * q1;
-                Real prd1 = givens.sn * q0 + givens.cs * q1;
-                q0 = prd0;
-                q1 = prd1;
+                LogError("Invalid eigenvalue index.");
+                return;
             }
         }
 
-        mIsRotation = 1 - (mSize & 1);
-        if (mPermutation[0] >= 0)
+        // Compute the eigenvectors as the columns of an Nxk matrix and
+        // transpose them to the output.
+        std::vector<Real> Z(mSize*numIndices);
+        ComputeEigenvectors(numIndices, indices, &Z[0]);
+        for (int r = 0; r < mSize; ++r)
         {
-            // Sorting was requested.
-            std::fill(mVisited.begin(), mVisited.end(), 0);
-            for (int i = 0; i < mSize; ++i)
+            for (int j = 0; j < numIndices; ++j)
             {
-                if (mVisited[i] == 0 && mPermutation[i] != i)
-                {
-                    // The item starts a cycle with 2 or more elements.
-                    mIsRotation = 1 - mIsRotation;
-                    int start = i, current = i, j, next;
-                    for (j = 0; j < mSize; ++j)
-                    {
-                        mPVector[j] = eigenvectors[i + mSize*j];
-                    }
-                    while ((next = mPermutation[current]) != start)
-                    {
-                        mVisited[current] = 1;
-                        for (j = 0; j < mSize; ++j)
-                        {
-                            eigenvectors[current + mSize*j] =
-                                eigenvectors[next + mSize*j];
-                        }
-                        current = next;
-                    }
-                    mVisited[current] = 1;
-                    for (j = 0; j < mSize; ++j)
-                    {
-                        eigenvectors[current + mSize*j] = mPVector[j];
-                    }
-                }
+                eigenvectors[r + mSize*j] = Z[j + numIndices*r];
             }
         }
     }
@@ -256,13 +207,19 @@ void SymmetricEigensolver<Real>::GetEigenvector(int c, Real* eigenvector)
 {
     if (0 <= c && c < mSize)
     {
+        if (!mWantEigenvectors)
+        {
+            LogError("Solve was called with wantEigenvectors set to false.");
+            return;
+        }
+
         // y = H*x, then x and y are swapped for the next H
         Real* x = eigenvector;
         Real* y = &mPVector[0];
 
         // Start with the Euclidean basis vector.
         memset(x, 0, mSize*sizeof(Real));
-        if (mPermutation[c] >= 0)
+        if (mPermutation[0] >= 0)
         {
             x[mPermutation[c]] = (Real)1;
         }
@@ -346,98 +303,189 @@ Real SymmetricEigensolver<Real>::GetEigenvalue(int c) const
 template <typename Real>
 void SymmetricEigensolver<Real>::Tridiagonalize()
 {
+    int const n = mSize;
+    Real* A = &mMatrix[0];
+    Real* p = &mPVector[0];
     int r, c;
-    for (int i = 0, ip1 = 1; i < mSize - 2; ++i, ++ip1)
+
+    // Only the upper-triangular part of the input is used.  Copy it to the
+    // lower-triangular part so that the rows of the remaining matrix are
+    // contiguous in memory.
+    for (r = 1; r < n; ++r)
     {
-        // Compute the Householder vector.  Read the initial vector from the
-        // row of the matrix.
-        Real length = (Real)0;
-        for (r = 0; r < ip1; ++r)
+        for (c = 0; c < r; ++c)
         {
-            mVVector[r] = (Real)0;
+            A[c + n*r] = A[r + n*c];
         }
-        for (r = ip1; r < mSize; ++r)
-        {
-            Real vr = mMatrix[r + mSize*i];
-            mVVector[r] = vr;
-            length += vr * vr;
-        }
-        Real vdv = (Real)1;
-        length = sqrt(length);
-        if (length > (Real)0)
+    }
+
+    for (int i0 = 0; i0 < n - 2; i0 += PANEL_SIZE)
+    {
+        int const numReflections = std::min((int)PANEL_SIZE, n - 2 - i0);
+        for (int k = 0, i = i0, ip1 = i0 + 1; k < numReflections;
+            ++k, ++i, ++ip1)
         {
-            Real& v1 = mVVector[ip1];
-            Real sgn = (v1 >= (Real)0 ? (Real)1 : (Real)-1);
-            Real invDenom = ((Real)1) / (v1 + sgn * length);
-            v1 = (Real)1;
-            for (r = ip1 + 1; r < mSize; ++r)
+            // Apply the reflections of the panel to row i.
+            Real* row = &A[n*i];
+            for (int j = 0; j < k; ++j)
             {
-                Real& vr = mVVector[r];
-                vr *= invDenom;
-                vdv += vr * vr;
+                Real const* v = &mVPanel[n*j];
+                Real const* w = &mWPanel[n*j];
+                Real vi = v[i], wi = w[i];
+                for (c = i; c < n; ++c)
+                {
+                    row[c] -= vi * w[c] + wi * v[c];
+                }
             }
-        }
 
-        // Compute the rank-1 offsets v*w^T and w*v^T.
-        Real invvdv = (Real)1 / vdv;
-        Real twoinvvdv = invvdv * (Real)2;
-        Real pdvtvdv = (Real)0;
-        for (r = i; r < mSize; ++r)
-        {
-            mPVector[r] = (Real)0;
-            for (c = i; c < r; ++c)
+            // Compute the Householder vector.  Read the initial vector from
+            // the row of the matrix.  A zero vector requires no reflection,
+            // which is represented by 2/Dot(v,v) = 0.
+            Real* v = &mVPanel[n*k];
+            Real* w = &mWPanel[n*k];
+            std::fill(v, v + ip1, (Real)0);
+            Real length = (Real)0;
+            for (c = ip1; c < n; ++c)
             {
-                mPVector[r] += mMatrix[r + mSize*c] * mVVector[c];
+                length += row[c] * row[c];
             }
-            for (/**/; c < mSize; ++c)
+            length = sqrt(length);
+            v[ip1] = (Real)1;
+            Real twoinvvdv = (Real)0;
+            mDiagonal[i] = row[i];
+            mSuperdiagonal[i] = (Real)0;
+            if (length > (Real)0)
             {
-                mPVector[r] += mMatrix[c + mSize*r] * mVVector[c];
+                Real v1 = row[ip1];
+                Real sgn = (v1 >= (Real)0 ? (Real)1 : (Real)-1);
+                Real invDenom = ((Real)1) / (v1 + sgn * length);
+                Real vdv = (Real)1;
+                for (c = ip1 + 1; c < n; ++c)
+                {
+                    Real vc = row[c] * invDenom;
+                    v[c] = vc;
+                    vdv += vc * vc;
+                }
+                twoinvvdv = (Real)2 / vdv;
+                mSuperdiagonal[i] = -sgn * length;
+            }
+            else
+            {
+                std::fill(v + ip1 + 1, v + n, (Real)0);
             }
-            mPVector[r] *= twoinvvdv;
-            pdvtvdv += mPVector[r] * mVVector[r];
-        }
 
-        pdvtvdv *= invvdv;
-        for (r = i; r < mSize; ++r)
-        {
-            mWVector[r] = mPVector[r] - pdvtvdv * mVVector[r];
+            // Compute p = (2/Dot(v,v))*B*v for the remaining matrix B, which
+            // is the current matrix with the reflections of the panel
+            // applied, and then w = p - (Dot(p,v)/Dot(v,v))*v.
+            std::fill(w, w + n, (Real)0);
+            if (twoinvvdv > (Real)0)
+            {
+                Run(n - ip1, [this, A, p, v, n, ip1](int rmin, int rmax)
+                {
+                    for (int r = ip1 + rmin; r < ip1 + rmax; ++r)
+                    {
+                        Real const* Arow = &A[n*r];
+                        Real sum = (Real)0;
+                        for (int c = ip1; c < n; ++c)
+                        {
+                            sum += Arow[c] * v[c];
+                        }
+                        p[r] = sum;
+                    }
+                }, 64);
+
+                for (int j = 0; j < k; ++j)
+                {
+                    Real const* vj = &mVPanel[n*j];
+                    Real const* wj = &mWPanel[n*j];
+                    Real wjdv = (Real)0, vjdv = (Real)0;
+                    for (c = ip1; c < n; ++c)
+                    {
+                        wjdv += wj[c] * v[c];
+                        vjdv += vj[c] * v[c];
+                    }
+                    for (r = ip1; r < n; ++r)
+                    {
+                        p[r] -= vj[r] * wjdv + wj[r] * vjdv;
+                    }
+                }
+
+                Real pdvtvdv = (Real)0;
+                for (r = ip1; r < n; ++r)
+                {
+                    p[r] *= twoinvvdv;
+                    pdvtvdv += p[r] * v[r];
+                }
+                pdvtvdv *= twoinvvdv * (Real)0.5;
+                for (r = ip1; r < n; ++r)
+                {
+                    w[r] = p[r] - pdvtvdv * v[r];
+                }
+            }
+
+            // Copy the vector to column i of the matrix.  The 0-valued
+            // components at indices 0 through i are not stored.  The 1-valued
+            // component at index i+1 is also not stored; instead, the
+            // quantity 2/Dot(v,v) is stored for use in eigenvector
+            // construction. That construction must take into account the
+            // implied components that are not stored.
+            A[i + n*ip1] = twoinvvdv;
+            for (r = ip1 + 1; r < n; ++r)
+            {
+                A[i + n*r] = v[r];
+            }
         }
 
-        // Update the input matrix.
-        for (r = i; r < mSize; ++r)
+        // Update the matrix to the lower right of the panel,
+        // B = B - V*W^T - W*V^T.  Only the upper-triangular part is
+        // updated, and it is then copied to the lower-triangular part.  Item
+        // k of a task consists of rows i1+k and n-1-k so that the items have
+        // the same cost.
+        int const i1 = i0 + numReflections;
+        int const numPairs = (n - i1 + 1) / 2;
+        Run(numPairs, [this, A, n, i1, numReflections](int kmin, int kmax)
         {
-            Real vr = mVVector[r];
-            Real wr = mWVector[r];
-            Real offset = vr * wr * (Real)2;
-            mMatrix[r + mSize*r] -= offset;
-            for (c = r + 1; c < mSize; ++c)
+            for (int k = kmin; k < kmax; ++k)
             {
-                offset = vr * mWVector[c] + wr * mVVector[c];
-                mMatrix[c + mSize*r] -= offset;
+                int const r0 = i1 + k, step = std::max(n - 1 - k - r0, 1);
+                for (int r = r0; r < n - k; r += step)
+                {
+                    Real* Arow = &A[n*r];
+                    for (int j = 0; j < numReflections; ++j)
+                    {
+                        Real const* v = &mVPanel[n*j];
+                        Real const* w = &mWPanel[n*j];
+                        Real vr = v[r], wr = w[r];
+                        for (int c = r; c < n; ++c)
+                        {
+                            Arow[c] -= vr * w[c] + wr * v[c];
+                        }
+                    }
+                }
             }
-        }
+        }, 32);
 
-        // Copy the vector to column i of the matrix.  The 0-valued components
-        // at indices 0 through i are not stored.  The 1-valued component at
-        // index i+1 is also not stored; instead, the quantity 2/Dot(v,v) is
-        // stored for use in eigenvector construction. That construction must
-        // take into account the implied components that are not stored.
-        mMatrix[i + mSize*ip1] = twoinvvdv;
-        for (r = ip1 + 1; r < mSize; ++r)
+        Run(numPairs, [A, n, i1](int kmin, int kmax)
         {
-            mMatrix[i + mSize*r] = mVVector[r];
-        }
+            for (int k = kmin; k < kmax; ++k)
+            {
+                int const r0 = i1 + k, step = std::max(n - 1 - k - r0, 1);
+                for (int r = r0; r < n - k; r += step)
+                {
+                    Real* Arow = &A[n*r];
+                    for (int c = i1; c < r; ++c)
+                    {
+                        Arow[c] = A[r + n*c];
+                    }
+                }
+            }
+        }, 32);
     }
 
-    // Copy the diagonal and subdiagonal entries for cache coherence in
-    // the QR iterations.
-    int k, ksup = mSize - 1, index = 0, delta = mSize + 1;
-    for (k = 0; k < ksup; ++k, index += delta)
-    {
-        mDiagonal[k] = mMatrix[index];
-        mSuperdiagonal[k] = mMatrix[index + 1];
-    }
-    mDiagonal[k] = mMatrix[index];
+    // The lower-right 2x2 block requires no reflection.
+    mDiagonal[n - 2] = A[(n - 2)*(n + 1)];
+    mSuperdiagonal[n - 2] = A[(n - 2)*(n + 1) + 1];
+    mDiagonal[n - 1] = A[n*n - 1];
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -490,7 +538,10 @@ void SymmetricEigensolver<Real>::DoQRImplicitShift(int imin, int imax)
         // Compute the Givens rotation and save it for use in computing the
         // eigenvectors.
         GetSinCos(x, y, cs, sn);
-        mGivens.push_back(GivensRotation(i1, cs, sn));
+        if (mWantEigenvectors)
+        {
+            mGivens.push_back(GivensRotation(i1, cs, sn));
+        }
 
         // Update the tridiagonal matrix.  This amounts to updating a 4x4
         // subblock,
@@ -588,20 +639,122 @@ void SymmetricEigensolver<Real>::ComputePermutation(int sortType)
         mPermutation[i++] = item.index;
     }
 
-    // GetEigenvectors() has nontrivial code for computing the orthogonal Q
-    // from the reflections and rotations.  To avoid complicating the code
-    // further when sorting is requested, Q is computed as in the unsorted
-    // case.  We then need to swap columns of Q to be consistent with the
-    // sorting of the eigenvalues.  To minimize copying due to column swaps,
-    // we use permutation P.  The minimum number of transpositions to obtain
-    // P from I is N minus the number of cycles of P.  Each cycle is reordered
-    // with a minimum number of transpositions; that is, the eigenitems are
-    // cyclically swapped, leading to a minimum amount of copying.  For
-    // example, if there is a cycle i0 -> i1 -> i2 -> i3, then the copying is
-    //   save = eigenitem[i0];
-    //   eigenitem[i1] = eigenitem[i2];
-    //   eigenitem[i2] = eigenitem[i3];
-    //   eigenitem[i3] = save;
+    // GetEigenvectors() starts with the columns of the identity permuted by
+    // P, so the columns of Q are consistent with the sorting of the
+    // eigenvalues without copying columns afterwards.
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SymmetricEigensolver<Real>::ComputeEigenvectors(int numColumns,
+    int const* indices, Real* Z) const
+{
+    int const n = mSize;
+
+    // Start with the Euclidean basis vectors, which are permuted when
+    // sorting was requested.
+    std::fill(Z, Z + n*numColumns, (Real)0);
+    for (int j = 0; j < numColumns; ++j)
+    {
+        int c = (indices ? indices[j] : j);
+        int r = (mPermutation[0] >= 0 ? mPermutation[c] : c);
+        Z[j + numColumns*r] = (Real)1;
+    }
+
+    // Copy the Householder vectors of each block of reflections to a matrix
+    // Y whose first row corresponds to row i0+1 of Q, where i0 is the index
+    // of the first reflection of the block, and compute its matrix T.
+    int const numReflections = n - 2;
+    int const numBlocks = (numReflections + PANEL_SIZE - 1) / PANEL_SIZE;
+    int const sizeT = PANEL_SIZE*PANEL_SIZE;
+    std::vector<int> offsetY(numBlocks + 1);
+    offsetY[0] = 0;
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        int i0 = PANEL_SIZE*b;
+        int K = std::min((int)PANEL_SIZE, numReflections - i0);
+        offsetY[b + 1] = offsetY[b] + K*(n - 1 - i0);
+    }
+    std::vector<Real> Y(std::max(offsetY[numBlocks], 1));
+    std::vector<Real> T(std::max(sizeT*numBlocks, 1));
+
+    Run(numBlocks, [this, n, numReflections, &offsetY, &Y, &T]
+        (int bmin, int bmax)
+    {
+        Real tau[PANEL_SIZE];
+        for (int b = bmin; b < bmax; ++b)
+        {
+            int i0 = PANEL_SIZE*b;
+            int K = std::min((int)PANEL_SIZE, numReflections - i0);
+            int numRows = n - 1 - i0;
+            Real* Yb = &Y[offsetY[b]];
+            for (int k = 0, i = i0; k < K; ++k, ++i)
+            {
+                tau[k] = mMatrix[i + n*(i + 1)];
+                for (int r = i0 + 1; r < n; ++r)
+                {
+                    Real& y = Yb[k + K*(r - i0 - 1)];
+                    if (r > i + 1)
+                    {
+                        y = mMatrix[i + n*r];
+                    }
+                    else
+                    {
+                        y = (r == i + 1 ? (Real)1 : (Real)0);
+                    }
+                }
+            }
+            BlockReflector<Real>::ComputeT(numRows, K, Yb, tau,
+                &T[sizeT*b]);
+        }
+    }, 1);
+
+    // Compute Z = H[0]*...*H[n-3]*G[0]*...*G[m-1]*Z, where the H[i] are
+    // the Householder reflections and the G[j] are the Givens rotations.
+    Run(numColumns, [this, n, numColumns, numBlocks, numReflections,
+        sizeT, &offsetY, &Y, &T, Z](int cmin, int cmax)
+    {
+        std::vector<Real> work(PANEL_SIZE*TILE_SIZE);
+        for (int c0 = cmin; c0 < cmax; c0 += TILE_SIZE)
+        {
+            int const numTileColumns = std::min((int)TILE_SIZE, cmax - c0);
+            Real* tile = Z + c0;
+
+            for (auto const& givens : gte::reverse(mGivens))
+            {
+                Real* z0 = tile + numColumns*givens.index;
+                Real* z1 = z0 + numColumns;
+                Real cs = givens.cs, sn = givens.sn;
+                for (int c = 0; c < numTileColumns; ++c)
+                {
+                    Real tmp0 = cs * z0[c] + sn * z1[c];
+                    Real tmp1 = -sn * z0[c] + cs * z1[c];
+                    z0[c] = tmp0;
+                    z1[c] = tmp1;
+                }
+            }
+
+            for (int b = numBlocks - 1; b >= 0; --b)
+            {
+                int i0 = PANEL_SIZE*b;
+                int K = std::min((int)PANEL_SIZE, numReflections - i0);
+                BlockReflector<Real>::Apply(n - 1 - i0, K, &Y[offsetY[b]],
+                    &T[sizeT*b], numTileColumns, numColumns,
+                    tile + numColumns*(i0 + 1), &work[0]);
+            }
+        }
+    }, TILE_SIZE);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SymmetricEigensolver<Real>::Run(int numItems,
+    std::function<void(int, int)> const& task, int minItemsPerThread) const
+{
+    unsigned int numThreads = mNumThreads;
+    if ((int64_t)minItemsPerThread*numThreads > (int64_t)numItems)
+    {
+        numThreads = std::max(numItems / minItemsPerThread, 1);
+    }
+    ParallelFor::Execute(numItems, numThreads, task);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
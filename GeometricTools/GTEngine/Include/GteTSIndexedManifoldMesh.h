@@ -0,0 +1,129 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include "GteTriangleKey.h"
+#include <array>
+#include <string>
+#include <vector>
+
+// A triangle-tetrahedron manifold mesh with the same topological semantics
+// as TSManifoldMesh, but the tetrahedra are referenced by integer handles
+// and their data is stored in contiguous arrays (structure of arrays).  The
+// handles of removed tetrahedra are placed on a free list and recycled by
+// later insertions, so the arrays do not grow during the remove-insert
+// cycles of incremental algorithms such as Delaunay3.  The shared faces are
+// located by an open-addressing hash table (linear probing with
+// backward-shift deletion) keyed on the unordered vertex triples.  After a
+// call to Reserve(numTetrahedra), no allocations occur until the mesh has
+// more than numTetrahedra tetrahedra.
+
+namespace gte
+{
+
+class GTE_IMPEXP TSIndexedManifoldMesh
+{
+public:
+    // Construction and destruction.  The input is passed to Reserve.
+    ~TSIndexedManifoldMesh();
+    TSIndexedManifoldMesh(int numTetrahedra = 0);
+
+    // Grow the arrays and the face table so that a mesh with the specified
+    // number of tetrahedra can be built without further allocations.  The
+    // face table is sized for meshes in which most faces are shared by two
+    // tetrahedra; it grows when necessary.  The call never shrinks the
+    // storage.
+    void Reserve(int numTetrahedra);
+
+    // Remove all tetrahedra.  The storage is retained for reuse.
+    void Clear();
+
+    // The handles are in [0,GetNumHandles()).  A handle is valid when it
+    // refers to a tetrahedron currently in the mesh.  The handles of the
+    // removed tetrahedra are invalid until they are recycled.
+    inline int GetNumTetrahedra() const;
+    inline int GetNumHandles() const;
+    inline bool IsValid(int t) const;
+
+    // The vertices of tetrahedron t are GetVertices()[t], listed in an order
+    // so that each face is counterclockwise when viewed from outside the
+    // tetrahedron.  The face opposite vertex j is
+    // TetrahedronKey<true>::oppositeFace[j].  The tetrahedron adjacent to
+    // that face is GetAdjacents()[t][j], which is -1 when the face is not
+    // shared.  The entries for invalid handles are undefined.
+    inline std::vector<std::array<int, 4>> const& GetVertices() const;
+    inline std::vector<std::array<int, 4>> const& GetAdjacents() const;
+
+    // If <v0,v1,v2,v3> is not in the mesh, a tetrahedron is created and its
+    // handle is returned; otherwise, <v0,v1,v2,v3> is in the mesh and -1 is
+    // returned.  If the insertion leads to a nonmanifold mesh, the call
+    // fails with a -1 returned.
+    int Insert(int v0, int v1, int v2, int v3);
+
+    // Return the handle of <v0,v1,v2,v3> if it is in the mesh; otherwise,
+    // return -1.
+    int Find(int v0, int v1, int v2, int v3) const;
+
+    // If the handle is valid, the tetrahedron is removed and 'true' is
+    // returned; otherwise, 'false' is returned.
+    bool Remove(int t);
+
+    // If <v0,v1,v2,v3> is in the mesh, it is removed and 'true' is returned;
+    // otherwise, <v0,v1,v2,v3> is not in the mesh and 'false' is returned.
+    bool Remove(int v0, int v1, int v2, int v3);
+
+    // A manifold mesh is closed if each face is shared twice.
+    inline bool IsClosed() const;
+
+    // For debugging.  The function returns 'true' iff the text file has been
+    // created and saved.
+    bool Print(std::string const& filename);
+
+private:
+    // A slot of the face table.  The slot is unused when T[0] is -1.  A
+    // face shared by one tetrahedron always has T[1] set to -1.
+    struct FSlot
+    {
+        TriangleKey<false> key;
+        int T[2];
+    };
+
+    static unsigned int Hash(TriangleKey<false> const& key);
+
+    // Return the index of the slot containing the key or, if the key is not
+    // in the table, the index of the empty slot at which the key would be
+    // inserted.
+    size_t FindFace(TriangleKey<false> const& key) const;
+
+    // Insertion into an empty slot returned by FindFace, deletion with
+    // backward shifting, and growth when the load factor exceeds 1/2.
+    void InsertFace(size_t slot, TriangleKey<false> const& key, int t);
+    void RemoveFace(size_t slot);
+    void RehashFaces(size_t numSlots);
+
+    // Return the index j for which tetrahedron t has face 'key' opposite
+    // V[t][j].
+    int GetFaceIndex(int t, TriangleKey<false> const& key) const;
+
+    // The per-tetrahedron arrays indexed by handle.
+    std::vector<std::array<int, 4>> mV;
+    std::vector<std::array<int, 4>> mS;
+    std::vector<char> mValid;
+    std::vector<int> mFree;
+    int mNumTetrahedra;
+
+    // The faces of the tetrahedra.
+    std::vector<FSlot> mFTable;
+    int mNumFaces;
+    int mNumBoundaryFaces;
+};
+
+#include "GteTSIndexedManifoldMesh.inl"
+
+}
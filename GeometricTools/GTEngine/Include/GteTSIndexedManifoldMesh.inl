@@ -0,0 +1,40 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+//----------------------------------------------------------------------------
+inline int TSIndexedManifoldMesh::GetNumTetrahedra() const
+{
+    return mNumTetrahedra;
+}
+//----------------------------------------------------------------------------
+inline int TSIndexedManifoldMesh::GetNumHandles() const
+{
+    return static_cast<int>(mV.size());
+}
+//----------------------------------------------------------------------------
+inline bool TSIndexedManifoldMesh::IsValid(int t) const
+{
+    return 0 <= t && t < static_cast<int>(mValid.size()) && mValid[t] != 0;
+}
+//----------------------------------------------------------------------------
+inline std::vector<std::array<int, 4>> const&
+TSIndexedManifoldMesh::GetVertices() const
+{
+    return mV;
+}
+//----------------------------------------------------------------------------
+inline std::vector<std::array<int, 4>> const&
+TSIndexedManifoldMesh::GetAdjacents() const
+{
+    return mS;
+}
+//----------------------------------------------------------------------------
+inline bool TSIndexedManifoldMesh::IsClosed() const
+{
+    return mNumBoundaryFaces == 0;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,70 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#pragma once
+
+#include "GTEngineDEF.h"
+#include <vector>
+
+// Multithreaded connected component labeling of binary images using
+// union-find.  This is the implementation of the multithreaded
+// GetComponents* functions of ImageUtility2 and ImageUtility3; use those
+// functions rather than this class.
+//
+// The image is partitioned into slabs of consecutive layers (rows of a 2D
+// image, slices of a 3D image), one per thread.  In the first pass, each
+// thread visits the foreground pixels of its slab in index order and unions
+// each pixel with its foreground neighbors that precede it in the slab; the
+// root of a set is always the smallest index of the set.  The neighbors are
+// visited in a fixed order, and the neighbors adjacent to a foreground
+// neighbor are skipped because they are already in its set; for example, a
+// 2D pixel whose upper neighbor is foreground needs no other test.  The
+// equivalences across the slab boundaries, which involve only the pixels of
+// the first layer of each slab, are merged on the calling thread, and the
+// roots are numbered in index order.  In the second pass, the threads label
+// their pixels with the labels of their roots and count the pixels of each
+// component, and the third pass builds the component lists.  Because the
+// components are numbered in the order of their smallest indices, the
+// labels and the lists are exactly those of the depth-first search used by
+// the single-threaded GetComponents* functions.
+
+namespace gte
+{
+
+class GTE_IMPEXP UnionFindLabeler
+{
+public:
+    // The maximum number of backward offsets, which is that of the
+    // 26-connected neighborhood of a 3D image.
+    enum { MAX_BACKWARD = 13 };
+
+    // The image has numLayers layers of layerSize pixels.  The 0-valued
+    // pixels are background and the 1-valued pixels are foreground; the
+    // boundary pixels of the image must be background.  The 'backward'
+    // array contains the negative 1D offsets of the neighborhood, that is,
+    // the offsets of the neighbors that precede a pixel, and numBackward
+    // must be at most MAX_BACKWARD.  On output, the pixel values are the
+    // labels for the components and the array components[k], k >= 1,
+    // contains the indices for the k-th component.
+    static void Execute(int layerSize, int numLayers, int numBackward,
+        int const backward[], unsigned int numThreads, int* pixels,
+        std::vector<std::vector<int> >& components);
+
+private:
+    // Sort the backward offsets for the merging of the first pass.  The
+    // bit c of adjacent[b] is set when neighbors b and c are adjacent.
+    static void GetMergeOrder(int numBackward, int const backward[],
+        int offset[], unsigned int adjacent[]);
+
+    // Union-find with path halving.  Union merges the set whose root is
+    // 'root' with the set containing j and returns the root of the union,
+    // which is the smaller of the two roots.
+    static int Find(std::vector<int>& parent, int i);
+    static int Union(std::vector<int>& parent, int root, int j);
+};
+
+}
@@ -13,6 +13,18 @@
 namespace gte
 {
     std::atomic<size_t> gBSNumberMaxSize;
+    std::atomic<size_t> gBSNumberSizeHistogram[GTE_BSNUMBER_HISTOGRAM_BINS];
+
+//----------------------------------------------------------------------------
+void ResetBSNumberStatistics()
+{
+    gBSNumberMaxSize = 0;
+    for (int i = 0; i < GTE_BSNUMBER_HISTOGRAM_BINS; ++i)
+    {
+        gBSNumberSizeHistogram[i] = 0;
+    }
+}
+//----------------------------------------------------------------------------
 }
 
 #endif
@@ -0,0 +1,46 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#include "GTEnginePCH.h"
+#include "GteBarrier.h"
+using namespace gte;
+
+//----------------------------------------------------------------------------
+Barrier::Barrier(unsigned int numThreads)
+    :
+    mNumThreads(numThreads),
+    mNumWaiting(0),
+    mGeneration(0)
+{
+}
+//----------------------------------------------------------------------------
+void Barrier::Wait()
+{
+    if (mNumThreads <= 1)
+    {
+        return;
+    }
+
+    // The generation distinguishes consecutive uses of the barrier, so a
+    // thread that is woken late is not confused by the next use.
+    std::unique_lock<std::mutex> lock(mMutex);
+    unsigned int const generation = mGeneration;
+    if (++mNumWaiting == mNumThreads)
+    {
+        mNumWaiting = 0;
+        ++mGeneration;
+        mCondition.notify_all();
+    }
+    else
+    {
+        mCondition.wait(lock, [this, generation]()
+        {
+            return mGeneration != generation;
+        });
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#include "GTEnginePCH.h"
+#include "GteBinaryImage2.h"
+#include <algorithm>
+using namespace gte;
+
+//----------------------------------------------------------------------------
+BinaryImage2::BinaryImage2()
+    :
+    mWordsPerRow(0)
+{
+    mDimensions[0] = 0;
+    mDimensions[1] = 0;
+}
+//----------------------------------------------------------------------------
+BinaryImage2::BinaryImage2(int dimension0, int dimension1)
+    :
+    mWordsPerRow(0)
+{
+    mDimensions[0] = 0;
+    mDimensions[1] = 0;
+    Resize(dimension0, dimension1);
+}
+//----------------------------------------------------------------------------
+BinaryImage2::BinaryImage2(Image2<int> const& image)
+    :
+    mWordsPerRow(0)
+{
+    mDimensions[0] = 0;
+    mDimensions[1] = 0;
+    Resize(image.GetDimension(0), image.GetDimension(1));
+
+    // Pack 64 pixels at a time.
+    for (int y = 0; y < mDimensions[1]; ++y)
+    {
+        int const* pixels = &image(0, y);
+        uint64_t* words = &mWords[y*mWordsPerRow];
+        for (int x = 0; x < mDimensions[0]; x += 64)
+        {
+            int const length = std::min(mDimensions[0] - x, 64);
+            uint64_t word = 0;
+            for (int i = 0; i < length; ++i)
+            {
+                word |= (uint64_t)(pixels[x + i] != 0) << i;
+            }
+            words[x >> 6] = word;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void BinaryImage2::CopyTo(Image2<int>& image) const
+{
+    image.Resize(mDimensions[0], mDimensions[1]);
+    for (int y = 0; y < mDimensions[1]; ++y)
+    {
+        int* pixels = &image(0, y);
+        uint64_t const* words = &mWords[y*mWordsPerRow];
+        for (int x = 0; x < mDimensions[0]; ++x)
+        {
+            pixels[x] = (int)((words[x >> 6] >> (x & 63)) & 1);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void BinaryImage2::Resize(int dimension0, int dimension1)
+{
+    if (dimension0 > 0 && dimension1 > 0)
+    {
+        if (dimension0 != mDimensions[0] || dimension1 != mDimensions[1])
+        {
+            mDimensions[0] = dimension0;
+            mDimensions[1] = dimension1;
+            mWordsPerRow = (dimension0 + 63) >> 6;
+            mWords.assign(mWordsPerRow*dimension1, 0);
+        }
+    }
+    else
+    {
+        mDimensions[0] = 0;
+        mDimensions[1] = 0;
+        mWordsPerRow = 0;
+        mWords.clear();
+    }
+}
+//----------------------------------------------------------------------------
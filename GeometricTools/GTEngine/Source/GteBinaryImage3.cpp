@@ -0,0 +1,100 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#include "GTEnginePCH.h"
+#include "GteBinaryImage3.h"
+#include <algorithm>
+using namespace gte;
+
+//----------------------------------------------------------------------------
+BinaryImage3::BinaryImage3()
+    :
+    mWordsPerRow(0)
+{
+    mDimensions[0] = 0;
+    mDimensions[1] = 0;
+    mDimensions[2] = 0;
+}
+//----------------------------------------------------------------------------
+BinaryImage3::BinaryImage3(int dimension0, int dimension1, int dimension2)
+    :
+    mWordsPerRow(0)
+{
+    mDimensions[0] = 0;
+    mDimensions[1] = 0;
+    mDimensions[2] = 0;
+    Resize(dimension0, dimension1, dimension2);
+}
+//----------------------------------------------------------------------------
+BinaryImage3::BinaryImage3(Image3<int> const& image)
+    :
+    mWordsPerRow(0)
+{
+    mDimensions[0] = 0;
+    mDimensions[1] = 0;
+    mDimensions[2] = 0;
+    Resize(image.GetDimension(0), image.GetDimension(1),
+        image.GetDimension(2));
+
+    // Pack 64 voxels at a time.
+    int const numRows = mDimensions[1]*mDimensions[2];
+    int const* voxels = image.GetPixels1D();
+    for (int row = 0; row < numRows; ++row, voxels += mDimensions[0])
+    {
+        uint64_t* words = &mWords[row*mWordsPerRow];
+        for (int x = 0; x < mDimensions[0]; x += 64)
+        {
+            int const length = std::min(mDimensions[0] - x, 64);
+            uint64_t word = 0;
+            for (int i = 0; i < length; ++i)
+            {
+                word |= (uint64_t)(voxels[x + i] != 0) << i;
+            }
+            words[x >> 6] = word;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void BinaryImage3::CopyTo(Image3<int>& image) const
+{
+    image.Resize(mDimensions[0], mDimensions[1], mDimensions[2]);
+    int const numRows = mDimensions[1]*mDimensions[2];
+    int* voxels = image.GetPixels1D();
+    for (int row = 0; row < numRows; ++row, voxels += mDimensions[0])
+    {
+        uint64_t const* words = &mWords[row*mWordsPerRow];
+        for (int x = 0; x < mDimensions[0]; ++x)
+        {
+            voxels[x] = (int)((words[x >> 6] >> (x & 63)) & 1);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void BinaryImage3::Resize(int dimension0, int dimension1, int dimension2)
+{
+    if (dimension0 > 0 && dimension1 > 0 && dimension2 > 0)
+    {
+        if (dimension0 != mDimensions[0] || dimension1 != mDimensions[1]
+        ||  dimension2 != mDimensions[2])
+        {
+            mDimensions[0] = dimension0;
+            mDimensions[1] = dimension1;
+            mDimensions[2] = dimension2;
+            mWordsPerRow = (dimension0 + 63) >> 6;
+            mWords.assign((size_t)mWordsPerRow*dimension1*dimension2, 0);
+        }
+    }
+    else
+    {
+        mDimensions[0] = 0;
+        mDimensions[1] = 0;
+        mDimensions[2] = 0;
+        mWordsPerRow = 0;
+        mWords.clear();
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,293 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#include "GTEnginePCH.h"
+#include "GteBinaryMorphology.h"
+#include "GteParallelFor.h"
+#include <algorithm>
+#include <cstdlib>
+#include <emmintrin.h>
+#include <map>
+using namespace gte;
+
+// The word loop of BinaryMorphology::Combine for the pairs of words in
+// [0,numPairWords).  The operation is a copy (Op = 0), an OR (Op = 1) or
+// an AND (Op = 2) of the source shifted right by 'shift' bits when Shifted
+// is 'true'.  The shift counts apply to each 64-bit half of a register.
+template <int Op, bool Shifted>
+static void CombinePairs(int numPairWords, uint64_t const* source,
+    int shift, uint64_t* target)
+{
+    __m128i const rcount = _mm_cvtsi32_si128(shift);
+    __m128i const lcount = _mm_cvtsi32_si128(64 - shift);
+    for (int w = 0; w < numPairWords; w += 2)
+    {
+        __m128i value = _mm_loadu_si128((__m128i const*)&source[w]);
+        if (Shifted)
+        {
+            __m128i next = _mm_loadu_si128((__m128i const*)&source[w + 1]);
+            value = _mm_or_si128(_mm_srl_epi64(value, rcount),
+                _mm_sll_epi64(next, lcount));
+        }
+
+        __m128i* pair = (__m128i*)&target[w];
+        if (Op == 1)
+        {
+            value = _mm_or_si128(_mm_loadu_si128(pair), value);
+        }
+        else if (Op == 2)
+        {
+            value = _mm_and_si128(_mm_loadu_si128(pair), value);
+        }
+        _mm_storeu_si128(pair, value);
+    }
+}
+
+//----------------------------------------------------------------------------
+void BinaryMorphology::Dilate(int const dimensions[3], int wordsPerRow,
+    int numOffsets, std::array<int, 3> const offsets[],
+    uint64_t const* input, uint64_t* output, unsigned int numThreads)
+{
+    // The pixel p+e is set when p is set, so p is set when p-e is set.
+    std::vector<std::array<int, 3> > samples(numOffsets + 1);
+    samples[0] = { { 0, 0, 0 } };
+    for (int i = 0; i < numOffsets; ++i)
+    {
+        samples[i + 1] = { { -offsets[i][0], -offsets[i][1],
+            -offsets[i][2] } };
+    }
+
+    Execute(dimensions, wordsPerRow, true, false, samples, input, output,
+        numThreads);
+}
+//----------------------------------------------------------------------------
+void BinaryMorphology::Erode(int const dimensions[3], int wordsPerRow,
+    bool zeroExterior, int numOffsets, std::array<int, 3> const offsets[],
+    uint64_t const* input, uint64_t* output, unsigned int numThreads)
+{
+    std::vector<std::array<int, 3> > samples(numOffsets + 1);
+    samples[0] = { { 0, 0, 0 } };
+    for (int i = 0; i < numOffsets; ++i)
+    {
+        samples[i + 1] = offsets[i];
+    }
+
+    Execute(dimensions, wordsPerRow, false, !zeroExterior, samples, input,
+        output, numThreads);
+}
+//----------------------------------------------------------------------------
+void BinaryMorphology::Execute(int const dimensions[3], int wordsPerRow,
+    bool dilate, bool exterior, std::vector<std::array<int, 3> >& samples,
+    uint64_t const* input, uint64_t* output, unsigned int numThreads)
+{
+    int const dim0 = dimensions[0];
+    int const dim1 = dimensions[1];
+    int const dim2 = dimensions[2];
+    int const numRows = dim1*dim2;
+    if (numRows <= 0 || wordsPerRow <= 0)
+    {
+        return;
+    }
+
+    // Group the x-offsets of the samples by their (y,z)-offsets, and
+    // number the distinct sets of x-offsets.  The set {0} is the input.
+    std::map<std::pair<int, int>, std::vector<int> > groups;
+    int maxAbsX = 0;
+    for (auto const& sample : samples)
+    {
+        groups[std::make_pair(sample[1], sample[2])].push_back(sample[0]);
+        maxAbsX = std::max(maxAbsX, std::abs(sample[0]));
+    }
+
+    std::map<std::vector<int>, int> setIndices;
+    std::vector<std::vector<int> > sets;
+    std::vector<std::array<int, 3> > rowSamples;  // (y, z, set index)
+    for (auto& group : groups)
+    {
+        std::vector<int>& xOffsets = group.second;
+        std::sort(xOffsets.begin(), xOffsets.end());
+        xOffsets.erase(std::unique(xOffsets.begin(), xOffsets.end()),
+            xOffsets.end());
+
+        auto iter = setIndices.find(xOffsets);
+        int index;
+        if (iter == setIndices.end())
+        {
+            index = (int)sets.size();
+            setIndices[xOffsets] = index;
+            sets.push_back(xOffsets);
+        }
+        else
+        {
+            index = iter->second;
+        }
+        rowSamples.push_back({ { group.first.first, group.first.second,
+            index } });
+    }
+
+    int const numSets = (int)sets.size();
+    std::vector<std::vector<uint64_t> > shifted(numSets);
+    std::vector<uint64_t const*> source(numSets);
+    bool anyShifted = false;
+    for (int s = 0; s < numSets; ++s)
+    {
+        if (sets[s].size() == 1 && sets[s][0] == 0)
+        {
+            source[s] = input;
+        }
+        else
+        {
+            shifted[s].resize((size_t)numRows*wordsPerRow);
+            source[s] = &shifted[s][0];
+            anyShifted = true;
+        }
+    }
+
+    uint64_t const fill = (exterior ? ~(uint64_t)0 : (uint64_t)0);
+    int const numTailBits = (dim0 & 63);
+    uint64_t const tailMask = (numTailBits > 0 ?
+        ((uint64_t)1 << numTailBits) - 1 : ~(uint64_t)0);
+
+    // The horizontal pass.  A row is copied to a buffer with 'guard' words
+    // of exterior values on each side, and the bits beyond the image in its
+    // last word are set to the exterior value.  Bit x of the row is bit
+    // x + 64*guard of the buffer, so the word of the shifted row that
+    // contains the samples at x+sx for x in [64*w,64*w+64) starts at bit
+    // 64*w + 64*guard + sx >= 0 of the buffer.
+    if (anyShifted)
+    {
+        int const guard = (maxAbsX + 63)/64 + 1;
+        ParallelFor::Execute(numRows, numThreads, [&](int rmin, int rmax)
+        {
+            std::vector<uint64_t> buffer(wordsPerRow + 2*guard + 1, fill);
+            uint64_t* padded = &buffer[guard];
+            for (int r = rmin; r < rmax; ++r)
+            {
+                uint64_t const* row = &input[(size_t)r*wordsPerRow];
+                for (int w = 0; w < wordsPerRow; ++w)
+                {
+                    padded[w] = row[w];
+                }
+                padded[wordsPerRow - 1] |= (fill & ~tailMask);
+
+                for (int s = 0; s < numSets; ++s)
+                {
+                    if (shifted[s].size() == 0)
+                    {
+                        continue;
+                    }
+
+                    uint64_t* target = &shifted[s][(size_t)r*wordsPerRow];
+                    bool first = true;
+                    for (int sx : sets[s])
+                    {
+                        int const bit = 64*guard + sx;
+                        Combine(dilate, first, wordsPerRow,
+                            &buffer[bit >> 6], (bit & 63), target);
+                        first = false;
+                    }
+                }
+            }
+        });
+    }
+
+    // The vertical pass.  The group with (y,z)-offset (0,0) contains the
+    // origin, so every row has at least one sample in the image.  A row
+    // outside the image has the exterior value.
+    ParallelFor::Execute(numRows, numThreads, [&](int rmin, int rmax)
+    {
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const y = r % dim1, z = r / dim1;
+            uint64_t* target = &output[(size_t)r*wordsPerRow];
+            bool first = true;
+            for (auto const& rowSample : rowSamples)
+            {
+                int const ys = y + rowSample[0], zs = z + rowSample[1];
+                if (0 <= ys && ys < dim1 && 0 <= zs && zs < dim2)
+                {
+                    uint64_t const* row = source[rowSample[2]] +
+                        (size_t)(ys + dim1*zs)*wordsPerRow;
+                    Combine(dilate, first, wordsPerRow, row, 0, target);
+                    first = false;
+                }
+                else if (!dilate && !exterior)
+                {
+                    for (int w = 0; w < wordsPerRow; ++w)
+                    {
+                        target[w] = 0;
+                    }
+                    break;
+                }
+            }
+            target[wordsPerRow - 1] &= tailMask;
+        }
+    });
+}
+//----------------------------------------------------------------------------
+void BinaryMorphology::Combine(bool dilate, bool first, int numWords,
+    uint64_t const* source, int shift, uint64_t* target)
+{
+    // Pairs of words are processed with SSE2 128-bit operations and the
+    // last word of an odd count is processed separately.  The source words
+    // are read beyond the pair only when the shift is positive.
+    int const numPairWords = (numWords & ~1);
+    if (shift > 0)
+    {
+        if (first)
+        {
+            CombinePairs<0, true>(numPairWords, source, shift, target);
+        }
+        else if (dilate)
+        {
+            CombinePairs<1, true>(numPairWords, source, shift, target);
+        }
+        else
+        {
+            CombinePairs<2, true>(numPairWords, source, shift, target);
+        }
+    }
+    else
+    {
+        if (first)
+        {
+            CombinePairs<0, false>(numPairWords, source, shift, target);
+        }
+        else if (dilate)
+        {
+            CombinePairs<1, false>(numPairWords, source, shift, target);
+        }
+        else
+        {
+            CombinePairs<2, false>(numPairWords, source, shift, target);
+        }
+    }
+
+    if (numPairWords < numWords)
+    {
+        int const w = numPairWords;
+        uint64_t value = source[w];
+        if (shift > 0)
+        {
+            value = (value >> shift) | (source[w + 1] << (64 - shift));
+        }
+
+        if (first)
+        {
+            target[w] = value;
+        }
+        else if (dilate)
+        {
+            target[w] |= value;
+        }
+        else
+        {
+            target[w] &= value;
+        }
+    }
+}
+//----------------------------------------------------------------------------
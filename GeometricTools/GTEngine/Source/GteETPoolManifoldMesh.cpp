@@ -0,0 +1,584 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#include "GTEnginePCH.h"
+#include "GteETPoolManifoldMesh.h"
+using namespace gte;
+
+//----------------------------------------------------------------------------
+ETPoolManifoldMesh::~ETPoolManifoldMesh()
+{
+}
+//----------------------------------------------------------------------------
+ETPoolManifoldMesh::ETPoolManifoldMesh(int numTriangles)
+    :
+    mNumEdges(0),
+    mNumTriangles(0),
+    mNumBoundaryEdges(0)
+{
+    Reserve(numTriangles);
+}
+//----------------------------------------------------------------------------
+void ETPoolManifoldMesh::Reserve(int numTriangles)
+{
+    numTriangles = std::max(numTriangles, 1);
+    int numEdges = 3 * numTriangles;
+    mTPool.Reserve(numTriangles - mNumTriangles);
+    mEPool.Reserve(numEdges - mNumEdges);
+
+    // The tables are kept at most half full.
+    size_t numSlots = 16;
+    while (numSlots < 2 * static_cast<size_t>(numTriangles))
+    {
+        numSlots <<= 1;
+    }
+    if (numSlots > mTTable.size())
+    {
+        RehashTriangles(numSlots);
+    }
+
+    numSlots = 16;
+    while (numSlots < 2 * static_cast<size_t>(numEdges))
+    {
+        numSlots <<= 1;
+    }
+    if (numSlots > mETable.size())
+    {
+        RehashEdges(numSlots);
+    }
+}
+//----------------------------------------------------------------------------
+void ETPoolManifoldMesh::Clear()
+{
+    for (auto& slot : mETable)
+    {
+        slot.edge = nullptr;
+    }
+    for (auto& slot : mTTable)
+    {
+        slot.triangle = nullptr;
+    }
+    mEPool.Clear();
+    mTPool.Clear();
+    mNumEdges = 0;
+    mNumTriangles = 0;
+    mNumBoundaryEdges = 0;
+}
+//----------------------------------------------------------------------------
+ETPoolManifoldMesh::Triangle* ETPoolManifoldMesh::Insert(int v0, int v1,
+    int v2)
+{
+    TriangleKey<true> tkey(v0, v1, v2);
+    size_t tslot = Find(tkey);
+    if (mTTable[tslot].triangle)
+    {
+        // The triangle already exists.  Return a null pointer as a signal to
+        // the caller that the insertion failed.
+        return nullptr;
+    }
+
+    // Before modifying the mesh, verify that the insertion does not lead to
+    // a nonmanifold mesh.  This avoids the partial updates that would occur
+    // if the test were made while inserting the edges.
+    EdgeKey<false> ekey[3];
+    size_t eslot[3];
+    int v[3] = { v0, v1, v2 };
+    for (int i0 = 2, i1 = 0; i1 < 3; i0 = i1++)
+    {
+        ekey[i0] = EdgeKey<false>(v[i0], v[i1]);
+        eslot[i0] = Find(ekey[i0]);
+        Edge* edge = mETable[eslot[i0]].edge;
+        if (edge && edge->T[1])
+        {
+            LogError("The mesh must be manifold.");
+            return nullptr;
+        }
+    }
+
+    // Add the new triangle.
+    Triangle* tri = mTPool.Allocate();
+    for (int i = 0; i < 3; ++i)
+    {
+        tri->V[i] = v[i];
+        tri->E[i] = nullptr;
+        tri->T[i] = nullptr;
+    }
+    InsertTriangle(tslot, tkey, tri);
+
+    // Add the edges to the mesh if they do not already exist.
+    for (int i0 = 2, i1 = 0; i1 < 3; i0 = i1++)
+    {
+        // The slot might have been invalidated by the growth of the table
+        // when an earlier edge of this triangle was inserted.
+        size_t slot = Find(ekey[i0]);
+        Edge* edge = mETable[slot].edge;
+        if (!edge)
+        {
+            // This is the first time the edge is encountered.
+            edge = mEPool.Allocate();
+            edge->V[0] = v[i0];
+            edge->V[1] = v[i1];
+            edge->T[0] = tri;
+            edge->T[1] = nullptr;
+            InsertEdge(slot, ekey[i0], edge);
+            ++mNumBoundaryEdges;
+
+            // Update the triangle.
+            tri->E[i0] = edge;
+        }
+        else
+        {
+            // This is the second time the edge is encountered.
+            edge->T[1] = tri;
+            --mNumBoundaryEdges;
+
+            // Update the adjacent triangles.
+            Triangle* adjacent = edge->T[0];
+            if (!adjacent)
+            {
+                LogError("Unexpected condition.");
+                return nullptr;
+            }
+            for (int j = 0; j < 3; ++j)
+            {
+                if (adjacent->E[j] == edge)
+                {
+                    adjacent->T[j] = tri;
+                    break;
+                }
+            }
+
+            // Update the triangle.
+            tri->E[i0] = edge;
+            tri->T[i0] = adjacent;
+        }
+    }
+
+    return tri;
+}
+//----------------------------------------------------------------------------
+bool ETPoolManifoldMesh::Remove(int v0, int v1, int v2)
+{
+    TriangleKey<true> tkey(v0, v1, v2);
+    size_t tslot = Find(tkey);
+    Triangle* tri = mTTable[tslot].triangle;
+    if (!tri)
+    {
+        // The triangle does not exist.
+        return false;
+    }
+
+    // Remove the edges and update adjacent triangles if necessary.
+    for (int i = 0; i < 3; ++i)
+    {
+        // Inform the edges the triangle is being deleted.
+        Edge* edge = tri->E[i];
+        if (!edge)
+        {
+            // The triangle edge should be nonnull.
+            LogError("Unexpected condition.");
+            return false;
+        }
+
+        if (edge->T[0] == tri)
+        {
+            // One-triangle edges always have pointer at index zero.
+            edge->T[0] = edge->T[1];
+            edge->T[1] = nullptr;
+        }
+        else if (edge->T[1] == tri)
+        {
+            edge->T[1] = nullptr;
+        }
+        else
+        {
+            LogError("Unexpected condition.");
+            return false;
+        }
+
+        // Remove the edge if you have the last reference to it.
+        if (!edge->T[0])
+        {
+            RemoveEdge(Find(EdgeKey<false>(edge->V[0], edge->V[1])));
+            mEPool.Free(edge);
+            --mNumBoundaryEdges;
+        }
+        else
+        {
+            ++mNumBoundaryEdges;
+        }
+
+        // Inform adjacent triangles the triangle is being deleted.
+        Triangle* adjacent = tri->T[i];
+        if (adjacent)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                if (adjacent->T[j] == tri)
+                {
+                    adjacent->T[j] = nullptr;
+                    break;
+                }
+            }
+        }
+    }
+
+    RemoveTriangle(tslot);
+    mTPool.Free(tri);
+    return true;
+}
+//----------------------------------------------------------------------------
+bool ETPoolManifoldMesh::Print(std::string const& filename)
+{
+    std::ofstream outFile(filename);
+    if (!outFile)
+    {
+        return false;
+    }
+
+    // Assign unique indices to the edges.
+    std::map<Edge*, int> edgeIndex;
+    edgeIndex[nullptr] = 0;
+    int i = 1;
+    for (auto const& slot : mETable)
+    {
+        if (slot.edge)
+        {
+            edgeIndex[slot.edge] = i++;
+        }
+    }
+
+    // Assign unique indices to the triangles.
+    std::map<Triangle*, int> triIndex;
+    triIndex[nullptr] = 0;
+    i = 1;
+    for (auto const& slot : mTTable)
+    {
+        if (slot.triangle)
+        {
+            triIndex[slot.triangle] = i++;
+        }
+    }
+
+    // Print the edges.
+    outFile << "edge quantity = " << mNumEdges << std::endl;
+    for (auto const& slot : mETable)
+    {
+        if (!slot.edge)
+        {
+            continue;
+        }
+
+        Edge const& edge = *slot.edge;
+        outFile << 'e' << edgeIndex[slot.edge] << " <"
+              << 'v' << edge.V[0] << ",v" << edge.V[1] << "; ";
+        for (int j = 0; j < 2; ++j)
+        {
+            if (edge.T[j])
+            {
+                outFile << 't' << triIndex[edge.T[j]];
+            }
+            else
+            {
+                outFile << '*';
+            }
+            outFile << (j == 0 ? ',' : '>');
+        }
+        outFile << std::endl;
+    }
+    outFile << std::endl;
+
+    // Print the triangles.
+    outFile << "triangle quantity = " << mNumTriangles << std::endl;
+    for (auto const& slot : mTTable)
+    {
+        if (!slot.triangle)
+        {
+            continue;
+        }
+
+        Triangle const& tri = *slot.triangle;
+        outFile << 't' << triIndex[slot.triangle] << " <"
+              << 'v' << tri.V[0] << ",v" << tri.V[1] << ",v"
+              << tri.V[2] << "; ";
+        for (int j = 0; j < 3; ++j)
+        {
+            if (tri.E[j])
+            {
+                outFile << 'e' << edgeIndex[tri.E[j]];
+            }
+            else
+            {
+                outFile << '*';
+            }
+            outFile << (j < 2 ? "," : "; ");
+        }
+
+        for (int j = 0; j < 3; ++j)
+        {
+            if (tri.T[j])
+            {
+                outFile << 't' << triIndex[tri.T[j]];
+            }
+            else
+            {
+                outFile << '*';
+            }
+            outFile << (j < 2 ? ',' : '>');
+        }
+        outFile << std::endl;
+    }
+    outFile << std::endl;
+    return true;
+}
+//----------------------------------------------------------------------------
+unsigned int ETPoolManifoldMesh::Hash(EdgeKey<false> const& key)
+{
+    // Multiplicative hashing of the vertex indices followed by a final
+    // avalanche step so that the low-order bits depend on all inputs.
+    unsigned int h = static_cast<unsigned int>(key.V[0]) * 0x9E3779B1u;
+    h ^= static_cast<unsigned int>(key.V[1]) * 0x85EBCA77u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 13;
+    return h;
+}
+//----------------------------------------------------------------------------
+unsigned int ETPoolManifoldMesh::Hash(TriangleKey<true> const& key)
+{
+    unsigned int h = static_cast<unsigned int>(key.V[0]) * 0x9E3779B1u;
+    h ^= static_cast<unsigned int>(key.V[1]) * 0x85EBCA77u;
+    h ^= static_cast<unsigned int>(key.V[2]) * 0xC2B2AE3Du;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 13;
+    return h;
+}
+//----------------------------------------------------------------------------
+size_t ETPoolManifoldMesh::Find(EdgeKey<false> const& key) const
+{
+    size_t mask = mETable.size() - 1;
+    size_t i = Hash(key) & mask;
+    for (;;)
+    {
+        ESlot const& slot = mETable[i];
+        if (!slot.edge
+            || (slot.key.V[0] == key.V[0] && slot.key.V[1] == key.V[1]))
+        {
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+}
+//----------------------------------------------------------------------------
+size_t ETPoolManifoldMesh::Find(TriangleKey<true> const& key) const
+{
+    size_t mask = mTTable.size() - 1;
+    size_t i = Hash(key) & mask;
+    for (;;)
+    {
+        TSlot const& slot = mTTable[i];
+        if (!slot.triangle
+            || (slot.key.V[0] == key.V[0] && slot.key.V[1] == key.V[1]
+            && slot.key.V[2] == key.V[2]))
+        {
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+}
+//----------------------------------------------------------------------------
+void ETPoolManifoldMesh::InsertEdge(size_t slot, EdgeKey<false> const& key,
+    Edge* edge)
+{
+    if (2 * static_cast<size_t>(mNumEdges + 1) > mETable.size())
+    {
+        RehashEdges(2 * mETable.size());
+        slot = Find(key);
+    }
+    mETable[slot].key = key;
+    mETable[slot].edge = edge;
+    ++mNumEdges;
+}
+//----------------------------------------------------------------------------
+void ETPoolManifoldMesh::InsertTriangle(size_t slot,
+    TriangleKey<true> const& key, Triangle* tri)
+{
+    if (2 * static_cast<size_t>(mNumTriangles + 1) > mTTable.size())
+    {
+        RehashTriangles(2 * mTTable.size());
+        slot = Find(key);
+    }
+    mTTable[slot].key = key;
+    mTTable[slot].triangle = tri;
+    ++mNumTriangles;
+}
+//----------------------------------------------------------------------------
+void ETPoolManifoldMesh::RemoveEdge(size_t slot)
+{
+    // Backward-shift deletion.  Entries following the removed one in its
+    // probe sequence are moved back so that no tombstones are required.
+    size_t mask = mETable.size() - 1;
+    size_t i = slot, j = slot;
+    for (;;)
+    {
+        j = (j + 1) & mask;
+        if (!mETable[j].edge)
+        {
+            break;
+        }
+
+        size_t home = Hash(mETable[j].key) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask))
+        {
+            mETable[i] = mETable[j];
+            i = j;
+        }
+    }
+    mETable[i].edge = nullptr;
+    --mNumEdges;
+}
+//----------------------------------------------------------------------------
+void ETPoolManifoldMesh::RemoveTriangle(size_t slot)
+{
+    size_t mask = mTTable.size() - 1;
+    size_t i = slot, j = slot;
+    for (;;)
+    {
+        j = (j + 1) & mask;
+        if (!mTTable[j].triangle)
+        {
+            break;
+        }
+
+        size_t home = Hash(mTTable[j].key) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask))
+        {
+            mTTable[i] = mTTable[j];
+            i = j;
+        }
+    }
+    mTTable[i].triangle = nullptr;
+    --mNumTriangles;
+}
+//----------------------------------------------------------------------------
+void ETPoolManifoldMesh::RehashEdges(size_t numSlots)
+{
+    std::vector<ESlot> oldTable(numSlots);
+    for (auto& slot : oldTable)
+    {
+        slot.edge = nullptr;
+    }
+    std::swap(oldTable, mETable);
+
+    for (auto const& slot : oldTable)
+    {
+        if (slot.edge)
+        {
+            mETable[Find(slot.key)] = slot;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void ETPoolManifoldMesh::RehashTriangles(size_t numSlots)
+{
+    std::vector<TSlot> oldTable(numSlots);
+    for (auto& slot : oldTable)
+    {
+        slot.triangle = nullptr;
+    }
+    std::swap(oldTable, mTTable);
+
+    for (auto const& slot : oldTable)
+    {
+        if (slot.triangle)
+        {
+            mTTable[Find(slot.key)] = slot;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Object>
+ETPoolManifoldMesh::Pool<Object>::Pool()
+    :
+    mCurrentBlock(0),
+    mNumUsed(0)
+{
+}
+//----------------------------------------------------------------------------
+template <typename Object>
+Object* ETPoolManifoldMesh::Pool<Object>::Allocate()
+{
+    if (mFree.size() > 0)
+    {
+        Object* object = mFree.back();
+        mFree.pop_back();
+        return object;
+    }
+
+    while (mCurrentBlock < mBlocks.size()
+        && mNumUsed == mBlocks[mCurrentBlock].size())
+    {
+        ++mCurrentBlock;
+        mNumUsed = 0;
+    }
+
+    if (mCurrentBlock == mBlocks.size())
+    {
+        // The pool is exhausted.  Double its capacity so that the number of
+        // blocks is logarithmic in the number of objects.
+        size_t capacity = 0;
+        for (auto const& block : mBlocks)
+        {
+            capacity += block.size();
+        }
+        mBlocks.push_back(std::vector<Object>(std::max(capacity,
+            static_cast<size_t>(1024))));
+    }
+
+    return &mBlocks[mCurrentBlock][mNumUsed++];
+}
+//----------------------------------------------------------------------------
+template <typename Object>
+void ETPoolManifoldMesh::Pool<Object>::Free(Object* object)
+{
+    mFree.push_back(object);
+}
+//----------------------------------------------------------------------------
+template <typename Object>
+void ETPoolManifoldMesh::Pool<Object>::Reserve(int numObjects)
+{
+    size_t available = mFree.size();
+    for (size_t b = mCurrentBlock; b < mBlocks.size(); ++b)
+    {
+        available += mBlocks[b].size() - (b == mCurrentBlock ? mNumUsed : 0);
+    }
+
+    if (numObjects > 0 && static_cast<size_t>(numObjects) > available)
+    {
+        mBlocks.push_back(std::vector<Object>(numObjects - available));
+    }
+
+    size_t capacity = 0;
+    for (auto const& block : mBlocks)
+    {
+        capacity += block.size();
+    }
+    if (mFree.capacity() < capacity)
+    {
+        mFree.reserve(capacity);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Object>
+void ETPoolManifoldMesh::Pool<Object>::Clear()
+{
+    mFree.clear();
+    mCurrentBlock = 0;
+    mNumUsed = 0;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,266 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#include "GTEnginePCH.h"
+#include "GteEuclideanDistanceTransform.h"
+#include "GteParallelFor.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+using namespace gte;
+
+//----------------------------------------------------------------------------
+void EuclideanDistanceTransform::Execute(int numDimensions,
+    int const dimensions[], unsigned int numThreads, int const* image,
+    float* distance, int* nearest)
+{
+    int numPoints = 1;
+    for (int d = 0; d < numDimensions; ++d)
+    {
+        numPoints *= dimensions[d];
+    }
+    if (numPoints <= 0)
+    {
+        return;
+    }
+    numThreads = ParallelFor::GetNumThreads(numThreads, numPoints);
+
+    ParallelFor::Execute(numThreads, [&](unsigned int t)
+    {
+        int imin, imax;
+        ParallelFor::GetRange(numPoints, numThreads, t, imin, imax);
+        for (int i = imin; i < imax; ++i)
+        {
+            SetSqr(distance, i, (image[i] != 0 ? INT_MAX : 0));
+        }
+        if (nearest)
+        {
+            for (int i = imin; i < imax; ++i)
+            {
+                nearest[i] = (image[i] != 0 ? -1 : i);
+            }
+        }
+    });
+
+    // The points of a line along dimension d are 'stride' apart, and the
+    // lines that start at adjacent points are adjacent.  The lines are
+    // processed in blocks of up to 16 adjacent lines; each block is a unit
+    // of work.  Along dimension 0 the points are contiguous, so the blocks
+    // have a single line.
+    int const maxBlockSize = 16;
+    int stride = 1;
+    for (int d = 0; d < numDimensions; ++d)
+    {
+        int const n = dimensions[d];
+        int const numHigh = numPoints/(stride*n);
+        int const blockSize = (stride == 1 ? 1 :
+            std::min(stride, maxBlockSize));
+        int const blocksPerHigh = (stride + blockSize - 1)/blockSize;
+        int const numUnits = numHigh*blocksPerHigh;
+        unsigned int const numUsed = ParallelFor::GetNumThreads(numThreads,
+            numUnits);
+
+        ParallelFor::Execute(numUsed, [&](unsigned int t)
+        {
+            int umin, umax;
+            ParallelFor::GetRange(numUnits, numUsed, t, umin, umax);
+            std::vector<int> f(blockSize*n), source(blockSize*n);
+            std::vector<int> feature(nearest ? blockSize*n : 0);
+            std::vector<int> workspace(3*n);
+
+            for (int unit = umin; unit < umax; ++unit)
+            {
+                int const high = unit/blocksPerHigh;
+                int const low = (unit % blocksPerHigh)*blockSize;
+                int const count = std::min(blockSize, stride - low);
+                int const base = low + high*stride*n;
+
+                int p = base;
+                for (int i = 0; i < n; ++i, p += stride)
+                {
+                    for (int b = 0; b < count; ++b)
+                    {
+                        f[b*n + i] = GetSqr(distance, p + b);
+                    }
+                    if (nearest)
+                    {
+                        for (int b = 0; b < count; ++b)
+                        {
+                            feature[b*n + i] = nearest[p + b];
+                        }
+                    }
+                }
+
+                for (int b = 0; b < count; ++b)
+                {
+                    Transform1(n, &f[b*n], &source[b*n], &workspace[0]);
+                }
+
+                p = base;
+                for (int i = 0; i < n; ++i, p += stride)
+                {
+                    for (int b = 0; b < count; ++b)
+                    {
+                        SetSqr(distance, p + b, f[b*n + i]);
+                    }
+                    if (nearest)
+                    {
+                        for (int b = 0; b < count; ++b)
+                        {
+                            int const s = source[b*n + i];
+                            if (s >= 0)
+                            {
+                                nearest[p + b] = feature[b*n + s];
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+        stride *= n;
+    }
+}
+//----------------------------------------------------------------------------
+void EuclideanDistanceTransform::GetDistances(int numPoints,
+    unsigned int numThreads, float* distance, float& maxDistance,
+    int& maxIndex)
+{
+    maxDistance = 0.0f;
+    maxIndex = 0;
+    if (numPoints <= 0)
+    {
+        return;
+    }
+    numThreads = ParallelFor::GetNumThreads(numThreads, numPoints);
+
+    std::vector<float> threadMax(numThreads);
+    std::vector<int> threadIndex(numThreads);
+    ParallelFor::Execute(numThreads, [&](unsigned int t)
+    {
+        int imin, imax;
+        ParallelFor::GetRange(numPoints, numThreads, t, imin, imax);
+        float tMax = 0.0f;
+        int tIndex = imin;
+        for (int i = imin; i < imax; ++i)
+        {
+            distance[i] = sqrt((float)GetSqr(distance, i));
+            if (distance[i] > tMax)
+            {
+                tMax = distance[i];
+                tIndex = i;
+            }
+        }
+        threadMax[t] = tMax;
+        threadIndex[t] = tIndex;
+    });
+
+    for (unsigned int t = 0; t < numThreads; ++t)
+    {
+        if (threadMax[t] > maxDistance)
+        {
+            maxDistance = threadMax[t];
+            maxIndex = threadIndex[t];
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void EuclideanDistanceTransform::Transform1(int n, int* f, int* source,
+    int* workspace)
+{
+    // The parabola of position u is F(x,u) = (x-u)^2 + f[u].  The lower
+    // envelope is stored as a stack of parabolas: parabola vertex[k] (whose
+    // f-value is value[k]) is the minimum for start[k] <= x < start[k+1].
+    // When two parabolas are equal, the one with the smaller position wins.
+    int* vertex = workspace;
+    int* start = workspace + n;
+    int* value = workspace + 2*n;
+    int q = -1;
+    for (int u = 0; u < n; ++u)
+    {
+        if (f[u] == INT_MAX)
+        {
+            continue;
+        }
+
+        int64_t const fu = f[u];
+        while (q >= 0)
+        {
+            int64_t d0 = start[q] - vertex[q];
+            int64_t d1 = start[q] - u;
+            if (d0*d0 + value[q] <= d1*d1 + fu)
+            {
+                break;
+            }
+            --q;
+        }
+
+        if (q < 0)
+        {
+            q = 0;
+            vertex[0] = u;
+            start[0] = 0;
+            value[0] = f[u];
+        }
+        else
+        {
+            // The parabola of u is smaller than that of vertex[q] for all
+            // integers x > sep.
+            int64_t const v = vertex[q];
+            int64_t numer = (int64_t)u*u - v*v + fu - value[q];
+            int64_t denom = 2*(u - v);
+            int64_t sep = numer/denom;
+            if (numer < 0 && sep*denom != numer)
+            {
+                --sep;
+            }
+            if (sep + 1 < n)
+            {
+                ++q;
+                vertex[q] = u;
+                start[q] = (int)(sep + 1);
+                value[q] = f[u];
+            }
+        }
+    }
+
+    if (q < 0)
+    {
+        for (int u = 0; u < n; ++u)
+        {
+            source[u] = -1;
+        }
+        return;
+    }
+
+    for (int u = n - 1; u >= 0; --u)
+    {
+        int64_t d = u - vertex[q];
+        f[u] = (int)(d*d + value[q]);
+        source[u] = vertex[q];
+        if (u == start[q])
+        {
+            --q;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+int EuclideanDistanceTransform::GetSqr(float const* distance, int i)
+{
+    int sqrDistance;
+    std::memcpy(&sqrDistance, &distance[i], sizeof(int));
+    return sqrDistance;
+}
+//----------------------------------------------------------------------------
+void EuclideanDistanceTransform::SetSqr(float* distance, int i,
+    int sqrDistance)
+{
+    std::memcpy(&distance[i], &sqrDistance, sizeof(int));
+}
+//----------------------------------------------------------------------------
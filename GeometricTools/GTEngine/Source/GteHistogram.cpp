@@ -7,8 +7,38 @@
 
 #include "GTEnginePCH.h"
 #include "GteHistogram.h"
+#include "GteParallelFor.h"
+#include <algorithm>
+#include <cstdint>
+#include <emmintrin.h>
+#include <mutex>
+#include <vector>
 using namespace gte;
 
+// Store the slots of two samples, given the samples and their clamped
+// differences from the minimum as doubles.  The truncation and the range
+// tests are those of Histogram::GetSlot.
+static inline void StoreSlots (__m128d value, __m128d difference,
+    bool checkRange, double mult, double minValue, double maxValue,
+    int numSlots, int* slots)
+{
+    __m128i slot = _mm_add_epi32(_mm_cvttpd_epi32(_mm_mul_pd(
+        _mm_set1_pd(mult), difference)), _mm_set1_epi32(1));
+    if (checkRange)
+    {
+        // The 64-bit comparison masks are reduced to 32-bit masks in the
+        // two low lanes.
+        __m128i less = _mm_shuffle_epi32(_mm_castpd_si128(_mm_cmplt_pd(
+            value, _mm_set1_pd(minValue))), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128i greater = _mm_shuffle_epi32(_mm_castpd_si128(_mm_cmpgt_pd(
+            value, _mm_set1_pd(maxValue))), _MM_SHUFFLE(2, 0, 2, 0));
+        slot = _mm_andnot_si128(less, slot);
+        slot = _mm_or_si128(_mm_andnot_si128(greater, slot), _mm_and_si128(
+            greater, _mm_set1_epi32(numSlots - 1)));
+    }
+    _mm_storel_epi64((__m128i*)slots, slot);
+}
+
 //----------------------------------------------------------------------------
 Histogram::~Histogram ()
 {
@@ -16,12 +46,15 @@ Histogram::~Histogram ()
 }
 //----------------------------------------------------------------------------
 Histogram::Histogram (int numBuckets, int numSamples, int const* samples,
-    bool noRescaling)
+    bool noRescaling, unsigned int numThreads)
     :
     mNumBuckets(numBuckets),
     mBuckets(nullptr),
     mExcessLess(0),
-    mExcessGreater(0)
+    mExcessGreater(0),
+    mNumInBuckets(0),
+    mMinValue(0.0),
+    mMaxValue(0.0)
 {
     if (mNumBuckets <= 0 || numSamples <= 0 || !samples)
     {
@@ -33,75 +66,31 @@ Histogram::Histogram (int numBuckets, int numSamples, int const* samples,
     mBuckets = new int[mNumBuckets];
     memset(mBuckets, 0, mNumBuckets*sizeof(int));
 
-    int i, value;
-
     if (noRescaling)
     {
         // Map to the buckets, also counting out-of-range pixels.
-        for (i = 0; i < numSamples; ++i)
-        {
-            value = samples[i];
-            if (0 <= value)
-            {
-                if (value < mNumBuckets)
-                {
-                    ++mBuckets[value];
-                }
-                else
-                {
-                    ++mExcessGreater;
-                }
-            }
-            else
-            {
-                ++mExcessLess;
-            }
-        }
+        mMaxValue = (double)(mNumBuckets - 1);
     }
     else
     {
-        // Compute the extremes.
-        int minValue = samples[0], maxValue = minValue;
-        for (i = 1; i < numSamples; ++i)
-        {
-            value = samples[i];
-            if (value < minValue)
-            {
-                minValue = value;
-            }
-            else if (value > maxValue)
-            {
-                maxValue = value;
-            }
-        }
-
-        // Map to the buckets.
-        if (minValue < maxValue)
-        {
-            // The image is not constant.
-            double numer = (double)(mNumBuckets - 1);
-            double denom = (double)(maxValue - minValue);
-            double mult = numer/denom;
-            for (i = 0; i < numSamples; ++i)
-            {
-                int index = (int)(mult*(double)(samples[i] - minValue));
-                ++mBuckets[index];
-            }
-        }
-        else
-        {
-            // The image is constant.
-            mBuckets[0] = numSamples;
-        }
+        int minValue, maxValue;
+        GetExtremes(numSamples, samples, numThreads, minValue, maxValue);
+        mMinValue = (double)minValue;
+        mMaxValue = (double)maxValue;
     }
+    Accumulate(numSamples, samples, noRescaling, numThreads);
 }
 //----------------------------------------------------------------------------
-Histogram::Histogram (int numBuckets, int numSamples, float const* samples)
+Histogram::Histogram (int numBuckets, int numSamples, float const* samples,
+    unsigned int numThreads)
     :
     mNumBuckets(numBuckets),
     mBuckets(nullptr),
     mExcessLess(0),
-    mExcessGreater(0)
+    mExcessGreater(0),
+    mNumInBuckets(0),
+    mMinValue(0.0),
+    mMaxValue(0.0)
 {
     if (mNumBuckets <= 0 || numSamples <= 0 || !samples)
     {
@@ -113,47 +102,23 @@ Histogram::Histogram (int numBuckets, int numSamples, float const* samples)
     mBuckets = new int[mNumBuckets];
     memset(mBuckets, 0, mNumBuckets*sizeof(int));
 
-    // Compute the extremes.
-    float minValue = samples[0], maxValue = minValue;
-    for (int i = 1; i < numSamples; ++i)
-    {
-        float value = samples[i];
-        if (value < minValue)
-        {
-            minValue = value;
-        }
-        else if (value > maxValue)
-        {
-            maxValue = value;
-        }
-    }
-
-    // Map to the buckets.
-    if (minValue < maxValue)
-    {
-        // The image is not constant.
-        double numer = (double)(mNumBuckets - 1);
-        double denom = (double)(maxValue - minValue);
-        double mult = numer/denom;
-        for (int i = 0; i < numSamples; ++i)
-        {
-            int index = (int)(mult*(double)(samples[i] - minValue));
-            ++mBuckets[index];
-        }
-    }
-    else
-    {
-        // The image is constant.
-        mBuckets[0] = numSamples;
-    }
+    float minValue, maxValue;
+    GetExtremes(numSamples, samples, numThreads, minValue, maxValue);
+    mMinValue = (double)minValue;
+    mMaxValue = (double)maxValue;
+    Accumulate(numSamples, samples, false, numThreads);
 }
 //----------------------------------------------------------------------------
-Histogram::Histogram (int numBuckets, int numSamples, double const* samples)
+Histogram::Histogram (int numBuckets, int numSamples, double const* samples,
+    unsigned int numThreads)
     :
     mNumBuckets(numBuckets),
     mBuckets(nullptr),
     mExcessLess(0),
-    mExcessGreater(0)
+    mExcessGreater(0),
+    mNumInBuckets(0),
+    mMinValue(0.0),
+    mMaxValue(0.0)
 {
     if (mNumBuckets <= 0 || numSamples <= 0 || !samples)
     {
@@ -165,49 +130,42 @@ Histogram::Histogram (int numBuckets, int numSamples, double const* samples)
     mBuckets = new int[mNumBuckets];
     memset(mBuckets, 0, mNumBuckets*sizeof(int));
 
-    // Compute the extremes.
-    double minValue = samples[0], maxValue = minValue;
-    for (int i = 1; i < numSamples; ++i)
+    GetExtremes(numSamples, samples, numThreads, mMinValue, mMaxValue);
+    Accumulate(numSamples, samples, false, numThreads);
+}
+//----------------------------------------------------------------------------
+Histogram::Histogram (int numBuckets)
+    :
+    mNumBuckets(numBuckets),
+    mBuckets(nullptr),
+    mExcessLess(0),
+    mExcessGreater(0),
+    mNumInBuckets(0),
+    mMinValue(0.0),
+    mMaxValue((double)(numBuckets - 1))
+{
+    if (mNumBuckets <= 0)
     {
-        double value = samples[i];
-        if (value < minValue)
-        {
-            minValue = value;
-        }
-        else if (value > maxValue)
-        {
-            maxValue = value;
-        }
+        LogError("Invalid inputs.");
+        mNumBuckets = 0;
+        return;
     }
 
-    // Map to the buckets.
-    if (minValue < maxValue)
-    {
-        // The image is not constant.
-        double numer = (double)(mNumBuckets - 1);
-        double denom = maxValue - minValue;
-        double mult = numer/denom;
-        for (int i = 0; i < numSamples; ++i)
-        {
-            int index = (int)(mult*(samples[i] - minValue));
-            ++mBuckets[index];
-        }
-    }
-    else
-    {
-        // The image is constant.
-        mBuckets[0] = numSamples;
-    }
+    mBuckets = new int[mNumBuckets];
+    memset(mBuckets, 0, mNumBuckets*sizeof(int));
 }
 //----------------------------------------------------------------------------
-Histogram::Histogram (int numBuckets)
+Histogram::Histogram (int numBuckets, double minValue, double maxValue)
     :
     mNumBuckets(numBuckets),
     mBuckets(nullptr),
     mExcessLess(0),
-    mExcessGreater(0)
+    mExcessGreater(0),
+    mNumInBuckets(0),
+    mMinValue(minValue),
+    mMaxValue(maxValue)
 {
-    if (mNumBuckets <= 0)
+    if (mNumBuckets <= 0 || minValue > maxValue)
     {
         LogError("Invalid inputs.");
         mNumBuckets = 0;
@@ -225,6 +183,7 @@ void Histogram::InsertCheck (int value)
         if (value < mNumBuckets)
         {
             ++mBuckets[value];
+            ++mNumInBuckets;
         }
         else
         {
@@ -237,15 +196,36 @@ void Histogram::InsertCheck (int value)
     }
 }
 //----------------------------------------------------------------------------
-int Histogram::GetLowerTail (double tailAmount)
+void Histogram::Insert (int numSamples, int const* samples,
+    unsigned int numThreads)
 {
-    int hSum = 0;
-    for (int i = 0; i < mNumBuckets; ++i)
+    if (mNumBuckets > 0 && numSamples > 0 && samples)
     {
-        hSum += mBuckets[i];
+        Accumulate(numSamples, samples, true, numThreads);
     }
-
-    int hTailSum = (int)(tailAmount*hSum);
+}
+//----------------------------------------------------------------------------
+void Histogram::Insert (int numSamples, float const* samples,
+    unsigned int numThreads)
+{
+    if (mNumBuckets > 0 && numSamples > 0 && samples)
+    {
+        Accumulate(numSamples, samples, true, numThreads);
+    }
+}
+//----------------------------------------------------------------------------
+void Histogram::Insert (int numSamples, double const* samples,
+    unsigned int numThreads)
+{
+    if (mNumBuckets > 0 && numSamples > 0 && samples)
+    {
+        Accumulate(numSamples, samples, true, numThreads);
+    }
+}
+//----------------------------------------------------------------------------
+int Histogram::GetLowerTail (double tailAmount) const
+{
+    int hTailSum = (int)(tailAmount*mNumInBuckets);
 
     int hLowerSum = 0;
     int lower;
@@ -260,15 +240,9 @@ int Histogram::GetLowerTail (double tailAmount)
     return lower;
 }
 //----------------------------------------------------------------------------
-int Histogram::GetUpperTail (double tailAmount)
+int Histogram::GetUpperTail (double tailAmount) const
 {
-    int hSum = 0;
-    for (int i = 0; i < mNumBuckets; ++i)
-    {
-        hSum += mBuckets[i];
-    }
-
-    int hTailSum = (int)(tailAmount*hSum);
+    int hTailSum = (int)(tailAmount*mNumInBuckets);
 
     int hUpperSum = 0;
     int upper;
@@ -283,15 +257,9 @@ int Histogram::GetUpperTail (double tailAmount)
     return upper;
 }
 //----------------------------------------------------------------------------
-void Histogram::GetTails (double tailAmount, int& lower, int& upper)
+void Histogram::GetTails (double tailAmount, int& lower, int& upper) const
 {
-    int hSum = 0;
-    for (int i = 0; i < mNumBuckets; ++i)
-    {
-        hSum += mBuckets[i];
-    }
-
-    int hTailSum = (int)(0.5*tailAmount*hSum);
+    int hTailSum = (int)(0.5*tailAmount*mNumInBuckets);
 
     int hLowerSum = 0;
     for (lower = 0; lower < mNumBuckets; ++lower)
@@ -363,3 +331,229 @@ void Histogram::SaveAsImage (std::string const& name, int dimension0)
     image.Save(name);
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void Histogram::Accumulate (int numSamples, Real const* samples,
+    bool checkRange, unsigned int numThreads)
+{
+    // Slot 0 of the counts is for the samples smaller than mMinValue, slot
+    // B+1 for those larger than mMaxValue, and slot i+1 for bucket i.  The
+    // range of a constant image has mMinValue = mMaxValue, and the samples
+    // equal to that value are in bucket 0.
+    int const numSlots = mNumBuckets + 2;
+    double const minValue = mMinValue, maxValue = mMaxValue;
+
+    // The differences of values are computed in the sample type, as the
+    // constructors have always done.
+    SlotRange range;
+    range.minValue = minValue;
+    range.maxValue = maxValue;
+    range.realMin = (double)(Real)minValue;
+    range.realMax = (double)(Real)maxValue;
+    range.mult = (range.realMin < range.realMax ?
+        (double)(mNumBuckets - 1)/(double)((Real)maxValue - (Real)minValue) :
+        0.0);
+    range.numSlots = numSlots;
+
+    std::mutex countMutex;
+    std::vector<int> counts(numSlots, 0);
+    ParallelFor::Execute(numSamples, numThreads, [&](int imin, int imax)
+    {
+        // Consecutive samples are counted in four interleaved copies of the
+        // slots, so runs of equal samples do not serialize on one counter.
+        int const blockSize = 256;
+        int slots[blockSize];
+        std::vector<int> localCounts(4*numSlots, 0);
+        int* localCounts0 = &localCounts[0];
+        int* localCounts1 = localCounts0 + numSlots;
+        int* localCounts2 = localCounts1 + numSlots;
+        int* localCounts3 = localCounts2 + numSlots;
+        for (int i0 = imin; i0 < imax; i0 += blockSize)
+        {
+            int const numBlock = std::min(imax - i0, blockSize);
+            GetSlots(numBlock, samples + i0, checkRange, range, slots);
+
+            int j = 0;
+            for (/**/; j + 4 <= numBlock; j += 4)
+            {
+                ++localCounts0[slots[j]];
+                ++localCounts1[slots[j + 1]];
+                ++localCounts2[slots[j + 2]];
+                ++localCounts3[slots[j + 3]];
+            }
+            for (/**/; j < numBlock; ++j)
+            {
+                ++localCounts0[slots[j]];
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(countMutex);
+        for (int i = 0; i < numSlots; ++i)
+        {
+            counts[i] += localCounts0[i] + localCounts1[i] +
+                localCounts2[i] + localCounts3[i];
+        }
+    });
+
+    mExcessLess += counts[0];
+    mExcessGreater += counts[numSlots - 1];
+    for (int i = 0; i < mNumBuckets; ++i)
+    {
+        mBuckets[i] += counts[i + 1];
+        mNumInBuckets += counts[i + 1];
+    }
+}
+//----------------------------------------------------------------------------
+void Histogram::GetSlots (int numValues, int const* values,
+    bool checkRange, SlotRange const& range, int* slots)
+{
+    // The integer samples and their differences are exact as doubles.
+    __m128d const realMin = _mm_set1_pd(range.realMin);
+    __m128d const realMax = _mm_set1_pd(range.realMax);
+    int j = 0;
+    for (/**/; j + 2 <= numValues; j += 2)
+    {
+        __m128d value = _mm_cvtepi32_pd(_mm_loadl_epi64(
+            (__m128i const*)(values + j)));
+        __m128d difference = _mm_sub_pd(value, realMin);
+        if (checkRange)
+        {
+            difference = _mm_sub_pd(_mm_min_pd(_mm_max_pd(value, realMin),
+                realMax), realMin);
+        }
+        StoreSlots(value, difference, checkRange, range.mult,
+            range.minValue, range.maxValue, range.numSlots, slots + j);
+    }
+    for (/**/; j < numValues; ++j)
+    {
+        slots[j] = GetSlot((double)values[j], checkRange, range);
+    }
+}
+//----------------------------------------------------------------------------
+void Histogram::GetSlots (int numValues, float const* values,
+    bool checkRange, SlotRange const& range, int* slots)
+{
+    // The differences are computed in float for four samples at a time and
+    // then converted to double in two pairs.
+    __m128 const realMin = _mm_set1_ps((float)range.realMin);
+    __m128 const realMax = _mm_set1_ps((float)range.realMax);
+    int j = 0;
+    for (/**/; j + 4 <= numValues; j += 4)
+    {
+        __m128 value = _mm_loadu_ps(values + j);
+        __m128 difference = _mm_sub_ps(value, realMin);
+        if (checkRange)
+        {
+            difference = _mm_sub_ps(_mm_min_ps(_mm_max_ps(value, realMin),
+                realMax), realMin);
+        }
+        StoreSlots(_mm_cvtps_pd(value), _mm_cvtps_pd(difference),
+            checkRange, range.mult, range.minValue, range.maxValue,
+            range.numSlots, slots + j);
+        StoreSlots(_mm_cvtps_pd(_mm_movehl_ps(value, value)),
+            _mm_cvtps_pd(_mm_movehl_ps(difference, difference)), checkRange,
+            range.mult, range.minValue, range.maxValue, range.numSlots,
+            slots + j + 2);
+    }
+    for (/**/; j < numValues; ++j)
+    {
+        float value = values[j];
+        float difference = (checkRange ? std::min(std::max(value,
+            (float)range.realMin), (float)range.realMax) : value) -
+            (float)range.realMin;
+        slots[j] = GetSlot((double)value, (double)difference, checkRange,
+            range);
+    }
+}
+//----------------------------------------------------------------------------
+void Histogram::GetSlots (int numValues, double const* values,
+    bool checkRange, SlotRange const& range, int* slots)
+{
+    __m128d const realMin = _mm_set1_pd(range.realMin);
+    __m128d const realMax = _mm_set1_pd(range.realMax);
+    int j = 0;
+    for (/**/; j + 2 <= numValues; j += 2)
+    {
+        __m128d value = _mm_loadu_pd(values + j);
+        __m128d difference = _mm_sub_pd(value, realMin);
+        if (checkRange)
+        {
+            difference = _mm_sub_pd(_mm_min_pd(_mm_max_pd(value, realMin),
+                realMax), realMin);
+        }
+        StoreSlots(value, difference, checkRange, range.mult,
+            range.minValue, range.maxValue, range.numSlots, slots + j);
+    }
+    for (/**/; j < numValues; ++j)
+    {
+        slots[j] = GetSlot(values[j], checkRange, range);
+    }
+}
+//----------------------------------------------------------------------------
+int Histogram::GetSlot (double value, bool checkRange,
+    SlotRange const& range)
+{
+    double difference = (checkRange ? std::min(std::max(value,
+        range.realMin), range.realMax) : value) - range.realMin;
+    return GetSlot(value, difference, checkRange, range);
+}
+//----------------------------------------------------------------------------
+int Histogram::GetSlot (double value, double difference, bool checkRange,
+    SlotRange const& range)
+{
+    if (checkRange)
+    {
+        if (value < range.minValue)
+        {
+            return 0;
+        }
+        if (value > range.maxValue)
+        {
+            return range.numSlots - 1;
+        }
+    }
+    return (int)(range.mult*difference) + 1;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void Histogram::GetExtremes (int numSamples, Real const* samples,
+    unsigned int numThreads, Real& minValue, Real& maxValue)
+{
+    std::mutex extremesMutex;
+    minValue = samples[0];
+    maxValue = samples[0];
+    ParallelFor::Execute(numSamples, numThreads, [&](int imin, int imax)
+    {
+        // Eight independent extremes, one per lane of a block of samples,
+        // so the loop can be vectorized without reordering the reduction.
+        int const numLanes = 8;
+        Real localMin[numLanes], localMax[numLanes];
+        for (int k = 0; k < numLanes; ++k)
+        {
+            localMin[k] = samples[imin];
+            localMax[k] = samples[imin];
+        }
+
+        int i = imin;
+        for (/**/; i + numLanes <= imax; i += numLanes)
+        {
+            for (int k = 0; k < numLanes; ++k)
+            {
+                localMin[k] = std::min(localMin[k], samples[i + k]);
+                localMax[k] = std::max(localMax[k], samples[i + k]);
+            }
+        }
+        for (/**/; i < imax; ++i)
+        {
+            localMin[0] = std::min(localMin[0], samples[i]);
+            localMax[0] = std::max(localMax[0], samples[i]);
+        }
+
+        std::lock_guard<std::mutex> lock(extremesMutex);
+        for (int k = 0; k < numLanes; ++k)
+        {
+            minValue = std::min(minValue, localMin[k]);
+            maxValue = std::max(maxValue, localMax[k]);
+        }
+    });
+}
+//----------------------------------------------------------------------------
@@ -7,6 +7,11 @@
 
 #include "GTEnginePCH.h"
 #include "GteImage.h"
+#if !defined(WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 using namespace gte;
 
 //----------------------------------------------------------------------------
@@ -16,7 +21,11 @@ Image::~Image()
     delete[] mOffsets;
     delete[] mPixelMetaData;
 
-    if (mOwnerRawPixels)
+    if (mMapView)
+    {
+        UnmapPixels();
+    }
+    else if (mOwnerRawPixels)
     {
         delete[] mRawPixels;
     }
@@ -32,6 +41,8 @@ Image::Image()
     mNumPixels(0),
     mRawPixels(nullptr),
     mOwnerRawPixels(true),
+    mMapView(nullptr),
+    mMapSize(0),
     mImageMetaData(""),
     mPixelMetaData(nullptr),
     mDefaultPixelMetaData("")
@@ -45,6 +56,8 @@ Image::Image(Image const& image)
     mNumDimensions(image.mNumDimensions),
     mNumPixels(image.mNumPixels),
     mOwnerRawPixels(true),
+    mMapView(nullptr),
+    mMapSize(0),
     mImageMetaData(image.mImageMetaData),
     mDefaultPixelMetaData(image.mDefaultPixelMetaData)
 {
@@ -84,6 +97,8 @@ Image::Image(std::string const& pixelType, int pixelSize, int numDimensions,
     mNumPixels(0),
     mRawPixels(nullptr),
     mOwnerRawPixels(true),
+    mMapView(nullptr),
+    mMapSize(0),
     mImageMetaData(""),
     mPixelMetaData(nullptr),
     mDefaultPixelMetaData("")
@@ -149,7 +164,11 @@ int Image::GetOffset(int i) const
 //----------------------------------------------------------------------------
 void Image::SetRawPixels(char* rawPixels)
 {
-    if (mOwnerRawPixels)
+    if (mMapView)
+    {
+        UnmapPixels();
+    }
+    else if (mOwnerRawPixels)
     {
         delete[] mRawPixels;
     }
@@ -319,75 +338,8 @@ bool Image::Load(std::string const& name,
         return false;
     }
 
-    if (!LoadHeader(input, mPixelType, mPixelSize, mNumDimensions))
-    {
-        input.close();
-        return false;
-    }
-
-    if (requiredNumDimensions)
-    {
-        int const numElements = (int)requiredNumDimensions->size();
-        int i;
-        for (i = 0; i < numElements; ++i)
-        {
-            if (mNumDimensions == (*requiredNumDimensions)[i])
-            {
-                break;
-            }
-        }
-        if (i == numElements)
-        {
-            CreateNullImage();
-            input.close();
-            return false;
-        }
-    }
-
-    if (requiredPixelTypes)
-    {
-        int const numElements = (int)requiredPixelTypes->size();
-        int i;
-        for (i = 0; i < numElements; ++i)
-        {
-            if (mPixelType == (*requiredPixelTypes)[i])
-            {
-                break;
-            }
-        }
-        if (i == numElements)
-        {
-            CreateNullImage();
-            input.close();
-            return false;
-        }
-    }
-
-    // Read the dimensions.
-    mDimensions = new int[mNumDimensions];
-    if (input.read((char*)mDimensions, mNumDimensions*sizeof(int)).bad())
-    {
-        LogError("Failed read dimensions.");
-        CreateNullImage();
-        input.close();
-        return false;
-    }
-
-    // Read the offsets.
-    mOffsets = new int[mNumDimensions];
-    if (input.read((char*)mOffsets, mNumDimensions*sizeof(int)).bad())
-    {
-        LogError("Failed read offsets.");
-        CreateNullImage();
-        input.close();
-        return false;
-    }
-
-    // Read the number of pixels.
-    if (input.read((char*)&mNumPixels, sizeof(int)).bad())
+    if (!LoadInfo(input, requiredNumDimensions, requiredPixelTypes))
     {
-        LogError("Failed read number of pixels.");
-        CreateNullImage();
         input.close();
         return false;
     }
@@ -403,80 +355,12 @@ bool Image::Load(std::string const& name,
         return false;
     }
 
-    // Read the length of the image metadata string.
-    int length;
-    if (input.read((char*)&length, sizeof(int)).bad())
-    {
-        LogError("Failed read length(image metadata).");
-        CreateNullImage();
-        input.close();
-        return false;
-    }
-
-    // Read the image metadata string.
-    numBytes = length + 1;
-    char* temp = new char[numBytes];
-    if (input.read(temp, numBytes).bad() || temp[length] != 0)
-    {
-        LogError("Failed read image metadata.");
-        delete[] temp;
-        CreateNullImage();
-        input.close();
-        return false;
-    }
-    mImageMetaData = std::string(temp);
-    delete[] temp;
-
-    // Read the existence flag for pixel metadata.
-    int existsPixelMetaData = 0;
-    if (input.read((char*)&existsPixelMetaData, sizeof(int)).bad())
+    if (!LoadMetaData(input))
     {
-        LogError("Failed read pixel metadata existence.");
-        CreateNullImage();
         input.close();
         return false;
     }
 
-    if (existsPixelMetaData)
-    {
-        CreatePixelMetaData();
-
-        int maxNumBytes = 128;
-        temp = new char[maxNumBytes];
-        for (int i = 0; i < mNumPixels; ++i)
-        {
-            // Read the length of the pixel metadata string.
-            if (input.read((char*)&length, sizeof(int)).bad())
-            {
-                LogError("Failed read length.");
-                delete[] temp;
-                CreateNullImage();
-                input.close();
-                return false;
-            }
-
-            // Resize the temporary storage if necessary.
-            numBytes = length + 1;
-            if (numBytes > maxNumBytes)
-            {
-                maxNumBytes = numBytes;
-                delete[] temp;
-                temp = new char[maxNumBytes];
-            }
-
-            // Read the pixel metadata string.
-            if (input.read(temp, numBytes).bad() || temp[length] != 0)
-            {
-                LogError("Failed read pixel metadata.");
-                delete[] temp;
-                CreateNullImage();
-                input.close();
-                return false;
-            }
-            mPixelMetaData[i] = std::string(temp);
-        }
-    }
-
     input.close();
     return true;
 }
@@ -496,127 +380,70 @@ bool Image::Save(std::string const& name) const
         return false;
     }
 
-    // Write the length of the pixel type.
-    int length = (int)mPixelType.length();
-    if (output.write((char const*)&length, sizeof(int)).bad())
-    {
-        LogError("Failed write length(pixelType).");
-        output.close();
-        return false;
-    }
-
-    // Write the pixel type string.
-    int numBytes = length + 1;
-    if (output.write(mPixelType.c_str(), numBytes).bad())
-    {
-        LogError("Failed write pixelType.");
-        output.close();
-        return false;
-    }
-
-    // Write the pixel size.
-    if (output.write((char const*)&mPixelSize, sizeof(int)).bad())
+    if (!SaveInfo(output))
     {
-        LogError("Failed write pixelSize.");
         output.close();
         return false;
     }
 
-    // Write the number of dimensions.
-    if (output.write((char const*)&mNumDimensions, sizeof(int)).bad())
+    // Write the pixels.
+    int numBytes = mNumPixels*mPixelSize;
+    if (output.write(mRawPixels, numBytes).bad())
     {
-        LogError("Failed write numDimensions.");
+        LogError("Failed write pixels.");
         output.close();
         return false;
     }
 
-    // Write the dimensions.
-    numBytes = mNumDimensions*sizeof(int);
-    if (output.write((char const*)mDimensions, numBytes).bad())
+    if (!SaveMetaData(output))
     {
-        LogError("Failed write dimensions.");
         output.close();
         return false;
     }
 
-    // Write the offsets.
-    if (output.write((char const*)mOffsets, numBytes).bad())
-    {
-        LogError("Failed write offsets.");
-        output.close();
-        return false;
-    }
+    output.close();
+    return true;
+}
+//----------------------------------------------------------------------------
+bool Image::Map(std::string const& name, bool writable,
+    std::vector<int> const* requiredNumDimensions,
+    std::vector<std::string> const* requiredPixelTypes)
+{
+    CreateNullImage();
 
-    // Write the number of pixels.
-    if (output.write((char const*)&mNumPixels, sizeof(int)).bad())
+    std::ifstream input(name, std::ios::in | std::ios::binary);
+    if (!input)
     {
-        LogError("Failed write numPixels.");
-        output.close();
+        LogError("Failed to open file " + name + " for reading.");
         return false;
     }
 
-    // Write the pixels.
-    numBytes = mNumPixels*mPixelSize;
-    if (output.write(mRawPixels, numBytes).bad())
+    if (!LoadInfo(input, requiredNumDimensions, requiredPixelTypes))
     {
-        LogError("Failed write pixels.");
-        output.close();
+        input.close();
         return false;
     }
 
-    // Write the length of the image metadata string.
-    length = (int)mImageMetaData.length();
-    if (output.write((char const*)&length, sizeof(int)).bad())
-    {
-        LogError("Failed write length(image metadata).");
-        output.close();
-        return false;
-    }
+    // Skip the pixels, which are mapped rather than read.
+    size_t pixelOffset = (size_t)input.tellg();
+    size_t numBytes = (size_t)mNumPixels*(size_t)mPixelSize;
+    input.seekg(numBytes, std::ios::cur);
 
-    // Write the image metadata string.
-    numBytes = length + 1;
-    if (output.write(mImageMetaData.c_str(), numBytes).bad())
+    if (!LoadMetaData(input))
     {
-        LogError("Failed write image metadata.");
-        output.close();
+        input.close();
         return false;
     }
+    input.close();
 
-    // Write the existence flag for pixel metadata.
-    int existsPixelMetaData = (mPixelMetaData ? 1 : 0);
-    if (output.write((char const*)&existsPixelMetaData, sizeof(int)).bad())
+    if (!MapPixels(name, pixelOffset + numBytes, writable))
     {
-        LogError("Failed write pixel metadata existence.");
-        output.close();
+        LogError("Failed to map file " + name + ".");
+        CreateNullImage();
         return false;
     }
-
-    if (mPixelMetaData)
-    {
-        for (int i = 0; i < mNumPixels; ++i)
-        {
-            // Write the length of the pixel metadata string.
-            std::string const& metadata = mPixelMetaData[i];
-            length = (int)metadata.length();
-            if (output.write((char const*)&length, sizeof(int)).bad())
-            {
-                LogError("Failed write length(pixel metadata).");
-                output.close();
-                return false;
-            }
-
-            // Write the pixel metadata string.
-            numBytes = length + 1;
-            if (output.write(metadata.c_str(), numBytes).bad())
-            {
-                LogError("Failed write pixel metadata.");
-                output.close();
-                return false;
-            }
-        }
-    }
-
-    output.close();
+    mRawPixels = (char*)mMapView + pixelOffset;
+    mOwnerRawPixels = false;
     return true;
 }
 //----------------------------------------------------------------------------
@@ -625,7 +452,11 @@ void Image::CreateNullImage()
     delete[] mDimensions;
     delete[] mOffsets;
     delete[] mPixelMetaData;
-    if (mOwnerRawPixels)
+    if (mMapView)
+    {
+        UnmapPixels();
+    }
+    else if (mOwnerRawPixels)
     {
         delete[] mRawPixels;
     }
@@ -788,3 +619,396 @@ bool Image::Copy(Image const& image)
     return compatible;
 }
 //----------------------------------------------------------------------------
+bool Image::CreateMapped(std::string const& name, int numDimensions, ...)
+{
+    if (numDimensions <= 0)
+    {
+        LogError("Invalid number of dimensions.");
+        return false;
+    }
+
+    std::string savePixelType = mPixelType;
+    int savePixelSize = mPixelSize;
+    CreateNullImage();
+    mPixelType = savePixelType;
+    mPixelSize = savePixelSize;
+    mNumDimensions = numDimensions;
+    mDimensions = new int[mNumDimensions];
+    mOffsets = new int[mNumDimensions];
+
+    va_list arguments;
+    va_start(arguments, numDimensions);
+    bool created = true;
+    mNumPixels = 1;
+    int i;
+    for (i = 0; i < mNumDimensions; ++i)
+    {
+        mDimensions[i] = va_arg(arguments, int);
+        mNumPixels *= mDimensions[i];
+        created = created && (mDimensions[i] > 0);
+    }
+    va_end(arguments);
+
+    mOffsets[0] = 1;
+    for (i = 1; i < mNumDimensions; ++i)
+    {
+        mOffsets[i] = mDimensions[i - 1]*mOffsets[i - 1];
+    }
+
+    if (created)
+    {
+        std::ofstream output(name, std::ios::out | std::ios::binary);
+        if (output)
+        {
+            // Write the header, skip over the pixels, and write the (empty)
+            // metadata.  The skipped bytes of the file are zero.
+            created = SaveInfo(output);
+            if (created)
+            {
+                size_t numBytes = (size_t)mNumPixels*(size_t)mPixelSize;
+                output.seekp(numBytes, std::ios::cur);
+                created = SaveMetaData(output);
+            }
+            output.close();
+        }
+        else
+        {
+            LogError("Failed to open file " + name + " for writing.");
+            created = false;
+        }
+    }
+    else
+    {
+        LogError("The dimensions must be positive.");
+    }
+
+    if (created && Map(name, true, nullptr, nullptr))
+    {
+        return true;
+    }
+
+    CreateNullImage();
+    mPixelType = savePixelType;
+    mPixelSize = savePixelSize;
+    return false;
+}
+//----------------------------------------------------------------------------
+bool Image::LoadInfo(std::ifstream& input,
+    std::vector<int> const* requiredNumDimensions,
+    std::vector<std::string> const* requiredPixelTypes)
+{
+    if (!LoadHeader(input, mPixelType, mPixelSize, mNumDimensions))
+    {
+        return false;
+    }
+
+    if (requiredNumDimensions)
+    {
+        int const numElements = (int)requiredNumDimensions->size();
+        int i;
+        for (i = 0; i < numElements; ++i)
+        {
+            if (mNumDimensions == (*requiredNumDimensions)[i])
+            {
+                break;
+            }
+        }
+        if (i == numElements)
+        {
+            CreateNullImage();
+            return false;
+        }
+    }
+
+    if (requiredPixelTypes)
+    {
+        int const numElements = (int)requiredPixelTypes->size();
+        int i;
+        for (i = 0; i < numElements; ++i)
+        {
+            if (mPixelType == (*requiredPixelTypes)[i])
+            {
+                break;
+            }
+        }
+        if (i == numElements)
+        {
+            CreateNullImage();
+            return false;
+        }
+    }
+
+    // Read the dimensions.
+    mDimensions = new int[mNumDimensions];
+    if (input.read((char*)mDimensions, mNumDimensions*sizeof(int)).bad())
+    {
+        LogError("Failed read dimensions.");
+        CreateNullImage();
+        return false;
+    }
+
+    // Read the offsets.
+    mOffsets = new int[mNumDimensions];
+    if (input.read((char*)mOffsets, mNumDimensions*sizeof(int)).bad())
+    {
+        LogError("Failed read offsets.");
+        CreateNullImage();
+        return false;
+    }
+
+    // Read the number of pixels.
+    if (input.read((char*)&mNumPixels, sizeof(int)).bad())
+    {
+        LogError("Failed read number of pixels.");
+        CreateNullImage();
+        return false;
+    }
+
+    return true;
+}
+//----------------------------------------------------------------------------
+bool Image::LoadMetaData(std::ifstream& input)
+{
+    // Read the length of the image metadata string.
+    int length;
+    if (input.read((char*)&length, sizeof(int)).bad())
+    {
+        LogError("Failed read length(image metadata).");
+        CreateNullImage();
+        return false;
+    }
+
+    // Read the image metadata string.
+    int numBytes = length + 1;
+    char* temp = new char[numBytes];
+    if (input.read(temp, numBytes).bad() || temp[length] != 0)
+    {
+        LogError("Failed read image metadata.");
+        delete[] temp;
+        CreateNullImage();
+        return false;
+    }
+    mImageMetaData = std::string(temp);
+    delete[] temp;
+
+    // Read the existence flag for pixel metadata.
+    int existsPixelMetaData = 0;
+    if (input.read((char*)&existsPixelMetaData, sizeof(int)).bad())
+    {
+        LogError("Failed read pixel metadata existence.");
+        CreateNullImage();
+        return false;
+    }
+
+    if (existsPixelMetaData)
+    {
+        CreatePixelMetaData();
+
+        int maxNumBytes = 128;
+        temp = new char[maxNumBytes];
+        for (int i = 0; i < mNumPixels; ++i)
+        {
+            // Read the length of the pixel metadata string.
+            if (input.read((char*)&length, sizeof(int)).bad())
+            {
+                LogError("Failed read length.");
+                delete[] temp;
+                CreateNullImage();
+                return false;
+            }
+
+            // Resize the temporary storage if necessary.
+            numBytes = length + 1;
+            if (numBytes > maxNumBytes)
+            {
+                maxNumBytes = numBytes;
+                delete[] temp;
+                temp = new char[maxNumBytes];
+            }
+
+            // Read the pixel metadata string.
+            if (input.read(temp, numBytes).bad() || temp[length] != 0)
+            {
+                LogError("Failed read pixel metadata.");
+                delete[] temp;
+                CreateNullImage();
+                return false;
+            }
+            mPixelMetaData[i] = std::string(temp);
+        }
+    }
+
+    return true;
+}
+//----------------------------------------------------------------------------
+bool Image::SaveInfo(std::ofstream& output) const
+{
+    // Write the length of the pixel type.
+    int length = (int)mPixelType.length();
+    if (output.write((char const*)&length, sizeof(int)).bad())
+    {
+        LogError("Failed write length(pixelType).");
+        return false;
+    }
+
+    // Write the pixel type string.
+    int numBytes = length + 1;
+    if (output.write(mPixelType.c_str(), numBytes).bad())
+    {
+        LogError("Failed write pixelType.");
+        return false;
+    }
+
+    // Write the pixel size.
+    if (output.write((char const*)&mPixelSize, sizeof(int)).bad())
+    {
+        LogError("Failed write pixelSize.");
+        return false;
+    }
+
+    // Write the number of dimensions.
+    if (output.write((char const*)&mNumDimensions, sizeof(int)).bad())
+    {
+        LogError("Failed write numDimensions.");
+        return false;
+    }
+
+    // Write the dimensions.
+    numBytes = mNumDimensions*sizeof(int);
+    if (output.write((char const*)mDimensions, numBytes).bad())
+    {
+        LogError("Failed write dimensions.");
+        return false;
+    }
+
+    // Write the offsets.
+    if (output.write((char const*)mOffsets, numBytes).bad())
+    {
+        LogError("Failed write offsets.");
+        return false;
+    }
+
+    // Write the number of pixels.
+    if (output.write((char const*)&mNumPixels, sizeof(int)).bad())
+    {
+        LogError("Failed write numPixels.");
+        return false;
+    }
+
+    return true;
+}
+//----------------------------------------------------------------------------
+bool Image::SaveMetaData(std::ofstream& output) const
+{
+    // Write the length of the image metadata string.
+    int length = (int)mImageMetaData.length();
+    if (output.write((char const*)&length, sizeof(int)).bad())
+    {
+        LogError("Failed write length(image metadata).");
+        return false;
+    }
+
+    // Write the image metadata string.
+    int numBytes = length + 1;
+    if (output.write(mImageMetaData.c_str(), numBytes).bad())
+    {
+        LogError("Failed write image metadata.");
+        return false;
+    }
+
+    // Write the existence flag for pixel metadata.
+    int existsPixelMetaData = (mPixelMetaData ? 1 : 0);
+    if (output.write((char const*)&existsPixelMetaData, sizeof(int)).bad())
+    {
+        LogError("Failed write pixel metadata existence.");
+        return false;
+    }
+
+    if (mPixelMetaData)
+    {
+        for (int i = 0; i < mNumPixels; ++i)
+        {
+            // Write the length of the pixel metadata string.
+            std::string const& metadata = mPixelMetaData[i];
+            length = (int)metadata.length();
+            if (output.write((char const*)&length, sizeof(int)).bad())
+            {
+                LogError("Failed write length(pixel metadata).");
+                return false;
+            }
+
+            // Write the pixel metadata string.
+            numBytes = length + 1;
+            if (output.write(metadata.c_str(), numBytes).bad())
+            {
+                LogError("Failed write pixel metadata.");
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+//----------------------------------------------------------------------------
+bool Image::MapPixels(std::string const& name, size_t size, bool writable)
+{
+    // The handles are closed once the view exists; the view keeps the file
+    // mapping alive until it is unmapped.
+#if defined(WIN32)
+    DWORD access = (writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ);
+    HANDLE file = CreateFileA(name.c_str(), access, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    uint64_t size64 = (uint64_t)size;
+    HANDLE mapping = CreateFileMappingA(file, nullptr,
+        (writable ? PAGE_READWRITE : PAGE_WRITECOPY),
+        (DWORD)(size64 >> 32), (DWORD)(size64 & 0xFFFFFFFFull), nullptr);
+    CloseHandle(file);
+    if (!mapping)
+    {
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping,
+        (writable ? FILE_MAP_WRITE : FILE_MAP_COPY), 0, 0, size);
+    CloseHandle(mapping);
+    if (!view)
+    {
+        return false;
+    }
+#else
+    int file = open(name.c_str(), (writable ? O_RDWR : O_RDONLY));
+    if (file < 0)
+    {
+        return false;
+    }
+
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+        (writable ? MAP_SHARED : MAP_PRIVATE), file, 0);
+    close(file);
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+#endif
+
+    mMapView = view;
+    mMapSize = size;
+    return true;
+}
+//----------------------------------------------------------------------------
+void Image::UnmapPixels()
+{
+#if defined(WIN32)
+    UnmapViewOfFile(mMapView);
+#else
+    munmap(mMapView, mMapSize);
+#endif
+    mMapView = nullptr;
+    mMapSize = 0;
+}
+//----------------------------------------------------------------------------
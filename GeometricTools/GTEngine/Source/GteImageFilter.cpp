@@ -0,0 +1,574 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#include "GTEnginePCH.h"
+#include "GteImageFilter.h"
+#include "GteParallelFor.h"
+#include "GteIntelSSE.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+using namespace gte;
+
+// The networks are those of the 9-sample median of A. Paeth, "Median Finding
+// on a 3x3 Grid", Graphics Gems, and of the 25-sample median of N. Devillard,
+// "Fast median search: an ANSI C implementation".
+int const ImageFilter::msMedian9[19][2] =
+{
+    { 1, 2 }, { 4, 5 }, { 7, 8 }, { 0, 1 }, { 3, 4 }, { 6, 7 }, { 1, 2 },
+    { 4, 5 }, { 7, 8 }, { 0, 3 }, { 5, 8 }, { 4, 7 }, { 3, 6 }, { 1, 4 },
+    { 2, 5 }, { 4, 7 }, { 4, 2 }, { 6, 4 }, { 4, 2 }
+};
+
+int const ImageFilter::msMedian25[99][2] =
+{
+    { 0, 1 }, { 3, 4 }, { 2, 4 }, { 2, 3 }, { 6, 7 }, { 5, 7 }, { 5, 6 },
+    { 9, 10 }, { 8, 10 }, { 8, 9 }, { 12, 13 }, { 11, 13 }, { 11, 12 },
+    { 15, 16 }, { 14, 16 }, { 14, 15 }, { 18, 19 }, { 17, 19 }, { 17, 18 },
+    { 21, 22 }, { 20, 22 }, { 20, 21 }, { 23, 24 }, { 2, 5 }, { 3, 6 },
+    { 0, 6 }, { 0, 3 }, { 4, 7 }, { 1, 7 }, { 1, 4 }, { 11, 14 }, { 8, 14 },
+    { 8, 11 }, { 12, 15 }, { 9, 15 }, { 9, 12 }, { 13, 16 }, { 10, 16 },
+    { 10, 13 }, { 20, 23 }, { 17, 23 }, { 17, 20 }, { 21, 24 }, { 18, 24 },
+    { 18, 21 }, { 19, 22 }, { 8, 17 }, { 9, 18 }, { 0, 18 }, { 0, 9 },
+    { 10, 19 }, { 1, 19 }, { 1, 10 }, { 11, 20 }, { 2, 20 }, { 2, 11 },
+    { 12, 21 }, { 3, 21 }, { 3, 12 }, { 13, 22 }, { 4, 22 }, { 4, 13 },
+    { 14, 23 }, { 5, 23 }, { 5, 14 }, { 15, 24 }, { 6, 24 }, { 6, 15 },
+    { 7, 16 }, { 7, 19 }, { 13, 21 }, { 15, 23 }, { 7, 13 }, { 7, 15 },
+    { 1, 9 }, { 3, 11 }, { 5, 17 }, { 11, 17 }, { 9, 17 }, { 4, 10 },
+    { 6, 12 }, { 7, 14 }, { 4, 6 }, { 4, 7 }, { 12, 14 }, { 10, 14 },
+    { 6, 7 }, { 10, 12 }, { 6, 10 }, { 6, 17 }, { 12, 17 }, { 7, 17 },
+    { 7, 10 }, { 12, 18 }, { 7, 12 }, { 10, 18 }, { 12, 20 }, { 10, 20 },
+    { 10, 12 }
+};
+
+//----------------------------------------------------------------------------
+void ImageFilter::Median(Image2<float> const& input, int radius,
+    Image2<float>& output, unsigned int numThreads)
+{
+    int const dim0 = input.GetDimension(0);
+    int const dim1 = input.GetDimension(1);
+    output.Resize(dim0, dim1);
+    if (radius <= 0)
+    {
+        std::copy(input.GetPixels1D(), input.GetPixels1D() +
+            input.GetNumPixels(), output.GetPixels1D());
+        return;
+    }
+
+    int const size = 2*radius + 1;
+    int const numSamples = size*size;
+    int const rowLength = dim0 + 2*radius;
+    float const* inPixels = input.GetPixels1D();
+    float* outPixels = output.GetPixels1D();
+
+    ParallelFor::Execute(dim1, numThreads, [&](int ymin, int ymax)
+    {
+        // Row dy of the buffer is the input row y+dy-radius with 'radius'
+        // zeros on each side, so the sample (x+dx-radius,y+dy-radius) is
+        // padded[x + dx + rowLength*dy].
+        std::vector<float> padded((size_t)size*rowLength, 0.0f);
+        std::vector<float> samples((size_t)numSamples*BLOCK_SIZE, 0.0f);
+        for (int y = ymin; y < ymax; ++y)
+        {
+            for (int dy = 0; dy < size; ++dy)
+            {
+                float* target = &padded[(size_t)rowLength*dy + radius];
+                int const ys = y + dy - radius;
+                if (0 <= ys && ys < dim1)
+                {
+                    std::copy(inPixels + (size_t)dim0*ys,
+                        inPixels + (size_t)dim0*(ys + 1), target);
+                }
+                else
+                {
+                    std::fill(target, target + dim0, 0.0f);
+                }
+            }
+
+            float* outRow = outPixels + (size_t)dim0*y;
+            if (radius <= 2)
+            {
+                int const numPairs = (radius == 1 ? 19 : 99);
+                int const (*pairs)[2] = (radius == 1 ? msMedian9 :
+                    msMedian25);
+                float const* median =
+                    &samples[(size_t)BLOCK_SIZE*(numSamples/2)];
+                for (int x0 = 0; x0 < dim0; x0 += BLOCK_SIZE)
+                {
+                    int const numLanes = std::min(dim0 - x0,
+                        (int)BLOCK_SIZE);
+                    for (int dy = 0, k = 0; dy < size; ++dy)
+                    {
+                        for (int dx = 0; dx < size; ++dx, ++k)
+                        {
+                            float const* source =
+                                &padded[x0 + dx + (size_t)rowLength*dy];
+                            std::copy(source, source + numLanes,
+                                &samples[(size_t)BLOCK_SIZE*k]);
+                        }
+                    }
+
+                    SelectMedian(numPairs, pairs, &samples[0]);
+                    std::copy(median, median + numLanes, outRow + x0);
+                }
+            }
+            else
+            {
+                for (int x = 0; x < dim0; ++x)
+                {
+                    for (int dy = 0, k = 0; dy < size; ++dy)
+                    {
+                        float const* source =
+                            &padded[x + (size_t)rowLength*dy];
+                        for (int dx = 0; dx < size; ++dx, ++k)
+                        {
+                            samples[k] = source[dx];
+                        }
+                    }
+
+                    auto median = samples.begin() + numSamples/2;
+                    std::nth_element(samples.begin(), median,
+                        samples.begin() + numSamples);
+                    outRow[x] = *median;
+                }
+            }
+        }
+    });
+}
+//----------------------------------------------------------------------------
+void ImageFilter::MedianByHistogram(Image2<float> const& input, int radius,
+    int numLevels, Image2<float>& output, unsigned int numThreads)
+{
+    int const dim0 = input.GetDimension(0);
+    int const dim1 = input.GetDimension(1);
+    int const numPixels = input.GetNumPixels();
+    output.Resize(dim0, dim1);
+    if (numLevels < 2)
+    {
+        LogError("The number of levels must be at least 2.");
+        return;
+    }
+    if (radius <= 0)
+    {
+        std::copy(input.GetPixels1D(), input.GetPixels1D() + numPixels,
+            output.GetPixels1D());
+        return;
+    }
+
+    // Quantize the pixels.  The range includes 0, the value of the pixels
+    // outside the image.
+    float const* inPixels = input.GetPixels1D();
+    float vmin = 0.0f, vmax = 0.0f;
+    for (int i = 0; i < numPixels; ++i)
+    {
+        vmin = std::min(vmin, inPixels[i]);
+        vmax = std::max(vmax, inPixels[i]);
+    }
+    if (vmin == vmax)
+    {
+        output.SetAllPixels(vmin);
+        return;
+    }
+
+    float const scale = (float)(numLevels - 1)/(vmax - vmin);
+    float const spacing = (vmax - vmin)/(float)(numLevels - 1);
+    auto Quantize = [vmin, scale, numLevels](float value)
+    {
+        int level = (int)((value - vmin)*scale + 0.5f);
+        return std::min(std::max(level, 0), numLevels - 1);
+    };
+
+    std::vector<int> levels(numPixels);
+    ParallelFor::Execute(dim1, numThreads, [&](int ymin, int ymax)
+    {
+        for (int i = dim0*ymin; i < dim0*ymax; ++i)
+        {
+            levels[i] = Quantize(inPixels[i]);
+        }
+    });
+    int const zeroLevel = Quantize(0.0f);
+
+    int const size = 2*radius + 1;
+    int const half = (size*size)/2;
+    int const numColumns = dim0 + 2*radius;
+    float* outPixels = output.GetPixels1D();
+
+    ParallelFor::Execute(dim1, numThreads, [&](int ymin, int ymax)
+    {
+        // Column c is the image column x = c - radius and has the histogram
+        // of the window rows at columns[c*numLevels].  The columns outside
+        // the image contain only zeros.
+        std::vector<int> columns((size_t)numColumns*numLevels, 0);
+        for (int c = 0; c < numColumns; ++c)
+        {
+            columns[(size_t)c*numLevels + zeroLevel] = size;
+        }
+
+        // Insert (delta = +1) or remove (delta = -1) row ys in the column
+        // histograms.
+        auto UpdateColumns = [&](int ys, int delta)
+        {
+            int* histogram = &columns[(size_t)radius*numLevels];
+            if (0 <= ys && ys < dim1)
+            {
+                int const* row = &levels[(size_t)dim0*ys];
+                for (int x = 0; x < dim0; ++x, histogram += numLevels)
+                {
+                    histogram[row[x]] += delta;
+                    histogram[zeroLevel] -= delta;
+                }
+            }
+        };
+
+        // The column histograms store the rows [ymin-radius-1,ymin+radius-1]
+        // before the first row is processed.
+        for (int ys = ymin - radius - 1; ys < ymin + radius; ++ys)
+        {
+            UpdateColumns(ys, +1);
+        }
+
+        std::vector<int> kernel(numLevels);
+        for (int y = ymin; y < ymax; ++y)
+        {
+            UpdateColumns(y - radius - 1, -1);
+            UpdateColumns(y + radius, +1);
+
+            std::fill(kernel.begin(), kernel.end(), 0);
+            for (int c = 0; c < size; ++c)
+            {
+                int const* histogram = &columns[(size_t)c*numLevels];
+                for (int j = 0; j < numLevels; ++j)
+                {
+                    kernel[j] += histogram[j];
+                }
+            }
+
+            float* outRow = outPixels + (size_t)dim0*y;
+            for (int x = 0; x < dim0; ++x)
+            {
+                if (x > 0)
+                {
+                    int const* add =
+                        &columns[(size_t)(x + 2*radius)*numLevels];
+                    int const* sub = &columns[(size_t)(x - 1)*numLevels];
+                    for (int j = 0; j < numLevels; ++j)
+                    {
+                        kernel[j] += add[j] - sub[j];
+                    }
+                }
+
+                int level = 0;
+                for (int count = kernel[0]; count <= half; )
+                {
+                    count += kernel[++level];
+                }
+                outRow[x] = vmin + spacing*(float)level;
+            }
+        }
+    });
+}
+//----------------------------------------------------------------------------
+void ImageFilter::Median(Image3<float> const& input, int radius,
+    Image3<float>& output, unsigned int numThreads)
+{
+    int const dim0 = input.GetDimension(0);
+    int const dim1 = input.GetDimension(1);
+    int const dim2 = input.GetDimension(2);
+    output.Resize(dim0, dim1, dim2);
+    if (radius <= 0)
+    {
+        std::copy(input.GetPixels1D(), input.GetPixels1D() +
+            input.GetNumPixels(), output.GetPixels1D());
+        return;
+    }
+
+    int const size = 2*radius + 1;
+    int const numSamples = size*size*size;
+    float const* inPixels = input.GetPixels1D();
+    float* outPixels = output.GetPixels1D();
+
+    ParallelFor::Execute(dim1*dim2, numThreads, [&](int rmin, int rmax)
+    {
+        std::vector<float> samples(numSamples);
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const y = r % dim1, z = r / dim1;
+            float* outRow = outPixels + (size_t)dim0*r;
+            for (int x = 0; x < dim0; ++x)
+            {
+                int k = 0;
+                for (int zs = z - radius; zs <= z + radius; ++zs)
+                {
+                    for (int ys = y - radius; ys <= y + radius; ++ys)
+                    {
+                        if (0 <= ys && ys < dim1 && 0 <= zs && zs < dim2)
+                        {
+                            float const* row = inPixels +
+                                (size_t)dim0*(ys + (size_t)dim1*zs);
+                            for (int xs = x - radius; xs <= x + radius; ++xs)
+                            {
+                                samples[k++] =
+                                    (0 <= xs && xs < dim0 ? row[xs] : 0.0f);
+                            }
+                        }
+                        else
+                        {
+                            for (int dx = 0; dx < size; ++dx)
+                            {
+                                samples[k++] = 0.0f;
+                            }
+                        }
+                    }
+                }
+
+                auto median = samples.begin() + numSamples/2;
+                std::nth_element(samples.begin(), median, samples.end());
+                outRow[x] = *median;
+            }
+        }
+    });
+}
+//----------------------------------------------------------------------------
+void ImageFilter::Convolve(Image2<float> const& input, int radius,
+    float const* weights, Image2<float>& output, unsigned int numThreads)
+{
+    int const dim0 = input.GetDimension(0);
+    int const dim1 = input.GetDimension(1);
+    output.Resize(dim0, dim1);
+
+    int const size = 2*radius + 1;
+    float const* inPixels = input.GetPixels1D();
+    float* outPixels = output.GetPixels1D();
+
+    ParallelFor::Execute(dim1, numThreads, [&](int ymin, int ymax)
+    {
+        // The input row with 'radius' zeros on each side.
+        std::vector<float> padded(dim0 + 2*radius, 0.0f);
+        for (int y = ymin; y < ymax; ++y)
+        {
+            float* outRow = outPixels + (size_t)dim0*y;
+            std::fill(outRow, outRow + dim0, 0.0f);
+            for (int dy = -radius; dy <= radius; ++dy)
+            {
+                int const ys = y + dy;
+                if (ys < 0 || ys >= dim1)
+                {
+                    continue;
+                }
+
+                float const* inRow = inPixels + (size_t)dim0*ys;
+                std::copy(inRow, inRow + dim0, &padded[radius]);
+                float const* w = weights + (size_t)size*(dy + radius);
+                for (int dx = 0; dx < size; ++dx)
+                {
+                    float const weight = w[dx];
+                    float const* source = &padded[dx];
+                    MultiplyAdd(dim0, weight, source, outRow);
+                }
+            }
+        }
+    });
+}
+//----------------------------------------------------------------------------
+void ImageFilter::Convolve(Image3<float> const& input, int radius,
+    float const* weights, Image3<float>& output, unsigned int numThreads)
+{
+    int const dim0 = input.GetDimension(0);
+    int const dim1 = input.GetDimension(1);
+    int const dim2 = input.GetDimension(2);
+    output.Resize(dim0, dim1, dim2);
+
+    int const size = 2*radius + 1;
+    float const* inPixels = input.GetPixels1D();
+    float* outPixels = output.GetPixels1D();
+
+    ParallelFor::Execute(dim1*dim2, numThreads, [&](int rmin, int rmax)
+    {
+        std::vector<float> padded(dim0 + 2*radius, 0.0f);
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const y = r % dim1, z = r / dim1;
+            float* outRow = outPixels + (size_t)dim0*r;
+            std::fill(outRow, outRow + dim0, 0.0f);
+            for (int dz = -radius; dz <= radius; ++dz)
+            {
+                for (int dy = -radius; dy <= radius; ++dy)
+                {
+                    int const ys = y + dy, zs = z + dz;
+                    if (ys < 0 || ys >= dim1 || zs < 0 || zs >= dim2)
+                    {
+                        continue;
+                    }
+
+                    float const* inRow = inPixels +
+                        (size_t)dim0*(ys + (size_t)dim1*zs);
+                    std::copy(inRow, inRow + dim0, &padded[radius]);
+                    float const* w = weights +
+                        (size_t)size*((dy + radius) + size*(dz + radius));
+                    for (int dx = 0; dx < size; ++dx)
+                    {
+                        float const weight = w[dx];
+                        float const* source = &padded[dx];
+                        MultiplyAdd(dim0, weight, source, outRow);
+                    }
+                }
+            }
+        }
+    });
+}
+//----------------------------------------------------------------------------
+void ImageFilter::ConvolveSeparable(Image2<float> const& input, int radius,
+    float const* weights, Image2<float>& output, unsigned int numThreads)
+{
+    int const dim0 = input.GetDimension(0);
+    int const dim1 = input.GetDimension(1);
+    output.Resize(dim0, dim1);
+
+    std::vector<float> temp(input.GetNumPixels());
+    if (temp.size() > 0)
+    {
+        ConvolveRows(dim0, dim1, radius, weights, input.GetPixels1D(),
+            &temp[0], numThreads);
+        ConvolveStrided(dim0, dim1, 1, radius, weights, &temp[0],
+            output.GetPixels1D(), numThreads);
+    }
+}
+//----------------------------------------------------------------------------
+void ImageFilter::ConvolveSeparable(Image3<float> const& input, int radius,
+    float const* weights, Image3<float>& output, unsigned int numThreads)
+{
+    int const dim0 = input.GetDimension(0);
+    int const dim1 = input.GetDimension(1);
+    int const dim2 = input.GetDimension(2);
+    output.Resize(dim0, dim1, dim2);
+
+    std::vector<float> temp(input.GetNumPixels());
+    if (temp.size() > 0)
+    {
+        float* outPixels = output.GetPixels1D();
+        ConvolveRows(dim0, dim1*dim2, radius, weights, input.GetPixels1D(),
+            outPixels, numThreads);
+        ConvolveStrided(dim0, dim1, dim2, radius, weights, outPixels,
+            &temp[0], numThreads);
+        ConvolveStrided(dim0*dim1, dim2, 1, radius, weights, &temp[0],
+            outPixels, numThreads);
+    }
+}
+//----------------------------------------------------------------------------
+void ImageFilter::GetGaussianWeights(int radius, float* weights)
+{
+    if (radius <= 0)
+    {
+        weights[0] = 1.0f;
+        return;
+    }
+
+    // If radius/sigma = ratio, then exp(-ratio^2/2) = 0.001.
+    float const ratio = 3.7169221888498384469524067613045f;
+    float const sigma = radius/ratio;
+
+    float totalWeight = 0.0f;
+    for (int x = -radius, i = 0; x <= radius; ++x, ++i)
+    {
+        float fx = x/sigma;
+        weights[i] = exp(-0.5f*fx*fx);
+        totalWeight += weights[i];
+    }
+
+    for (int i = 0; i <= 2*radius; ++i)
+    {
+        weights[i] /= totalWeight;
+    }
+}
+//----------------------------------------------------------------------------
+void ImageFilter::SelectMedian(int numPairs, int const pairs[][2],
+    float* samples)
+{
+    for (int p = 0; p < numPairs; ++p)
+    {
+        float* s0 = samples + BLOCK_SIZE*pairs[p][0];
+        float* s1 = samples + BLOCK_SIZE*pairs[p][1];
+        for (int i = 0; i < BLOCK_SIZE; i += 4)
+        {
+            __m128 const v0 = _mm_loadu_ps(s0 + i);
+            __m128 const v1 = _mm_loadu_ps(s1 + i);
+            _mm_storeu_ps(s0 + i, _mm_min_ps(v0, v1));
+            _mm_storeu_ps(s1 + i, _mm_max_ps(v0, v1));
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void ImageFilter::MultiplyAdd(int numValues, float weight,
+    float const* source, float* target)
+{
+    __m128 const w = _mm_set1_ps(weight);
+    int const numQuads = (numValues & ~3);
+    int i;
+    for (i = 0; i < numQuads; i += 4)
+    {
+        __m128 const product = SIMD::Multiply(w, _mm_loadu_ps(source + i));
+        _mm_storeu_ps(target + i, SIMD::Add(_mm_loadu_ps(target + i),
+            product));
+    }
+    for (; i < numValues; ++i)
+    {
+        target[i] += weight*source[i];
+    }
+}
+//----------------------------------------------------------------------------
+void ImageFilter::ConvolveRows(int length, int numRows, int radius,
+    float const* weights, float const* source, float* target,
+    unsigned int numThreads)
+{
+    int const size = 2*radius + 1;
+    ParallelFor::Execute(numRows, numThreads, [&](int rmin, int rmax)
+    {
+        std::vector<float> padded(length + 2*radius, 0.0f);
+        for (int r = rmin; r < rmax; ++r)
+        {
+            float const* inRow = source + (size_t)length*r;
+            float* outRow = target + (size_t)length*r;
+            std::copy(inRow, inRow + length, &padded[radius]);
+            std::fill(outRow, outRow + length, 0.0f);
+            for (int dx = 0; dx < size; ++dx)
+            {
+                float const weight = weights[dx];
+                float const* samples = &padded[dx];
+                MultiplyAdd(length, weight, samples, outRow);
+            }
+        }
+    });
+}
+//----------------------------------------------------------------------------
+void ImageFilter::ConvolveStrided(int stride, int numSamples, int numOuter,
+    int radius, float const* weights, float const* source, float* target,
+    unsigned int numThreads)
+{
+    // Each output row of 'stride' floats is a weighted sum of the rows at
+    // the neighboring samples.
+    int const numRows = numSamples*numOuter;
+    ParallelFor::Execute(numRows, numThreads, [&](int rmin, int rmax)
+    {
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const s = r % numSamples;
+            float const* block = source +
+                (size_t)stride*numSamples*(r / numSamples);
+            float* outRow = target + (size_t)stride*r;
+            std::fill(outRow, outRow + stride, 0.0f);
+            int const dmin = std::max(-radius, -s);
+            int const dmax = std::min(radius, numSamples - 1 - s);
+            for (int d = dmin; d <= dmax; ++d)
+            {
+                float const weight = weights[d + radius];
+                float const* inRow = block + (size_t)stride*(s + d);
+                MultiplyAdd(stride, weight, inRow, outRow);
+            }
+        }
+    });
+}
+//----------------------------------------------------------------------------
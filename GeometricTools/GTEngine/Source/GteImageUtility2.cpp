@@ -11,7 +11,7 @@ using namespace gte;
 
 //----------------------------------------------------------------------------
 void ImageUtility2::GetComponents8(Image2<int>& image,
-    std::vector<std::vector<int> >& components)
+    std::vector<std::vector<int> >& components, unsigned int numThreads)
 {
     // Incremental 1D offsets for 8-connected neighbors.  Store +1 and -1
     // first to be cache friendly during the depth-first search (i.e. search
@@ -22,11 +22,11 @@ void ImageUtility2::GetComponents8(Image2<int>& image,
         1, -1, -1 - dim0, -dim0, 1 - dim0, -1 + dim0, dim0, 1 + dim0
     };
 
-    GetComponents(8, delta, image, components);
+    GetComponents(8, delta, image, components, numThreads);
 }
 //----------------------------------------------------------------------------
 void ImageUtility2::GetComponents4(Image2<int>& image,
-    std::vector<std::vector<int> >& components)
+    std::vector<std::vector<int> >& components, unsigned int numThreads)
 {
     // Incremental 1D offsets for 4-connected neighbors.  Store +1 and -1
     // first to be cache friendly during the depth-first search (i.e. search
@@ -37,7 +37,7 @@ void ImageUtility2::GetComponents4(Image2<int>& image,
         +1, -1, -dim0, +dim0
     };
 
-    GetComponents(4, delta, image, components);
+    GetComponents(4, delta, image, components, numThreads);
 }
 //----------------------------------------------------------------------------
 void ImageUtility2::Dilate4(Image2<int> const& input, Image2<int>& output)
@@ -64,7 +64,7 @@ void ImageUtility2::Dilate8(Image2<int> const& input, Image2<int>& output)
         std::make_pair(+1,  0),
         std::make_pair(-1, +1),
         std::make_pair( 0, +1),
-        std::make_pair(-1, +1)
+        std::make_pair(+1, +1)
     };
 
     Dilate(input, 8, neighbors, output);
@@ -230,6 +230,162 @@ void ImageUtility2::Close(Image2<int> const& input, bool zeroExterior,
     Erode(temp, zeroExterior, numNeighbors, neighbors, output);
 }
 //----------------------------------------------------------------------------
+void ImageUtility2::Dilate4(BinaryImage2 const& input, BinaryImage2& output,
+    unsigned int numThreads)
+{
+    std::pair<int,int> const neighbors[4] =
+    {
+        std::make_pair( 0, -1),
+        std::make_pair(-1,  0),
+        std::make_pair(+1,  0),
+        std::make_pair( 0, +1)
+    };
+
+    Dilate(input, 4, neighbors, output, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Dilate8(BinaryImage2 const& input, BinaryImage2& output,
+    unsigned int numThreads)
+{
+    std::pair<int,int> const neighbors[8] =
+    {
+        std::make_pair(-1, -1),
+        std::make_pair( 0, -1),
+        std::make_pair(+1, -1),
+        std::make_pair(-1,  0),
+        std::make_pair(+1,  0),
+        std::make_pair(-1, +1),
+        std::make_pair( 0, +1),
+        std::make_pair(+1, +1)
+    };
+
+    Dilate(input, 8, neighbors, output, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Dilate(BinaryImage2 const& input, int numNeighbors,
+    std::pair<int,int> const neighbors[], BinaryImage2& output,
+    unsigned int numThreads)
+{
+    LogAssert(&output != &input, "Input and output must be different.");
+
+    int const dimensions[3] = { input.GetDimension(0),
+        input.GetDimension(1), 1 };
+    output.Resize(dimensions[0], dimensions[1]);
+
+    std::vector<std::array<int, 3> > offsets(numNeighbors);
+    for (int j = 0; j < numNeighbors; ++j)
+    {
+        offsets[j] = { { neighbors[j].first, neighbors[j].second, 0 } };
+    }
+
+    BinaryMorphology::Dilate(dimensions, input.GetWordsPerRow(),
+        numNeighbors, offsets.data(), input.GetWords(), output.GetWords(),
+        numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Erode4(BinaryImage2 const& input, bool zeroExterior,
+    BinaryImage2& output, unsigned int numThreads)
+{
+    std::pair<int,int> const neighbors[4] =
+    {
+        std::make_pair( 0, -1),
+        std::make_pair(-1,  0),
+        std::make_pair(+1,  0),
+        std::make_pair( 0, +1)
+    };
+
+    Erode(input, zeroExterior, 4, neighbors, output, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Erode8(BinaryImage2 const& input, bool zeroExterior,
+    BinaryImage2& output, unsigned int numThreads)
+{
+    std::pair<int,int> const neighbors[8] =
+    {
+        std::make_pair(-1, -1),
+        std::make_pair( 0, -1),
+        std::make_pair(+1, -1),
+        std::make_pair(-1,  0),
+        std::make_pair(+1,  0),
+        std::make_pair(-1, +1),
+        std::make_pair( 0, +1),
+        std::make_pair(+1, +1)
+    };
+
+    Erode(input, zeroExterior, 8, neighbors, output, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Erode(BinaryImage2 const& input, bool zeroExterior,
+    int numNeighbors, std::pair<int,int> const neighbors[],
+    BinaryImage2& output, unsigned int numThreads)
+{
+    LogAssert(&output != &input, "Input and output must be different.");
+
+    int const dimensions[3] = { input.GetDimension(0),
+        input.GetDimension(1), 1 };
+    output.Resize(dimensions[0], dimensions[1]);
+
+    std::vector<std::array<int, 3> > offsets(numNeighbors);
+    for (int j = 0; j < numNeighbors; ++j)
+    {
+        offsets[j] = { { neighbors[j].first, neighbors[j].second, 0 } };
+    }
+
+    BinaryMorphology::Erode(dimensions, input.GetWordsPerRow(), zeroExterior,
+        numNeighbors, offsets.data(), input.GetWords(), output.GetWords(),
+        numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Open4(BinaryImage2 const& input, bool zeroExterior,
+    BinaryImage2& output, unsigned int numThreads)
+{
+    BinaryImage2 temp;
+    Erode4(input, zeroExterior, temp, numThreads);
+    Dilate4(temp, output, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Open8(BinaryImage2 const& input, bool zeroExterior,
+    BinaryImage2& output, unsigned int numThreads)
+{
+    BinaryImage2 temp;
+    Erode8(input, zeroExterior, temp, numThreads);
+    Dilate8(temp, output, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Open(BinaryImage2 const& input, bool zeroExterior,
+    int numNeighbors, std::pair<int,int> const neighbors[],
+    BinaryImage2& output, unsigned int numThreads)
+{
+    BinaryImage2 temp;
+    Erode(input, zeroExterior, numNeighbors, neighbors, temp, numThreads);
+    Dilate(temp, numNeighbors, neighbors, output, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Close4(BinaryImage2 const& input, bool zeroExterior,
+    BinaryImage2& output, unsigned int numThreads)
+{
+    BinaryImage2 temp;
+    Dilate4(input, temp, numThreads);
+    Erode4(temp, zeroExterior, output, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Close8(BinaryImage2 const& input, bool zeroExterior,
+    BinaryImage2& output, unsigned int numThreads)
+{
+    BinaryImage2 temp;
+    Dilate8(input, temp, numThreads);
+    Erode8(temp, zeroExterior, output, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::Close(BinaryImage2 const& input, bool zeroExterior,
+    int numNeighbors, std::pair<int,int> const neighbors[],
+    BinaryImage2& output, unsigned int numThreads)
+{
+    BinaryImage2 temp;
+    Dilate(input, numNeighbors, neighbors, temp, numThreads);
+    Erode(temp, zeroExterior, numNeighbors, neighbors, output, numThreads);
+}
+//----------------------------------------------------------------------------
 bool ImageUtility2::ExtractBoundary(int x, int y, Image2<int>& image,
     std::vector<int>& boundary)
 {
@@ -601,6 +757,22 @@ void ImageUtility2::GetL2Distance(Image2<int> const& image,
     }
 }
 //----------------------------------------------------------------------------
+void ImageUtility2::GetExactL2Distance(Image2<int> const& image,
+    float& maxDistance, int& xMax, int& yMax, Image2<float>& transform,
+    unsigned int numThreads)
+{
+    GetExactL2Distance(image, maxDistance, xMax, yMax, transform, nullptr,
+        numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility2::GetExactL2Distance(Image2<int> const& image,
+    float& maxDistance, int& xMax, int& yMax, Image2<float>& transform,
+    Image2<int>& nearest, unsigned int numThreads)
+{
+    GetExactL2Distance(image, maxDistance, xMax, yMax, transform, &nearest,
+        numThreads);
+}
+//----------------------------------------------------------------------------
 void ImageUtility2::GetSkeleton(Image2<int>& image)
 {
     int const dim0 = image.GetDimension(0);
@@ -902,8 +1074,27 @@ void ImageUtility2::DrawRectangle(int xMin, int yMin, int xMax,
 }
 //----------------------------------------------------------------------------
 void ImageUtility2::GetComponents(int numNeighbors, int const delta[],
-    Image2<int>& image, std::vector<std::vector<int> >& components)
+    Image2<int>& image, std::vector<std::vector<int> >& components,
+    unsigned int numThreads)
 {
+    if (numThreads > 1)
+    {
+        // Union-find labeling of slabs of rows on multiple threads.  Only the
+        // neighbors that precede a pixel are needed.
+        int backward[8], numBackward = 0;
+        for (int j = 0; j < numNeighbors; ++j)
+        {
+            if (delta[j] < 0)
+            {
+                backward[numBackward++] = delta[j];
+            }
+        }
+        UnionFindLabeler::Execute(image.GetDimension(0),
+            image.GetDimension(1), numBackward, backward, numThreads,
+            image.GetPixels1D(), components);
+        return;
+    }
+
     int const numPixels = image.GetNumPixels();
     int* numElements = new int[numPixels];
     int* vstack = new int[numPixels];
@@ -970,6 +1161,32 @@ void ImageUtility2::GetComponents(int numNeighbors, int const delta[],
     delete[] numElements;
 }
 //----------------------------------------------------------------------------
+void ImageUtility2::GetExactL2Distance(Image2<int> const& image,
+    float& maxDistance, int& xMax, int& yMax, Image2<float>& transform,
+    Image2<int>* nearest, unsigned int numThreads)
+{
+    int const dimensions[2] = { image.GetDimension(0),
+        image.GetDimension(1) };
+    transform.Resize(dimensions[0], dimensions[1]);
+    if (nearest)
+    {
+        nearest->Resize(dimensions[0], dimensions[1]);
+    }
+
+    // The squared distances are computed in the storage of 'transform' and
+    // then replaced by the distances.
+    int const numPixels = image.GetNumPixels();
+    float* distance = transform.GetPixels1D();
+    EuclideanDistanceTransform::Execute(2, dimensions, numThreads,
+        image.GetPixels1D(), distance,
+        (nearest ? nearest->GetPixels1D() : nullptr));
+
+    int maxIndex;
+    EuclideanDistanceTransform::GetDistances(numPixels, numThreads, distance,
+        maxDistance, maxIndex);
+    image.GetCoordinates(maxIndex, xMax, yMax);
+}
+//----------------------------------------------------------------------------
 void ImageUtility2::L2Check(int x, int y, int dx, int dy, Image2<int>& xNear,
     Image2<int>& yNear, Image2<int>& dist)
 {
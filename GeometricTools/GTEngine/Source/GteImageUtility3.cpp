@@ -9,84 +9,84 @@
 #include "GteImageUtility3.h"
 using namespace gte;
 
+std::array<int, 3> const ImageUtility3::msNeighbors26[26] =
+{
+    { -1, -1, -1 },
+    { 0, -1, -1 },
+    { +1, -1, -1 },
+    { -1, 0, -1 },
+    { 0, 0, -1 },
+    { +1, 0, -1 },
+    { -1, +1, -1 },
+    { 0, +1, -1 },
+    { +1, +1, -1 },
+    { -1, -1, 0 },
+    { 0, -1, 0 },
+    { +1, -1, 0 },
+    { -1, 0, 0 },
+    { +1, 0, 0 },
+    { -1, +1, 0 },
+    { 0, +1, 0 },
+    { +1, +1, 0 },
+    { -1, -1, +1 },
+    { 0, -1, +1 },
+    { +1, -1, +1 },
+    { -1, 0, +1 },
+    { 0, 0, +1 },
+    { +1, 0, +1 },
+    { -1, +1, +1 },
+    { 0, +1, +1 },
+    { +1, +1, +1 }
+};
+
+std::array<int, 3> const ImageUtility3::msNeighbors18[18] =
+{
+    { 0, -1, -1 },
+    { -1, 0, -1 },
+    { 0, 0, -1 },
+    { +1, 0, -1 },
+    { 0, +1, -1 },
+    { -1, -1, 0 },
+    { 0, -1, 0 },
+    { +1, -1, 0 },
+    { -1, 0, 0 },
+    { +1, 0, 0 },
+    { -1, +1, 0 },
+    { 0, +1, 0 },
+    { +1, +1, 0 },
+    { 0, -1, +1 },
+    { -1, 0, +1 },
+    { 0, 0, +1 },
+    { +1, 0, +1 },
+    { 0, +1, +1 }
+};
+
+std::array<int, 3> const ImageUtility3::msNeighbors6[6] =
+{
+    { -1, 0, 0 },
+    { +1, 0, 0 },
+    { 0, -1, 0 },
+    { 0, +1, 0 },
+    { 0, 0, -1 },
+    { 0, 0, +1 }
+};
+
 //----------------------------------------------------------------------------
 void ImageUtility3::Dilate26(Image3<int> const& inImage,
     Image3<int>& outImage)
 {
-    std::array<int, 3> delta[26] =
-    {
-        { -1, -1, -1 },
-        { 0, -1, -1 },
-        { +1, -1, -1 },
-        { -1, 0, -1 },
-        { 0, 0, -1 },
-        { +1, 0, -1 },
-        { -1, +1, -1 },
-        { 0, +1, -1 },
-        { +1, +1, -1 },
-        { -1, -1, 0 },
-        { 0, -1, 0 },
-        { +1, -1, 0 },
-        { -1, 0, 0 },
-        { +1, 0, 0 },
-        { -1, +1, 0 },
-        { 0, +1, 0 },
-        { +1, +1, 0 },
-        { -1, -1, +1 },
-        { 0, -1, +1 },
-        { +1, -1, +1 },
-        { -1, 0, +1 },
-        { 0, 0, +1 },
-        { +1, 0, +1 },
-        { -1, +1, +1 },
-        { 0, +1, +1 },
-        { +1, +1, +1 }
-    };
-
-    Dilate(26, delta, inImage, outImage);
+    Dilate(26, msNeighbors26, inImage, outImage);
 }
 //----------------------------------------------------------------------------
 void ImageUtility3::Dilate18(Image3<int> const& inImage,
     Image3<int>& outImage)
 {
-    std::array<int, 3> delta[18] =
-    {
-        { 0, -1, -1 },
-        { -1, 0, -1 },
-        { 0, 0, -1 },
-        { +1, 0, -1 },
-        { 0, +1, -1 },
-        { -1, -1, 0 },
-        { 0, -1, 0 },
-        { +1, -1, 0 },
-        { -1, 0, 0 },
-        { +1, 0, 0 },
-        { -1, +1, 0 },
-        { 0, +1, 0 },
-        { +1, +1, 0 },
-        { 0, -1, +1 },
-        { -1, 0, +1 },
-        { 0, 0, +1 },
-        { +1, 0, +1 },
-        { 0, +1, +1 }
-    };
-
-    Dilate(18, delta, inImage, outImage);
+    Dilate(18, msNeighbors18, inImage, outImage);
 }
 //----------------------------------------------------------------------------
 void ImageUtility3::Dilate6(Image3<int> const& inImage, Image3<int>& outImage)
 {
-    std::array<int, 3> delta[6] =
-    {
-        { -1, 0, 0 },
-        { +1, 0, 0 },
-        { 0, -1, 0 },
-        { 0, +1, 0 },
-        { 0, 0, -1 },
-        { 0, 0, +1 }
-    };
-
-    Dilate(6, delta, inImage, outImage);
+    Dilate(6, msNeighbors6, inImage, outImage);
 }
 //----------------------------------------------------------------------------
 void ImageUtility3::ComputeCDConvex(Image3<int>& image)
@@ -95,7 +95,9 @@ void ImageUtility3::ComputeCDConvex(Image3<int>& image)
     int const dim1 = image.GetDimension(1);
     int const dim2 = image.GetDimension(2);
 
-    Image3<int> temp = image;
+    // Mark the voxels outside the convex set with bit 1.  The marking is
+    // done in place rather than in a copy of the image, which matters when
+    // the image is mapped and larger than physical memory.
     int i0, i1, i2;
     for (i1 = 0; i1 < dim1; ++i1)
     {
@@ -104,9 +106,9 @@ void ImageUtility3::ComputeCDConvex(Image3<int>& image)
             int i2min;
             for (i2min = 0; i2min < dim2; ++i2min)
             {
-                if ((temp(i0, i1, i2min) & 1) == 0)
+                if ((image(i0, i1, i2min) & 1) == 0)
                 {
-                    temp(i0, i1, i2min) |= 2;
+                    image(i0, i1, i2min) |= 2;
                 }
                 else
                 {
@@ -118,9 +120,9 @@ void ImageUtility3::ComputeCDConvex(Image3<int>& image)
                 int i2max;
                 for (i2max = dim2 - 1; i2max >= i2min; --i2max)
                 {
-                    if ((temp(i0, i1, i2max) & 1) == 0)
+                    if ((image(i0, i1, i2max) & 1) == 0)
                     {
-                        temp(i0, i1, i2max) |= 2;
+                        image(i0, i1, i2max) |= 2;
                     }
                     else
                     {
@@ -138,9 +140,9 @@ void ImageUtility3::ComputeCDConvex(Image3<int>& image)
             int i1min;
             for (i1min = 0; i1min < dim1; ++i1min)
             {
-                if ((temp(i0, i1min, i2) & 1) == 0)
+                if ((image(i0, i1min, i2) & 1) == 0)
                 {
-                    temp(i0, i1min, i2) |= 2;
+                    image(i0, i1min, i2) |= 2;
                 }
                 else
                 {
@@ -152,9 +154,9 @@ void ImageUtility3::ComputeCDConvex(Image3<int>& image)
                 int i1max;
                 for (i1max = dim1 - 1; i1max >= i1min; --i1max)
                 {
-                    if ((temp(i0, i1max, i2) & 1) == 0)
+                    if ((image(i0, i1max, i2) & 1) == 0)
                     {
-                        temp(i0, i1max, i2) |= 2;
+                        image(i0, i1max, i2) |= 2;
                     }
                     else
                     {
@@ -172,9 +174,9 @@ void ImageUtility3::ComputeCDConvex(Image3<int>& image)
             int i0min;
             for (i0min = 0; i0min < dim0; ++i0min)
             {
-                if ((temp(i0min, i1, i2) & 1) == 0)
+                if ((image(i0min, i1, i2) & 1) == 0)
                 {
-                    temp(i0min, i1, i2) |= 2;
+                    image(i0min, i1, i2) |= 2;
                 }
                 else
                 {
@@ -186,9 +188,9 @@ void ImageUtility3::ComputeCDConvex(Image3<int>& image)
                 int i0max;
                 for (i0max = dim0 - 1; i0max >= i0min; --i0max)
                 {
-                    if ((temp(i0max, i1, i2) & 1) == 0)
+                    if ((image(i0max, i1, i2) & 1) == 0)
                     {
-                        temp(i0max, i1, i2) |= 2;
+                        image(i0max, i1, i2) |= 2;
                     }
                     else
                     {
@@ -201,12 +203,28 @@ void ImageUtility3::ComputeCDConvex(Image3<int>& image)
 
     for (int i = 0; i < image.GetNumPixels(); ++i)
     {
-        image[i] = (temp[i] & 2 ? 0 : 1);
+        image[i] = (image[i] & 2 ? 0 : 1);
     }
 }
 //----------------------------------------------------------------------------
+void ImageUtility3::GetExactL2Distance(Image3<int> const& image,
+    float& maxDistance, int& xMax, int& yMax, int& zMax,
+    Image3<float>& transform, unsigned int numThreads)
+{
+    GetExactL2Distance(image, maxDistance, xMax, yMax, zMax, transform,
+        nullptr, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::GetExactL2Distance(Image3<int> const& image,
+    float& maxDistance, int& xMax, int& yMax, int& zMax,
+    Image3<float>& transform, Image3<int>& nearest, unsigned int numThreads)
+{
+    GetExactL2Distance(image, maxDistance, xMax, yMax, zMax, transform,
+        &nearest, numThreads);
+}
+//----------------------------------------------------------------------------
 void ImageUtility3::GetComponents26(Image3<int>& image,
-    std::vector<std::vector<int> >& components)
+    std::vector<std::vector<int> >& components, unsigned int numThreads)
 {
     // Incremental 1D offsets for 26-connected neighbors.  Store +1 and -1
     // first, the xy-offsets second, to be cache friendly during the
@@ -243,11 +261,11 @@ void ImageUtility3::GetComponents26(Image3<int>& image,
         +1 + dim0 - dim01
     };
 
-    GetComponents(26, delta, image, components);
+    GetComponents(26, delta, image, components, numThreads);
 }
 //----------------------------------------------------------------------------
 void ImageUtility3::GetComponents18(Image3<int>& image,
-    std::vector<std::vector<int> >& components)
+    std::vector<std::vector<int> >& components, unsigned int numThreads)
 {
     // Incremental 1D offsets for 18-connected neighbors.  Store +1 and -1
     // first, the xy-offsets second, to be cache friendly during the
@@ -276,11 +294,11 @@ void ImageUtility3::GetComponents18(Image3<int>& image,
         0 + dim0 - dim01
     };
 
-    GetComponents(18, delta, image, components);
+    GetComponents(18, delta, image, components, numThreads);
 }
 //----------------------------------------------------------------------------
 void ImageUtility3::GetComponents6(Image3<int>& image,
-    std::vector<std::vector<int> >& components)
+    std::vector<std::vector<int> >& components, unsigned int numThreads)
 {
     // Incremental 1D offsets for 6-connected neighbors.  Store +1 and -1
     // first to be cache friendly during the depth-first search.
@@ -296,9 +314,130 @@ void ImageUtility3::GetComponents6(Image3<int>& image,
         -dim01
     };
 
+    GetComponents(6, delta, image, components, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::Dilate26(BrickedImage3<int> const& inImage,
+    BrickedImage3<int>& outImage)
+{
+    Dilate(26, msNeighbors26, inImage, outImage);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::Dilate18(BrickedImage3<int> const& inImage,
+    BrickedImage3<int>& outImage)
+{
+    Dilate(18, msNeighbors18, inImage, outImage);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::Dilate6(BrickedImage3<int> const& inImage,
+    BrickedImage3<int>& outImage)
+{
+    Dilate(6, msNeighbors6, inImage, outImage);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::GetComponents26(BrickedImage3<int>& image,
+    std::vector<std::vector<int> >& components)
+{
+    // The 26-connected neighbors in the order used for Image3, +x and -x
+    // first and the xy-neighbors second, so that the depth-first search
+    // prefers the neighbors in the same row of the brick.
+    std::array<int, 3> const delta[26] =
+    {
+        { +1, 0, 0 },
+        { -1, 0, 0 },
+        { -1, -1, 0 },
+        { 0, -1, 0 },
+        { +1, -1, 0 },
+        { -1, +1, 0 },
+        { 0, +1, 0 },
+        { +1, +1, 0 },
+        { 0, 0, +1 },
+        { +1, 0, +1 },
+        { -1, 0, +1 },
+        { -1, -1, +1 },
+        { 0, -1, +1 },
+        { +1, -1, +1 },
+        { -1, +1, +1 },
+        { 0, +1, +1 },
+        { +1, +1, +1 },
+        { 0, 0, -1 },
+        { +1, 0, -1 },
+        { -1, 0, -1 },
+        { -1, -1, -1 },
+        { 0, -1, -1 },
+        { +1, -1, -1 },
+        { -1, +1, -1 },
+        { 0, +1, -1 },
+        { +1, +1, -1 }
+    };
+
+    GetComponents(26, delta, image, components);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::GetComponents18(BrickedImage3<int>& image,
+    std::vector<std::vector<int> >& components)
+{
+    // The 18-connected neighbors in the order used for Image3.
+    std::array<int, 3> const delta[18] =
+    {
+        { +1, 0, 0 },
+        { -1, 0, 0 },
+        { -1, -1, 0 },
+        { 0, -1, 0 },
+        { +1, -1, 0 },
+        { -1, +1, 0 },
+        { 0, +1, 0 },
+        { +1, +1, 0 },
+        { 0, 0, +1 },
+        { +1, 0, +1 },
+        { -1, 0, +1 },
+        { 0, -1, +1 },
+        { 0, +1, +1 },
+        { 0, 0, -1 },
+        { +1, 0, -1 },
+        { -1, 0, -1 },
+        { 0, -1, -1 },
+        { 0, +1, -1 }
+    };
+
+    GetComponents(18, delta, image, components);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::GetComponents6(BrickedImage3<int>& image,
+    std::vector<std::vector<int> >& components)
+{
+    // The 6-connected neighbors in the order used for Image3.
+    std::array<int, 3> const delta[6] =
+    {
+        { +1, 0, 0 },
+        { -1, 0, 0 },
+        { 0, -1, 0 },
+        { 0, +1, 0 },
+        { 0, 0, +1 },
+        { 0, 0, -1 }
+    };
+
     GetComponents(6, delta, image, components);
 }
 //----------------------------------------------------------------------------
+void ImageUtility3::Dilate26(BinaryImage3 const& inImage,
+    BinaryImage3& outImage, unsigned int numThreads)
+{
+    Dilate(26, msNeighbors26, inImage, outImage, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::Dilate18(BinaryImage3 const& inImage,
+    BinaryImage3& outImage, unsigned int numThreads)
+{
+    Dilate(18, msNeighbors18, inImage, outImage, numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::Dilate6(BinaryImage3 const& inImage,
+    BinaryImage3& outImage, unsigned int numThreads)
+{
+    Dilate(6, msNeighbors6, inImage, outImage, numThreads);
+}
+//----------------------------------------------------------------------------
 void ImageUtility3::DrawLine(int x0, int y0, int z0, int x1, int y1, int z1,
     std::function<void(int, int, int)> const& callback)
 {
@@ -457,26 +596,74 @@ void ImageUtility3::Dilate(int numNeighbors, std::array<int, 3> const delta[],
     }
 }
 //----------------------------------------------------------------------------
+void ImageUtility3::GetExactL2Distance(Image3<int> const& image,
+    float& maxDistance, int& xMax, int& yMax, int& zMax,
+    Image3<float>& transform, Image3<int>* nearest, unsigned int numThreads)
+{
+    int const dimensions[3] = { image.GetDimension(0),
+        image.GetDimension(1), image.GetDimension(2) };
+    transform.Resize(dimensions[0], dimensions[1], dimensions[2]);
+    if (nearest)
+    {
+        nearest->Resize(dimensions[0], dimensions[1], dimensions[2]);
+    }
+
+    // The squared distances are computed in the storage of 'transform' and
+    // then replaced by the distances.
+    int const numVoxels = image.GetNumPixels();
+    float* distance = transform.GetPixels1D();
+    EuclideanDistanceTransform::Execute(3, dimensions, numThreads,
+        image.GetPixels1D(), distance,
+        (nearest ? nearest->GetPixels1D() : nullptr));
+
+    int maxIndex;
+    EuclideanDistanceTransform::GetDistances(numVoxels, numThreads, distance,
+        maxDistance, maxIndex);
+    image.GetCoordinates(maxIndex, xMax, yMax, zMax);
+}
+//----------------------------------------------------------------------------
 void ImageUtility3::GetComponents(int numNeighbors, int const delta[],
-    Image3<int>& image, std::vector<std::vector<int> >& components)
+    Image3<int>& image, std::vector<std::vector<int> >& components,
+    unsigned int numThreads)
 {
+    if (numThreads > 1)
+    {
+        // Union-find labeling of slabs of slices on multiple threads.
+        // Only the neighbors that precede a voxel are needed.
+        int backward[26], numBackward = 0;
+        for (int j = 0; j < numNeighbors; ++j)
+        {
+            if (delta[j] < 0)
+            {
+                backward[numBackward++] = delta[j];
+            }
+        }
+        UnionFindLabeler::Execute(image.GetDimension(0)*
+            image.GetDimension(1), image.GetDimension(2), numBackward,
+            backward, numThreads, image.GetPixels1D(), components);
+        return;
+    }
+
+    // The stack and the component sizes grow on demand rather than being
+    // preallocated with one element per voxel, so the memory used in
+    // addition to the image is proportional to the depth of the search and
+    // the number of components.  The image may be mapped (Image3::Map) and
+    // larger than physical memory.
     int const numVoxels = image.GetNumPixels();
-    int* numElements = new int[numVoxels];
-    int* vstack = new int[numVoxels];
+    std::vector<int> numElements(1);
+    std::vector<int> vstack;
     int i, numComponents = 0;
     int label = 2;
     for (i = 0; i < numVoxels; ++i)
     {
         if (image[i] == 1)
         {
-            int top = -1;
-            vstack[++top] = i;
+            vstack.push_back(i);
 
-            int& count = numElements[numComponents + 1];
-            count = 0;
-            while (top >= 0)
+            int count = 0;
+            while (vstack.size() > 0)
             {
-                int v = vstack[top];
+                int v = vstack.back();
                 image[v] = -1;
                 int j;
                 for (j = 0; j < numNeighbors; ++j)
@@ -484,7 +671,7 @@ void ImageUtility3::GetComponents(int numNeighbors, int const delta[],
                     int adj = v + delta[j];
                     if (image[adj] == 1)
                     {
-                        vstack[++top] = adj;
+                        vstack.push_back(adj);
                         break;
                     }
                 }
@@ -492,15 +679,15 @@ void ImageUtility3::GetComponents(int numNeighbors, int const delta[],
                 {
                     image[v] = label;
                     ++count;
-                    --top;
+                    vstack.pop_back();
                 }
             }
+            numElements.push_back(count);
 
             ++numComponents;
             ++label;
         }
     }
-    delete[] vstack;
 
     if (numComponents > 0)
     {
@@ -524,6 +711,211 @@ void ImageUtility3::GetComponents(int numNeighbors, int const delta[],
             }
         }
     }
-    delete[] numElements;
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::Dilate(int numNeighbors, std::array<int, 3> const delta[],
+    BrickedImage3<int> const& inImage, BrickedImage3<int>& outImage)
+{
+    int const size = BrickedImage3<int>::BRICK_SIZE;
+    int const mask = BrickedImage3<int>::BRICK_MASK;
+    int const dim0 = inImage.GetDimension(0);
+    int const dim1 = inImage.GetDimension(1);
+    int const dim2 = inImage.GetDimension(2);
+    std::vector<int> offsets;
+    GetBrickedOffsets(numNeighbors, delta, inImage, offsets);
+
+    int brick = 0;
+    for (int b2 = 0; b2 < inImage.GetNumBricks(2); ++b2)
+    {
+        for (int b1 = 0; b1 < inImage.GetNumBricks(1); ++b1)
+        {
+            for (int b0 = 0; b0 < inImage.GetNumBricks(0); ++b0, ++brick)
+            {
+                // Dilate the voxels of the brick that are not on the image
+                // boundary.  The loop indices are brick coordinates.
+                int const x0 = size*b0, y0 = size*b1, z0 = size*b2;
+                int const l0min = std::max(1 - x0, 0);
+                int const l0max = std::min(dim0 - 1 - x0, size);
+                int const l1min = std::max(1 - y0, 0);
+                int const l1max = std::min(dim1 - 1 - y0, size);
+                int const l2min = std::max(1 - z0, 0);
+                int const l2max = std::min(dim2 - 1 - z0, size);
+                for (int l2 = l2min; l2 < l2max; ++l2)
+                {
+                    int const c2 = (l2 == 0 ? 0 : (l2 == mask ? 2 : 1));
+                    for (int l1 = l1min; l1 < l1max; ++l1)
+                    {
+                        int const c1 = (l1 == 0 ? 0 : (l1 == mask ? 2 : 1));
+                        int const row = BrickedImage3<int>::BRICK_NUM_PIXELS*
+                            brick + size*(l1 + size*l2);
+                        for (int l0 = l0min; l0 < l0max; ++l0)
+                        {
+                            int const v = row + l0;
+                            if (inImage[v] == 0)
+                            {
+                                int const c0 =
+                                    (l0 == 0 ? 0 : (l0 == mask ? 2 : 1));
+                                int const* offset = &offsets[numNeighbors*(
+                                    c0 + 3*(c1 + 3*c2))];
+                                for (int n = 0; n < numNeighbors; ++n)
+                                {
+                                    if (inImage[v + offset[n]] == 1)
+                                    {
+                                        outImage[v] = 1;
+                                        break;
+                                    }
+                                }
+                            }
+                            else
+                            {
+                                outImage[v] = 1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::Dilate(int numNeighbors, std::array<int, 3> const delta[],
+    BinaryImage3 const& inImage, BinaryImage3& outImage,
+    unsigned int numThreads)
+{
+    LogAssert(&outImage != &inImage, "Input and output must be different.");
+
+    int const dimensions[3] = { inImage.GetDimension(0),
+        inImage.GetDimension(1), inImage.GetDimension(2) };
+    outImage.Resize(dimensions[0], dimensions[1], dimensions[2]);
+    BinaryMorphology::Dilate(dimensions, inImage.GetWordsPerRow(),
+        numNeighbors, delta, inImage.GetWords(), outImage.GetWords(),
+        numThreads);
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::GetComponents(int numNeighbors,
+    std::array<int, 3> const delta[], BrickedImage3<int>& image,
+    std::vector<std::vector<int> >& components)
+{
+    int const mask = BrickedImage3<int>::BRICK_MASK;
+    int const shift = BrickedImage3<int>::BRICK_LOG;
+    std::vector<int> offsets;
+    GetBrickedOffsets(numNeighbors, delta, image, offsets);
+
+    int const numVoxels = image.GetNumPixels();
+    std::vector<int> numElements(1);
+    std::vector<int> vstack;
+    int i, numComponents = 0;
+    int label = 2;
+    for (i = 0; i < numVoxels; ++i)
+    {
+        if (image[i] == 1)
+        {
+            vstack.push_back(i);
+
+            int count = 0;
+            while (vstack.size() > 0)
+            {
+                int v = vstack.back();
+                image[v] = -1;
+                int const l0 = v & mask;
+                int const l1 = (v >> shift) & mask;
+                int const l2 = (v >> (2*shift)) & mask;
+                int const c0 = (l0 == 0 ? 0 : (l0 == mask ? 2 : 1));
+                int const c1 = (l1 == 0 ? 0 : (l1 == mask ? 2 : 1));
+                int const c2 = (l2 == 0 ? 0 : (l2 == mask ? 2 : 1));
+                int const* offset =
+                    &offsets[numNeighbors*(c0 + 3*(c1 + 3*c2))];
+                int j;
+                for (j = 0; j < numNeighbors; ++j)
+                {
+                    int adj = v + offset[j];
+                    if (image[adj] == 1)
+                    {
+                        vstack.push_back(adj);
+                        break;
+                    }
+                }
+                if (j == numNeighbors)
+                {
+                    image[v] = label;
+                    ++count;
+                    vstack.pop_back();
+                }
+            }
+            numElements.push_back(count);
+
+            ++numComponents;
+            ++label;
+        }
+    }
+
+    if (numComponents > 0)
+    {
+        components.resize(numComponents + 1);
+        for (i = 1; i <= numComponents; ++i)
+        {
+            components[i].resize(numElements[i]);
+            numElements[i] = 0;
+        }
+
+        for (i = 0; i < numVoxels; ++i)
+        {
+            int value = image[i];
+            if (value != 0)
+            {
+                image[i] = --value;
+                components[value][numElements[value]] = i;
+                ++numElements[value];
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void ImageUtility3::GetBrickedOffsets(int numNeighbors,
+    std::array<int, 3> const delta[], BrickedImage3<int> const& image,
+    std::vector<int>& offsets)
+{
+    // A brick coordinate l is in class 0 when l = 0, in class 2 when
+    // l = BRICK_SIZE-1, and in class 1 otherwise.  For a neighbor offset d,
+    // l+d is in the same brick for class 1.  For the other classes, l+d is
+    // either in the same brick or it wraps around to the adjacent brick, so
+    // the difference of the bricked indices of a voxel and its neighbor
+    // depends only on the classes of the brick coordinates of the voxel.
+    int const size = BrickedImage3<int>::BRICK_SIZE;
+    int const brickStep[3] =
+    {
+        BrickedImage3<int>::BRICK_NUM_PIXELS,
+        BrickedImage3<int>::BRICK_NUM_PIXELS*image.GetNumBricks(0),
+        BrickedImage3<int>::BRICK_NUM_PIXELS*image.GetNumBricks(0)*
+            image.GetNumBricks(1)
+    };
+    int const localStep[3] = { 1, size, size*size };
+    int const representative[3] = { 0, 1, size - 1 };
+
+    offsets.resize(27*numNeighbors);
+    for (int c = 0, k = 0; c < 27; ++c)
+    {
+        int const cls[3] = { c % 3, (c / 3) % 3, c / 9 };
+        for (int n = 0; n < numNeighbors; ++n, ++k)
+        {
+            offsets[k] = 0;
+            for (int i = 0; i < 3; ++i)
+            {
+                int l = representative[cls[i]] + delta[n][i];
+                if (l < 0)
+                {
+                    offsets[k] += (size - 1)*localStep[i] - brickStep[i];
+                }
+                else if (l >= size)
+                {
+                    offsets[k] += brickStep[i] - (size - 1)*localStep[i];
+                }
+                else
+                {
+                    offsets[k] += delta[n][i]*localStep[i];
+                }
+            }
+        }
+    }
 }
 //----------------------------------------------------------------------------
@@ -0,0 +1,406 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#include "GTEnginePCH.h"
+#include "GteTSIndexedManifoldMesh.h"
+#include "GteTetrahedronKey.h"
+using namespace gte;
+
+//----------------------------------------------------------------------------
+TSIndexedManifoldMesh::~TSIndexedManifoldMesh()
+{
+}
+//----------------------------------------------------------------------------
+TSIndexedManifoldMesh::TSIndexedManifoldMesh(int numTetrahedra)
+    :
+    mNumTetrahedra(0),
+    mNumFaces(0),
+    mNumBoundaryFaces(0)
+{
+    Reserve(numTetrahedra);
+}
+//----------------------------------------------------------------------------
+void TSIndexedManifoldMesh::Reserve(int numTetrahedra)
+{
+    numTetrahedra = std::max(numTetrahedra, 1);
+    size_t numHandles = static_cast<size_t>(numTetrahedra);
+    mV.reserve(numHandles);
+    mS.reserve(numHandles);
+    mValid.reserve(numHandles);
+    mFree.reserve(numHandles);
+
+    // A mesh whose faces are mostly shared has about 2*numTetrahedra faces
+    // and the table is kept at most half full.
+    size_t numSlots = 16;
+    while (numSlots < 4 * numHandles)
+    {
+        numSlots <<= 1;
+    }
+    if (numSlots > mFTable.size())
+    {
+        RehashFaces(numSlots);
+    }
+}
+//----------------------------------------------------------------------------
+void TSIndexedManifoldMesh::Clear()
+{
+    mV.clear();
+    mS.clear();
+    mValid.clear();
+    mFree.clear();
+    mNumTetrahedra = 0;
+    for (auto& slot : mFTable)
+    {
+        slot.T[0] = -1;
+        slot.T[1] = -1;
+    }
+    mNumFaces = 0;
+    mNumBoundaryFaces = 0;
+}
+//----------------------------------------------------------------------------
+int TSIndexedManifoldMesh::Insert(int v0, int v1, int v2, int v3)
+{
+    // Before modifying the mesh, verify that the tetrahedron does not exist
+    // and that the insertion does not lead to a nonmanifold mesh.
+    std::array<int, 4> v = {{ v0, v1, v2, v3 }};
+    auto const& opposite = TetrahedronKey<true>::oppositeFace;
+    TriangleKey<false> fkey[4];
+    for (int j = 0; j < 4; ++j)
+    {
+        fkey[j] = TriangleKey<false>(v[opposite[j][0]], v[opposite[j][1]],
+            v[opposite[j][2]]);
+        FSlot const& slot = mFTable[FindFace(fkey[j])];
+        if (slot.T[0] >= 0)
+        {
+            for (int k = 0; k < 2; ++k)
+            {
+                int s = slot.T[k];
+                if (s >= 0 && mV[s][GetFaceIndex(s, fkey[j])] == v[j])
+                {
+                    // The tetrahedron already exists.  Return -1 as a signal
+                    // to the caller that the insertion failed.
+                    return -1;
+                }
+            }
+
+            if (slot.T[1] >= 0)
+            {
+                LogError("The mesh must be manifold.");
+                return -1;
+            }
+        }
+    }
+
+    // Add the new tetrahedron, recycling a handle when possible.
+    int t;
+    if (mFree.size() > 0)
+    {
+        t = mFree.back();
+        mFree.pop_back();
+    }
+    else
+    {
+        t = static_cast<int>(mV.size());
+        mV.push_back(std::array<int, 4>());
+        mS.push_back(std::array<int, 4>());
+        mValid.push_back(0);
+    }
+    mV[t] = v;
+    mS[t] = {{ -1, -1, -1, -1 }};
+    mValid[t] = 1;
+    ++mNumTetrahedra;
+
+    // Add the faces to the mesh if they do not already exist.
+    for (int j = 0; j < 4; ++j)
+    {
+        size_t index = FindFace(fkey[j]);
+        FSlot& slot = mFTable[index];
+        if (slot.T[0] < 0)
+        {
+            // This is the first time the face is encountered.
+            InsertFace(index, fkey[j], t);
+            ++mNumBoundaryFaces;
+        }
+        else
+        {
+            // This is the second time the face is encountered.
+            int adjacent = slot.T[0];
+            slot.T[1] = t;
+            --mNumBoundaryFaces;
+
+            // Update the adjacent tetrahedra.
+            mS[adjacent][GetFaceIndex(adjacent, fkey[j])] = t;
+            mS[t][j] = adjacent;
+        }
+    }
+
+    return t;
+}
+//----------------------------------------------------------------------------
+int TSIndexedManifoldMesh::Find(int v0, int v1, int v2, int v3) const
+{
+    TriangleKey<false> fkey(v1, v2, v3);
+    FSlot const& slot = mFTable[FindFace(fkey)];
+    if (slot.T[0] >= 0)
+    {
+        TetrahedronKey<true> skey(v0, v1, v2, v3);
+        for (int k = 0; k < 2; ++k)
+        {
+            int s = slot.T[k];
+            if (s >= 0)
+            {
+                TetrahedronKey<true> test(mV[s][0], mV[s][1], mV[s][2],
+                    mV[s][3]);
+                if (!(test < skey) && !(skey < test))
+                {
+                    return s;
+                }
+            }
+        }
+    }
+    return -1;
+}
+//----------------------------------------------------------------------------
+bool TSIndexedManifoldMesh::Remove(int t)
+{
+    if (!IsValid(t))
+    {
+        return false;
+    }
+
+    auto const& opposite = TetrahedronKey<true>::oppositeFace;
+    for (int j = 0; j < 4; ++j)
+    {
+        // Inform the face the tetrahedron is being deleted.
+        std::array<int, 4> const& v = mV[t];
+        TriangleKey<false> fkey(v[opposite[j][0]], v[opposite[j][1]],
+            v[opposite[j][2]]);
+        size_t index = FindFace(fkey);
+        FSlot& slot = mFTable[index];
+        if (slot.T[0] == t)
+        {
+            // One-tetrahedron faces always have the handle at index zero.
+            slot.T[0] = slot.T[1];
+            slot.T[1] = -1;
+        }
+        else if (slot.T[1] == t)
+        {
+            slot.T[1] = -1;
+        }
+        else
+        {
+            LogError("Unexpected condition.");
+            return false;
+        }
+
+        // Remove the face if you have the last reference to it.
+        if (slot.T[0] < 0)
+        {
+            RemoveFace(index);
+            --mNumBoundaryFaces;
+        }
+        else
+        {
+            ++mNumBoundaryFaces;
+        }
+
+        // Inform the adjacent tetrahedron the tetrahedron is being deleted.
+        int adjacent = mS[t][j];
+        if (adjacent >= 0)
+        {
+            std::array<int, 4>& s = mS[adjacent];
+            for (int k = 0; k < 4; ++k)
+            {
+                if (s[k] == t)
+                {
+                    s[k] = -1;
+                    break;
+                }
+            }
+        }
+    }
+
+    mValid[t] = 0;
+    mFree.push_back(t);
+    --mNumTetrahedra;
+    return true;
+}
+//----------------------------------------------------------------------------
+bool TSIndexedManifoldMesh::Remove(int v0, int v1, int v2, int v3)
+{
+    return Remove(Find(v0, v1, v2, v3));
+}
+//----------------------------------------------------------------------------
+bool TSIndexedManifoldMesh::Print(std::string const& filename)
+{
+    std::ofstream outFile(filename);
+    if (!outFile)
+    {
+        return false;
+    }
+
+    // Print the faces.
+    outFile << "triangle quantity = " << mNumFaces << std::endl;
+    for (auto const& slot : mFTable)
+    {
+        if (slot.T[0] < 0)
+        {
+            continue;
+        }
+
+        outFile << "<v" << slot.key.V[0] << ",v" << slot.key.V[1] << ",v"
+            << slot.key.V[2] << "; ";
+        for (int j = 0; j < 2; ++j)
+        {
+            if (slot.T[j] >= 0)
+            {
+                outFile << 's' << slot.T[j];
+            }
+            else
+            {
+                outFile << '*';
+            }
+            outFile << (j == 0 ? ',' : '>');
+        }
+        outFile << std::endl;
+    }
+    outFile << std::endl;
+
+    // Print the tetrahedra.
+    outFile << "tetrahedron quantity = " << mNumTetrahedra << std::endl;
+    for (int t = 0; t < static_cast<int>(mV.size()); ++t)
+    {
+        if (!mValid[t])
+        {
+            continue;
+        }
+
+        outFile << 's' << t << " <"
+            << 'v' << mV[t][0] << ",v" << mV[t][1] << ",v"
+            << mV[t][2] << ",v" << mV[t][3] << "; ";
+        for (int j = 0; j < 4; ++j)
+        {
+            if (mS[t][j] >= 0)
+            {
+                outFile << 's' << mS[t][j];
+            }
+            else
+            {
+                outFile << '*';
+            }
+            outFile << (j < 3 ? ',' : '>');
+        }
+        outFile << std::endl;
+    }
+    outFile << std::endl;
+    return true;
+}
+//----------------------------------------------------------------------------
+unsigned int TSIndexedManifoldMesh::Hash(TriangleKey<false> const& key)
+{
+    // Multiplicative hashing of the vertex indices followed by a final
+    // avalanche step so that the low-order bits depend on all inputs.
+    unsigned int h = static_cast<unsigned int>(key.V[0]) * 0x9E3779B1u;
+    h ^= static_cast<unsigned int>(key.V[1]) * 0x85EBCA77u;
+    h ^= static_cast<unsigned int>(key.V[2]) * 0xC2B2AE3Du;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 13;
+    return h;
+}
+//----------------------------------------------------------------------------
+size_t TSIndexedManifoldMesh::FindFace(TriangleKey<false> const& key) const
+{
+    size_t mask = mFTable.size() - 1;
+    size_t i = Hash(key) & mask;
+    for (;;)
+    {
+        FSlot const& slot = mFTable[i];
+        if (slot.T[0] < 0
+            || (slot.key.V[0] == key.V[0] && slot.key.V[1] == key.V[1]
+            && slot.key.V[2] == key.V[2]))
+        {
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+}
+//----------------------------------------------------------------------------
+void TSIndexedManifoldMesh::InsertFace(size_t slot,
+    TriangleKey<false> const& key, int t)
+{
+    if (2 * static_cast<size_t>(mNumFaces + 1) > mFTable.size())
+    {
+        RehashFaces(2 * mFTable.size());
+        slot = FindFace(key);
+    }
+    mFTable[slot].key = key;
+    mFTable[slot].T[0] = t;
+    mFTable[slot].T[1] = -1;
+    ++mNumFaces;
+}
+//----------------------------------------------------------------------------
+void TSIndexedManifoldMesh::RemoveFace(size_t slot)
+{
+    // Backward-shift deletion.  Entries following the removed one in its
+    // probe sequence are moved back so that no tombstones are required.
+    size_t mask = mFTable.size() - 1;
+    size_t i = slot, j = slot;
+    for (;;)
+    {
+        j = (j + 1) & mask;
+        if (mFTable[j].T[0] < 0)
+        {
+            break;
+        }
+
+        size_t home = Hash(mFTable[j].key) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask))
+        {
+            mFTable[i] = mFTable[j];
+            i = j;
+        }
+    }
+    mFTable[i].T[0] = -1;
+    mFTable[i].T[1] = -1;
+    --mNumFaces;
+}
+//----------------------------------------------------------------------------
+void TSIndexedManifoldMesh::RehashFaces(size_t numSlots)
+{
+    std::vector<FSlot> oldTable(numSlots);
+    for (auto& slot : oldTable)
+    {
+        slot.T[0] = -1;
+        slot.T[1] = -1;
+    }
+    std::swap(oldTable, mFTable);
+
+    for (auto const& slot : oldTable)
+    {
+        if (slot.T[0] >= 0)
+        {
+            mFTable[FindFace(slot.key)] = slot;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+int TSIndexedManifoldMesh::GetFaceIndex(int t, TriangleKey<false> const& key)
+    const
+{
+    // The face opposite V[t][j] is the one that does not contain V[t][j].
+    std::array<int, 4> const& v = mV[t];
+    for (int j = 0; j < 4; ++j)
+    {
+        if (v[j] != key.V[0] && v[j] != key.V[1] && v[j] != key.V[2])
+        {
+            return j;
+        }
+    }
+    return -1;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,272 @@
+// Geometric Tools LLC, Redmond WA 98052
+// Copyright (c) 1998-2014
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 1.0.0 (2014/08/11)
+
+#include "GTEnginePCH.h"
+#include "GteUnionFindLabeler.h"
+#include "GteParallelFor.h"
+using namespace gte;
+
+//----------------------------------------------------------------------------
+void UnionFindLabeler::Execute(int layerSize, int numLayers,
+    int numBackward, int const backward[], unsigned int numThreads,
+    int* pixels, std::vector<std::vector<int> >& components)
+{
+    if (numLayers <= 0)
+    {
+        return;
+    }
+    numThreads = ParallelFor::GetNumThreads(numThreads, numLayers);
+
+    // The slab of thread t is the index range [first[t],first[t+1]).
+    std::vector<int> first(numThreads + 1);
+    for (unsigned int t = 0; t < numThreads; ++t)
+    {
+        int lmin, lmax;
+        ParallelFor::GetRange(numLayers, numThreads, t, lmin, lmax);
+        first[t] = layerSize*lmin;
+    }
+    first[numThreads] = layerSize*numLayers;
+
+    // The neighbors are visited in the order of decreasing number of
+    // adjacent neighbors.  Once a foreground neighbor is merged, the
+    // neighbors adjacent to it are already in its set and are skipped.
+    int offset[MAX_BACKWARD];
+    unsigned int adjacent[MAX_BACKWARD];
+    GetMergeOrder(numBackward, backward, offset, adjacent);
+
+    // The parent of a background pixel is -1.
+    int const numPixels = layerSize*numLayers;
+    std::vector<int> parent(numPixels);
+
+    // Union the foreground pixels with their preceding neighbors in the
+    // slab.  The pixels that are roots when visited are the candidates for
+    // the roots of the components.
+    std::vector<std::vector<int> > roots(numThreads);
+    ParallelFor::Execute(numThreads, [&](unsigned int t)
+    {
+        int const imin = first[t], imax = first[t + 1];
+        for (int i = imin; i < imax; ++i)
+        {
+            if (pixels[i] == 1)
+            {
+                // Merge the sets of the neighbors, keeping track of the
+                // root of the merged set.
+                int root = i;
+                unsigned int skip = 0;
+                for (int b = 0; b < numBackward; ++b)
+                {
+                    if ((skip & (1u << b)) == 0)
+                    {
+                        int j = i + offset[b];
+                        if (j >= imin && pixels[j] == 1)
+                        {
+                            if (root == i)
+                            {
+                                root = Find(parent, j);
+                            }
+                            else if (parent[j] != root)
+                            {
+                                root = Union(parent, root, j);
+                            }
+                            skip |= adjacent[b];
+                        }
+                    }
+                }
+                parent[i] = root;
+                if (root == i)
+                {
+                    roots[t].push_back(i);
+                }
+            }
+            else
+            {
+                parent[i] = -1;
+            }
+        }
+    });
+
+    // Merge the equivalences across the slab boundaries.  The boundary
+    // pixels of the image are background, so only the pixels in the first
+    // layer of a slab have neighbors in the previous slab.
+    for (unsigned int t = 1; t < numThreads; ++t)
+    {
+        int const imin = first[t], imax = imin + layerSize;
+        for (int i = imin; i < imax; ++i)
+        {
+            if (pixels[i] == 1)
+            {
+                for (int b = 0; b < numBackward; ++b)
+                {
+                    int j = i + backward[b];
+                    if (j < imin && pixels[j] == 1)
+                    {
+                        Union(parent, Find(parent, i), j);
+                    }
+                }
+            }
+        }
+    }
+
+    // Label the roots in index order.  A root is the smallest index of its
+    // component, so the components are numbered as in the depth-first
+    // search.
+    int numComponents = 0;
+    for (unsigned int t = 0; t < numThreads; ++t)
+    {
+        for (auto i : roots[t])
+        {
+            if (parent[i] == i)
+            {
+                pixels[i] = ++numComponents;
+            }
+        }
+    }
+    roots.clear();
+    if (numComponents == 0)
+    {
+        return;
+    }
+
+    // Label the other pixels with the labels of their roots and count the
+    // pixels of each component in each slab.  Only the pixels that are not
+    // roots are written, so the labels of the roots may be read
+    // concurrently.
+    std::vector<std::vector<int> > offsets(numThreads);
+    ParallelFor::Execute(numThreads, [&](unsigned int t)
+    {
+        std::vector<int>& count = offsets[t];
+        count.resize(numComponents + 1);
+        for (int i = first[t]; i < first[t + 1]; ++i)
+        {
+            int root = parent[i];
+            if (root >= 0)
+            {
+                if (root != i)
+                {
+                    while (parent[root] != root)
+                    {
+                        root = parent[root];
+                    }
+                    pixels[i] = pixels[root];
+                }
+                ++count[pixels[root]];
+            }
+        }
+    });
+    parent.clear();
+
+    // Build the component lists.  The pixels of component k in slab t are
+    // stored starting at offsets[t][k], so the lists are in index order.
+    components.resize(numComponents + 1);
+    for (int k = 1; k <= numComponents; ++k)
+    {
+        int count = 0;
+        for (unsigned int t = 0; t < numThreads; ++t)
+        {
+            int saveCount = count;
+            count += offsets[t][k];
+            offsets[t][k] = saveCount;
+        }
+        components[k].resize(count);
+    }
+
+    ParallelFor::Execute(numThreads, [&](unsigned int t)
+    {
+        for (int i = first[t]; i < first[t + 1]; ++i)
+        {
+            int const k = pixels[i];
+            if (k != 0)
+            {
+                components[k][offsets[t][k]++] = i;
+            }
+        }
+    });
+}
+//----------------------------------------------------------------------------
+void UnionFindLabeler::GetMergeOrder(int numBackward, int const backward[],
+    int offset[], unsigned int adjacent[])
+{
+    // Neighbors b and c are adjacent when their difference is an offset of
+    // the neighborhood.  The boundary pixels of the image are background,
+    // so a difference that wraps around a row or slice never relates two
+    // foreground pixels.
+    int count[MAX_BACKWARD];
+    for (int b = 0; b < numBackward; ++b)
+    {
+        offset[b] = backward[b];
+        count[b] = 0;
+        for (int c = 0; c < numBackward; ++c)
+        {
+            int diff = backward[c] - backward[b];
+            for (int e = 0; e < numBackward; ++e)
+            {
+                if (diff == backward[e] || diff == -backward[e])
+                {
+                    ++count[b];
+                    break;
+                }
+            }
+        }
+    }
+
+    // Sort by decreasing count with a stable insertion sort.
+    for (int b = 1; b < numBackward; ++b)
+    {
+        int saveOffset = offset[b], saveCount = count[b];
+        int c = b;
+        for (/**/; c > 0 && count[c - 1] < saveCount; --c)
+        {
+            offset[c] = offset[c - 1];
+            count[c] = count[c - 1];
+        }
+        offset[c] = saveOffset;
+        count[c] = saveCount;
+    }
+
+    for (int b = 0; b < numBackward; ++b)
+    {
+        adjacent[b] = 0;
+        for (int c = 0; c < numBackward; ++c)
+        {
+            int diff = offset[c] - offset[b];
+            for (int e = 0; e < numBackward; ++e)
+            {
+                if (diff == offset[e] || diff == -offset[e])
+                {
+                    adjacent[b] |= (1u << c);
+                    break;
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+int UnionFindLabeler::Find(std::vector<int>& parent, int i)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+//----------------------------------------------------------------------------
+int UnionFindLabeler::Union(std::vector<int>& parent, int root, int j)
+{
+    int rj = Find(parent, j);
+    if (rj < root)
+    {
+        parent[root] = rj;
+        return rj;
+    }
+    if (root < rj)
+    {
+        parent[rj] = root;
+    }
+    return root;
+}
+//----------------------------------------------------------------------------